@@ -0,0 +1,732 @@
+/***************************************************************************//**
+ * @file asmgen.c
+ * @brief Implementation der Übersetzung nach x86-64-Assembler.
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "asmgen.h"
+#include "vec.h"
+
+/* *** internal structures ************************************************** */
+
+/**
+ * @internal
+ * @brief Zustand des Übersetzers.
+ */
+typedef struct {
+	const Program *ast;     /**<@brief Der übersetzte Syntaxbaum. */
+	const DefInfo *defs;    /**<@brief Die Definitionstabelle. */
+	FILE *out;              /**<@brief Der Ausgabestrom. */
+	DataType ret_type;      /**<@brief Rückgabetyp der aktuellen Funktion. */
+	unsigned int depth;     /**<@brief Anzahl gesicherter Werte auf dem Stack. */
+	unsigned int labels;    /**<@brief Anzahl bisher vergebener Sprungmarken. */
+	unsigned int epilogue;  /**<@brief Sprungmarke des Epilogs der Funktion. */
+	const char **strings;   /**<@brief Vektor aller Zeichenkettenliterale. */
+} AsmGen;
+
+/**
+ * @internal
+ * @brief Übergabeort eines Arguments nach der System V ABI.
+ */
+typedef enum {
+	PASS_INT,   /**<@brief In einem Allzweckregister. */
+	PASS_FLOAT, /**<@brief In einem SSE-Register. */
+	PASS_STACK  /**<@brief Auf dem Stack. */
+} Pass;
+
+/* *** internal constants *************************************************** */
+
+/** @internal @brief Die Register für `int`- und `bool`-Argumente. */
+static const char *INT_REGS[] = { "rdi", "rsi", "rdx", "rcx", "r8", "r9" };
+
+/** @internal @brief Anzahl der Register für `float`-Argumente. */
+#define FLOAT_REGS 8
+
+/** @internal @brief Die `setcc`-Befehle für Vergleiche auf `int`. */
+static const char *INT_SETCC[] = {
+	[BIN_OP_EQ]  = "sete",
+	[BIN_OP_NEQ] = "setne",
+	[BIN_OP_LT]  = "setl",
+	[BIN_OP_GT]  = "setg",
+	[BIN_OP_LEQ] = "setle",
+	[BIN_OP_GEQ] = "setge",
+};
+
+/** @internal @brief Die Befehle für Arithmetik auf `int`. */
+static const char *INT_ARITH[] = {
+	[BIN_OP_ADD] = "addl %ecx, %eax",
+	[BIN_OP_SUB] = "subl %ecx, %eax",
+	[BIN_OP_MUL] = "imull %ecx, %eax",
+	[BIN_OP_DIV] = "cltd\n\tidivl %ecx",
+};
+
+/** @internal @brief Die SSE2-Befehle für Arithmetik auf `float`. */
+static const char *FLOAT_ARITH[] = {
+	[BIN_OP_ADD] = "addsd",
+	[BIN_OP_SUB] = "subsd",
+	[BIN_OP_MUL] = "mulsd",
+	[BIN_OP_DIV] = "divsd",
+};
+
+/** @internal @brief Die Ausgabefunktionen der `print`-Anweisung. */
+static const char *PRINT_FUNCS[] = {
+	[TYPE_BOOL]   = "rt_print_bool",
+	[TYPE_INT]    = "rt_print_int",
+	[TYPE_FLOAT]  = "rt_print_float",
+	[TYPE_STRING] = "rt_print_string",
+};
+
+/**
+ * @internal
+ * @brief Die Laufzeitbibliothek am Ende jeder Ausgabe.
+ *
+ * Alle Funktionen springen direkt in die C-Bibliothek, so dass deren
+ * Rücksprung an den Aufrufer der Laufzeitfunktion geht.
+ */
+static const char RUNTIME[] =
+	"\n"
+	"/* print runtime */\n"
+	"\t.text\n"
+	"rt_print_int:\n"
+	"\tmovl %edi, %esi\n"
+	"\tleaq .Lrt_int(%rip), %rdi\n"
+	"\txorl %eax, %eax\n"
+	"\tjmp printf@PLT\n"
+	"rt_print_bool:\n"
+	"\tleaq .Lrt_true(%rip), %rax\n"
+	"\ttestl %edi, %edi\n"
+	"\tleaq .Lrt_false(%rip), %rdi\n"
+	"\tcmovnz %rax, %rdi\n"
+	"rt_print_string:\n"
+	"\tmovq %rdi, %rsi\n"
+	"\tleaq .Lrt_string(%rip), %rdi\n"
+	"\txorl %eax, %eax\n"
+	"\tjmp printf@PLT\n"
+	"rt_print_float:\n"
+	"\tucomisd %xmm0, %xmm0\n"
+	"\tjp .Lrt_print_nan\n"
+	"\tleaq .Lrt_float(%rip), %rdi\n"
+	"\tmovl $1, %eax\n"
+	"\tjmp printf@PLT\n"
+	".Lrt_print_nan:\n"
+	"\tleaq .Lrt_nan(%rip), %rdi\n"
+	"\tjmp rt_print_string\n"
+	"rt_newline:\n"
+	"\tmovl $10, %edi\n"
+	"\tjmp putchar@PLT\n"
+	"\n"
+	"\t.section .rodata\n"
+	".Lrt_int: .string \"%i\"\n"
+	".Lrt_float: .string \"%g\"\n"
+	".Lrt_string: .string \"%s\"\n"
+	".Lrt_true: .string \"true\"\n"
+	".Lrt_false: .string \"false\"\n"
+	".Lrt_nan: .string \"nan\"\n"
+	"\n"
+	"\t.section .note.GNU-stack,\"\",@progbits\n";
+
+/* *** internal helpers ***************************************************** */
+
+/* forward declarations */
+static void genExpr(AsmGen*, const Expr*);
+static void genStmt(AsmGen*, const Stmt*);
+
+/**
+ * @internal
+ * @brief Gibt einen eingerückten Befehl auf einer eigenen Zeile aus.
+ */
+static void ins(AsmGen *self, const char *fmt, ...) {
+	va_list args;
+	va_start(args, fmt);
+	fputc('\t', self->out);
+	vfprintf(self->out, fmt, args);
+	fputc('\n', self->out);
+	va_end(args);
+}
+
+/**
+ * @internal
+ * @brief Gibt eine neue, eindeutige Sprungmarke zurück.
+ */
+static inline unsigned int newLabel(AsmGen *self) {
+	return self->labels++;
+}
+
+/**
+ * @internal
+ * @brief Setzt die Sprungmarke \p label an die aktuelle Position.
+ */
+static inline void placeLabel(AsmGen *self, unsigned int label) {
+	fprintf(self->out, ".L%u:\n", label);
+}
+
+/**
+ * @internal
+ * @brief Sichert `rax` auf dem Stack.
+ */
+static inline void genPush(AsmGen *self) {
+	ins(self, "pushq %%rax");
+	++self->depth;
+}
+
+/**
+ * @internal
+ * @brief Ruft \p func mit einem auf 16 Byte ausgerichteten Stack auf.
+ */
+static void genAlignedCall(AsmGen *self, const char *func) {
+	if (self->depth % 2) { ins(self, "subq $8, %%rsp"); }
+	ins(self, "call %s", func);
+	if (self->depth % 2) { ins(self, "addq $8, %%rsp"); }
+}
+
+/**
+ * @internal
+ * @brief Erzeugt eine implizite Typumwandlung von \p from nach \p to.
+ */
+static void genConvert(AsmGen *self, DataType from, DataType to) {
+	if (from == TYPE_INT && to == TYPE_FLOAT) {
+		ins(self, "cvtsi2sdl %%eax, %%xmm0");
+		ins(self, "movq %%xmm0, %%rax");
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt den Operanden für den Speicherort der Variablen \p id zurück.
+ */
+static void genVarOperand(AsmGen *self, DefId id, char *buf, size_t size) {
+	const DefInfo *def = &self->defs[id.index];
+	
+	if (def->tag == SYM_DEF_LOCAL_VAR) {
+		snprintf(buf, size, "-%u(%%rbp)", 8*(def->var.offset + 1));
+	} else {
+		assert(def->tag == SYM_DEF_GLOBAL_VAR);
+		snprintf(buf, size, "g_%s(%%rip)", internName(def->ident));
+	}
+}
+
+/**
+ * @internal
+ * @brief Erzeugt einen Lese- oder Schreibzugriff zwischen `rax` und der
+ * Variablen \p id.
+ */
+static void genVar(AsmGen *self, DefId id, int store) {
+	char operand[64];
+	genVarOperand(self, id, operand, sizeof(operand));
+	
+	if (store) {
+		ins(self, "movq %%rax, %s", operand);
+	} else {
+		ins(self, "movq %s, %%rax", operand);
+	}
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine Zuweisung; der Wert verbleibt in `rax`.
+ */
+static void genStore(AsmGen *self, DefId id, const Expr *rhs) {
+	genExpr(self, rhs);
+	genConvert(self, rhs->data_type, self->defs[id.index].var.data_type);
+	genVar(self, id, 1);
+}
+
+/**
+ * @internal
+ * @brief Bestimmt die Übergabeorte der Parameter der Funktion \p func.
+ * @return Anzahl der auf dem Stack übergebenen Parameter.
+ */
+static unsigned int classifyParams(const AsmGen *self, const FuncInfo *func, Pass *pass) {
+	unsigned int ints = 0, floats = 0, stack = 0;
+	
+	for (unsigned int i = 0; i < func->param_count; ++i) {
+		const DefInfo *param = &self->defs[func->local_vars[i].index];
+		
+		if (param->var.data_type == TYPE_FLOAT && floats < FLOAT_REGS) {
+			pass[i] = PASS_FLOAT;
+			++floats;
+		} else if (param->var.data_type != TYPE_FLOAT && ints < 6) {
+			pass[i] = PASS_INT;
+			++ints;
+		} else {
+			pass[i] = PASS_STACK;
+			++stack;
+		}
+	}
+	
+	return stack;
+}
+
+/**
+ * @internal
+ * @brief Übersetzt einen Funktionsaufruf; das Ergebnis liegt in `rax`.
+ *
+ * Die Argumente werden von links nach rechts berechnet und auf den Stack
+ * gelegt. Anschließend werden die Stack-Argumente in der von der ABI
+ * geforderten Reihenfolge kopiert und die Register geladen.
+ */
+static void genCall(AsmGen *self, const FuncCall *call) {
+	const DefInfo *def = &self->defs[call->res_ident.res.index];
+	const FuncInfo *func = &def->func;
+	unsigned int count = func->param_count;
+	Pass *pass = malloc((count + 1)*sizeof(Pass));
+	
+	if (pass == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	for (unsigned int i = 0; i < count; ++i) {
+		genExpr(self, &call->args[i]);
+		genConvert(self, call->args[i].data_type, self->defs[func->local_vars[i].index].var.data_type);
+		genPush(self);
+	}
+	
+	unsigned int stack = classifyParams(self, func, pass);
+	unsigned int pad = (self->depth + stack) % 2;
+	unsigned int copied = 0, ints = 0, floats = 0;
+	
+	if (pad) { ins(self, "subq $8, %%rsp"); }
+	
+	/* argument i lies 8*(count - 1 - i) bytes above the pushed arguments */
+	for (unsigned int i = count; i-- > 0;) {
+		if (pass[i] == PASS_STACK) {
+			ins(self, "pushq %u(%%rsp)", 8*(copied + pad + count - 1 - i));
+			++copied;
+		}
+	}
+	
+	for (unsigned int i = 0; i < count; ++i) {
+		unsigned int offset = 8*(copied + pad + count - 1 - i);
+		
+		if (pass[i] == PASS_INT) {
+			ins(self, "movq %u(%%rsp), %%%s", offset, INT_REGS[ints++]);
+		} else if (pass[i] == PASS_FLOAT) {
+			ins(self, "movq %u(%%rsp), %%xmm%u", offset, floats++);
+		}
+	}
+	
+	ins(self, "call f_%s", internName(def->ident));
+	
+	if (func->return_type == TYPE_FLOAT) {
+		ins(self, "movq %%xmm0, %%rax");
+	}
+	
+	if (count + pad + copied > 0) {
+		ins(self, "addq $%u, %%rsp", 8*(count + pad + copied));
+	}
+	
+	self->depth -= count;
+	free(pass);
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine binäre Operation.
+ *
+ * Der linke Operand liegt anschließend in `rax` bzw. `xmm0`, der rechte in
+ * `rcx` bzw. `xmm1`.
+ */
+static void genBinOp(AsmGen *self, const BinOpExpr *bin) {
+	if (bin->op == BIN_OP_LOG_OR || bin->op == BIN_OP_LOG_AND) {
+		unsigned int end = newLabel(self);
+		genExpr(self, bin->lhs);
+		ins(self, "testl %%eax, %%eax");
+		ins(self, "%s .L%u", bin->op == BIN_OP_LOG_OR ? "jnz" : "jz", end);
+		genExpr(self, bin->rhs);
+		placeLabel(self, end);
+		return;
+	}
+	
+	int is_float = bin->lhs->data_type == TYPE_FLOAT || bin->rhs->data_type == TYPE_FLOAT;
+	
+	genExpr(self, bin->lhs);
+	if (is_float) { genConvert(self, bin->lhs->data_type, TYPE_FLOAT); }
+	genPush(self);
+	genExpr(self, bin->rhs);
+	if (is_float) { genConvert(self, bin->rhs->data_type, TYPE_FLOAT); }
+	ins(self, "movq %%rax, %%rcx");
+	ins(self, "popq %%rax");
+	--self->depth;
+	
+	if (is_float) {
+		ins(self, "movq %%rax, %%xmm0");
+		ins(self, "movq %%rcx, %%xmm1");
+		
+		switch (bin->op) {
+		case BIN_OP_ADD:
+		case BIN_OP_SUB:
+		case BIN_OP_MUL:
+		case BIN_OP_DIV:
+			ins(self, "%s %%xmm1, %%xmm0", FLOAT_ARITH[bin->op]);
+			ins(self, "movq %%xmm0, %%rax");
+			return;
+			
+		/* unordered comparisons (NaN) set ZF, PF and CF */
+		case BIN_OP_EQ:
+			ins(self, "ucomisd %%xmm1, %%xmm0");
+			ins(self, "sete %%al");
+			ins(self, "setnp %%cl");
+			ins(self, "andb %%cl, %%al");
+			break;
+			
+		case BIN_OP_NEQ:
+			ins(self, "ucomisd %%xmm1, %%xmm0");
+			ins(self, "setne %%al");
+			ins(self, "setp %%cl");
+			ins(self, "orb %%cl, %%al");
+			break;
+			
+		case BIN_OP_LT:
+		case BIN_OP_LEQ:
+			ins(self, "ucomisd %%xmm0, %%xmm1");
+			ins(self, "%s %%al", bin->op == BIN_OP_LT ? "seta" : "setae");
+			break;
+			
+		case BIN_OP_GT:
+		case BIN_OP_GEQ:
+			ins(self, "ucomisd %%xmm1, %%xmm0");
+			ins(self, "%s %%al", bin->op == BIN_OP_GT ? "seta" : "setae");
+			break;
+			
+		default:
+			assert(0);
+			break;
+		}
+		
+		ins(self, "movzbl %%al, %%eax");
+		return;
+	}
+	
+	if (bin->op <= BIN_OP_DIV) {
+		ins(self, "%s", INT_ARITH[bin->op]);
+	} else {
+		ins(self, "cmpl %%ecx, %%eax");
+		ins(self, "%s %%al", INT_SETCC[bin->op]);
+		ins(self, "movzbl %%al, %%eax");
+	}
+}
+
+/**
+ * @internal
+ * @brief Übersetzt einen Ausdruck, dessen Wert anschließend in `rax` liegt.
+ */
+static void genExpr(AsmGen *self, const Expr *expr) {
+	switch (expr->tag) {
+	case EXPR_ASSIGN:
+		genStore(self, expr->assign.lhs.res, expr->assign.rhs);
+		break;
+		
+	case EXPR_BIN_OP:
+		genBinOp(self, &expr->bin_op);
+		break;
+		
+	case EXPR_UNARY_MINUS:
+		genExpr(self, expr->unary_minus);
+		
+		if (expr->data_type == TYPE_FLOAT) {
+			ins(self, "btcq $63, %%rax");
+		} else {
+			ins(self, "negl %%eax");
+		}
+		break;
+		
+	case EXPR_CALL:
+		genCall(self, &expr->call);
+		break;
+		
+	case EXPR_LITERAL:
+		switch (expr->literal.tag) {
+		case LITERAL_INT:
+			ins(self, "movl $%d, %%eax", expr->literal.iVal);
+			break;
+			
+		case LITERAL_BOOL:
+			ins(self, "movl $%d, %%eax", expr->literal.bVal != 0);
+			break;
+			
+		case LITERAL_FLOAT: {
+			uint64_t bits;
+			memcpy(&bits, &expr->literal.fVal, sizeof(bits));
+			ins(self, "movabsq $0x%llx, %%rax", (unsigned long long) bits);
+			break;
+		}
+		
+		case LITERAL_STRING:
+			vecPush(self->strings) = expr->literal.sVal;
+			ins(self, "leaq .Lstr%u(%%rip), %%rax", vecLen(self->strings) - 1);
+			break;
+		}
+		break;
+		
+	case EXPR_VAR:
+		genVar(self, expr->var.res, 0);
+		break;
+		
+	case EXPR_INVALID:
+		assert(0);
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine Bedingung und einen Sprung nach \p label, der bei
+ * \p jump (`jz` oder `jnz`) ausgeführt wird.
+ */
+static void genBranch(AsmGen *self, const Expr *cond, const char *jump, unsigned int label) {
+	genExpr(self, cond);
+	ins(self, "testl %%eax, %%eax");
+	ins(self, "%s .L%u", jump, label);
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine Anweisung.
+ *
+ * Schleifen werden wie im Bytecode mit der Bedingung am Ende übersetzt.
+ */
+static void genStmt(AsmGen *self, const Stmt *stmt) {
+	unsigned int end, loop;
+	
+	switch (stmt->tag) {
+	case STMT_EMPTY:
+		break;
+		
+	case STMT_IF:
+		end = newLabel(self);
+		genBranch(self, &stmt->if_stmt.cond, "jz", end);
+		genStmt(self, stmt->if_stmt.if_true);
+		
+		if (stmt->if_stmt.if_false->tag != STMT_EMPTY) {
+			unsigned int skip = newLabel(self);
+			ins(self, "jmp .L%u", skip);
+			placeLabel(self, end);
+			genStmt(self, stmt->if_stmt.if_false);
+			end = skip;
+		}
+		
+		placeLabel(self, end);
+		break;
+		
+	case STMT_FOR: {
+		const ForStmt *for_stmt = &stmt->for_stmt;
+		
+		if (for_stmt->init.tag == FOR_INIT_VAR_DEF) {
+			if (for_stmt->init.var_def.init.tag != EXPR_INVALID) {
+				genStore(self, for_stmt->init.var_def.res_ident.res, &for_stmt->init.var_def.init);
+			}
+		} else {
+			genStore(self, for_stmt->init.assign.lhs.res, for_stmt->init.assign.rhs);
+		}
+		
+		end = newLabel(self);
+		loop = newLabel(self);
+		ins(self, "jmp .L%u", end);
+		placeLabel(self, loop);
+		genStmt(self, for_stmt->body);
+		genStore(self, for_stmt->update.lhs.res, for_stmt->update.rhs);
+		placeLabel(self, end);
+		genBranch(self, &for_stmt->cond, "jnz", loop);
+		break;
+	}
+	
+	case STMT_WHILE:
+		end = newLabel(self);
+		loop = newLabel(self);
+		ins(self, "jmp .L%u", end);
+		placeLabel(self, loop);
+		genStmt(self, stmt->while_stmt.body);
+		placeLabel(self, end);
+		genBranch(self, &stmt->while_stmt.cond, "jnz", loop);
+		break;
+		
+	case STMT_DO_WHILE:
+		loop = newLabel(self);
+		placeLabel(self, loop);
+		genStmt(self, stmt->do_while_stmt.body);
+		genBranch(self, &stmt->do_while_stmt.cond, "jnz", loop);
+		break;
+		
+	case STMT_RETURN:
+		if (stmt->return_stmt.tag != EXPR_INVALID) {
+			genExpr(self, &stmt->return_stmt);
+			genConvert(self, stmt->return_stmt.data_type, self->ret_type);
+		}
+		
+		ins(self, "jmp .L%u", self->epilogue);
+		break;
+		
+	case STMT_PRINT:
+		vecForEach(const Expr *expr, stmt->print_stmt.expressions) {
+			genExpr(self, expr);
+			ins(self, expr->data_type == TYPE_FLOAT ? "movq %%rax, %%xmm0" : "movq %%rax, %%rdi");
+			genAlignedCall(self, PRINT_FUNCS[expr->data_type]);
+		}
+		
+		genAlignedCall(self, "rt_newline");
+		break;
+		
+	case STMT_VAR_DEF:
+		if (stmt->var_def.init.tag != EXPR_INVALID) {
+			genStore(self, stmt->var_def.res_ident.res, &stmt->var_def.init);
+		}
+		break;
+		
+	case STMT_ASSIGN:
+		genStore(self, stmt->assign.lhs.res, stmt->assign.rhs);
+		break;
+		
+	case STMT_CALL:
+		genCall(self, &stmt->call);
+		break;
+		
+	case STMT_BLOCK:
+		vecForEach(const Stmt *inner, stmt->block.statements) {
+			genStmt(self, inner);
+		}
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Übersetzt die Funktion \p id.
+ *
+ * Der Prolog legt den Frame an und kopiert die Parameter in ihre Slots. Fehlt
+ * die `return`-Anweisung, ist der Rückgabewert `0`.
+ */
+static void genFunc(AsmGen *self, DefId id) {
+	const DefInfo *def = &self->defs[id.index];
+	const FuncInfo *info = &def->func;
+	const FuncDef *func = &self->ast->items[info->item_id.index].func_def;
+	unsigned int frame = (8*vecLen(info->local_vars) + 15) & ~15u;
+	Pass *pass = malloc((info->param_count + 1)*sizeof(Pass));
+	unsigned int ints = 0, floats = 0, stack = 0;
+	
+	if (pass == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	self->ret_type = info->return_type;
+	self->epilogue = newLabel(self);
+	self->depth = 0;
+	
+	fprintf(self->out, "\n\t.text\n\t.type f_%s, @function\nf_%s:\n", internName(def->ident), internName(def->ident));
+	ins(self, "pushq %%rbp");
+	ins(self, "movq %%rsp, %%rbp");
+	if (frame > 0) { ins(self, "subq $%u, %%rsp", frame); }
+	
+	classifyParams(self, info, pass);
+	
+	for (unsigned int i = 0; i < info->param_count; ++i) {
+		unsigned int slot = 8*(self->defs[info->local_vars[i].index].var.offset + 1);
+		
+		if (pass[i] == PASS_INT) {
+			ins(self, "movq %%%s, -%u(%%rbp)", INT_REGS[ints++], slot);
+		} else if (pass[i] == PASS_FLOAT) {
+			ins(self, "movq %%xmm%u, -%u(%%rbp)", floats++, slot);
+		} else {
+			ins(self, "movq %u(%%rbp), %%rax", 16 + 8*stack++);
+			ins(self, "movq %%rax, -%u(%%rbp)", slot);
+		}
+	}
+	
+	vecForEach(const Stmt *stmt, func->statements) {
+		genStmt(self, stmt);
+	}
+	
+	ins(self, "xorl %%eax, %%eax");
+	placeLabel(self, self->epilogue);
+	
+	if (info->return_type == TYPE_FLOAT) {
+		ins(self, "movq %%rax, %%xmm0");
+	}
+	
+	ins(self, "leave");
+	ins(self, "ret");
+	assert(self->depth == 0);
+	free(pass);
+}
+
+/**
+ * @internal
+ * @brief Gibt ein Zeichenkettenliteral für `.string` aus.
+ */
+static void writeString(FILE *out, const char *str) {
+	fputc('"', out);
+	
+	for (const unsigned char *c = (const unsigned char*) str; *c != 0; ++c) {
+		if (*c == '"' || *c == '\\') {
+			fprintf(out, "\\%c", *c);
+		} else if (*c < 0x20 || *c >= 0x7F) {
+			fprintf(out, "\\%03o", *c);
+		} else {
+			fputc(*c, out);
+		}
+	}
+	
+	fputc('"', out);
+}
+
+/* *** implementation ******************************************************* */
+
+void asmgenProgram(const Program *ast, const SymDefTable *tab, FILE *out) {
+	AsmGen self = {
+		.ast = ast,
+		.defs = tab->definitions,
+		.out = out
+	};
+	
+	fputs("/* generated by minako --emit-asm */\n", out);
+	
+	/* global variables */
+	fputs("\t.data\n\t.align 8\n", out);
+	vecForEach(const Item *item, ast->items) {
+		if (item->tag == ITEM_GLOBAL_VAR) {
+			fprintf(out, "g_%s:\t.quad 0\n", internName(self.defs[item->var_def.res_ident.res.index].ident));
+		}
+	}
+	
+	for (unsigned int i = 0; i < vecLen(self.defs); ++i) {
+		if (self.defs[i].tag == SYM_DEF_FUNC) {
+			genFunc(&self, (DefId) { i });
+		}
+	}
+	
+	/* initialize the global variables in the order of their declaration */
+	fputs("\n\t.text\n\t.globl main\n\t.type main, @function\nmain:\n", out);
+	ins(&self, "pushq %%rbp");
+	ins(&self, "movq %%rsp, %%rbp");
+	self.depth = 0;
+	
+	vecForEach(const Item *item, ast->items) {
+		if (item->tag == ITEM_GLOBAL_VAR && item->var_def.init.tag != EXPR_INVALID) {
+			genStore(&self, item->var_def.res_ident.res, &item->var_def.init);
+		}
+	}
+	
+	ins(&self, "call f_%s", internName(self.defs[tab->main_func.index].ident));
+	ins(&self, "xorl %%eax, %%eax");
+	ins(&self, "leave");
+	ins(&self, "ret");
+	
+	/* string literals */
+	if (!vecIsEmpty(self.strings)) {
+		fputs("\n\t.section .rodata\n", out);
+	}
+	
+	for (unsigned int i = 0; i < vecLen(self.strings); ++i) {
+		fprintf(out, ".Lstr%u:\t.string ", i);
+		writeString(out, self.strings[i]);
+		fputc('\n', out);
+	}
+	
+	fputs(RUNTIME, out);
+	vecRelease(self.strings);
+}
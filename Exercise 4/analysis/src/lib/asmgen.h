@@ -0,0 +1,49 @@
+/***************************************************************************//**
+ * @file asmgen.h
+ * @brief Übersetzung von C1-Programmen in x86-64-Assembler (GNU as).
+ *
+ * # Überblick
+ *
+ * Der Übersetzer erzeugt aus einem analysierten Programm Assembler in
+ * AT&T-Syntax, der mit `as` assembliert und mit `ld` gegen die C-Bibliothek
+ * gebunden werden kann. Die Codeerzeugung folgt denselben Schablonen wie der
+ * JIT (siehe `jit.h`): Das Ergebnis jedes Ausdrucks liegt in `rax`, linke
+ * Operanden werden auf dem Maschinenstack gesichert.
+ *
+ * - Funktionen folgen der System V ABI: Die ersten sechs `int`- bzw.
+ *   `bool`-Parameter werden in `rdi`, `rsi`, `rdx`, `rcx`, `r8` und `r9`, die
+ *   ersten acht `float`-Parameter in `xmm0` bis `xmm7` und alle weiteren auf
+ *   dem Stack übergeben.
+ * - Der Stack-Frame einer Funktion enthält `FuncInfo.local_vars` Slots zu je
+ *   8 Byte unterhalb von `rbp`; die ersten `FuncInfo.param_count` davon
+ *   nehmen die Parameter auf.
+ * - Globale Variablen liegen in `.data`, Zeichenkettenliterale in `.rodata`.
+ * - Die `print`-Anweisung ruft eine kleine Laufzeitbibliothek (`rt_...`) am
+ *   Ende der Ausgabe auf, die mit `printf` die Ausgaberegeln der Sprache
+ *   umsetzt.
+ *
+ * Das Symbol `main` initialisiert die globalen Variablen und ruft danach die
+ * Funktion `main()` des C1-Programms auf.
+ ******************************************************************************/
+
+#ifndef ASMGEN_H_INCLUDED
+#define ASMGEN_H_INCLUDED
+
+/* *** Includes ************************************************************* */
+
+#include <stdio.h>
+#include "ast.h"
+#include "symtab.h"
+
+/* *** Öffentliche Schnittstelle ******************************************** */
+
+/**
+ * @brief Übersetzt ein semantisch analysiertes Programm in Assembler.
+ *
+ * @param ast Die Wurzel des abstrakten Syntaxbaumes.
+ * @param tab Die Definitionstabelle des Programms.
+ * @param out Der Ausgabestrom für den erzeugten Assembler.
+ */
+extern void asmgenProgram(const Program *ast, const SymDefTable *tab, FILE *out);
+
+#endif
@@ -65,11 +65,11 @@
 } while (0)
 
 /**
- * Makro zur Ausgabe von Strukturfeldern mit Zeigertyp.
+ * Makro zur Ausgabe von Strukturfeldern mit Bezeichnertyp.
  */
-#define STR_FIELD(NAME) do { \
-	fprintf(out, "%s\n%*s." #NAME " = \"%s\"", sep, indent*4, "", self->NAME); \
-	sep = ",";                                                                 \
+#define IDENT_FIELD(NAME) do {                                                             \
+	fprintf(out, "%s\n%*s." #NAME " = \"%s\"", sep, indent*4, "", internName(self->NAME)); \
+	sep = ",";                                                                             \
 } while (0)
 
 /**
@@ -162,7 +162,7 @@ Item astItemFromFuncDef(FuncDef func_def) {
 	};
 }
 
-FuncDef astFuncDefNew(DataType return_type, char *ident, FuncParam *params, Stmt *statements) {
+FuncDef astFuncDefNew(DataType return_type, Ident ident, FuncParam *params, Stmt *statements) {
 	if (params == NULL) { vecInit(params); }
 	if (statements == NULL) { vecInit(statements); }
 	
@@ -174,7 +174,7 @@ FuncDef astFuncDefNew(DataType return_type, char *ident, FuncParam *params, Stmt
 	};
 }
 
-FuncCall astFuncCallNew(char *ident, Expr *args) {
+FuncCall astFuncCallNew(Ident ident, Expr *args) {
 	if (args == NULL) { vecInit(args); }
 	
 	return (FuncCall) {
@@ -183,7 +183,7 @@ FuncCall astFuncCallNew(char *ident, Expr *args) {
 	};
 }
 
-FuncParam astFuncParamNew(DataType data_type, char *ident) {
+FuncParam astFuncParamNew(DataType data_type, Ident ident) {
 	return (FuncParam) {
 		.data_type = data_type,
 		.ident = ident
@@ -204,7 +204,7 @@ Expr astExprFromFuncCall(FuncCall func_call) {
 	};
 }
 
-Expr astExprFromIdent(char *ident) {
+Expr astExprFromIdent(Ident ident) {
 	return (Expr) {
 		.tag = EXPR_VAR,
 		.var = { .ident = ident, .res = INVALID_DEF_ID }
@@ -257,14 +257,14 @@ Literal astLiteralFromBool(int value) {
 	};
 }
 
-Literal astLiteralFromString(char *string) {
+Literal astLiteralFromString(const char *string) {
 	return (Literal) {
 		.tag = LITERAL_STRING,
 		.sVal = string
 	};
 }
 
-Assign astAssignNew(char *lhs, Expr rhs) {
+Assign astAssignNew(Ident lhs, Expr rhs) {
 	return (Assign) {
 		.lhs = { .ident = lhs, .res = INVALID_DEF_ID },
 		.rhs = BOX(rhs)
@@ -391,7 +391,7 @@ PrintStmt astPrintStmtNew(Expr *expressions) {
 	};
 }
 
-VarDef astVarDefNew(DataType data_type, char *ident, Expr *init) {
+VarDef astVarDefNew(DataType data_type, Ident ident, Expr *init) {
 	return (VarDef) {
 		.data_type = data_type,
 		.res_ident = { .ident = ident, .res = INVALID_DEF_ID },
@@ -442,7 +442,6 @@ void astFuncDefRelease(FuncDef *self) {
 	
 	vecRelease(self->params);
 	vecRelease(self->statements);
-	free(self->ident);
 }
 
 void astFuncCallRelease(FuncCall *self) {
@@ -451,11 +450,10 @@ void astFuncCallRelease(FuncCall *self) {
 	}
 	
 	vecRelease(self->args);
-	free(self->res_ident.ident);
 }
 
 void astFuncParamRelease(FuncParam *self) {
-	free(self->ident);
+	/* the name belongs to the interner */
 }
 
 void astExprRelease(Expr *self) {
@@ -485,19 +483,15 @@ void astExprRelease(Expr *self) {
 		break;
 		
 	case EXPR_VAR:
-		free(self->var.ident);
 		break;
 	}
 }
 
 void astLiteralRelease(Literal *self) {
-	if (self->tag == LITERAL_STRING) {
-		free(self->sVal);
-	}
+	/* string literals belong to the interner */
 }
 
 void astAssignRelease(Assign *self) {
-	free(self->lhs.ident);
 	astExprRelease(self->rhs);
 	free(self->rhs);
 }
@@ -591,7 +585,6 @@ void astPrintStmtRelease(PrintStmt *self) {
 }
 
 void astVarDefRelease(VarDef *self) {
-	free(self->res_ident.ident);
 	astExprRelease(&self->init);
 }
 
@@ -628,7 +621,7 @@ void astItemPrint(const Item *self, int indent, FILE *out) {
 void astFuncDefPrint(const FuncDef *self, int indent, FILE *out) {
 	STRUCT(FuncDef, {
 		FIELD(return_type, astDataTypePrint(&self->return_type, indent, out));
-		STR_FIELD(ident);
+		IDENT_FIELD(ident);
 		VEC_FIELD(params, astFuncParamPrint(&self->params[i], indent, out));
 		VEC_FIELD(statements, astStmtPrint(&self->statements[i], indent, out));
 	});
@@ -637,7 +630,7 @@ void astFuncDefPrint(const FuncDef *self, int indent, FILE *out) {
 void astFuncParamPrint(const FuncParam *self, int indent, FILE *out) {
 	STRUCT(FuncParam, {
 		FIELD(data_type, astDataTypePrint(&self->data_type, indent, out));
-		STR_FIELD(ident);
+		IDENT_FIELD(ident);
 	});
 }
 
@@ -855,7 +848,7 @@ void astDataTypePrint(const DataType *self, int indent, FILE *out) {
 
 void astResIdentPrint(const ResIdent *self, int indent, FILE *out) {
 	STRUCT(ResIdent, {
-		STR_FIELD(ident);
+		IDENT_FIELD(ident);
 		
 		/* ignore the `res`-field to allow diffs with the non-semantically
 		 * checked syntax tree even after semantic analysis  */
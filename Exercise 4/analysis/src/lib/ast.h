@@ -70,6 +70,7 @@
 /* *** Includes ************************************************************* */
 
 #include <stdio.h>
+#include "intern.h"
 
 /* *** Strukturen *********************************************************** */
 
@@ -134,7 +135,7 @@ typedef struct {
  */
 typedef struct ResIdent {
 	/** Der Name, der aufgelöst werden soll. */
-	char *ident;
+	Ident ident;
 	
 	/**
 	 * Die Definition, auf die dieser Bezeichner verweist.
@@ -158,7 +159,7 @@ typedef struct Literal {
 		int iVal;
 		double fVal;
 		int bVal;
-		char *sVal;
+		const char *sVal;
 	};
 } Literal;
 
@@ -387,14 +388,28 @@ typedef struct Stmt {
 /** Ein Funktionsparameter mit einem Typ und einem (nicht auflösbaren) Namen. */
 typedef struct FuncParam {
 	DataType data_type;
-	char *ident;
+	Ident ident;
 } FuncParam;
 
+/**
+ * Die von der Datenflussanalyse (`flowAnalyze()`) bewiesenen Eigenschaften
+ * eines Funktionskörpers.
+ *
+ * `returns` ist `1`, falls jeder Pfad mit `return` endet oder die Funktion
+ * den Rückgabetyp `void` hat, `assigned`, falls jede lokale Variable auf
+ * jedem Pfad vor dem Lesen zugewiesen wird. Vor der Analyse sind beide `0`.
+ */
+typedef struct FlowFacts {
+	unsigned char returns;
+	unsigned char assigned;
+} FlowFacts;
+
 /**
  * Eine Funktionsdefinition.
  *
- * Beinhaltet den Rückgabetyp, einen (nicht auflösbaren) Namen, Parameter und
- * den Funktionskörper als eine Liste von Anweisungen.
+ * Beinhaltet den Rückgabetyp, einen (nicht auflösbaren) Namen, Parameter,
+ * den Funktionskörper als eine Liste von Anweisungen und die Ergebnisse der
+ * Datenflussanalyse.
  *
  * # Beispiel
  *
@@ -404,9 +419,10 @@ typedef struct FuncParam {
  */
 typedef struct FuncDef {
 	DataType return_type;
-	char *ident;
+	Ident ident;
 	FuncParam *params;
 	Stmt *statements;
+	FlowFacts flow;
 } FuncDef;
 
 /**
@@ -466,7 +482,7 @@ extern Item astItemFromFuncDef(FuncDef func_def);
  * @param statements  Vektor von Anweisungen im Funktionskörper
  * @return Ein neues `FuncDef`-Objekt.
  */
-extern FuncDef astFuncDefNew(DataType return_type, char *ident, FuncParam *params, Stmt *statements);
+extern FuncDef astFuncDefNew(DataType return_type, Ident ident, FuncParam *params, Stmt *statements);
 
 /**
  * Erstellt einen neuen Funktionsaufruf.
@@ -475,7 +491,7 @@ extern FuncDef astFuncDefNew(DataType return_type, char *ident, FuncParam *param
  * @param args  Vektor der Argumente des Funktionsaufrufs
  * @return Ein neues `FuncCall`-Objekt.
  */
-extern FuncCall astFuncCallNew(char *ident, Expr *args);
+extern FuncCall astFuncCallNew(Ident ident, Expr *args);
 
 /**
  * Erstellt einen neuen Funktionsparameter.
@@ -484,7 +500,7 @@ extern FuncCall astFuncCallNew(char *ident, Expr *args);
  * @param ident     Name des Parameters
  * @return Ein neues `FuncParam`-Objekt.
  */
-extern FuncParam astFuncParamNew(DataType data_type, char *ident);
+extern FuncParam astFuncParamNew(DataType data_type, Ident ident);
 
 /**
  * Erstellt einen Ausdruck aus einer Zuweisung.
@@ -499,7 +515,7 @@ extern Expr astExprFromFuncCall(FuncCall func_call);
 /**
  * Erstellt einen Ausdruck aus einem Bezeichner.
  */
-extern Expr astExprFromIdent(char *ident);
+extern Expr astExprFromIdent(Ident ident);
 
 /**
  * Erstellt einen Ausdruck aus einem Literal.
@@ -537,9 +553,9 @@ extern Literal astLiteralFromFloat(double value);
 extern Literal astLiteralFromBool(int value);
 
 /**
- * Erstellt ein Literal aus einer Zeichenkette.
+ * Erstellt ein Literal aus einer internalisierten Zeichenkette.
  */
-extern Literal astLiteralFromString(char *value);
+extern Literal astLiteralFromString(const char *value);
 
 /**
  * Erstellt eine neue Zuweisung.
@@ -548,7 +564,7 @@ extern Literal astLiteralFromString(char *value);
  * @param rhs Ausdruck, der zugewiesen wird
  * @return Ein neues `Assign`-Objekt.
  */
-extern Assign astAssignNew(char *lhs, Expr rhs);
+extern Assign astAssignNew(Ident lhs, Expr rhs);
 
 /**
  * Erstellt eine neue (leere) Anweisung.
@@ -661,7 +677,7 @@ extern PrintStmt astPrintStmtNew(Expr *expressions);
  * @param init      Initialisierungsausdruck der Variablen
  * @return Ein neues `VarDef`-Objekt.
  */
-extern VarDef astVarDefNew(DataType data_type, char *ident, Expr *init);
+extern VarDef astVarDefNew(DataType data_type, Ident ident, Expr *init);
 
 /**
  * Erstellt einen neuen Block von Anweisungen.
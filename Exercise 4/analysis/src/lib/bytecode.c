@@ -0,0 +1,726 @@
+/***************************************************************************//**
+ * @file bytecode.c
+ * @brief Übersetzung analysierter C1-Programme in Bytecode.
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <assert.h>
+#include "bytecode.h"
+#include "vec.h"
+
+/* *** internal structures ************************************************** */
+
+/**
+ * @internal
+ * @brief Zustand des Übersetzers.
+ */
+typedef struct {
+	Bytecode bc;            /**<@brief Der erzeugte Bytecode. */
+	const Program *ast;     /**<@brief Der übersetzte Syntaxbaum. */
+	const DefInfo *defs;    /**<@brief Die Definitionstabelle. */
+	DataType ret_type;      /**<@brief Rückgabetyp der aktuellen Funktion. */
+	int depth;              /**<@brief Aktuelle Tiefe des Operandenstacks. */
+	int max_depth;          /**<@brief Maximale Tiefe des Operandenstacks. */
+	int fuse;               /**<@brief Gibt an, ob Superinstruktionen erzeugt werden. */
+} Compiler;
+
+/* *** internal constants *************************************************** */
+
+/**
+ * @internal
+ * @brief Veränderung der Stacktiefe durch die einzelnen Opcodes.
+ *
+ * Die Wirkung von `OP_CALL` hängt von der gerufenen Funktion ab und wird
+ * gesondert berechnet. Für `OP_OR` und `OP_AND` ist die Wirkung des
+ * durchfallenden Pfades angegeben.
+ */
+static const signed char STACK_EFFECT[OP_COUNT] = {
+	[OP_POP]          = -1,
+	[OP_DUP]          =  1,
+	[OP_PUSH]         =  1,
+	[OP_CONST]        =  1,
+	[OP_LOAD_LOCAL]   =  1,
+	[OP_STORE_LOCAL]  = -1,
+	[OP_LOAD_GLOBAL]  =  1,
+	[OP_STORE_GLOBAL] = -1,
+	[OP_ADD_I]        = -1,
+	[OP_SUB_I]        = -1,
+	[OP_MUL_I]        = -1,
+	[OP_DIV_I]        = -1,
+	[OP_ADD_F]        = -1,
+	[OP_SUB_F]        = -1,
+	[OP_MUL_F]        = -1,
+	[OP_DIV_F]        = -1,
+	[OP_EQ_I]         = -1,
+	[OP_NEQ_I]        = -1,
+	[OP_LT_I]         = -1,
+	[OP_GT_I]         = -1,
+	[OP_LEQ_I]        = -1,
+	[OP_GEQ_I]        = -1,
+	[OP_EQ_F]         = -1,
+	[OP_NEQ_F]        = -1,
+	[OP_LT_F]         = -1,
+	[OP_GT_F]         = -1,
+	[OP_LEQ_F]        = -1,
+	[OP_GEQ_F]        = -1,
+	[OP_JUMP_FALSE]   = -1,
+	[OP_JUMP_TRUE]    = -1,
+	[OP_OR]           = -1,
+	[OP_AND]          = -1,
+	[OP_RET_VAL]      = -1,
+	[OP_PRINT_B]      = -1,
+	[OP_PRINT_I]      = -1,
+	[OP_PRINT_F]      = -1,
+	[OP_PRINT_S]      = -1,
+	[OP_LOAD_ADD_LK]  =  1,
+	[OP_LOAD_CALL]    =  1,
+};
+
+/** @internal @brief Opcodes binärer Operationen auf `int` und `bool`. */
+static const Opcode INT_OPS[] = {
+	[BIN_OP_ADD] = OP_ADD_I,
+	[BIN_OP_SUB] = OP_SUB_I,
+	[BIN_OP_MUL] = OP_MUL_I,
+	[BIN_OP_DIV] = OP_DIV_I,
+	[BIN_OP_EQ]  = OP_EQ_I,
+	[BIN_OP_NEQ] = OP_NEQ_I,
+	[BIN_OP_LT]  = OP_LT_I,
+	[BIN_OP_GT]  = OP_GT_I,
+	[BIN_OP_LEQ] = OP_LEQ_I,
+	[BIN_OP_GEQ] = OP_GEQ_I,
+};
+
+/** @internal @brief Opcodes binärer Operationen auf `float`. */
+static const Opcode FLOAT_OPS[] = {
+	[BIN_OP_ADD] = OP_ADD_F,
+	[BIN_OP_SUB] = OP_SUB_F,
+	[BIN_OP_MUL] = OP_MUL_F,
+	[BIN_OP_DIV] = OP_DIV_F,
+	[BIN_OP_EQ]  = OP_EQ_F,
+	[BIN_OP_NEQ] = OP_NEQ_F,
+	[BIN_OP_LT]  = OP_LT_F,
+	[BIN_OP_GT]  = OP_GT_F,
+	[BIN_OP_LEQ] = OP_LEQ_F,
+	[BIN_OP_GEQ] = OP_GEQ_F,
+};
+
+/**
+ * @internal
+ * @brief Superinstruktionen für den Vergleich einer lokalen Ganzzahl mit
+ * einem Literal; `OP_HALT` für alle übrigen Operationen.
+ */
+static const Opcode CMP_JUMP_OPS[] = {
+	[BIN_OP_EQ]  = OP_JEQ_LK,
+	[BIN_OP_NEQ] = OP_JNEQ_LK,
+	[BIN_OP_LT]  = OP_JLT_LK,
+	[BIN_OP_GT]  = OP_JGT_LK,
+	[BIN_OP_LEQ] = OP_JLEQ_LK,
+	[BIN_OP_GEQ] = OP_JGEQ_LK,
+};
+
+/** @internal @brief Verneinung der Vergleichsoperationen. */
+static const BinOp NEGATED[] = {
+	[BIN_OP_EQ]  = BIN_OP_NEQ,
+	[BIN_OP_NEQ] = BIN_OP_EQ,
+	[BIN_OP_LT]  = BIN_OP_GEQ,
+	[BIN_OP_GT]  = BIN_OP_LEQ,
+	[BIN_OP_LEQ] = BIN_OP_GT,
+	[BIN_OP_GEQ] = BIN_OP_LT,
+};
+
+/** @internal @brief Vergleichsoperationen mit vertauschten Operanden. */
+static const BinOp MIRRORED[] = {
+	[BIN_OP_EQ]  = BIN_OP_EQ,
+	[BIN_OP_NEQ] = BIN_OP_NEQ,
+	[BIN_OP_LT]  = BIN_OP_GT,
+	[BIN_OP_GT]  = BIN_OP_LT,
+	[BIN_OP_LEQ] = BIN_OP_GEQ,
+	[BIN_OP_GEQ] = BIN_OP_LEQ,
+};
+
+/** @internal @brief Opcodes der `print`-Anweisung je Datentyp. */
+static const Opcode PRINT_OPS[] = {
+	[TYPE_BOOL]   = OP_PRINT_B,
+	[TYPE_INT]    = OP_PRINT_I,
+	[TYPE_FLOAT]  = OP_PRINT_F,
+	[TYPE_STRING] = OP_PRINT_S,
+};
+
+/* *** public constants ***************************************************** */
+
+const char *OPCODE_NAMES[OP_COUNT] = {
+	[OP_HALT]         = "HALT",
+	[OP_POP]          = "POP",
+	[OP_DUP]          = "DUP",
+	[OP_PUSH]         = "PUSH",
+	[OP_CONST]        = "CONST",
+	[OP_LOAD_LOCAL]   = "LOAD_LOCAL",
+	[OP_STORE_LOCAL]  = "STORE_LOCAL",
+	[OP_LOAD_GLOBAL]  = "LOAD_GLOBAL",
+	[OP_STORE_GLOBAL] = "STORE_GLOBAL",
+	[OP_I2F]          = "I2F",
+	[OP_NEG_I]        = "NEG_I",
+	[OP_NEG_F]        = "NEG_F",
+	[OP_ADD_I]        = "ADD_I",
+	[OP_SUB_I]        = "SUB_I",
+	[OP_MUL_I]        = "MUL_I",
+	[OP_DIV_I]        = "DIV_I",
+	[OP_ADD_F]        = "ADD_F",
+	[OP_SUB_F]        = "SUB_F",
+	[OP_MUL_F]        = "MUL_F",
+	[OP_DIV_F]        = "DIV_F",
+	[OP_EQ_I]         = "EQ_I",
+	[OP_NEQ_I]        = "NEQ_I",
+	[OP_LT_I]         = "LT_I",
+	[OP_GT_I]         = "GT_I",
+	[OP_LEQ_I]        = "LEQ_I",
+	[OP_GEQ_I]        = "GEQ_I",
+	[OP_EQ_F]         = "EQ_F",
+	[OP_NEQ_F]        = "NEQ_F",
+	[OP_LT_F]         = "LT_F",
+	[OP_GT_F]         = "GT_F",
+	[OP_LEQ_F]        = "LEQ_F",
+	[OP_GEQ_F]        = "GEQ_F",
+	[OP_JUMP]         = "JUMP",
+	[OP_JUMP_FALSE]   = "JUMP_FALSE",
+	[OP_JUMP_TRUE]    = "JUMP_TRUE",
+	[OP_OR]           = "OR",
+	[OP_AND]          = "AND",
+	[OP_CALL]         = "CALL",
+	[OP_RET]          = "RET",
+	[OP_RET_VAL]      = "RET_VAL",
+	[OP_PRINT_B]      = "PRINT_B",
+	[OP_PRINT_I]      = "PRINT_I",
+	[OP_PRINT_F]      = "PRINT_F",
+	[OP_PRINT_S]      = "PRINT_S",
+	[OP_PRINT_NL]     = "PRINT_NL",
+	[OP_JEQ_LK]       = "JEQ_LK",
+	[OP_JNEQ_LK]      = "JNEQ_LK",
+	[OP_JLT_LK]       = "JLT_LK",
+	[OP_JGT_LK]       = "JGT_LK",
+	[OP_JLEQ_LK]      = "JLEQ_LK",
+	[OP_JGEQ_LK]      = "JGEQ_LK",
+	[OP_ADD_LK]       = "ADD_LK",
+	[OP_LOAD_ADD_LK]  = "LOAD_ADD_LK",
+	[OP_LOAD_CALL]    = "LOAD_CALL",
+	[OP_EXT]          = "EXT",
+};
+
+/* *** internal helpers ***************************************************** */
+
+/* forward declarations */
+static void compileExpr(Compiler*, const Expr*);
+static void compileStmt(Compiler*, const Stmt*);
+
+/**
+ * @internal
+ * @brief Passt die verfolgte Stacktiefe an.
+ */
+static inline void adjustDepth(Compiler *self, int effect) {
+	self->depth += effect;
+	
+	if (self->depth > self->max_depth) {
+		self->max_depth = self->depth;
+	}
+}
+
+/**
+ * @internal
+ * @brief Hängt eine Instruktion an und gibt deren Index zurück.
+ */
+static unsigned int emit(Compiler *self, Opcode op, int arg) {
+	vecPush(self->bc.code) = (Instr) { op, arg };
+	adjustDepth(self, STACK_EFFECT[op]);
+	return vecLen(self->bc.code) - 1;
+}
+
+/**
+ * @internal
+ * @brief Gibt den Index der nächsten Instruktion zurück.
+ */
+static inline unsigned int here(const Compiler *self) {
+	return vecLen(self->bc.code);
+}
+
+/**
+ * @internal
+ * @brief Setzt das Sprungziel der Instruktion \p at auf die nächste
+ * Instruktion.
+ */
+static inline void patch(Compiler *self, unsigned int at) {
+	self->bc.code[at].arg = here(self);
+}
+
+/**
+ * @internal
+ * @brief Fügt eine Konstante hinzu und gibt deren Index zurück.
+ */
+static int addConst(Compiler *self, Value value) {
+	vecPush(self->bc.consts) = value;
+	return vecLen(self->bc.consts) - 1;
+}
+
+/**
+ * @internal
+ * @brief Gibt den Speicherplatz der Variablen \p id zurück, oder -1, falls
+ * diese keine lokale Variable vom Typ \p type ist.
+ */
+static int localSlot(const Compiler *self, DefId id, DataType type) {
+	const DefInfo *def = &self->defs[id.index];
+	
+	if (def->tag != SYM_DEF_LOCAL_VAR || def->var.data_type != type) {
+		return -1;
+	}
+	
+	return def->var.offset;
+}
+
+/**
+ * @internal
+ * @brief Gibt den Speicherplatz der lokalen Variablen vom Typ \p type zurück,
+ * die \p expr liest, oder -1, falls \p expr keine solche Variable ist.
+ */
+static inline int exprSlot(const Compiler *self, const Expr *expr, DataType type) {
+	return expr->tag == EXPR_VAR ? localSlot(self, expr->var.res, type) : -1;
+}
+
+/**
+ * @internal
+ * @brief Gibt zurück, ob \p expr ein Ganzzahlliteral ist.
+ */
+static inline int isIntLiteral(const Expr *expr) {
+	return expr->tag == EXPR_LITERAL && expr->literal.tag == LITERAL_INT;
+}
+
+/**
+ * @internal
+ * @brief Erzeugt eine implizite Typumwandlung von \p from nach \p to.
+ */
+static inline void emitConvert(Compiler *self, DataType from, DataType to) {
+	if (from == TYPE_INT && to == TYPE_FLOAT) {
+		emit(self, OP_I2F, 0);
+	}
+}
+
+/**
+ * @internal
+ * @brief Erzeugt einen Lese- oder Schreibzugriff auf eine Variable.
+ */
+static void emitVar(Compiler *self, DefId id, Opcode local, Opcode global) {
+	const DefInfo *def = &self->defs[id.index];
+	
+	assert(def->tag != SYM_DEF_FUNC);
+	emit(self, def->tag == SYM_DEF_LOCAL_VAR ? local : global, def->var.offset);
+}
+
+/**
+ * @internal
+ * @brief Erzeugt die Superinstruktion \p op für `i + k`, `k + i` oder `i - k`
+ * mit einer lokalen Ganzzahl `i` und einem Literal `k`.
+ *
+ * Ist \p slot nicht negativ, muss `i` diese Variable sein. Gibt zurück, ob
+ * die Operation erzeugt wurde.
+ */
+static int compileAddConst(Compiler *self, const BinOpExpr *bin, Opcode op, int slot) {
+	const Expr *var = bin->lhs, *lit = bin->rhs;
+	
+	if (!self->fuse || (bin->op != BIN_OP_ADD && bin->op != BIN_OP_SUB)) {
+		return 0;
+	}
+	
+	if (bin->op == BIN_OP_ADD && isIntLiteral(var)) {
+		var = bin->rhs;
+		lit = bin->lhs;
+	}
+	
+	int local = exprSlot(self, var, TYPE_INT);
+	
+	if (local < 0 || !isIntLiteral(lit) || (slot >= 0 && local != slot)) {
+		return 0;
+	}
+	
+	unsigned int k = (unsigned int) lit->literal.iVal;
+	
+	emit(self, op, local);
+	emit(self, OP_EXT, (int) (bin->op == BIN_OP_SUB ? 0u - k : k));
+	return 1;
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine Zuweisung.
+ *
+ * Ist \p keep gesetzt, verbleibt der zugewiesene Wert als Ergebnis des
+ * Ausdrucks auf dem Stack.
+ */
+static void compileAssign(Compiler *self, const Assign *assign, int keep) {
+	DataType type = self->defs[assign->lhs.res.index].var.data_type;
+	const Expr *rhs = assign->rhs;
+	int slot = localSlot(self, assign->lhs.res, TYPE_INT);
+	
+	/* i = i + k als Anweisung verändert die Variable direkt */
+	if (!keep && slot >= 0 && rhs->tag == EXPR_BIN_OP
+		&& compileAddConst(self, &rhs->bin_op, OP_ADD_LK, slot)) {
+		return;
+	}
+	
+	compileExpr(self, assign->rhs);
+	emitConvert(self, assign->rhs->data_type, type);
+	
+	if (keep) { emit(self, OP_DUP, 0); }
+	emitVar(self, assign->lhs.res, OP_STORE_LOCAL, OP_STORE_GLOBAL);
+}
+
+/**
+ * @internal
+ * @brief Übersetzt die Initialisierung einer Variablen.
+ */
+static void compileVarDef(Compiler *self, const VarDef *var_def) {
+	if (var_def->init.tag == EXPR_INVALID) { return; }
+	
+	compileExpr(self, &var_def->init);
+	emitConvert(self, var_def->init.data_type, var_def->data_type);
+	emitVar(self, var_def->res_ident.res, OP_STORE_LOCAL, OP_STORE_GLOBAL);
+}
+
+/**
+ * @internal
+ * @brief Übersetzt einen Funktionsaufruf.
+ *
+ * Nach dem Aufruf liegt genau dann ein Rückgabewert auf dem Stack, wenn die
+ * gerufene Funktion nicht `void` zurückgibt.
+ */
+static void compileCall(Compiler *self, const FuncCall *call) {
+	const FuncInfo *func = &self->defs[call->res_ident.res.index].func;
+	const FuncDef *def = &self->ast->items[func->item_id.index].func_def;
+	
+	unsigned int count = func->param_count;
+	int slot = -1;
+	
+	/* ein lokales letztes Argument ohne Umwandlung wird mit OP_LOAD_CALL geladen */
+	if (self->fuse && count > 0) {
+		slot = exprSlot(self, &call->args[count - 1], def->params[count - 1].data_type);
+		count -= slot >= 0;
+	}
+	
+	for (unsigned int i = 0; i < count; ++i) {
+		compileExpr(self, &call->args[i]);
+		emitConvert(self, call->args[i].data_type, def->params[i].data_type);
+	}
+	
+	if (slot >= 0) {
+		emit(self, OP_LOAD_CALL, slot);
+		emit(self, OP_EXT, func->item_id.index);
+	} else {
+		emit(self, OP_CALL, func->item_id.index);
+	}
+	
+	adjustDepth(self, (func->return_type != TYPE_VOID) - (int) func->param_count);
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine binäre Operation.
+ */
+static void compileBinOp(Compiler *self, const BinOpExpr *bin) {
+	unsigned int jump;
+	
+	switch (bin->op) {
+	case BIN_OP_LOG_OR:
+	case BIN_OP_LOG_AND:
+		compileExpr(self, bin->lhs);
+		jump = emit(self, bin->op == BIN_OP_LOG_OR ? OP_OR : OP_AND, 0);
+		compileExpr(self, bin->rhs);
+		patch(self, jump);
+		return;
+		
+	case BIN_OP_ADD:
+	case BIN_OP_SUB:
+		if (compileAddConst(self, bin, OP_LOAD_ADD_LK, -1)) { return; }
+		break;
+		
+	default:
+		break;
+	}
+	
+	if (bin->lhs->data_type == TYPE_FLOAT || bin->rhs->data_type == TYPE_FLOAT) {
+		compileExpr(self, bin->lhs);
+		emitConvert(self, bin->lhs->data_type, TYPE_FLOAT);
+		compileExpr(self, bin->rhs);
+		emitConvert(self, bin->rhs->data_type, TYPE_FLOAT);
+		emit(self, FLOAT_OPS[bin->op], 0);
+	} else {
+		compileExpr(self, bin->lhs);
+		compileExpr(self, bin->rhs);
+		emit(self, INT_OPS[bin->op], 0);
+	}
+}
+
+/**
+ * @internal
+ * @brief Übersetzt einen Ausdruck, dessen Wert anschließend auf dem Stack
+ * liegt.
+ */
+static void compileExpr(Compiler *self, const Expr *expr) {
+	switch (expr->tag) {
+	case EXPR_ASSIGN:
+		compileAssign(self, &expr->assign, 1);
+		break;
+		
+	case EXPR_BIN_OP:
+		compileBinOp(self, &expr->bin_op);
+		break;
+		
+	case EXPR_UNARY_MINUS:
+		compileExpr(self, expr->unary_minus);
+		emit(self, expr->data_type == TYPE_FLOAT ? OP_NEG_F : OP_NEG_I, 0);
+		break;
+		
+	case EXPR_CALL:
+		compileCall(self, &expr->call);
+		break;
+		
+	case EXPR_LITERAL:
+		switch (expr->literal.tag) {
+		case LITERAL_INT:
+			emit(self, OP_PUSH, expr->literal.iVal);
+			break;
+			
+		case LITERAL_BOOL:
+			emit(self, OP_PUSH, expr->literal.bVal != 0);
+			break;
+			
+		case LITERAL_FLOAT:
+			emit(self, OP_CONST, addConst(self, (Value) { .f = expr->literal.fVal }));
+			break;
+			
+		case LITERAL_STRING:
+			emit(self, OP_CONST, addConst(self, (Value) { .s = expr->literal.sVal }));
+			break;
+		}
+		break;
+		
+	case EXPR_VAR:
+		emitVar(self, expr->var.res, OP_LOAD_LOCAL, OP_LOAD_GLOBAL);
+		break;
+		
+	case EXPR_INVALID:
+		assert(0);
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Übersetzt einen Sprung nach \p target, der genau dann ausgeführt
+ * wird, wenn die Bedingung \p cond den Wahrheitswert \p when besitzt.
+ *
+ * Vergleicht die Bedingung eine lokale Ganzzahl mit einem Literal, wird eine
+ * Superinstruktion erzeugt. Zurückgegeben wird der Index des Eintrags, der das
+ * Sprungziel enthält.
+ */
+static unsigned int compileBranch(Compiler *self, const Expr *cond, int when, int target) {
+	if (self->fuse && cond->tag == EXPR_BIN_OP && cond->bin_op.op >= BIN_OP_EQ) {
+		const BinOpExpr *bin = &cond->bin_op;
+		BinOp op = bin->op;
+		const Expr *lit = bin->rhs;
+		int slot = exprSlot(self, bin->lhs, TYPE_INT);
+		
+		if (slot < 0) {
+			slot = exprSlot(self, bin->rhs, TYPE_INT);
+			lit = bin->lhs;
+			op = MIRRORED[op];
+		}
+		
+		if (slot >= 0 && isIntLiteral(lit)) {
+			emit(self, CMP_JUMP_OPS[when ? op : NEGATED[op]], slot);
+			emit(self, OP_EXT, lit->literal.iVal);
+			return emit(self, OP_EXT, target);
+		}
+	}
+	
+	compileExpr(self, cond);
+	return emit(self, when ? OP_JUMP_TRUE : OP_JUMP_FALSE, target);
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine Anweisung.
+ *
+ * Schleifen werden mit der Bedingung am Ende übersetzt, so dass pro Iteration
+ * nur ein bedingter Sprung ausgeführt wird.
+ */
+static void compileStmt(Compiler *self, const Stmt *stmt) {
+	unsigned int jump, loop;
+	
+	switch (stmt->tag) {
+	case STMT_EMPTY:
+		break;
+		
+	case STMT_IF:
+		jump = compileBranch(self, &stmt->if_stmt.cond, 0, 0);
+		compileStmt(self, stmt->if_stmt.if_true);
+		
+		if (stmt->if_stmt.if_false->tag != STMT_EMPTY) {
+			unsigned int skip = emit(self, OP_JUMP, 0);
+			patch(self, jump);
+			compileStmt(self, stmt->if_stmt.if_false);
+			jump = skip;
+		}
+		
+		patch(self, jump);
+		break;
+		
+	case STMT_FOR: {
+		const ForStmt *for_stmt = &stmt->for_stmt;
+		
+		if (for_stmt->init.tag == FOR_INIT_VAR_DEF) {
+			compileVarDef(self, &for_stmt->init.var_def);
+		} else {
+			compileAssign(self, &for_stmt->init.assign, 0);
+		}
+		
+		jump = emit(self, OP_JUMP, 0);
+		loop = here(self);
+		compileStmt(self, for_stmt->body);
+		compileAssign(self, &for_stmt->update, 0);
+		patch(self, jump);
+		compileBranch(self, &for_stmt->cond, 1, loop);
+		break;
+	}
+	
+	case STMT_WHILE:
+		jump = emit(self, OP_JUMP, 0);
+		loop = here(self);
+		compileStmt(self, stmt->while_stmt.body);
+		patch(self, jump);
+		compileBranch(self, &stmt->while_stmt.cond, 1, loop);
+		break;
+		
+	case STMT_DO_WHILE:
+		loop = here(self);
+		compileStmt(self, stmt->do_while_stmt.body);
+		compileBranch(self, &stmt->do_while_stmt.cond, 1, loop);
+		break;
+		
+	case STMT_RETURN:
+		if (stmt->return_stmt.tag == EXPR_INVALID) {
+			emit(self, OP_RET, 0);
+		} else {
+			compileExpr(self, &stmt->return_stmt);
+			emitConvert(self, stmt->return_stmt.data_type, self->ret_type);
+			emit(self, OP_RET_VAL, 0);
+		}
+		break;
+		
+	case STMT_PRINT:
+		vecForEach(const Expr *expr, stmt->print_stmt.expressions) {
+			compileExpr(self, expr);
+			emit(self, PRINT_OPS[expr->data_type], 0);
+		}
+		emit(self, OP_PRINT_NL, 0);
+		break;
+		
+	case STMT_VAR_DEF:
+		compileVarDef(self, &stmt->var_def);
+		break;
+		
+	case STMT_ASSIGN:
+		compileAssign(self, &stmt->assign, 0);
+		break;
+		
+	case STMT_CALL:
+		compileCall(self, &stmt->call);
+		
+		if (self->defs[stmt->call.res_ident.res.index].func.return_type != TYPE_VOID) {
+			emit(self, OP_POP, 0);
+		}
+		break;
+		
+	case STMT_BLOCK:
+		vecForEach(const Stmt *inner, stmt->block.statements) {
+			compileStmt(self, inner);
+		}
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine Funktion.
+ *
+ * Fehlt am Ende einer Funktion mit Rückgabewert die `return`-Anweisung, wird
+ * der Wert `0` zurückgegeben, damit der Stack des Rufers konsistent bleibt.
+ */
+static void compileFunc(Compiler *self, const FuncInfo *func) {
+	const FuncDef *def = &self->ast->items[func->item_id.index].func_def;
+	BcFunc *bc_func = &self->bc.funcs[func->item_id.index];
+	
+	self->ret_type = func->return_type;
+	self->depth = self->max_depth = 0;
+	
+	bc_func->entry = here(self);
+	bc_func->param_count = func->param_count;
+	bc_func->frame_size = vecLen(func->local_vars);
+	
+	vecForEach(const Stmt *stmt, def->statements) {
+		compileStmt(self, stmt);
+	}
+	
+	if (func->return_type == TYPE_VOID) {
+		emit(self, OP_RET, 0);
+	} else {
+		emit(self, OP_PUSH, 0);
+		emit(self, OP_RET_VAL, 0);
+	}
+	
+	bc_func->max_stack = self->max_depth;
+}
+
+/* *** implementation ******************************************************* */
+
+Bytecode bcCompile(const Program *ast, const SymDefTable *tab) {
+	return bcCompileWith(ast, tab, 1);
+}
+
+Bytecode bcCompileWith(const Program *ast, const SymDefTable *tab, int fuse) {
+	Compiler self = {
+		.bc = { .global_count = tab->global_count },
+		.ast = ast,
+		.defs = tab->definitions,
+		.fuse = fuse
+	};
+	
+	vecForEach(const Item *item, ast->items) {
+		(void) item;
+		vecPush(self.bc.funcs) = (BcFunc) { 0 };
+	}
+	
+	vecForEach(const DefInfo *def, tab->definitions) {
+		if (def->tag == SYM_DEF_FUNC) {
+			compileFunc(&self, &def->func);
+		}
+	}
+	
+	/* initialize the global variables and call main */
+	self.depth = self.max_depth = 0;
+	self.bc.entry = here(&self);
+	
+	vecForEach(const Item *item, ast->items) {
+		if (item->tag == ITEM_GLOBAL_VAR) {
+			compileVarDef(&self, &item->var_def);
+		}
+	}
+	
+	emit(&self, OP_CALL, tab->definitions[tab->main_func.index].func.item_id.index);
+	emit(&self, OP_HALT, 0);
+	
+	self.bc.max_stack = self.max_depth;
+	return self.bc;
+}
+
+void bcRelease(Bytecode *self) {
+	vecRelease(self->code);
+	vecRelease(self->consts);
+	vecRelease(self->funcs);
+}
@@ -0,0 +1,181 @@
+/***************************************************************************//**
+ * @file bytecode.h
+ * @brief Bytecode-Darstellung und Übersetzer für C1-Programme.
+ *
+ * # Überblick
+ *
+ * Ein analysiertes Programm wird in ein lineares Feld von Instruktionen fester
+ * Breite übersetzt, das von einer Stackmaschine (siehe `vm.h`) ausgeführt
+ * wird. Alle Opcodes sind bereits nach dem Datentyp ihrer Operanden
+ * spezialisiert, so dass zur Laufzeit keine Typprüfungen mehr stattfinden.
+ *
+ * Der Speicherort von Variablen wird wie im AST-Interpreter aus der
+ * Definitionstabelle übernommen: Lokale Variablen (einschließlich Parameter)
+ * werden über `VarInfo.offset` relativ zum Frame der aktuellen Funktion
+ * adressiert, globale Variablen absolut.
+ *
+ * Ein Funktionsaufruf erwartet seine Argumente in Aufrufreihenfolge auf dem
+ * Stack. Diese bilden die ersten Einträge des neuen Frames, auf die
+ * unmittelbar die übrigen lokalen Variablen folgen.
+ *
+ * # Superinstruktionen
+ *
+ * Häufige Muster, etwa die Bedingung `i < 10` oder die Fortschaltung
+ * `i = i + 1` einer `for`-Schleife, werden beim Übersetzen im Syntaxbaum
+ * erkannt und als eine einzige Instruktion erzeugt. Benötigt eine solche
+ * Superinstruktion mehr als einen Operanden, folgen die weiteren als
+ * `OP_EXT`-Einträge unmittelbar auf sie und werden bei der Ausführung
+ * übersprungen. Die Auswahl der Muster beruht auf den Häufigkeiten
+ * aufeinanderfolgender Opcodes im ungefügten Bytecode (siehe
+ * `VmStats.pairs`).
+ ******************************************************************************/
+
+#ifndef BYTECODE_H_INCLUDED
+#define BYTECODE_H_INCLUDED
+
+/* *** Includes ************************************************************* */
+
+#include <stdio.h>
+#include "ast.h"
+#include "symtab.h"
+#include "interp.h"
+
+/* *** Strukturen *********************************************************** */
+
+/**
+ * @brief Die Opcodes der Stackmaschine.
+ *
+ * Die Suffixe `_I`, `_F`, `_B` und `_S` geben den Datentyp der Operanden an.
+ * Wahrheitswerte werden wie Ganzzahlen behandelt, wo dies keinen Unterschied
+ * macht.
+ */
+typedef enum Opcode {
+	OP_HALT,         /**<@brief Beendet die Ausführung. */
+	OP_POP,          /**<@brief Verwirft den obersten Stackeintrag. */
+	OP_DUP,          /**<@brief Dupliziert den obersten Stackeintrag. */
+	OP_PUSH,         /**<@brief Legt die Ganzzahl `arg` auf den Stack. */
+	OP_CONST,        /**<@brief Legt die Konstante `consts[arg]` auf den Stack. */
+	OP_LOAD_LOCAL,   /**<@brief Lädt die lokale Variable `arg`. */
+	OP_STORE_LOCAL,  /**<@brief Speichert in die lokale Variable `arg`. */
+	OP_LOAD_GLOBAL,  /**<@brief Lädt die globale Variable `arg`. */
+	OP_STORE_GLOBAL, /**<@brief Speichert in die globale Variable `arg`. */
+	OP_I2F,          /**<@brief Wandelt eine Ganzzahl in eine Fließkommazahl. */
+	OP_NEG_I,
+	OP_NEG_F,
+	OP_ADD_I,
+	OP_SUB_I,
+	OP_MUL_I,
+	OP_DIV_I,
+	OP_ADD_F,
+	OP_SUB_F,
+	OP_MUL_F,
+	OP_DIV_F,
+	OP_EQ_I,
+	OP_NEQ_I,
+	OP_LT_I,
+	OP_GT_I,
+	OP_LEQ_I,
+	OP_GEQ_I,
+	OP_EQ_F,
+	OP_NEQ_F,
+	OP_LT_F,
+	OP_GT_F,
+	OP_LEQ_F,
+	OP_GEQ_F,
+	OP_JUMP,         /**<@brief Springt nach `arg`. */
+	OP_JUMP_FALSE,   /**<@brief Springt nach `arg`, falls der Wert falsch ist. */
+	OP_JUMP_TRUE,    /**<@brief Springt nach `arg`, falls der Wert wahr ist. */
+	OP_OR,           /**<@brief Springt nach `arg` und behält den Wert, falls er wahr ist. */
+	OP_AND,          /**<@brief Springt nach `arg` und behält den Wert, falls er falsch ist. */
+	OP_CALL,         /**<@brief Ruft die Funktion `funcs[arg]` auf. */
+	OP_RET,          /**<@brief Kehrt ohne Wert zum Rufer zurück. */
+	OP_RET_VAL,      /**<@brief Kehrt mit dem obersten Stackeintrag zurück. */
+	OP_PRINT_B,
+	OP_PRINT_I,
+	OP_PRINT_F,
+	OP_PRINT_S,
+	OP_PRINT_NL,     /**<@brief Beendet die Ausgabe einer `print`-Anweisung. */
+	OP_JEQ_LK,       /**<@brief Springt nach `ext[1]`, falls lokal `arg == ext[0]`. */
+	OP_JNEQ_LK,      /**<@brief Springt nach `ext[1]`, falls lokal `arg != ext[0]`. */
+	OP_JLT_LK,       /**<@brief Springt nach `ext[1]`, falls lokal `arg < ext[0]`. */
+	OP_JGT_LK,       /**<@brief Springt nach `ext[1]`, falls lokal `arg > ext[0]`. */
+	OP_JLEQ_LK,      /**<@brief Springt nach `ext[1]`, falls lokal `arg <= ext[0]`. */
+	OP_JGEQ_LK,      /**<@brief Springt nach `ext[1]`, falls lokal `arg >= ext[0]`. */
+	OP_ADD_LK,       /**<@brief Addiert die Ganzzahl `ext[0]` zur lokalen Variablen `arg`. */
+	OP_LOAD_ADD_LK,  /**<@brief Legt die Summe der lokalen Variablen `arg` und `ext[0]` ab. */
+	OP_LOAD_CALL,    /**<@brief Lädt die lokale Variable `arg` und ruft `funcs[ext[0]]` auf. */
+	OP_EXT,          /**<@brief Weiterer Operand der vorangehenden Superinstruktion. */
+	OP_COUNT         /**<@brief Anzahl der Opcodes. */
+} Opcode;
+
+/**
+ * @brief Eine Instruktion fester Breite.
+ */
+typedef struct Instr {
+	Opcode op; /**<@brief Die auszuführende Operation. */
+	int arg;   /**<@brief Der Operand (Index, Sprungziel oder Ganzzahl). */
+} Instr;
+
+/**
+ * @brief Übersetzungsinformationen einer Funktion.
+ */
+typedef struct BcFunc {
+	unsigned int entry;       /**<@brief Index der ersten Instruktion. */
+	unsigned int param_count; /**<@brief Anzahl der Parameter. */
+	unsigned int frame_size;  /**<@brief Anzahl lokaler Variablen. */
+	unsigned int max_stack;   /**<@brief Maximale Tiefe des Operandenstacks. */
+} BcFunc;
+
+/**
+ * @brief Ein übersetztes Programm.
+ *
+ * Die Ausführung beginnt bei `entry`. Der dort abgelegte Code initialisiert
+ * die globalen Variablen, ruft `main()` auf und hält anschließend an.
+ */
+typedef struct Bytecode {
+	Instr *code;               /**<@brief Vektor aller Instruktionen. */
+	Value *consts;             /**<@brief Vektor der Konstanten. */
+	BcFunc *funcs;             /**<@brief Funktionen, indiziert durch `ItemId`. */
+	unsigned int global_count; /**<@brief Anzahl globaler Variablen. */
+	unsigned int entry;        /**<@brief Index der ersten Instruktion. */
+	unsigned int max_stack;    /**<@brief Stacktiefe des Einstiegscodes. */
+} Bytecode;
+
+/* *** Öffentliche Schnittstelle ******************************************** */
+
+/**
+ * @brief Die Namen der Opcodes, indiziert durch `Opcode`.
+ */
+extern const char *OPCODE_NAMES[OP_COUNT];
+
+/**
+ * @brief Übersetzt ein semantisch analysiertes Programm in Bytecode.
+ *
+ * Zeichenkettenkonstanten verweisen weiterhin in den Syntaxbaum, der somit
+ * mindestens so lange leben muss wie der Bytecode. Es werden
+ * Superinstruktionen erzeugt.
+ *
+ * @param ast Die Wurzel des abstrakten Syntaxbaumes.
+ * @param tab Die Definitionstabelle des Programms.
+ * @return Der übersetzte Bytecode.
+ */
+extern Bytecode bcCompile(const Program *ast, const SymDefTable *tab);
+
+/**
+ * @brief Übersetzt ein semantisch analysiertes Programm in Bytecode und
+ * erzeugt Superinstruktionen nur auf Wunsch.
+ *
+ * @param ast  Die Wurzel des abstrakten Syntaxbaumes.
+ * @param tab  Die Definitionstabelle des Programms.
+ * @param fuse 1, falls Superinstruktionen erzeugt werden sollen, sonst 0.
+ * @return Der übersetzte Bytecode.
+ */
+extern Bytecode bcCompileWith(const Program *ast, const SymDefTable *tab, int fuse);
+
+/**
+ * @brief Gibt den Speicher des Bytecodes frei.
+ * @param self Der freizugebende Bytecode.
+ */
+extern void bcRelease(Bytecode *self);
+
+#endif
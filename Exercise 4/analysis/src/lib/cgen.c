@@ -0,0 +1,683 @@
+/***************************************************************************//**
+ * @file cgen.c
+ * @brief Implementation der Übersetzung nach C.
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <assert.h>
+#include "cgen.h"
+#include "vec.h"
+
+/* *** internal structures ************************************************** */
+
+/**
+ * @internal
+ * @brief Zustand des Übersetzers.
+ */
+typedef struct {
+	const Program *ast;  /**<@brief Der übersetzte Syntaxbaum. */
+	const DefInfo *defs; /**<@brief Die Definitionstabelle. */
+	char *body;          /**<@brief Vektor mit dem Rumpf der aktuellen Funktion. */
+	DataType *temps;     /**<@brief Vektor der Typen aller Hilfsvariablen. */
+	unsigned int indent; /**<@brief Aktuelle Einrücktiefe. */
+} CGen;
+
+/* *** internal constants *************************************************** */
+
+/** @internal @brief Die C-Typen der Datentypen von C1. */
+static const char *C_TYPES[] = {
+	[TYPE_VOID]   = "void",
+	[TYPE_BOOL]   = "int",
+	[TYPE_INT]    = "int",
+	[TYPE_FLOAT]  = "double",
+	[TYPE_STRING] = "const char *",
+};
+
+/** @internal @brief Die C-Operatoren der binären Operationen. */
+static const char *C_OPS[] = {
+	[BIN_OP_ADD]     = "+",
+	[BIN_OP_SUB]     = "-",
+	[BIN_OP_MUL]     = "*",
+	[BIN_OP_DIV]     = "/",
+	[BIN_OP_LOG_OR]  = "||",
+	[BIN_OP_LOG_AND] = "&&",
+	[BIN_OP_EQ]      = "==",
+	[BIN_OP_NEQ]     = "!=",
+	[BIN_OP_LT]      = "<",
+	[BIN_OP_GT]      = ">",
+	[BIN_OP_LEQ]     = "<=",
+	[BIN_OP_GEQ]     = ">=",
+};
+
+/** @internal @brief Die Laufzeitfunktionen für Arithmetik mit Überlauf. */
+static const char *INT_OPS[] = {
+	[BIN_OP_ADD] = "rt_add",
+	[BIN_OP_SUB] = "rt_sub",
+	[BIN_OP_MUL] = "rt_mul",
+};
+
+/** @internal @brief Die Ausgabefunktionen der `print`-Anweisung. */
+static const char *PRINT_FUNCS[] = {
+	[TYPE_BOOL]   = "rt_print_bool",
+	[TYPE_INT]    = "rt_print_int",
+	[TYPE_FLOAT]  = "rt_print_float",
+	[TYPE_STRING] = "rt_print_string",
+};
+
+/** @internal @brief Die Laufzeitbibliothek am Anfang jeder Übersetzungseinheit. */
+static const char RUNTIME[] =
+	"/* generated by minako --emit-c */\n"
+	"#include <stdio.h>\n"
+	"#include <math.h>\n"
+	"\n"
+	"/* int arithmetic wraps around like in the interpreters */\n"
+	"static inline int rt_add(int a, int b) { return (int) ((unsigned int) a + (unsigned int) b); }\n"
+	"static inline int rt_sub(int a, int b) { return (int) ((unsigned int) a - (unsigned int) b); }\n"
+	"static inline int rt_mul(int a, int b) { return (int) ((unsigned int) a * (unsigned int) b); }\n"
+	"static inline int rt_neg(int a) { return (int) -(unsigned int) a; }\n"
+	"\n"
+	"static inline void rt_print_bool(int v) { fputs(v ? \"true\" : \"false\", stdout); }\n"
+	"static inline void rt_print_int(int v) { printf(\"%i\", v); }\n"
+	"static inline void rt_print_string(const char *v) { fputs(v, stdout); }\n"
+	"static inline void rt_newline(void) { putchar('\\n'); }\n"
+	"\n"
+	"static inline void rt_print_float(double v) {\n"
+	"\tif (v != v) {\n"
+	"\t\tfputs(\"nan\", stdout);\n"
+	"\t} else if (v == HUGE_VAL || v == -HUGE_VAL) {\n"
+	"\t\tfputs(v > 0 ? \"inf\" : \"-inf\", stdout);\n"
+	"\t} else {\n"
+	"\t\tprintf(\"%g\", v);\n"
+	"\t}\n"
+	"}\n";
+	
+/* *** internal helpers ***************************************************** */
+
+/* forward declarations */
+static void emitExpr(CGen*, const Expr*);
+static void emitStmt(CGen*, const Stmt*);
+
+/**
+ * @internal
+ * @brief Hängt formatierten Text an den Rumpf der aktuellen Funktion an.
+ */
+static void emit(CGen *self, const char *fmt, ...) {
+	va_list args, copy;
+	va_start(args, fmt);
+	va_copy(copy, args);
+	int len = vsnprintf(NULL, 0, fmt, copy);
+	va_end(copy);
+	
+	unsigned int at = vecLen(self->body);
+	for (int i = 0; i <= len; ++i) {
+		vecPush(self->body) = 0;
+	}
+	
+	vsnprintf(&self->body[at], len + 1, fmt, args);
+	(void) vecPop(self->body);
+	va_end(args);
+}
+
+/**
+ * @internal
+ * @brief Beginnt eine neue Zeile in der aktuellen Einrücktiefe.
+ */
+static void emitLine(CGen *self) {
+	for (unsigned int i = 0; i < self->indent; ++i) {
+		vecPush(self->body) = '\t';
+	}
+}
+
+/**
+ * @internal
+ * @brief Legt eine neue Hilfsvariable vom Typ \p type an.
+ * @return Die Nummer der Hilfsvariablen.
+ */
+static unsigned int newTemp(CGen *self, DataType type) {
+	vecPush(self->temps) = type;
+	return vecLen(self->temps) - 1;
+}
+
+/**
+ * @internal
+ * @brief Gibt zurück, ob die Auswertung von \p expr Seiteneffekte haben kann.
+ */
+static int hasEffects(const Expr *expr) {
+	switch (expr->tag) {
+	case EXPR_ASSIGN:
+	case EXPR_CALL:
+		return 1;
+		
+	case EXPR_BIN_OP:
+		return hasEffects(expr->bin_op.lhs) || hasEffects(expr->bin_op.rhs);
+		
+	case EXPR_UNARY_MINUS:
+		return hasEffects(expr->unary_minus);
+		
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt zurück, ob \p expr selbst eine Zuweisung an \p id enthält.
+ */
+static int assignsTo(const Expr *expr, DefId id) {
+	switch (expr->tag) {
+	case EXPR_ASSIGN:
+		return expr->assign.lhs.res.index == id.index || assignsTo(expr->assign.rhs, id);
+		
+	case EXPR_BIN_OP:
+		return assignsTo(expr->bin_op.lhs, id) || assignsTo(expr->bin_op.rhs, id);
+		
+	case EXPR_UNARY_MINUS:
+		return assignsTo(expr->unary_minus, id);
+		
+	case EXPR_CALL:
+		vecForEach(const Expr *arg, expr->call.args) {
+			if (assignsTo(arg, id)) { return 1; }
+		}
+		return 0;
+		
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt den Namen der Variablen \p id aus.
+ */
+static void emitVarName(CGen *self, DefId id) {
+	const DefInfo *def = &self->defs[id.index];
+	
+	if (def->tag == SYM_DEF_LOCAL_VAR) {
+		emit(self, "l%u_%s", def->var.offset, internName(def->ident));
+	} else {
+		assert(def->tag == SYM_DEF_GLOBAL_VAR);
+		emit(self, "g_%s", internName(def->ident));
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt ein Zeichenkettenliteral mit C-Escape-Sequenzen aus.
+ */
+static void emitString(CGen *self, const char *str) {
+	vecPush(self->body) = '"';
+	
+	for (const unsigned char *c = (const unsigned char*) str; *c != 0; ++c) {
+		if (*c == '"' || *c == '\\' || *c == '?') {
+			emit(self, "\\%c", *c);
+		} else if (*c < 0x20 || *c >= 0x7F) {
+			emit(self, "\\%03o", *c);
+		} else {
+			vecPush(self->body) = (char) *c;
+		}
+	}
+	
+	vecPush(self->body) = '"';
+}
+
+/**
+ * @internal
+ * @brief Gibt ein Literal aus.
+ *
+ * Fließkommazahlen werden mit 17 signifikanten Stellen und somit ohne
+ * Rundungsverlust ausgegeben.
+ */
+static void emitLiteral(CGen *self, const Literal *literal) {
+	switch (literal->tag) {
+	case LITERAL_INT:
+		if (literal->iVal == INT_MIN) {
+			emit(self, "(%d - 1)", INT_MIN + 1);
+		} else {
+			emit(self, "%d", literal->iVal);
+		}
+		break;
+		
+	case LITERAL_BOOL:
+		emit(self, "%d", literal->bVal != 0);
+		break;
+		
+	case LITERAL_FLOAT: {
+		if (isinf(literal->fVal)) {
+			emit(self, "HUGE_VAL");
+			break;
+		}
+		
+		char buf[32];
+		snprintf(buf, sizeof(buf), "%.17g", literal->fVal);
+		emit(self, strpbrk(buf, ".e") != NULL ? "%s" : "%s.0", buf);
+		break;
+	}
+	
+	case LITERAL_STRING:
+		emitString(self, literal->sVal);
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt die Zuweisung von \p rhs an die Variable \p id ohne äußere
+ * Klammern aus.
+ *
+ * Weist \p rhs selbst der Variablen einen Wert zu, wären beide Schreibzugriffe
+ * in C nicht sequenziert; der Wert wird dann zuerst in einer Hilfsvariablen
+ * abgelegt.
+ */
+static void emitStore(CGen *self, DefId id, const Expr *rhs) {
+	if (assignsTo(rhs, id)) {
+		unsigned int temp = newTemp(self, rhs->data_type);
+		emit(self, "t%u = ", temp);
+		emitExpr(self, rhs);
+		emit(self, ", ");
+		emitVarName(self, id);
+		emit(self, " = t%u", temp);
+	} else {
+		emitVarName(self, id);
+		emit(self, " = ");
+		emitExpr(self, rhs);
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt einen Funktionsaufruf aus.
+ *
+ * Hat eines der Argumente Seiteneffekte, werden alle Argumente bis auf das
+ * letzte zuvor der Reihe nach in Hilfsvariablen berechnet.
+ */
+static void emitCall(CGen *self, const FuncCall *call) {
+	unsigned int count = vecLen(call->args);
+	unsigned int *temps = NULL;
+	int ordered = 0;
+	
+	vecForEach(const Expr *arg, call->args) {
+		ordered |= hasEffects(arg);
+	}
+	
+	if (ordered) {
+		emit(self, "(");
+		
+		for (unsigned int i = 0; i + 1 < count; ++i) {
+			if (call->args[i].tag == EXPR_LITERAL) {
+				vecPush(temps) = UINT_MAX;
+				continue;
+			}
+			
+			vecPush(temps) = newTemp(self, call->args[i].data_type);
+			emit(self, "t%u = ", vecTop(temps));
+			emitExpr(self, &call->args[i]);
+			emit(self, ", ");
+		}
+	}
+	
+	emit(self, "f_%s(", internName(self->defs[call->res_ident.res.index].ident));
+	
+	for (unsigned int i = 0; i < count; ++i) {
+		if (i > 0) { emit(self, ", "); }
+		
+		if (ordered && i + 1 < count && temps[i] != UINT_MAX) {
+			emit(self, "t%u", temps[i]);
+		} else {
+			emitExpr(self, &call->args[i]);
+		}
+	}
+	
+	emit(self, ordered ? "))" : ")");
+	vecRelease(temps);
+}
+
+/**
+ * @internal
+ * @brief Gibt einen Operanden aus, der bei \p widen von `int` nach `float`
+ * umgewandelt wird; liegt sein Wert bereits in der Hilfsvariablen \p temp, wird
+ * diese gelesen.
+ */
+static void emitOperand(CGen *self, const Expr *expr, unsigned int temp, int widen) {
+	if (widen && expr->data_type == TYPE_INT) {
+		if (temp == UINT_MAX && expr->tag == EXPR_LITERAL) {
+			emit(self, "%d.0", expr->literal.iVal);
+			return;
+		}
+		
+		emit(self, "(double) ");
+	}
+	
+	if (temp != UINT_MAX) {
+		emit(self, "t%u", temp);
+	} else {
+		emitExpr(self, expr);
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt eine binäre Operation aus.
+ *
+ * Hat einer der Operanden Seiteneffekte, wird der linke Operand zuerst in einer
+ * Hilfsvariablen berechnet. Logische Operationen sind bereits in C von links
+ * nach rechts sequenziert.
+ */
+static void emitBinOp(CGen *self, const BinOpExpr *bin, DataType type) {
+	int widen = bin->lhs->data_type == TYPE_FLOAT || bin->rhs->data_type == TYPE_FLOAT;
+	int wraps = type == TYPE_INT && bin->op <= BIN_OP_MUL;
+	unsigned int temp = UINT_MAX;
+	
+	if (bin->op != BIN_OP_LOG_OR && bin->op != BIN_OP_LOG_AND
+		&& bin->lhs->tag != EXPR_LITERAL && bin->rhs->tag != EXPR_LITERAL
+		&& (hasEffects(bin->lhs) || hasEffects(bin->rhs))) {
+		temp = newTemp(self, bin->lhs->data_type);
+		emit(self, "(t%u = ", temp);
+		emitExpr(self, bin->lhs);
+		emit(self, ", ");
+	}
+	
+	if (wraps) {
+		emit(self, "%s(", INT_OPS[bin->op]);
+	} else {
+		emit(self, "(");
+	}
+	
+	emitOperand(self, bin->lhs, temp, widen);
+	emit(self, wraps ? ", " : " %s ", C_OPS[bin->op]);
+	emitOperand(self, bin->rhs, UINT_MAX, widen);
+	emit(self, temp != UINT_MAX ? "))" : ")");
+}
+
+/**
+ * @internal
+ * @brief Gibt einen Ausdruck aus.
+ */
+static void emitExpr(CGen *self, const Expr *expr) {
+	switch (expr->tag) {
+	case EXPR_ASSIGN:
+		emit(self, "(");
+		emitStore(self, expr->assign.lhs.res, expr->assign.rhs);
+		emit(self, ")");
+		break;
+		
+	case EXPR_BIN_OP:
+		emitBinOp(self, &expr->bin_op, expr->data_type);
+		break;
+		
+	case EXPR_UNARY_MINUS:
+		emit(self, expr->data_type == TYPE_INT ? "rt_neg(" : "(-");
+		emitExpr(self, expr->unary_minus);
+		emit(self, ")");
+		break;
+		
+	case EXPR_CALL:
+		emitCall(self, &expr->call);
+		break;
+		
+	case EXPR_LITERAL:
+		emitLiteral(self, &expr->literal);
+		break;
+		
+	case EXPR_VAR:
+		emitVarName(self, expr->var.res);
+		break;
+		
+	case EXPR_INVALID:
+		assert(0);
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt eine Anweisung als Block in geschweiften Klammern aus.
+ */
+static void emitBlock(CGen *self, const Stmt *stmt) {
+	emit(self, "{\n");
+	++self->indent;
+	
+	if (stmt->tag == STMT_BLOCK) {
+		vecForEach(const Stmt *inner, stmt->block.statements) {
+			emitStmt(self, inner);
+		}
+	} else {
+		emitStmt(self, stmt);
+	}
+	
+	--self->indent;
+	emitLine(self);
+	emit(self, "}");
+}
+
+/**
+ * @internal
+ * @brief Gibt eine Anweisung auf eigenen Zeilen aus.
+ */
+static void emitStmt(CGen *self, const Stmt *stmt) {
+	if (stmt->tag == STMT_EMPTY) { return; }
+	if (stmt->tag == STMT_VAR_DEF && stmt->var_def.init.tag == EXPR_INVALID) { return; }
+	
+	emitLine(self);
+	
+	switch (stmt->tag) {
+	case STMT_EMPTY:
+		break;
+		
+	case STMT_IF:
+		emit(self, "if (");
+		emitExpr(self, &stmt->if_stmt.cond);
+		emit(self, ") ");
+		emitBlock(self, stmt->if_stmt.if_true);
+		
+		if (stmt->if_stmt.if_false->tag != STMT_EMPTY) {
+			emit(self, " else ");
+			emitBlock(self, stmt->if_stmt.if_false);
+		}
+		emit(self, "\n");
+		break;
+		
+	case STMT_FOR: {
+		const ForStmt *for_stmt = &stmt->for_stmt;
+		emit(self, "for (");
+		
+		if (for_stmt->init.tag == FOR_INIT_VAR_DEF) {
+			if (for_stmt->init.var_def.init.tag != EXPR_INVALID) {
+				emitStore(self, for_stmt->init.var_def.res_ident.res, &for_stmt->init.var_def.init);
+			}
+		} else {
+			emitStore(self, for_stmt->init.assign.lhs.res, for_stmt->init.assign.rhs);
+		}
+		
+		emit(self, "; ");
+		emitExpr(self, &for_stmt->cond);
+		emit(self, "; ");
+		emitStore(self, for_stmt->update.lhs.res, for_stmt->update.rhs);
+		emit(self, ") ");
+		emitBlock(self, for_stmt->body);
+		emit(self, "\n");
+		break;
+	}
+	
+	case STMT_WHILE:
+		emit(self, "while (");
+		emitExpr(self, &stmt->while_stmt.cond);
+		emit(self, ") ");
+		emitBlock(self, stmt->while_stmt.body);
+		emit(self, "\n");
+		break;
+		
+	case STMT_DO_WHILE:
+		emit(self, "do ");
+		emitBlock(self, stmt->do_while_stmt.body);
+		emit(self, " while (");
+		emitExpr(self, &stmt->do_while_stmt.cond);
+		emit(self, ");\n");
+		break;
+		
+	case STMT_RETURN:
+		if (stmt->return_stmt.tag != EXPR_INVALID) {
+			emit(self, "return ");
+			emitExpr(self, &stmt->return_stmt);
+			emit(self, ";\n");
+		} else {
+			emit(self, "return;\n");
+		}
+		break;
+		
+	case STMT_PRINT:
+		vecForEach(const Expr *expr, stmt->print_stmt.expressions) {
+			emit(self, "%s(", PRINT_FUNCS[expr->data_type]);
+			emitExpr(self, expr);
+			emit(self, ");\n");
+			emitLine(self);
+		}
+		emit(self, "rt_newline();\n");
+		break;
+		
+	case STMT_VAR_DEF:
+		emitStore(self, stmt->var_def.res_ident.res, &stmt->var_def.init);
+		emit(self, ";\n");
+		break;
+		
+	case STMT_ASSIGN:
+		emitStore(self, stmt->assign.lhs.res, stmt->assign.rhs);
+		emit(self, ";\n");
+		break;
+		
+	case STMT_CALL:
+		emitCall(self, &stmt->call);
+		emit(self, ";\n");
+		break;
+		
+	case STMT_BLOCK:
+		emitBlock(self, stmt);
+		emit(self, "\n");
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Schreibt die Hilfsvariablen und den Rumpf der aktuellen Funktion
+ * nach \p out und setzt beide zurück.
+ */
+static void flushBody(CGen *self, FILE *out) {
+	unsigned int index = 0;
+	
+	vecForEach(const DataType *type, self->temps) {
+		fprintf(out, "\t%s t%u;\n", C_TYPES[*type], index++);
+	}
+	
+	if (self->body != NULL) {
+		fwrite(self->body, 1, vecLen(self->body), out);
+	}
+	
+	vecRelease(self->body);
+	vecRelease(self->temps);
+	self->body = NULL;
+	self->temps = NULL;
+}
+
+/**
+ * @internal
+ * @brief Gibt den Kopf der Funktion \p id ohne abschließendes Zeichen aus.
+ */
+static void writeSignature(const CGen *self, DefId id, FILE *out) {
+	const FuncInfo *info = &self->defs[id.index].func;
+	
+	fprintf(out, "static %s f_%s(", C_TYPES[info->return_type], internName(self->defs[id.index].ident));
+	
+	for (unsigned int i = 0; i < info->param_count; ++i) {
+		const DefInfo *param = &self->defs[info->local_vars[i].index];
+		fprintf(out, "%s%s l%u_%s", i > 0 ? ", " : "", C_TYPES[param->var.data_type], param->var.offset, internName(param->ident));
+	}
+	
+	fputs(info->param_count == 0 ? "void)" : ")", out);
+}
+
+/**
+ * @internal
+ * @brief Übersetzt die Funktion \p id.
+ *
+ * Die lokalen Variablen werden mit `0` vorbelegt. Funktionen ohne `return`
+ * am Ende geben wie im Interpreter `0` zurück.
+ */
+static void writeFunc(CGen *self, DefId id, FILE *out) {
+	const FuncInfo *info = &self->defs[id.index].func;
+	const FuncDef *def = &self->ast->items[info->item_id.index].func_def;
+	
+	writeSignature(self, id, out);
+	fputs(" {\n", out);
+	
+	for (unsigned int i = info->param_count; i < vecLen(info->local_vars); ++i) {
+		const DefInfo *var = &self->defs[info->local_vars[i].index];
+		fprintf(out, "\t%s l%u_%s = 0;\n", C_TYPES[var->var.data_type], var->var.offset, internName(var->ident));
+	}
+	
+	self->indent = 1;
+	vecForEach(const Stmt *stmt, def->statements) {
+		emitStmt(self, stmt);
+	}
+	
+	if (info->return_type != TYPE_VOID) {
+		emit(self, "\treturn 0;\n");
+	}
+	
+	flushBody(self, out);
+	fputs("}\n", out);
+}
+
+/* *** implementation ******************************************************* */
+
+void cgenProgram(const Program *ast, const SymDefTable *tab, FILE *out) {
+	CGen self = {
+		.ast = ast,
+		.defs = tab->definitions
+	};
+	
+	fputs(RUNTIME, out);
+	fputc('\n', out);
+	
+	/* global variables and prototypes of all functions */
+	vecForEach(const Item *item, ast->items) {
+		if (item->tag == ITEM_GLOBAL_VAR) {
+			const DefInfo *var = &self.defs[item->var_def.res_ident.res.index];
+			fprintf(out, "static %s g_%s;\n", C_TYPES[var->var.data_type], internName(var->ident));
+		}
+	}
+	
+	for (unsigned int i = 0; i < vecLen(self.defs); ++i) {
+		if (self.defs[i].tag == SYM_DEF_FUNC) {
+			writeSignature(&self, (DefId) { i }, out);
+			fputs(";\n", out);
+		}
+	}
+	
+	for (unsigned int i = 0; i < vecLen(self.defs); ++i) {
+		if (self.defs[i].tag == SYM_DEF_FUNC) {
+			fputc('\n', out);
+			writeFunc(&self, (DefId) { i }, out);
+		}
+	}
+	
+	/* initialize the global variables in the order of their declaration */
+	self.indent = 1;
+	vecForEach(const Item *item, ast->items) {
+		if (item->tag == ITEM_GLOBAL_VAR && item->var_def.init.tag != EXPR_INVALID) {
+			emitLine(&self);
+			emitStore(&self, item->var_def.res_ident.res, &item->var_def.init);
+			emit(&self, ";\n");
+		}
+	}
+	
+	emit(&self, "\tf_%s();\n", internName(self.defs[tab->main_func.index].ident));
+	emit(&self, "\treturn 0;\n");
+	
+	fputs("\nint main(void) {\n", out);
+	flushBody(&self, out);
+	fputs("}\n", out);
+}
@@ -0,0 +1,48 @@
+/***************************************************************************//**
+ * @file cgen.h
+ * @brief Übersetzung von C1-Programmen in C-Quelltext.
+ *
+ * # Überblick
+ *
+ * Der Übersetzer erzeugt aus einem analysierten Programm eine eigenständige
+ * C11-Übersetzungseinheit, die mit einem gewöhnlichen C-Compiler (z.B.
+ * `cc -O2`) in ein ausführbares Programm übersetzt werden kann:
+ *
+ * - Globale Variablen (`SYM_DEF_GLOBAL_VAR`) werden zu statischen Variablen
+ *   `g_<name>`, die zu Beginn von `main()` in der Reihenfolge ihrer Deklaration
+ *   initialisiert werden.
+ * - Jede `FuncDef` wird zu einer Funktion `f_<name>`. Ihre lokalen Variablen
+ *   werden wie im Stack-Frame des Interpreters zu Beginn der Funktion angelegt
+ *   und über ihren Slot benannt (`l<offset>_<name>`).
+ * - Die `print`-Anweisung ruft eine kleine Laufzeitbibliothek (`rt_...`) am
+ *   Anfang der Übersetzungseinheit auf, die die Ausgaberegeln der Sprache
+ *   umsetzt.
+ *
+ * Da C die Auswertungsreihenfolge von Operanden und Argumenten offen lässt,
+ * werden Teilausdrücke mit Seiteneffekten über Hilfsvariablen (`t<n>`) und den
+ * Kommaoperator in die von C1 geforderte Reihenfolge von links nach rechts
+ * gebracht. Arithmetik auf `int` läuft wie in den Interpretern mit
+ * Zweierkomplement-Überlauf.
+ ******************************************************************************/
+
+#ifndef CGEN_H_INCLUDED
+#define CGEN_H_INCLUDED
+
+/* *** Includes ************************************************************* */
+
+#include <stdio.h>
+#include "ast.h"
+#include "symtab.h"
+
+/* *** Öffentliche Schnittstelle ******************************************** */
+
+/**
+ * @brief Übersetzt ein semantisch analysiertes Programm in C-Quelltext.
+ *
+ * @param ast Die Wurzel des abstrakten Syntaxbaumes.
+ * @param tab Die Definitionstabelle des Programms.
+ * @param out Der Ausgabestrom für den erzeugten Quelltext.
+ */
+extern void cgenProgram(const Program *ast, const SymDefTable *tab, FILE *out);
+
+#endif
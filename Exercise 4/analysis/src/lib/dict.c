@@ -8,7 +8,6 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <string.h>
 #include <limits.h>
 #include <assert.h>
 
@@ -29,15 +28,19 @@ typedef struct {
  */
 typedef uint32_t Hash;
 
-static const Hash FNVHashSeed = 0x811c9dc5u;
-static const Hash FNVHashPrime = 0x1000193u;
+/**
+ * @internal
+ * @brief Multiplikator für das Fibonacci-Hashing (2^32 geteilt durch den
+ * goldenen Schnitt).
+ */
+static const Hash FibonacciHashFactor = 0x9e3779b9u;
 
 /**
  * @internal
  * @brief Gibt zurück, ob ein Eintrag noch nie in Benutzung war.
  */
 static inline int isNeverUsed(const DictEntry *entry) {
-	return entry->key == ((char*) 0);
+	return entry->key.index == 0;
 }
 
 /**
@@ -45,7 +48,7 @@ static inline int isNeverUsed(const DictEntry *entry) {
  * @brief Gibt zurück, ob ein Eintrag schon zuvor in Benutzung war.
  */
 static inline int isPrevUsed(const DictEntry *entry) {
-	return entry->key == ((char*) -1);
+	return entry->key.index == -1u;
 }
 
 /**
@@ -62,45 +65,19 @@ static inline int isUnused(const DictEntry *entry) {
  */
 static inline void setUnused(DictEntry *entry) {
 	assert(!isUnused(entry));
-	free(entry->key);
-	entry->key = ((char*) -1);
+	entry->key.index = -1u;
 }
 
 /* ******************************************************** private functions */
 
 /**
  * @internal
- * @brief Dupliziert eine Zeichenkette und gibt einen Zeiger auf die Kopie
- * zurück.
- */
-static char* stringDup(const char *str) {
-	size_t len = strlen(str);
-	char *mem = malloc(len + 1);
-	
-	if (mem == NULL) {
-		fputs("out-of-memory error", stderr);
-		exit(-1);
-	}
-	
-	memcpy(mem, str, len + 1);
-	return mem;
-}
-
-/**
- * @internal
- * @brief Hashfunktion FNV-1a von Fowler, Noll und Vo.
+ * @brief Fibonacci-Hashing der fortlaufenden Kennung.
  * @param key  der Schlüssel
  * @return der Hashwert von \p key
  */
-static Hash fnvHash(const char *key) {
-	Hash hash;
-	
-	for (hash = FNVHashSeed; *key != 0; ++key) {
-		hash ^= *key;
-		hash *= FNVHashPrime;
-	}
-	
-	return hash;
+static inline Hash identHash(Ident key) {
+	return key.index*FibonacciHashFactor;
 }
 
 /**
@@ -113,9 +90,9 @@ static Hash fnvHash(const char *key) {
  * @return 1, falls der Eintrag gefunden wurde,\n
  *         0, ansonsten
  */
-static int locate(const Dict *self, const char *key, LocateResult *result) {
+static int locate(const Dict *self, Ident key, LocateResult *result) {
 	enum { UNUSED, FORMER, MATCH } state = UNUSED;
-	Hash hash = fnvHash(key);
+	Hash hash = identHash(key);
 	const unsigned int mask = (1u << self->bits) - 1;
 	const unsigned int initial = hash & mask;
 	
@@ -158,7 +135,7 @@ static int locate(const Dict *self, const char *key, LocateResult *result) {
 			}
 		}
 		/* teste, ob dieser Eintrag der gesuchte ist */
-		else if (strcmp(probe.p->key, key) == 0) {
+		else if (identEq(probe.p->key, key)) {
 			*result = probe;
 			state = MATCH;
 			break;
@@ -230,22 +207,15 @@ void dictInit(Dict *self) {
 }
 
 void dictRelease(Dict *self) {
-	DictEntry *it, *end;
-	
-	/* iteriere über das Array und gib' Schlüssel benutzter Elemente frei */
-	for (it = self->data, end = it + (1u << self->bits); it < end; ++it) {
-		if (!isUnused(it))
-			free(it->key);
-	}
-	
+	/* die Schlüssel gehören der Internalisierung */
 	free(self->data);
 }
 
-unsigned int dictInsert(Dict *self, const char *key, unsigned int val) {
+unsigned int dictInsert(Dict *self, Ident key, unsigned int val) {
 	unsigned int oldVal = -1u;
 	LocateResult loc;
 	
-	assert(key != NULL && val != -1u);
+	assert(key.index != 0 && key.index != -1u && val != -1u);
 	
 	/* vergrößere die Hashmap bei (potenziellem) Platzmangel */
 	if (self->left == 0)
@@ -258,7 +228,7 @@ unsigned int dictInsert(Dict *self, const char *key, unsigned int val) {
 		loc.p->val = val;
 	} else {
 		/* erstelle den Wert neu */
-		loc.p->key = stringDup(key);
+		loc.p->key = key;
 		loc.p->val = val;
 		--self->left;
 	}
@@ -267,7 +237,7 @@ unsigned int dictInsert(Dict *self, const char *key, unsigned int val) {
 	return oldVal;
 }
 
-unsigned int dictGet(const Dict *self, const char *key) {
+unsigned int dictGet(const Dict *self, Ident key) {
 	LocateResult loc;
 	
 	if (locate(self, key, &loc))
@@ -276,7 +246,7 @@ unsigned int dictGet(const Dict *self, const char *key) {
 	return -1u;
 }
 
-unsigned int dictRemove(Dict *self, const char *key) {
+unsigned int dictRemove(Dict *self, Ident key) {
 	unsigned int val = (unsigned int) -1;
 	LocateResult loc;
 	
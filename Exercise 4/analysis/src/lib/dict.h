@@ -3,26 +3,31 @@
  * @author Dorian Weber
  * @brief Enthält die Schnittstelle für ein assoziatives Array (Wörterbuch).
  * @details
+ * Die Schlüssel sind internalisierte Bezeichner (`Ident`), so dass das
+ * Wörterbuch keine Zeichenketten kopiert oder vergleicht.
  * Hier ist ein Beispiel für die Benutzung des Wörterbuches:
  * @code
  * Dict dict;
+ * Ident one = internString("One", 3);
+ * Ident two = internString("Two", 3);
+ * Ident three = internString("Three", 5);
  * 
  * dictInit(&dict);
  * 
- * dictInsert(&dict, "One", 1);
- * dictInsert(&dict, "Two", 2);
- * dictInsert(&dict, "Three", 3);
+ * dictInsert(&dict, one, 1);
+ * dictInsert(&dict, two, 2);
+ * dictInsert(&dict, three, 3);
  * 
- * printf("One -> %u\n", dictGet(&dict, "One"));
- * printf("Two -> %u\n", dictGet(&dict, "Two"));
- * printf("Three -> %u\n", dictGet(&dict, "Three"));
+ * printf("One -> %u\n", dictGet(&dict, one));
+ * printf("Two -> %u\n", dictGet(&dict, two));
+ * printf("Three -> %u\n", dictGet(&dict, three));
  * 
- * dictInsert(&dict, "One", 0);
- * dictRemove(&dict, "Two");
+ * dictInsert(&dict, one, 0);
+ * dictRemove(&dict, two);
  * 
- * printf("One -> %u\n", dictGet(&dict, "One"));
- * printf("Two -> %u\n", dictGet(&dict, "Two"));
- * printf("Three -> %u\n", dictGet(&dict, "Three"));
+ * printf("One -> %u\n", dictGet(&dict, one));
+ * printf("Two -> %u\n", dictGet(&dict, two));
+ * printf("Three -> %u\n", dictGet(&dict, three));
  * 
  * dictRelease(&dict);
  * @endcode
@@ -40,13 +45,15 @@
 #ifndef DICT_H_INCLUDED
 #define DICT_H_INCLUDED
 
+#include "intern.h"
+
 /* *** structures *********************************************************** */
 
 /**
  * @brief Wörterbucheintrag.
  */
 typedef struct {
-	char *key;        /**<@brief Der Schlüssel. */
+	Ident key;        /**<@brief Der Schlüssel. */
 	unsigned int val; /**<@brief Der Wert. */
 } DictEntry;
 
@@ -86,7 +93,7 @@ typedef struct {
 extern void dictInit(Dict *self);
 
 /**
- * @brief Gibt ein Wörterbuch und alle darin gespeicherten Schlüssel frei.
+ * @brief Gibt ein Wörterbuch frei.
  * @param self  das Wörterbuch
  */
 extern void dictRelease(Dict *self);
@@ -99,7 +106,7 @@ extern void dictRelease(Dict *self);
  * @return der alte Wert, falls er überschrieben wurde,
  *         `-1u`, ansonsten
  */
-extern unsigned int dictInsert(Dict *self, const char *key, unsigned int val);
+extern unsigned int dictInsert(Dict *self, Ident key, unsigned int val);
 
 /**
  * @brief Gibt den Wert zu einem Schlüssel zurück.
@@ -108,7 +115,7 @@ extern unsigned int dictInsert(Dict *self, const char *key, unsigned int val);
  * @return der assoziierte Wert, falls der Schlüssel enthalten ist,
  *         `-1u`, ansonsten
  */
-extern unsigned int dictGet(const Dict *self, const char *key);
+extern unsigned int dictGet(const Dict *self, Ident key);
 
 /**
  * @brief Entfernt eine Schlüssel-/Wert-Assoziation.
@@ -117,6 +124,6 @@ extern unsigned int dictGet(const Dict *self, const char *key);
  * @return der entfernte Wert, falls der Schlüssel enthalten ist,
  *         `-1u`, ansonsten
  */
-extern unsigned int dictRemove(Dict *self, const char *key);
+extern unsigned int dictRemove(Dict *self, Ident key);
 
 #endif /* DICT_H_INCLUDED */
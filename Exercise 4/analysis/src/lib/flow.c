@@ -0,0 +1,360 @@
+/***************************************************************************//**
+ * @file flow.c
+ * @brief Implementation der Datenflussanalysen.
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include "flow.h"
+#include "vec.h"
+
+/* *** internal structures ************************************************** */
+
+/**
+ * @internal
+ * @brief Zustand der Analyse eines Programms.
+ *
+ * Die Felder je `DefId` werden für alle Funktionen gemeinsam verwendet; nach
+ * jeder Funktion ist `assigned` wieder leer.
+ */
+typedef struct {
+	const DefInfo *defs;     /**<@brief Die Definitionstabelle. */
+	unsigned char *assigned; /**<@brief Je `DefId`, ob die Variable sicher zugewiesen ist. */
+	unsigned char *both;     /**<@brief Je `DefId`, ob der erste Zweig einer Verzweigung sie zuweist. */
+	unsigned char *unsafe;   /**<@brief Je `DefId`, ob die Variable ungeschützt gelesen wird, oder `NULL`. */
+	unsigned int *log;       /**<@brief Vektor der zugewiesenen Variablen in ihrer Reihenfolge. */
+	int safe;                /**<@brief Ob die aktuelle Funktion nur geschützt liest. */
+} Flow;
+
+/* *** internal helpers ***************************************************** */
+
+/**
+ * @internal
+ * @brief Legt den Zustand der Analyse für die Definitionstabelle \p tab an.
+ */
+static Flow flowNew(const SymDefTable *tab, unsigned char *unsafe) {
+	unsigned int count = vecLen(tab->definitions);
+	Flow self = {
+		.defs = tab->definitions,
+		.assigned = calloc(count + 1, 1),
+		.both = calloc(count + 1, 1),
+		.unsafe = unsafe
+	};
+	
+	if (self.assigned == NULL || self.both == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	vecInit(self.log);
+	return self;
+}
+
+/**
+ * @internal
+ * @brief Gibt den Zustand der Analyse frei.
+ */
+static void flowRelease(Flow *self) {
+	vecRelease(self->log);
+	free(self->assigned);
+	free(self->both);
+}
+
+/**
+ * @internal
+ * @brief Vermerkt die Zuweisung an \p id, falls es eine lokale Variable ist.
+ */
+static void flowAssign(Flow *self, DefId id) {
+	if (self->defs[id.index].tag == SYM_DEF_LOCAL_VAR && !self->assigned[id.index]) {
+		self->assigned[id.index] = 1;
+		vecPush(self->log) = id.index;
+	}
+}
+
+/**
+ * @internal
+ * @brief Verwirft alle Zuweisungen nach den ersten \p len Einträgen des
+ * Protokolls.
+ */
+static void flowUndo(Flow *self, unsigned int len) {
+	while (vecLen(self->log) > len) {
+		self->assigned[vecPop(self->log)] = 0;
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt die Variablen zurück, die nach den ersten \p len Einträgen des
+ * Protokolls zugewiesen wurden und noch zugewiesen sind.
+ */
+static unsigned int* flowAdded(const Flow *self, unsigned int len) {
+	unsigned int *added;
+	vecInit(added);
+	
+	for (unsigned int i = len; i < vecLen(self->log); ++i) {
+		if (self->assigned[self->log[i]]) { vecPush(added) = self->log[i]; }
+	}
+	
+	return added;
+}
+
+/**
+ * @internal
+ * @brief Gibt zurück, ob ein Ausdruck das Literal `true` ist.
+ */
+static int isTrue(const Expr *expr) {
+	return expr->tag == EXPR_LITERAL && expr->literal.tag == LITERAL_BOOL && expr->literal.bVal;
+}
+
+/**
+ * @internal
+ * @brief Analysiert einen Ausdruck in der Reihenfolge seiner Auswertung.
+ */
+static void flowExpr(Flow *self, const Expr *expr) {
+	switch (expr->tag) {
+	case EXPR_ASSIGN:
+		flowExpr(self, expr->assign.rhs);
+		flowAssign(self, expr->assign.lhs.res);
+		break;
+		
+	case EXPR_BIN_OP: {
+		flowExpr(self, expr->bin_op.lhs);
+		unsigned int len = vecLen(self->log);
+		flowExpr(self, expr->bin_op.rhs);
+		
+		/* the right operand of `&&` and `||` is evaluated conditionally */
+		if (expr->bin_op.op == BIN_OP_LOG_AND || expr->bin_op.op == BIN_OP_LOG_OR) { flowUndo(self, len); }
+		break;
+	}
+	
+	case EXPR_UNARY_MINUS:
+		flowExpr(self, expr->unary_minus);
+		break;
+		
+	case EXPR_CALL:
+		vecForEach(const Expr *arg, expr->call.args) {
+			flowExpr(self, arg);
+		}
+		break;
+		
+	case EXPR_VAR: {
+		unsigned int id = expr->var.res.index;
+		
+		if (self->defs[id].tag == SYM_DEF_LOCAL_VAR && !self->assigned[id]) {
+			self->safe = 0;
+			if (self->unsafe != NULL) { self->unsafe[id] = 1; }
+		}
+		break;
+	}
+	
+	default:
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Analysiert eine Variablendefinition.
+ */
+static void flowVarDef(Flow *self, const VarDef *var_def) {
+	if (var_def->init.tag == EXPR_INVALID) {
+		self->assigned[var_def->res_ident.res.index] = 0;
+	} else {
+		flowExpr(self, &var_def->init);
+		flowAssign(self, var_def->res_ident.res);
+	}
+}
+
+/**
+ * @internal
+ * @brief Analysiert eine Anweisung.
+ *
+ * Schleifenrümpfe und bedingt ausgewertete Operanden werden mit den vor ihnen
+ * sicher zugewiesenen Variablen analysiert, ihre Zuweisungen danach
+ * verworfen. Nach einer Verzweigung gelten die Variablen als zugewiesen, die
+ * jeder fortgesetzte Zweig zuweist.
+ *
+ * @return Ob die Ausführung nach der Anweisung fortgesetzt werden kann.
+ */
+static int flowStmt(Flow *self, const Stmt *stmt) {
+	switch (stmt->tag) {
+	case STMT_IF: {
+		flowExpr(self, &stmt->if_stmt.cond);
+		unsigned int len = vecLen(self->log);
+		int if_true = flowStmt(self, stmt->if_stmt.if_true);
+		unsigned int *added = flowAdded(self, len);
+		
+		flowUndo(self, len);
+		int if_false = flowStmt(self, stmt->if_stmt.if_false);
+		
+		if (if_true && !if_false) {
+			/* only the first branch continues */
+			flowUndo(self, len);
+			
+			vecForEach(const unsigned int *id, added) {
+				flowAssign(self, (DefId) { *id });
+			}
+		} else if (if_true) {
+			/* both branches continue, keep what both of them assign */
+			vecForEach(const unsigned int *id, added) {
+				self->both[*id] = 1;
+			}
+			
+			unsigned int *kept = flowAdded(self, len);
+			flowUndo(self, len);
+			
+			vecForEach(const unsigned int *id, kept) {
+				if (self->both[*id]) { flowAssign(self, (DefId) { *id }); }
+			}
+			
+			vecForEach(const unsigned int *id, added) {
+				self->both[*id] = 0;
+			}
+			
+			vecRelease(kept);
+		}
+		
+		vecRelease(added);
+		return if_true || if_false;
+	}
+	
+	case STMT_FOR: {
+		const ForStmt *for_stmt = &stmt->for_stmt;
+		
+		if (for_stmt->init.tag == FOR_INIT_VAR_DEF) {
+			flowVarDef(self, &for_stmt->init.var_def);
+		} else {
+			flowExpr(self, for_stmt->init.assign.rhs);
+			flowAssign(self, for_stmt->init.assign.lhs.res);
+		}
+		
+		flowExpr(self, &for_stmt->cond);
+		unsigned int len = vecLen(self->log);
+		flowStmt(self, for_stmt->body);
+		flowExpr(self, for_stmt->update.rhs);
+		flowAssign(self, for_stmt->update.lhs.res);
+		flowUndo(self, len);
+		return !isTrue(&for_stmt->cond);
+	}
+	
+	case STMT_WHILE: {
+		flowExpr(self, &stmt->while_stmt.cond);
+		unsigned int len = vecLen(self->log);
+		flowStmt(self, stmt->while_stmt.body);
+		flowUndo(self, len);
+		return !isTrue(&stmt->while_stmt.cond);
+	}
+	
+	case STMT_DO_WHILE: {
+		int next = flowStmt(self, stmt->do_while_stmt.body);
+		flowExpr(self, &stmt->do_while_stmt.cond);
+		return next && !isTrue(&stmt->do_while_stmt.cond);
+	}
+	
+	case STMT_RETURN:
+		flowExpr(self, &stmt->return_stmt);
+		return 0;
+		
+	case STMT_PRINT:
+		vecForEach(const Expr *expr, stmt->print_stmt.expressions) {
+			flowExpr(self, expr);
+		}
+		return 1;
+		
+	case STMT_VAR_DEF:
+		flowVarDef(self, &stmt->var_def);
+		return 1;
+		
+	case STMT_ASSIGN:
+		flowExpr(self, stmt->assign.rhs);
+		flowAssign(self, stmt->assign.lhs.res);
+		return 1;
+		
+	case STMT_CALL:
+		vecForEach(const Expr *arg, stmt->call.args) {
+			flowExpr(self, arg);
+		}
+		return 1;
+		
+	case STMT_BLOCK: {
+		int next = 1;
+		
+		vecForEach(const Stmt *inner, stmt->block.statements) {
+			if (!flowStmt(self, inner)) { next = 0; }
+		}
+		
+		/* the variables of the block go out of scope */
+		vecForEach(const Stmt *inner, stmt->block.statements) {
+			if (inner->tag == STMT_VAR_DEF) { self->assigned[inner->var_def.res_ident.res.index] = 0; }
+		}
+		
+		return next;
+	}
+	
+	default:
+		return 1;
+	}
+}
+
+/**
+ * @internal
+ * @brief Analysiert den Rumpf einer Funktion; ihre Parameter sind zu Beginn
+ * zugewiesen.
+ *
+ * @return Ob die Ausführung das Ende des Rumpfes erreichen kann.
+ */
+static int flowFunc(Flow *self, const FuncInfo *info, const FuncDef *def) {
+	int next = 1;
+	self->safe = 1;
+	
+	for (unsigned int i = 0; i < info->param_count; ++i) {
+		flowAssign(self, info->local_vars[i]);
+	}
+	
+	vecForEach(const Stmt *stmt, def->statements) {
+		if (!flowStmt(self, stmt)) { next = 0; }
+	}
+	
+	flowUndo(self, 0);
+	return next;
+}
+
+/* *** implementation ******************************************************* */
+
+void flowAnalyze(Program *ast, const SymDefTable *tab) {
+	Flow flow = flowNew(tab, NULL);
+	
+	vecForEach(const DefInfo *def, tab->definitions) {
+		if (def->tag != SYM_DEF_FUNC) { continue; }
+		
+		FuncDef *func = &ast->items[def->func.item_id.index].func_def;
+		int next = flowFunc(&flow, &def->func, func);
+		
+		func->flow = (FlowFacts) {
+			.returns = !next || func->return_type == TYPE_VOID,
+			.assigned = flow.safe
+		};
+	}
+	
+	flowRelease(&flow);
+}
+
+unsigned char* flowUnsafeReads(const Program *ast, const SymDefTable *tab) {
+	unsigned char *unsafe = calloc(vecLen(tab->definitions) + 1, 1);
+	
+	if (unsafe == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	Flow flow = flowNew(tab, unsafe);
+	
+	vecForEach(const DefInfo *def, tab->definitions) {
+		if (def->tag != SYM_DEF_FUNC) { continue; }
+		
+		const FuncDef *func = &ast->items[def->func.item_id.index].func_def;
+		if (!func->flow.assigned) { flowFunc(&flow, &def->func, func); }
+	}
+	
+	flowRelease(&flow);
+	return unsafe;
+}
@@ -0,0 +1,65 @@
+/***************************************************************************//**
+ * @file flow.h
+ * @brief Datenflussanalysen auf dem analysierten Syntaxbaum.
+ *
+ * # Überblick
+ *
+ * Die Analyse durchläuft den Rumpf jeder Funktion einmal in der Reihenfolge
+ * seiner Ausführung und verfolgt dabei die Menge der lokalen Variablen, die
+ * auf jedem Pfad zugewiesen wurden:
+ *
+ * - Nach einer Verzweigung gelten die Variablen als zugewiesen, die jeder
+ *   Zweig zuweist, der nicht mit `return` endet.
+ * - Zuweisungen in Schleifenrümpfen und im rechten Operanden von `&&` und
+ *   `||` gelten danach nicht als sicher, da sie nicht ausgeführt werden
+ *   müssen; der Rumpf einer `do while`-Schleife dagegen schon.
+ * - Beim Verlassen eines Blocks verlieren seine Variablen ihre Zuweisung, eine
+ *   Definition ohne Initialisierung beginnt ohne.
+ *
+ * Zugleich wird bestimmt, ob die Ausführung das Ende einer Anweisung
+ * erreichen kann. Da C1 kein `break` kennt, endet eine Schleife mit der
+ * Bedingung `true` nur durch `return`.
+ *
+ * Die Analyse ist konservativ: Sie kann Pfade annehmen, die zur Laufzeit nie
+ * ausgeführt werden, beweist aber nichts Falsches. Ihre Laufzeit ist linear
+ * in der Größe der Funktionsrümpfe, solange Verzweigungen nicht beliebig tief
+ * geschachtelt sind.
+ ******************************************************************************/
+
+#ifndef FLOW_H_INCLUDED
+#define FLOW_H_INCLUDED
+
+/* *** Includes ************************************************************* */
+
+#include "ast.h"
+#include "symtab.h"
+
+/* *** Öffentliche Schnittstelle ******************************************** */
+
+/**
+ * @brief Analysiert alle Funktionen eines Programms und legt die Ergebnisse
+ * in `FuncDef.flow` ab.
+ *
+ * Die Analyse muss nach jeder Veränderung des Syntaxbaumes, etwa durch
+ * `optProgram()`, wiederholt werden.
+ *
+ * @param ast Die Wurzel des abstrakten Syntaxbaumes.
+ * @param tab Die Definitionstabelle des Programms.
+ */
+extern void flowAnalyze(Program *ast, const SymDefTable *tab);
+
+/**
+ * @brief Bestimmt die lokalen Variablen, die an einer Stelle gelesen werden,
+ * an der sie nicht auf jedem Pfad zugewiesen sind.
+ *
+ * Funktionen, für die `flowAnalyze()` bereits `FuncDef.flow.assigned`
+ * bewiesen hat, werden übersprungen.
+ *
+ * @param ast Die Wurzel des abstrakten Syntaxbaumes.
+ * @param tab Die Definitionstabelle des Programms.
+ * @return Ein Feld, das je `DefId` angibt, ob die Variable ungeschützt
+ *         gelesen wird; vom Rufer mit `free()` freizugeben.
+ */
+extern unsigned char* flowUnsafeReads(const Program *ast, const SymDefTable *tab);
+
+#endif
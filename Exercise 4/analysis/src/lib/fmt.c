@@ -0,0 +1,186 @@
+/***************************************************************************//**
+ * @file fmt.c
+ * @brief Implementation der Formatierung von Fließkommawerten.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "fmt.h"
+
+/* *** internal structures ************************************************** */
+
+/** @internal @brief Anzahl signifikanter Stellen der Ausgabe. */
+#define PRECISION 6
+
+/** @internal @brief Größte Zehnerpotenz, die als `double` exakt ist. */
+#define MAX_EXACT_POW10 22
+
+/**
+ * @internal
+ * @brief Mindestabstand des skalierten Wertes von der Mitte zwischen zwei
+ * ganzen Zahlen, ab dem die Rundung trotz des Skalierungsfehlers feststeht.
+ */
+#define TIE_MARGIN 1e-9
+
+/** @internal @brief Die exakt darstellbaren Zehnerpotenzen. */
+static const double POW10[MAX_EXACT_POW10 + 1] = {
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* *** internal helpers ***************************************************** */
+
+/**
+ * @internal
+ * @brief Multipliziert \p value mit `10^k` für `|k| <= 2 * MAX_EXACT_POW10`.
+ *
+ * Negative Exponenten werden durch Division mit der exakten Zehnerpotenz
+ * umgesetzt, so dass jeder Schritt genau einmal rundet.
+ */
+static double scale(double value, int k) {
+	if (k >= 0) {
+		if (k > MAX_EXACT_POW10) {
+			value *= POW10[k - MAX_EXACT_POW10];
+			k = MAX_EXACT_POW10;
+		}
+		
+		return value*POW10[k];
+	}
+	
+	if (-k > MAX_EXACT_POW10) {
+		value /= POW10[-k - MAX_EXACT_POW10];
+		k = -MAX_EXACT_POW10;
+	}
+	
+	return value/POW10[-k];
+}
+
+/**
+ * @internal
+ * @brief Bestimmt die auf `PRECISION` Stellen gerundete Mantisse eines
+ * positiven, endlichen Wertes.
+ *
+ * @param value Der Wert.
+ * @param exp   Nimmt den dezimalen Exponenten der ersten Stelle auf.
+ * @return Die Mantisse in `[100000, 1000000)` oder `0`, falls die Rundung
+ *         nicht sicher bestimmt werden kann.
+ */
+static unsigned long digits(double value, int *exp) {
+	int bin;
+	frexp(value, &bin);
+	
+	/* an estimate that is either exact or one too small */
+	double estimate = (bin - 1)*0.30102999566398120;
+	int dec = (int) estimate;
+	if (dec > estimate) { --dec; }
+	if (dec < -2*MAX_EXACT_POW10 + PRECISION || dec > 2*MAX_EXACT_POW10 + PRECISION - 2) { return 0; }
+	
+	double scaled = scale(value, PRECISION - 1 - dec);
+	
+	if (scaled >= 1e6) {
+		scaled = scale(value, PRECISION - 1 - ++dec);
+	}
+	
+	unsigned long result = (unsigned long) scaled;
+	double frac = scaled - result;
+	
+	if (fabs(frac - 0.5) < TIE_MARGIN) { return 0; }
+	result += frac > 0.5;
+	
+	if (result == 1000000) {
+		result = 100000;
+		++dec;
+	}
+	
+	*exp = dec;
+	return result;
+}
+
+/* *** implementation ******************************************************* */
+
+int fmtFloat(char *buf, double value) {
+	if (value != value || isinf(value)) {
+		const char *text = value != value ? "nan" : value > 0 ? "inf" : "-inf";
+		strcpy(buf, text);
+		return strlen(text);
+	}
+	
+	double original = value;
+	char *out = buf;
+	
+	if (signbit(value)) {
+		*out++ = '-';
+		value = -value;
+	}
+	
+	if (value == 0.0) {
+		*out++ = '0';
+		*out = '\0';
+		return out - buf;
+	}
+	
+	int exp;
+	unsigned long mantissa = digits(value, &exp);
+	
+	if (mantissa == 0) {
+		return snprintf(buf, FMT_FLOAT_SIZE, "%g", original);
+	}
+	
+	/* the significant digits without trailing zeros */
+	char digit[PRECISION];
+	int count = PRECISION;
+	
+	while (mantissa % 10 == 0) {
+		mantissa /= 10;
+		--count;
+	}
+	
+	for (int i = count - 1; i >= 0; --i) {
+		digit[i] = '0' + mantissa % 10;
+		mantissa /= 10;
+	}
+	
+	if (exp < -4 || exp >= PRECISION) {
+		/* scientific notation */
+		*out++ = digit[0];
+		
+		if (count > 1) {
+			*out++ = '.';
+			memcpy(out, digit + 1, count - 1);
+			out += count - 1;
+		}
+		
+		*out++ = 'e';
+		*out++ = exp < 0 ? '-' : '+';
+		if (exp < 0) { exp = -exp; }
+		if (exp >= 100) { *out++ = '0' + exp/100; }
+		*out++ = '0' + exp/10 % 10;
+		*out++ = '0' + exp % 10;
+	} else if (exp >= 0) {
+		/* decimal notation with an integral part */
+		for (int i = 0; i <= exp; ++i) {
+			*out++ = i < count ? digit[i] : '0';
+		}
+		
+		if (count > exp + 1) {
+			*out++ = '.';
+			memcpy(out, digit + exp + 1, count - exp - 1);
+			out += count - exp - 1;
+		}
+	} else {
+		/* decimal notation of a fraction */
+		*out++ = '0';
+		*out++ = '.';
+		
+		for (int i = -1; i > exp; --i) {
+			*out++ = '0';
+		}
+		
+		memcpy(out, digit, count);
+		out += count;
+	}
+	
+	*out = '\0';
+	return out - buf;
+}
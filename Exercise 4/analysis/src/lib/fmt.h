@@ -0,0 +1,42 @@
+/***************************************************************************//**
+ * @file fmt.h
+ * @brief Formatierung von Fließkommawerten für die `print`-Anweisung.
+ *
+ * # Überblick
+ *
+ * `fmtFloat()` erzeugt dieselbe Ausgabe wie `printf("%g")`, also den auf
+ * sechs signifikante Stellen gerundeten Wert ohne abschließende Nullen in
+ * Dezimal- oder wissenschaftlicher Notation, je nachdem welche kürzer ist.
+ * Sonderwerte werden als `nan`, `inf` und `-inf` ausgegeben.
+ *
+ * Statt die Formatierung der C-Bibliothek zu durchlaufen, wird der Wert mit
+ * einer exakten Zehnerpotenz in den Bereich `[100000, 1000000)` skaliert und
+ * auf eine ganze Zahl gerundet. Die Skalierung kostet höchstens zwei
+ * Rundungen und ist damit auf wenige Einheiten der letzten Stelle genau.
+ * Liegt das Ergebnis so nahe an der Mitte zwischen zwei ganzen Zahlen, dass
+ * dieser Fehler die Rundung umkehren könnte, oder liegt der Exponent
+ * außerhalb des Bereiches der exakten Zehnerpotenzen, wird auf `snprintf()`
+ * zurückgegriffen, so dass das Ergebnis stets mit `%g` übereinstimmt.
+ ******************************************************************************/
+
+#ifndef FMT_H_INCLUDED
+#define FMT_H_INCLUDED
+
+/* *** Konstanten *********************************************************** */
+
+/** @brief Puffergröße, die für jeden formatierten Wert ausreicht. */
+#define FMT_FLOAT_SIZE 16
+
+/* *** Öffentliche Schnittstelle ******************************************** */
+
+/**
+ * @brief Formatiert einen Fließkommawert gemäß der Semantik der
+ * `print`-Anweisung.
+ *
+ * @param buf   Der Zielpuffer mit mindestens `FMT_FLOAT_SIZE` Zeichen.
+ * @param value Der zu formatierende Wert.
+ * @return Die Länge der nullterminierten Ausgabe in \p buf.
+ */
+extern int fmtFloat(char *buf, double value);
+
+#endif
@@ -0,0 +1,285 @@
+/***************************************************************************//**
+ * @file intern.c
+ * @brief Implementation der Internalisierung von Zeichenketten.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include "intern.h"
+
+/* *** internal structures ************************************************** */
+
+/** @internal @brief Mindestgröße eines Arenablocks in Bytes. */
+#define BLOCK_SIZE ((size_t) 1 << 16)
+
+/** @internal @brief Anfängliche Anzahl der Bits für die Größe der Hashtabelle. */
+#define TABLE_BITS 10
+
+/** @internal @brief Anfängliche Anzahl der Bits für die Größe eines Zwischenspeichers. */
+#define CACHE_BITS 8
+
+/** @internal @brief Anzahl der Bits für die Anzahl der Einträge eines Abschnitts. */
+#define CHUNK_BITS 12
+
+/** @internal @brief Höchstzahl der Abschnitte. */
+#define MAX_CHUNKS ((size_t) 1 << 14)
+
+/**
+ * @internal
+ * @brief Ein Block der Arena; ein voller Block wird nicht vergrößert,
+ * sondern durch einen neuen ersetzt, damit die Zeichenketten an ihrem Platz
+ * bleiben.
+ */
+typedef struct Block {
+	struct Block *prev; /**<@brief Der vorher belegte Block. */
+	size_t used;        /**<@brief Anzahl belegter Bytes. */
+	size_t size;        /**<@brief Größe von `data` in Bytes. */
+	char data[];        /**<@brief Die abgelegten Zeichenketten. */
+} Block;
+
+/**
+ * @internal
+ * @brief Eine internalisierte Zeichenkette.
+ */
+typedef struct Entry {
+	const char *name; /**<@brief Die Zeichenkette in der Arena. */
+	size_t len;       /**<@brief Die Länge ohne Nullbyte. */
+	uint32_t hash;    /**<@brief Der Hashwert. */
+} Entry;
+
+/**
+ * @internal
+ * @brief Eine offene Hashtabelle von Kennungen, `0` ist frei.
+ */
+typedef struct Table {
+	unsigned int *ids;  /**<@brief Die Plätze der Tabelle. */
+	unsigned int bits;  /**<@brief Anzahl der Bits für die Größe der Tabelle. */
+	unsigned int count; /**<@brief Anzahl der belegten Plätze. */
+} Table;
+
+/**
+ * @internal
+ * @brief Der globale Zustand der Internalisierung.
+ *
+ * Ein Eintrag wird vollständig geschrieben, bevor seine Kennung unter dem
+ * Mutex in die Tabelle eingetragen wird, und danach nicht mehr verändert.
+ */
+static struct {
+	mtx_t lock;                  /**<@brief Schützt alle übrigen Felder außer den Einträgen. */
+	tss_t cache_key;             /**<@brief Gibt den Zwischenspeicher eines Threads bei seinem Ende frei. */
+	Block *arena;                /**<@brief Der aktuelle Arenablock. */
+	Entry *chunks[MAX_CHUNKS];   /**<@brief Die Abschnitte der Einträge, indiziert durch `Ident`. */
+	unsigned int count;          /**<@brief Anzahl der vergebenen Kennungen einschließlich `0`. */
+	Table table;                 /**<@brief Alle Kennungen. */
+} interner;
+
+/** @internal @brief Initialisiert den globalen Zustand genau einmal. */
+static once_flag interner_once = ONCE_FLAG_INIT;
+
+/** @internal @brief Die in diesem Thread bereits gesehenen Kennungen. */
+static _Thread_local Table cache;
+
+/* *** internal helpers ***************************************************** */
+
+/**
+ * @internal
+ * @brief Beendet das Programm mit einer Fehlermeldung, falls \p ptr `NULL` ist.
+ */
+static void* checked(void *ptr) {
+	if (ptr == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	return ptr;
+}
+
+/**
+ * @internal
+ * @brief Hashfunktion FNV-1a von Fowler, Noll und Vo.
+ */
+static uint32_t fnvHash(const char *str, size_t len) {
+	uint32_t hash = 0x811c9dc5u;
+	
+	for (size_t i = 0; i < len; ++i) {
+		hash ^= (unsigned char) str[i];
+		hash *= 0x1000193u;
+	}
+	
+	return hash;
+}
+
+/**
+ * @internal
+ * @brief Gibt den Eintrag einer vergebenen Kennung zurück.
+ */
+static inline const Entry* entryOf(unsigned int id) {
+	return &interner.chunks[id >> CHUNK_BITS][id & ((1u << CHUNK_BITS) - 1)];
+}
+
+/**
+ * @internal
+ * @brief Legt eine Kopie der Zeichenkette nullterminiert in der Arena ab.
+ */
+static const char* arenaCopy(const char *str, size_t len) {
+	Block *block = interner.arena;
+	
+	if (block == NULL || block->size - block->used <= len) {
+		size_t size = len + 1 > BLOCK_SIZE ? len + 1 : BLOCK_SIZE;
+		block = checked(malloc(sizeof(Block) + size));
+		block->prev = interner.arena;
+		block->used = 0;
+		block->size = size;
+		interner.arena = block;
+	}
+	
+	char *copy = block->data + block->used;
+	memcpy(copy, str, len);
+	copy[len] = '\0';
+	block->used += len + 1;
+	return copy;
+}
+
+/**
+ * @internal
+ * @brief Sucht eine Zeichenkette in einer Tabelle.
+ *
+ * @return Die Kennung oder `0`; in \p slot steht dann der freie Platz, an
+ *         dem sie einzutragen ist.
+ */
+static unsigned int tableFind(const Table *self, const char *str, size_t len, uint32_t hash, unsigned int *slot) {
+	unsigned int mask = (1u << self->bits) - 1;
+	unsigned int i = hash & mask, id;
+	
+	/* linear probing; the table is at most three quarters full */
+	for (; (id = self->ids[i]) != 0; i = (i + 1) & mask) {
+		const Entry *entry = entryOf(id);
+		
+		if (entry->hash == hash && entry->len == len && memcmp(entry->name, str, len) == 0) {
+			break;
+		}
+	}
+	
+	*slot = i;
+	return id;
+}
+
+/**
+ * @internal
+ * @brief Verdoppelt eine Tabelle und trägt alle Kennungen neu ein.
+ */
+static void tableGrow(Table *self) {
+	unsigned int *old = self->ids;
+	unsigned int old_size = old != NULL ? 1u << self->bits : 0;
+	
+	++self->bits;
+	unsigned int mask = (1u << self->bits) - 1;
+	self->ids = checked(calloc(mask + 1, sizeof(*self->ids)));
+	
+	for (unsigned int j = 0; j < old_size; ++j) {
+		if (old[j] == 0) { continue; }
+		
+		unsigned int i = entryOf(old[j])->hash & mask;
+		while (self->ids[i] != 0) { i = (i + 1) & mask; }
+		self->ids[i] = old[j];
+	}
+	
+	free(old);
+}
+
+/**
+ * @internal
+ * @brief Trägt eine Kennung an dem von `tableFind()` gelieferten Platz ein.
+ */
+static void tableInsert(Table *self, unsigned int slot, unsigned int id) {
+	self->ids[slot] = id;
+	if (4*++self->count > 3u << self->bits) { tableGrow(self); }
+}
+
+/**
+ * @internal
+ * @brief Gibt den Zwischenspeicher eines beendeten Threads frei.
+ */
+static void cacheRelease(void *ids) {
+	free(ids);
+}
+
+/**
+ * @internal
+ * @brief Legt den globalen Zustand an; die Kennung `0` wird reserviert.
+ */
+static void internInit(void) {
+	if (mtx_init(&interner.lock, mtx_plain) != thrd_success
+		|| tss_create(&interner.cache_key, cacheRelease) != thrd_success) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	interner.chunks[0] = checked(calloc((size_t) 1 << CHUNK_BITS, sizeof(Entry)));
+	interner.count = 1;
+	interner.table.bits = TABLE_BITS - 1;
+	tableGrow(&interner.table);
+}
+
+/**
+ * @internal
+ * @brief Sucht oder vergibt die Kennung einer Zeichenkette in der
+ * gemeinsamen Tabelle; der Aufrufer hält den Mutex.
+ */
+static unsigned int internShared(const char *str, size_t len, uint32_t hash) {
+	unsigned int slot, id = tableFind(&interner.table, str, len, hash, &slot);
+	if (id != 0) { return id; }
+	
+	id = interner.count;
+	size_t chunk = id >> CHUNK_BITS;
+	
+	if (chunk >= MAX_CHUNKS) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	if (interner.chunks[chunk] == NULL) {
+		interner.chunks[chunk] = checked(malloc(sizeof(Entry) << CHUNK_BITS));
+	}
+	
+	interner.chunks[chunk][id & ((1u << CHUNK_BITS) - 1)] = (Entry) { arenaCopy(str, len), len, hash };
+	++interner.count;
+	tableInsert(&interner.table, slot, id);
+	return id;
+}
+
+/* *** implementation ******************************************************* */
+
+Ident internString(const char *str, size_t len) {
+	uint32_t hash = fnvHash(str, len);
+	unsigned int slot, id;
+	
+	if (cache.ids == NULL) {
+		call_once(&interner_once, internInit);
+		cache.bits = CACHE_BITS - 1;
+		tableGrow(&cache);
+		tss_set(interner.cache_key, cache.ids);
+	}
+	
+	if ((id = tableFind(&cache, str, len, hash, &slot)) != 0) {
+		return (Ident) { id };
+	}
+	
+	mtx_lock(&interner.lock);
+	id = internShared(str, len, hash);
+	mtx_unlock(&interner.lock);
+	
+	/* growing replaces the table that is freed at the end of the thread */
+	unsigned int *ids = cache.ids;
+	tableInsert(&cache, slot, id);
+	if (cache.ids != ids) { tss_set(interner.cache_key, cache.ids); }
+	
+	return (Ident) { id };
+}
+
+const char* internName(Ident ident) {
+	return entryOf(ident.index)->name;
+}
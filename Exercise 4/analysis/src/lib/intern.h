@@ -0,0 +1,77 @@
+/***************************************************************************//**
+ * @file intern.h
+ * @brief Globale Internalisierung von Bezeichnern und Zeichenkettenliteralen.
+ *
+ * # Überblick
+ *
+ * Jede verschiedene Zeichenkette wird genau einmal in einer Arena abgelegt
+ * und erhält eine fortlaufende 32-Bit-Kennung (`Ident`). Gleiche Namen haben
+ * dieselbe Kennung, so dass der Vergleich zweier Bezeichner ein Vergleich
+ * ganzer Zahlen ist und AST, Symboltabelle und Wörterbuch keine eigenen
+ * Kopien der Namen anlegen oder freigeben müssen.
+ *
+ * Die Arena besteht aus Blöcken, die nie verschoben werden; der von
+ * `internName()` zurückgegebene Zeiger bleibt daher bis zum Programmende
+ * gültig. Gleiche Zeichenketten liefern denselben Zeiger, was auch für die
+ * Literale von `print` einen Vergleich per Zeiger erlaubt.
+ *
+ * Die Kennung `0` ist ungültig und wird nie vergeben.
+ *
+ * Alle Funktionen dürfen gleichzeitig aus mehreren Threads aufgerufen werden.
+ * Die gemeinsame Tabelle ist durch einen Mutex geschützt; jeder Thread hält
+ * zusätzlich einen eigenen Zwischenspeicher der von ihm gesehenen Kennungen,
+ * so dass wiederholte Bezeichner ohne Sperre aufgelöst werden. Die Einträge
+ * liegen in Abschnitten fester Größe, die nie verschoben werden, daher liest
+ * `internName()` ebenfalls ohne Sperre.
+ ******************************************************************************/
+
+#ifndef INTERN_H_INCLUDED
+#define INTERN_H_INCLUDED
+
+/* *** Includes ************************************************************* */
+
+#include <stddef.h>
+
+/* *** Strukturen *********************************************************** */
+
+/**
+ * @brief Die Kennung einer internalisierten Zeichenkette.
+ */
+typedef struct Ident {
+	unsigned int index;
+} Ident;
+
+/* *** Öffentliche Schnittstelle ******************************************** */
+
+/**
+ * @brief Internalisiert eine Zeichenkette.
+ *
+ * @param str Die Zeichen, die nicht nullterminiert sein müssen.
+ * @param len Die Anzahl der Zeichen.
+ * @return Die Kennung der Zeichenkette, für gleiche Zeichenketten stets
+ *         dieselbe.
+ */
+extern Ident internString(const char *str, size_t len);
+
+/**
+ * @brief Internalisiert ein Zeichenkettenliteral des C-Quelltextes.
+ * @param STR Das Literal, z.B. `"main"`.
+ */
+#define internLiteral(STR) internString(STR, sizeof(STR) - 1)
+
+/**
+ * @brief Gibt die nullterminierte Zeichenkette zu einer Kennung zurück.
+ * @param ident Die Kennung.
+ * @return Die Zeichenkette, die bis zum Programmende gültig ist.
+ */
+extern const char* internName(Ident ident);
+
+/**
+ * @brief Gibt `1` zurück, falls beide Kennungen dieselbe Zeichenkette
+ * bezeichnen, ansonsten `0`.
+ */
+static inline int identEq(Ident a, Ident b) {
+	return a.index == b.index;
+}
+
+#endif
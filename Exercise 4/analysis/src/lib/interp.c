@@ -0,0 +1,781 @@
+/***************************************************************************//**
+ * @file interp.c
+ * @brief Implementation des AST-Interpreters.
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdarg.h>
+#include <limits.h>
+#include <setjmp.h>
+#include <math.h>
+#include <assert.h>
+#include "interp.h"
+#include "flow.h"
+#include "jit.h"
+#include "vec.h"
+
+/* *** internal structures ************************************************** */
+
+/**
+ * @internal
+ * @brief Ergebnis der Ausführung einer Anweisung.
+ */
+typedef enum {
+	FLOW_NEXT,   /**<@brief Fortsetzung mit der nächsten Anweisung. */
+	FLOW_RETURN, /**<@brief Rückkehr aus der aktuellen Funktion. */
+	FLOW_TAIL    /**<@brief Neubeginn der aktuellen Funktion mit neuen Parametern. */
+} Flow;
+
+/**
+ * @internal
+ * @brief Zustand des Interpreters.
+ */
+typedef struct {
+	const Program *ast;     /**<@brief Der ausgeführte Syntaxbaum. */
+	const DefInfo *defs;    /**<@brief Die Definitionstabelle. */
+	Value *globals;         /**<@brief Speicher der globalen Variablen. */
+	Value *stack;           /**<@brief Flacher Speicher aller Stack-Frames. */
+	unsigned int base;      /**<@brief Beginn des aktuellen Stack-Frames. */
+	unsigned int top;       /**<@brief Erster freier Eintrag im Stack. */
+	unsigned int cap;       /**<@brief Kapazität des Stacks. */
+	DefId func;             /**<@brief Die aktuelle Funktion. */
+	DataType ret_type;      /**<@brief Rückgabetyp der aktuellen Funktion. */
+	Value ret;              /**<@brief Rückgabewert der aktuellen Funktion. */
+	Out *out;               /**<@brief Ausgabepuffer für `print`. */
+	const SymDefTable *tab; /**<@brief Die Definitionstabelle für den JIT. */
+	JitEntry *native;       /**<@brief Übersetzte Funktionen je `DefId` oder `NULL` ohne JIT. */
+	unsigned int *calls;    /**<@brief Aufrufzähler je `DefId`. */
+	unsigned int threshold; /**<@brief Aufrufe, nach denen übersetzt wird. */
+	JitCode *jit_code;      /**<@brief Vektor des ausführbaren Speichers. */
+	JitEnv env;             /**<@brief Laufzeitumgebung des übersetzten Codes. */
+	InterpStats stats;      /**<@brief Die Laufzeitstatistik. */
+	int checked;            /**<@brief Ob undefiniertes Verhalten erkannt wird. */
+	unsigned char *guarded; /**<@brief Je `DefId`, ob Lesezugriffe geprüft werden, oder `NULL`. */
+	unsigned int *defined;  /**<@brief Bitvektor der initialisierten Einträge des Stacks. */
+	jmp_buf trap;           /**<@brief Rücksprungziel bei erkanntem undefiniertem Verhalten. */
+} Interp;
+
+/* *** internal helpers ***************************************************** */
+
+/* forward declarations */
+static Value evalExpr(Interp*, const Expr*);
+static Flow execStmts(Interp*, const Stmt*, int);
+
+/**
+ * @internal
+ * @brief Gibt den Speicherort der Variablen zurück, auf die \p id verweist.
+ *
+ * Der Zeiger ist nur bis zum nächsten Funktionsaufruf gültig, da der Stack
+ * dabei vergrößert werden kann.
+ */
+static inline Value* slot(Interp *self, DefId id) {
+	const DefInfo *def = &self->defs[id.index];
+	
+	if (def->tag == SYM_DEF_LOCAL_VAR) {
+		return &self->stack[self->base + def->var.offset];
+	}
+	
+	assert(def->tag == SYM_DEF_GLOBAL_VAR);
+	return &self->globals[def->var.offset];
+}
+
+/**
+ * @internal
+ * @brief Meldet undefiniertes Verhalten in der aktuellen Funktion und bricht
+ * die Ausführung ab.
+ */
+static _Noreturn void trap(Interp *self, const char *format, ...) {
+	va_list args;
+	outFlush(self->out);
+	
+	if (defIdIsInvalid(self->func)) {
+		fputs("Runtime error in global variable initialization: ", stderr);
+	} else {
+		fprintf(stderr, "Runtime error in function '%s': ", internName(self->defs[self->func.index].ident));
+	}
+	
+	va_start(args, format);
+	vfprintf(stderr, format, args);
+	va_end(args);
+	fputc('\n', stderr);
+	longjmp(self->trap, 1);
+}
+
+/**
+ * @internal
+ * @brief Anzahl der Bits eines Wortes im Bitvektor der initialisierten
+ * Einträge.
+ */
+#define WORD_BITS (8*sizeof(unsigned int))
+
+/**
+ * @internal
+ * @brief Markiert den Eintrag \p index des Stacks als initialisiert oder
+ * nicht initialisiert.
+ */
+static inline void setDefined(Interp *self, unsigned int index, int defined) {
+	if (defined) {
+		self->defined[index / WORD_BITS] |= 1u << (index % WORD_BITS);
+	} else {
+		self->defined[index / WORD_BITS] &= ~(1u << (index % WORD_BITS));
+	}
+}
+
+/**
+ * @internal
+ * @brief Vermerkt, ob die lokale Variable \p id des aktuellen Frames
+ * initialisiert ist, falls ihre Lesezugriffe geprüft werden.
+ */
+static inline void markDefined(Interp *self, DefId id, int defined) {
+	if (self->guarded != NULL && self->guarded[id.index]) {
+		setDefined(self, self->base + self->defs[id.index].var.offset, defined);
+	}
+}
+
+/**
+ * @internal
+ * @brief Meldet das Lesen einer nicht initialisierten lokalen Variablen, deren
+ * Lesezugriffe geprüft werden.
+ */
+static inline void checkDefined(Interp *self, const ResIdent *var) {
+	unsigned int index = self->base + self->defs[var->res.index].var.offset;
+	
+	if (!(self->defined[index / WORD_BITS] >> (index % WORD_BITS) & 1u)) {
+		trap(self, "read of uninitialized variable '%s'", internName(var->ident));
+	}
+}
+
+/**
+ * @internal
+ * @brief Wandelt einen Wert implizit von \p from nach \p to um.
+ */
+static inline Value convert(Value value, DataType from, DataType to) {
+	if (from == TYPE_INT && to == TYPE_FLOAT) {
+		value.f = value.i;
+	}
+	
+	return value;
+}
+
+/**
+ * @internal
+ * @brief Reserviert einen neuen Stack-Frame mit \p size Einträgen und gibt
+ * dessen Beginn zurück.
+ */
+static unsigned int frameReserve(Interp *self, unsigned int size) {
+	unsigned int frame = self->top;
+	
+	if (self->top + size > self->cap) {
+		while (self->top + size > self->cap) {
+			self->cap = self->cap ? 2*self->cap : 256;
+		}
+		
+		self->stack = realloc(self->stack, self->cap*sizeof(*self->stack));
+		if (self->stack == NULL) {
+			fputs("out-of-memory error\n", stderr);
+			exit(-1);
+		}
+		
+		if (self->guarded != NULL) {
+			self->defined = realloc(self->defined, (self->cap / WORD_BITS + 1)*sizeof(unsigned int));
+			if (self->defined == NULL) {
+				fputs("out-of-memory error\n", stderr);
+				exit(-1);
+			}
+		}
+	}
+	
+	/* a new frame starts without initialized variables */
+	if (self->guarded != NULL) {
+		for (unsigned int i = frame; i < frame + size; ++i) {
+			setDefined(self, i, 0);
+		}
+	}
+	
+	self->top += size;
+	return frame;
+}
+
+/**
+ * @internal
+ * @brief Führt die Funktion \p id aus, deren Argumente bereits am Beginn des
+ * Frames \p frame liegen, und gibt ihren Rückgabewert zurück.
+ *
+ * Ist der JIT aktiv, wird die Funktion übersetzt, sobald ihr Aufrufzähler den
+ * Schwellwert überschreitet, und fortan als Maschinencode ausgeführt.
+ */
+static Value invokeFunc(Interp *self, DefId id, unsigned int frame) {
+	const FuncInfo *func = &self->defs[id.index].func;
+	const FuncDef *def = &self->ast->items[func->item_id.index].func_def;
+	++self->stats.calls;
+	
+	if (self->native != NULL) {
+		if (self->native[id.index] == NULL && self->calls[id.index]++ == self->threshold) {
+			JitCode code;
+			self->native[id.index] = jitCompile(self->ast, self->tab, id, &self->env, &code);
+			vecPush(self->jit_code) = code;
+		}
+		
+		if (self->native[id.index] != NULL) {
+			Value result = self->native[id.index](&self->stack[frame]);
+			self->top = frame;
+			return result;
+		}
+	}
+	
+	unsigned int base = self->base;
+	DefId caller = self->func;
+	DataType ret_type = self->ret_type;
+	self->base = frame;
+	self->func = id;
+	self->ret_type = func->return_type;
+	
+	/* a tail call has replaced the parameters in the frame */
+	Flow flow;
+	while ((flow = execStmts(self, def->statements, 1)) == FLOW_TAIL) {}
+	
+	/* only functions the flow analysis could not prove are checked */
+	if (flow == FLOW_NEXT && self->checked && !def->flow.returns && func->return_type != TYPE_VOID) {
+		trap(self, "missing return");
+	}
+	
+	self->base = base;
+	self->func = caller;
+	self->ret_type = ret_type;
+	self->top = frame;
+	return self->ret;
+}
+
+/**
+ * @internal
+ * @brief Ruft eine Funktion mit den übergebenen Argumenten auf und gibt ihren
+ * Rückgabewert zurück.
+ *
+ * Die Argumente werden von links nach rechts im Kontext des Rufers berechnet
+ * und direkt in die Parameter des neuen Frames geschrieben.
+ */
+static Value callFunc(Interp *self, DefId id, const Expr *args) {
+	const FuncInfo *func = &self->defs[id.index].func;
+	const FuncDef *def = &self->ast->items[func->item_id.index].func_def;
+	unsigned int frame = frameReserve(self, vecLen(func->local_vars));
+	
+	for (unsigned int i = 0; i < func->param_count; ++i) {
+		Value arg = evalExpr(self, &args[i]);
+		self->stack[frame + i] = convert(arg, args[i].data_type, def->params[i].data_type);
+	}
+	
+	return invokeFunc(self, id, frame);
+}
+
+/**
+ * @internal
+ * @brief Gibt zurück, ob \p call die aktuelle Funktion aufruft.
+ */
+static inline int isSelfCall(const Interp *self, const FuncCall *call) {
+	return call->res_ident.res.index == self->func.index;
+}
+
+/**
+ * @internal
+ * @brief Führt einen Selbstaufruf in Endposition als Sprung aus.
+ *
+ * Die Argumente werden wie bei `callFunc()` von links nach rechts berechnet,
+ * aber zunächst oberhalb des Frames abgelegt, da sie noch die alten Parameter
+ * lesen dürfen. Danach ersetzen sie die Parameter des aktuellen Frames, der
+ * für den erneuten Durchlauf des Rumpfes wiederverwendet wird.
+ */
+static Flow tailCall(Interp *self, const FuncCall *call) {
+	const FuncInfo *func = &self->defs[self->func.index].func;
+	const FuncDef *def = &self->ast->items[func->item_id.index].func_def;
+	unsigned int top = self->top;
+	unsigned int args = frameReserve(self, func->param_count);
+	
+	for (unsigned int i = 0; i < func->param_count; ++i) {
+		Value arg = evalExpr(self, &call->args[i]);
+		self->stack[args + i] = convert(arg, call->args[i].data_type, def->params[i].data_type);
+	}
+	
+	for (unsigned int i = 0; i < func->param_count; ++i) {
+		self->stack[self->base + i] = self->stack[args + i];
+	}
+	
+	/* the body starts again with only the parameters initialized */
+	if (self->guarded != NULL) {
+		for (unsigned int i = self->base + func->param_count; i < self->base + vecLen(func->local_vars); ++i) {
+			setDefined(self, i, 0);
+		}
+	}
+	
+	self->top = top;
+	++self->stats.tail_calls;
+	return FLOW_TAIL;
+}
+
+/**
+ * @internal
+ * @brief Rückruffunktion des JIT für Funktionsaufrufe.
+ *
+ * Die Argumente liegen in umgekehrter Reihenfolge vor.
+ */
+static Value jitCall(void *ctx, unsigned int func, const Value *args) {
+	Interp *self = ctx;
+	const FuncInfo *info = &self->defs[func].func;
+	unsigned int frame = frameReserve(self, vecLen(info->local_vars));
+	
+	for (unsigned int i = 0; i < info->param_count; ++i) {
+		self->stack[frame + i] = args[info->param_count - 1 - i];
+	}
+	
+	return invokeFunc(self, (DefId) { func }, frame);
+}
+
+/**
+ * @internal
+ * @brief Rückruffunktion des JIT für die Ausgabe eines Wertes.
+ */
+static void jitPrint(void *ctx, Value value, DataType type) {
+	interpValuePrint(value, type, ((Interp*) ctx)->out);
+}
+
+/**
+ * @internal
+ * @brief Rückruffunktion des JIT für das Ende einer Ausgabe.
+ */
+static void jitNewline(void *ctx) {
+	outChar(((Interp*) ctx)->out, '\n');
+}
+
+/**
+ * @internal
+ * @brief Führt eine Zuweisung aus und gibt den zugewiesenen Wert zurück.
+ */
+static Value execAssign(Interp *self, const Assign *assign) {
+	Value value = evalExpr(self, assign->rhs);
+	const VarInfo *var = &self->defs[assign->lhs.res.index].var;
+	
+	value = convert(value, assign->rhs->data_type, var->data_type);
+	*slot(self, assign->lhs.res) = value;
+	markDefined(self, assign->lhs.res, 1);
+	return value;
+}
+
+/**
+ * @internal
+ * @brief Führt eine Variablendefinition aus.
+ */
+static void execVarDef(Interp *self, const VarDef *var_def) {
+	if (var_def->init.tag == EXPR_INVALID) {
+		markDefined(self, var_def->res_ident.res, 0);
+		return;
+	}
+	
+	Value value = evalExpr(self, &var_def->init);
+	*slot(self, var_def->res_ident.res) = convert(value, var_def->init.data_type, var_def->data_type);
+	markDefined(self, var_def->res_ident.res, 1);
+}
+
+/**
+ * @internal
+ * @brief Markiert die in einem Block definierten Variablen beim Verlassen
+ * des Blocks als nicht initialisiert.
+ */
+static void leaveScope(Interp *self, const Stmt *stmts) {
+	vecForEach(const Stmt *stmt, stmts) {
+		if (stmt->tag == STMT_VAR_DEF) { markDefined(self, stmt->var_def.res_ident.res, 0); }
+	}
+}
+
+/**
+ * @internal
+ * @brief Berechnet eine arithmetische Operation auf `int` und meldet dabei
+ * Überläufe und Divisionen durch `0`.
+ */
+static Value evalChecked(Interp *self, BinOp op, int lhs, int rhs) {
+	Value result;
+	
+	switch (op) {
+	case BIN_OP_ADD:
+		if (__builtin_add_overflow(lhs, rhs, &result.i)) { trap(self, "integer overflow in '+'"); }
+		break;
+		
+	case BIN_OP_SUB:
+		if (__builtin_sub_overflow(lhs, rhs, &result.i)) { trap(self, "integer overflow in '-'"); }
+		break;
+		
+	case BIN_OP_MUL:
+		if (__builtin_mul_overflow(lhs, rhs, &result.i)) { trap(self, "integer overflow in '*'"); }
+		break;
+		
+	default:
+		assert(op == BIN_OP_DIV);
+		if (rhs == 0) { trap(self, "integer division by zero"); }
+		if (lhs == INT_MIN && rhs == -1) { trap(self, "integer overflow in '/'"); }
+		result.i = lhs / rhs;
+		break;
+	}
+	
+	return result;
+}
+
+/**
+ * @internal
+ * @brief Berechnet eine binäre Operation.
+ *
+ * Logische Operationen werten ihren rechten Operanden wie in C nur bei Bedarf
+ * aus. Arithmetik auf `int` wird über vorzeichenlose Operationen berechnet, so
+ * dass ein Überlauf in C1 kein undefiniertes Verhalten im Interpreter auslöst;
+ * im geprüften Modus wird er stattdessen gemeldet.
+ */
+static Value evalBinOp(Interp *self, const Expr *expr) {
+	const BinOpExpr *bin = &expr->bin_op;
+	Value lhs, rhs, result;
+	
+	switch (bin->op) {
+	case BIN_OP_LOG_OR:
+		result.i = evalExpr(self, bin->lhs).i || evalExpr(self, bin->rhs).i;
+		return result;
+		
+	case BIN_OP_LOG_AND:
+		result.i = evalExpr(self, bin->lhs).i && evalExpr(self, bin->rhs).i;
+		return result;
+		
+	default:
+		break;
+	}
+	
+	lhs = evalExpr(self, bin->lhs);
+	rhs = evalExpr(self, bin->rhs);
+	
+	/* Operationen auf Fließkommazahlen, sobald ein Operand `float` ist */
+	if (bin->lhs->data_type == TYPE_FLOAT || bin->rhs->data_type == TYPE_FLOAT) {
+		lhs = convert(lhs, bin->lhs->data_type, TYPE_FLOAT);
+		rhs = convert(rhs, bin->rhs->data_type, TYPE_FLOAT);
+		
+		switch (bin->op) {
+		case BIN_OP_ADD: result.f = lhs.f + rhs.f; break;
+		case BIN_OP_SUB: result.f = lhs.f - rhs.f; break;
+		case BIN_OP_MUL: result.f = lhs.f * rhs.f; break;
+		case BIN_OP_DIV: result.f = lhs.f / rhs.f; break;
+		case BIN_OP_EQ:  result.i = lhs.f == rhs.f; break;
+		case BIN_OP_NEQ: result.i = lhs.f != rhs.f; break;
+		case BIN_OP_LT:  result.i = lhs.f < rhs.f; break;
+		case BIN_OP_GT:  result.i = lhs.f > rhs.f; break;
+		case BIN_OP_LEQ: result.i = lhs.f <= rhs.f; break;
+		case BIN_OP_GEQ: result.i = lhs.f >= rhs.f; break;
+		default: assert(0); result.i = 0; break;
+		}
+		
+		return result;
+	}
+	
+	if (self->checked && bin->op <= BIN_OP_DIV) {
+		return evalChecked(self, bin->op, lhs.i, rhs.i);
+	}
+	
+	switch (bin->op) {
+	case BIN_OP_ADD: result.i = (int) ((unsigned int) lhs.i + (unsigned int) rhs.i); break;
+	case BIN_OP_SUB: result.i = (int) ((unsigned int) lhs.i - (unsigned int) rhs.i); break;
+	case BIN_OP_MUL: result.i = (int) ((unsigned int) lhs.i * (unsigned int) rhs.i); break;
+	case BIN_OP_DIV: result.i = lhs.i / rhs.i; break;
+	case BIN_OP_EQ:  result.i = lhs.i == rhs.i; break;
+	case BIN_OP_NEQ: result.i = lhs.i != rhs.i; break;
+	case BIN_OP_LT:  result.i = lhs.i < rhs.i; break;
+	case BIN_OP_GT:  result.i = lhs.i > rhs.i; break;
+	case BIN_OP_LEQ: result.i = lhs.i <= rhs.i; break;
+	case BIN_OP_GEQ: result.i = lhs.i >= rhs.i; break;
+	default: assert(0); result.i = 0; break;
+	}
+	
+	return result;
+}
+
+/**
+ * @internal
+ * @brief Berechnet den Wert eines Ausdrucks.
+ */
+static Value evalExpr(Interp *self, const Expr *expr) {
+	Value result;
+	++self->stats.evals;
+	
+	switch (expr->tag) {
+	case EXPR_ASSIGN:
+		return execAssign(self, &expr->assign);
+		
+	case EXPR_BIN_OP:
+		return evalBinOp(self, expr);
+		
+	case EXPR_UNARY_MINUS:
+		result = evalExpr(self, expr->unary_minus);
+		
+		if (expr->data_type == TYPE_FLOAT) {
+			result.f = -result.f;
+		} else if (self->checked && result.i == INT_MIN) {
+			trap(self, "integer overflow in unary '-'");
+		} else {
+			result.i = (int) (0u - (unsigned int) result.i);
+		}
+		
+		return result;
+		
+	case EXPR_CALL:
+		return callFunc(self, expr->call.res_ident.res, expr->call.args);
+		
+	case EXPR_LITERAL:
+		switch (expr->literal.tag) {
+		case LITERAL_INT:    result.i = expr->literal.iVal; break;
+		case LITERAL_FLOAT:  result.f = expr->literal.fVal; break;
+		case LITERAL_BOOL:   result.i = expr->literal.bVal; break;
+		case LITERAL_STRING: result.s = expr->literal.sVal; break;
+		}
+		
+		return result;
+		
+	case EXPR_VAR:
+		if (self->guarded != NULL && self->guarded[expr->var.res.index]) { checkDefined(self, &expr->var); }
+		return *slot(self, expr->var.res);
+		
+	case EXPR_INVALID:
+		break;
+	}
+	
+	assert(0);
+	result.i = 0;
+	return result;
+}
+
+/**
+ * @internal
+ * @brief Führt eine Anweisung aus.
+ *
+ * \p tail gibt an, ob die Anweisung in Endposition der Funktion steht, nach
+ * ihr also keine weitere Anweisung der Funktion ausgeführt wird. Ein
+ * Selbstaufruf als Rückgabewert oder als Anweisung in Endposition einer
+ * `void`-Funktion wird dann als Sprung an den Beginn der Funktion ausgeführt,
+ * so dass endrekursive Funktionen mit konstantem Stack auskommen.
+ */
+static Flow execStmt(Interp *self, const Stmt *stmt, int tail) {
+	switch (stmt->tag) {
+	case STMT_EMPTY:
+		break;
+		
+	case STMT_IF:
+		return execStmt(self, evalExpr(self, &stmt->if_stmt.cond).i
+			? stmt->if_stmt.if_true
+			: stmt->if_stmt.if_false, tail);
+			
+	case STMT_FOR: {
+		const ForStmt *for_stmt = &stmt->for_stmt;
+		
+		if (for_stmt->init.tag == FOR_INIT_VAR_DEF) {
+			execVarDef(self, &for_stmt->init.var_def);
+		} else {
+			execAssign(self, &for_stmt->init.assign);
+		}
+		
+		while (evalExpr(self, &for_stmt->cond).i) {
+			Flow flow = execStmt(self, for_stmt->body, 0);
+			if (flow != FLOW_NEXT) { return flow; }
+			execAssign(self, &for_stmt->update);
+		}
+		break;
+	}
+	
+	case STMT_WHILE:
+		while (evalExpr(self, &stmt->while_stmt.cond).i) {
+			Flow flow = execStmt(self, stmt->while_stmt.body, 0);
+			if (flow != FLOW_NEXT) { return flow; }
+		}
+		break;
+		
+	case STMT_DO_WHILE:
+		do {
+			Flow flow = execStmt(self, stmt->do_while_stmt.body, 0);
+			if (flow != FLOW_NEXT) { return flow; }
+		} while (evalExpr(self, &stmt->do_while_stmt.cond).i);
+		break;
+		
+	case STMT_RETURN:
+		if (stmt->return_stmt.tag == EXPR_CALL && isSelfCall(self, &stmt->return_stmt.call)) {
+			++self->stats.evals;
+			return tailCall(self, &stmt->return_stmt.call);
+		}
+		
+		if (stmt->return_stmt.tag != EXPR_INVALID) {
+			Value value = evalExpr(self, &stmt->return_stmt);
+			self->ret = convert(value, stmt->return_stmt.data_type, self->ret_type);
+		}
+		return FLOW_RETURN;
+		
+	case STMT_PRINT:
+		vecForEach(const Expr *expr, stmt->print_stmt.expressions) {
+			interpValuePrint(evalExpr(self, expr), expr->data_type, self->out);
+		}
+		outChar(self->out, '\n');
+		break;
+		
+	case STMT_VAR_DEF:
+		execVarDef(self, &stmt->var_def);
+		break;
+		
+	case STMT_ASSIGN:
+		execAssign(self, &stmt->assign);
+		break;
+		
+	case STMT_CALL:
+		/* a discarded result must not become the one of a non-void function */
+		if (tail && self->ret_type == TYPE_VOID && isSelfCall(self, &stmt->call)) {
+			return tailCall(self, &stmt->call);
+		}
+		
+		callFunc(self, stmt->call.res_ident.res, stmt->call.args);
+		break;
+		
+	case STMT_BLOCK: {
+		Flow flow = execStmts(self, stmt->block.statements, tail);
+		if (self->guarded != NULL) { leaveScope(self, stmt->block.statements); }
+		return flow;
+	}
+	}
+	
+	return FLOW_NEXT;
+}
+
+/**
+ * @internal
+ * @brief Führt eine Liste von Anweisungen der Reihe nach aus; nur die letzte
+ * erbt die Endposition \p tail.
+ */
+static Flow execStmts(Interp *self, const Stmt *stmts, int tail) {
+	unsigned int count = vecLen(stmts);
+	
+	for (unsigned int i = 0; i < count; ++i) {
+		Flow flow = execStmt(self, &stmts[i], tail && i + 1 == count);
+		if (flow != FLOW_NEXT) { return flow; }
+	}
+	
+	return FLOW_NEXT;
+}
+
+/* *** implementation ******************************************************* */
+
+/**
+ * @internal
+ * @brief Initialisiert die globalen Variablen und ruft `main()` auf.
+ *
+ * Das Rücksprungziel für erkanntes undefiniertes Verhalten wird hier gesetzt,
+ * damit der Zustand in \p self nach dem Rücksprung gültig bleibt.
+ *
+ * @return Ob das Programm ohne undefiniertes Verhalten beendet wurde.
+ */
+static int interpMain(Interp *self) {
+	if (setjmp(self->trap) != 0) { return 0; }
+	
+	/* initialize the global variables in the order of their declaration */
+	vecForEach(const Item *item, self->ast->items) {
+		if (item->tag == ITEM_GLOBAL_VAR) {
+			execVarDef(self, &item->var_def);
+		}
+	}
+	
+	callFunc(self, self->tab->main_func, NULL);
+	return 1;
+}
+
+/**
+ * @internal
+ * @brief Führt ein Programm aus; \p jit gibt an, ob übersetzt werden darf,
+ * \p checked, ob undefiniertes Verhalten der Arithmetik erkannt wird.
+ *
+ * Die Laufzeitstatistik wird in \p stats abgelegt, falls es nicht `NULL` ist.
+ *
+ * @return Ob das Programm ohne undefiniertes Verhalten beendet wurde.
+ */
+static int interpExecute(const Program *ast, const SymDefTable *tab, Out *out, int jit, unsigned int threshold, int checked, InterpStats *stats) {
+	Interp self = {
+		.ast = ast,
+		.defs = tab->definitions,
+		.globals = calloc(tab->global_count + 1, sizeof(Value)),
+		.func = INVALID_DEF_ID,
+		.ret_type = TYPE_VOID,
+		.out = out,
+		.tab = tab,
+		.threshold = threshold,
+		.checked = checked,
+		.guarded = checked ? flowUnsafeReads(ast, tab) : NULL
+	};
+	
+	if (self.globals == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	if (jit && jitAvailable()) {
+		self.native = calloc(vecLen(tab->definitions) + 1, sizeof(JitEntry));
+		self.calls = calloc(vecLen(tab->definitions) + 1, sizeof(unsigned int));
+		self.env = (JitEnv) { &self, self.globals, jitCall, jitPrint, jitNewline };
+		
+		if (self.native == NULL || self.calls == NULL) {
+			fputs("out-of-memory error\n", stderr);
+			exit(-1);
+		}
+	}
+	
+	int ok = interpMain(&self);
+	
+	vecForEach(JitCode *code, self.jit_code) {
+		jitRelease(code);
+	}
+	
+	vecRelease(self.jit_code);
+	free(self.native);
+	free(self.calls);
+	free(self.globals);
+	free(self.stack);
+	free(self.guarded);
+	free(self.defined);
+	
+	if (stats != NULL) {
+		*stats = self.stats;
+	}
+	
+	return ok;
+}
+
+void interpRun(const Program *ast, const SymDefTable *tab, Out *out) {
+	interpExecute(ast, tab, out, 0, 0, 0, NULL);
+}
+
+void interpRunCounted(const Program *ast, const SymDefTable *tab, Out *out, InterpStats *stats) {
+	interpExecute(ast, tab, out, 0, 0, 0, stats);
+}
+
+int interpRunChecked(const Program *ast, const SymDefTable *tab, Out *out, InterpStats *stats) {
+	return interpExecute(ast, tab, out, 0, 0, 1, stats);
+}
+
+void interpRunJit(const Program *ast, const SymDefTable *tab, Out *out, unsigned int threshold) {
+	interpExecute(ast, tab, out, 1, threshold, 0, NULL);
+}
+
+void interpValuePrint(Value value, DataType type, Out *out) {
+	switch (type) {
+	case TYPE_BOOL:
+		outString(out, value.i ? "true" : "false");
+		break;
+		
+	case TYPE_INT:
+		outInt(out, value.i);
+		break;
+		
+	case TYPE_FLOAT:
+		outFloat(out, value.f);
+		break;
+		
+	case TYPE_STRING:
+		outString(out, value.s);
+		break;
+		
+	case TYPE_VOID:
+		break;
+	}
+}
@@ -0,0 +1,147 @@
+/***************************************************************************//**
+ * @file interp.h
+ * @brief Schnittstelle des AST-Interpreters für C1.
+ *
+ * # Überblick
+ *
+ * Der Interpreter führt ein analysiertes Programm direkt auf dem abstrakten
+ * Syntaxbaum aus. Variablenzugriffe laufen ausschließlich über die während der
+ * Analyse aufgelösten `DefId`s und die daraus abgeleiteten Speicherorte:
+ *
+ * - Globale Variablen liegen in einem Feld mit `SymDefTable.global_count`
+ *   Einträgen und werden über `VarInfo.offset` indiziert.
+ * - Lokale Variablen (einschließlich Parameter) liegen in einem flachen
+ *   Stack-Frame, dessen Größe der Anzahl der Einträge in
+ *   `FuncInfo.local_vars` entspricht. Die ersten `FuncInfo.param_count`
+ *   Einträge des Frames sind die Parameter.
+ *
+ * Zur Laufzeit finden somit keine Namensauflösungen mehr statt.
+ *
+ * Ruft sich eine Funktion in `return` oder als letzte Anweisung ihres Rumpfes
+ * selbst auf, wird kein neuer Frame angelegt: Die Argumente ersetzen die
+ * Parameter des aktuellen Frames und der Rumpf beginnt von vorn. Endrekursive
+ * Funktionen benötigen daher unabhängig von der Rekursionstiefe nur einen
+ * Frame und keinen Stack des Interpreters selbst.
+ ******************************************************************************/
+
+#ifndef INTERP_H_INCLUDED
+#define INTERP_H_INCLUDED
+
+/* *** Includes ************************************************************* */
+
+#include <stdio.h>
+#include "out.h"
+#include "ast.h"
+#include "symtab.h"
+
+/* *** Strukturen *********************************************************** */
+
+/**
+ * @brief Ein Laufzeitwert von C1.
+ *
+ * Der Wert trägt keine Typinformation; welche Variante gültig ist, ergibt sich
+ * aus dem statischen Datentyp des erzeugenden Ausdrucks. Boolesche Werte
+ * werden als `0` oder `1` in `i` abgelegt.
+ */
+typedef union Value {
+	int i;         /**<@brief Wert für `int` und `bool`. */
+	double f;      /**<@brief Wert für `float`. */
+	const char *s; /**<@brief Wert für Zeichenkettenliterale. */
+} Value;
+
+/**
+ * @brief Laufzeitstatistik einer Ausführung.
+ */
+typedef struct InterpStats {
+	unsigned long long evals;      /**<@brief Anzahl ausgewerteter Ausdrucksknoten. */
+	unsigned long long calls;      /**<@brief Anzahl ausgeführter Funktionsaufrufe. */
+	unsigned long long tail_calls; /**<@brief Anzahl als Sprung ausgeführter Selbstaufrufe. */
+} InterpStats;
+
+/* *** Öffentliche Schnittstelle ******************************************** */
+
+/**
+ * @brief Führt ein semantisch analysiertes Programm aus.
+ *
+ * Zunächst werden alle globalen Variablen mit Initialisierungsausdruck in der
+ * Reihenfolge ihrer Deklaration initialisiert, danach wird `main()` gerufen.
+ *
+ * @param ast Die Wurzel des abstrakten Syntaxbaumes.
+ * @param tab Die Definitionstabelle des Programms.
+ * @param out Der Ausgabepuffer für die `print`-Anweisung.
+ */
+extern void interpRun(const Program *ast, const SymDefTable *tab, Out *out);
+
+/**
+ * @brief Führt ein semantisch analysiertes Programm aus und zählt dabei die
+ * ausgewerteten Ausdrucksknoten und Funktionsaufrufe.
+ *
+ * Die Zähler sind ein vom Rechner unabhängiges Maß für die Arbeit des
+ * Interpreters, an dem sich Optimierungen des Syntaxbaumes vergleichen lassen.
+ *
+ * @param ast   Die Wurzel des abstrakten Syntaxbaumes.
+ * @param tab   Die Definitionstabelle des Programms.
+ * @param out   Der Ausgabepuffer für die `print`-Anweisung.
+ * @param stats Nimmt die Laufzeitstatistik auf.
+ */
+extern void interpRunCounted(const Program *ast, const SymDefTable *tab, Out *out, InterpStats *stats);
+
+/**
+ * @brief Führt ein semantisch analysiertes Programm aus und erkennt dabei
+ * undefiniertes Verhalten der Ganzzahlarithmetik, das Lesen nicht
+ * initialisierter lokaler Variablen und das Erreichen des Endes einer
+ * Funktion mit Rückgabewert.
+ *
+ * Addition, Subtraktion, Multiplikation und Negation auf `int` werden auf
+ * Überlauf geprüft, Divisionen zusätzlich auf den Divisor `0` und auf
+ * `INT_MIN / -1`.
+ *
+ * Für lokale Variablen führt der Interpreter einen Bitvektor parallel zum
+ * Stack, in dem jeder Frame ab seinem Beginn ein Bit je `VarInfo.offset`
+ * belegt. Definitionen mit Initialisierung und Zuweisungen setzen das Bit,
+ * Definitionen ohne Initialisierung und das Verlassen des umgebenden Blocks
+ * löschen es. Geprüft werden nur Variablen, die `flowUnsafeReads()` nicht auf
+ * jedem Pfad vor dem Lesen zugewiesen findet, und nur Funktionen, für die
+ * `flowAnalyze()` die Ergebnisse `FuncDef.flow` nicht bereits bewiesen hat.
+ * Ohne vorherigen Aufruf von `flowAnalyze()` wird alles geprüft.
+ *
+ * Im ersten Fall undefinierten Verhaltens wird die Ausgabe in \p out
+ * geleert, eine Meldung mit der betroffenen Funktion und gegebenenfalls
+ * Variablen auf `stderr` ausgegeben und die Ausführung abgebrochen. Die
+ * übrigen Ausführungsfunktionen verzichten auf diese Prüfungen.
+ *
+ * @param ast   Die Wurzel des abstrakten Syntaxbaumes.
+ * @param tab   Die Definitionstabelle des Programms.
+ * @param out   Der Ausgabepuffer für die `print`-Anweisung.
+ * @param stats Nimmt die Laufzeitstatistik auf oder `NULL`.
+ * @return `1`, falls das Programm vollständig ausgeführt wurde, `0` nach
+ *         erkanntem undefiniertem Verhalten.
+ */
+extern int interpRunChecked(const Program *ast, const SymDefTable *tab, Out *out, InterpStats *stats);
+
+/**
+ * @brief Führt ein semantisch analysiertes Programm aus und übersetzt häufig
+ * gerufene Funktionen mit dem JIT (siehe `jit.h`).
+ *
+ * Jede Funktion besitzt einen Aufrufzähler. Überschreitet dieser
+ * \p threshold, wird die Funktion in Maschinencode übersetzt und fortan
+ * direkt ausgeführt; bei \p threshold gleich 0 bereits beim ersten Aufruf.
+ * Bis dahin, und auf Plattformen ohne JIT immer, wird sie interpretiert.
+ *
+ * @param ast       Die Wurzel des abstrakten Syntaxbaumes.
+ * @param tab       Die Definitionstabelle des Programms.
+ * @param out       Der Ausgabepuffer für die `print`-Anweisung.
+ * @param threshold Die Anzahl interpretierter Aufrufe vor der Übersetzung.
+ */
+extern void interpRunJit(const Program *ast, const SymDefTable *tab, Out *out, unsigned int threshold);
+
+/**
+ * @brief Gibt einen Laufzeitwert gemäß der Semantik der `print`-Anweisung aus.
+ *
+ * @param value Der auszugebende Wert.
+ * @param type  Der statische Datentyp des Wertes.
+ * @param out   Der Ausgabepuffer.
+ */
+extern void interpValuePrint(Value value, DataType type, Out *out);
+
+#endif
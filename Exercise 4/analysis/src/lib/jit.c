@@ -0,0 +1,629 @@
+/***************************************************************************//**
+ * @file jit.c
+ * @brief Implementation des Template-JIT für Linux x86-64.
+ ******************************************************************************/
+
+/* mmap und MAP_ANONYMOUS gehören nicht zu C11 */
+#define _DEFAULT_SOURCE
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "jit.h"
+#include "vec.h"
+
+/**
+ * @internal
+ * @brief Gibt an, ob der JIT für diese Plattform übersetzt wird.
+ */
+#if defined(__x86_64__) && defined(__linux__)
+	#define JIT_AVAILABLE 1
+	#include <sys/mman.h>
+#else
+	#define JIT_AVAILABLE 0
+#endif
+
+#if JIT_AVAILABLE
+
+/* *** internal structures ************************************************** */
+
+/**
+ * @internal
+ * @brief Zustand des Übersetzers.
+ */
+typedef struct {
+	unsigned char *code;    /**<@brief Vektor des erzeugten Maschinencodes. */
+	const Program *ast;     /**<@brief Der übersetzte Syntaxbaum. */
+	const DefInfo *defs;    /**<@brief Die Definitionstabelle. */
+	const JitEnv *env;      /**<@brief Die Laufzeitumgebung. */
+	DataType ret_type;      /**<@brief Rückgabetyp der Funktion. */
+	unsigned int depth;     /**<@brief Anzahl gesicherter Werte auf dem Stack. */
+	unsigned int *returns;  /**<@brief Vektor der Sprünge zum Epilog. */
+} JitCompiler;
+
+/* *** internal constants *************************************************** */
+
+/** @internal @brief Zweites Byte von `setcc al` für Vergleiche auf `int`. */
+static const unsigned char INT_SETCC[] = {
+	[BIN_OP_EQ]  = 0x94, /* sete */
+	[BIN_OP_NEQ] = 0x95, /* setne */
+	[BIN_OP_LT]  = 0x9C, /* setl */
+	[BIN_OP_GT]  = 0x9F, /* setg */
+	[BIN_OP_LEQ] = 0x9E, /* setle */
+	[BIN_OP_GEQ] = 0x9D, /* setge */
+};
+
+/** @internal @brief Drittes Byte der SSE2-Befehle für Arithmetik auf `float`. */
+static const unsigned char FLOAT_ARITH[] = {
+	[BIN_OP_ADD] = 0x58, /* addsd */
+	[BIN_OP_SUB] = 0x5C, /* subsd */
+	[BIN_OP_MUL] = 0x59, /* mulsd */
+	[BIN_OP_DIV] = 0x5E, /* divsd */
+};
+
+/* *** internal helpers ***************************************************** */
+
+/* forward declarations */
+static void compileExpr(JitCompiler*, const Expr*);
+static void compileStmt(JitCompiler*, const Stmt*);
+
+/**
+ * @internal
+ * @brief Hängt die Bytes \p bytes an den Code an.
+ */
+static void emitBytes(JitCompiler *self, const unsigned char *bytes, size_t count) {
+	for (size_t i = 0; i < count; ++i) {
+		vecPush(self->code) = bytes[i];
+	}
+}
+
+/**
+ * @internal
+ * @brief Hilfsmakro, um eine feste Bytefolge anzuhängen.
+ */
+#define EMIT(self, ...) emitBytes(self, \
+	(const unsigned char[]) { __VA_ARGS__ }, \
+	sizeof((const unsigned char[]) { __VA_ARGS__ }))
+
+/**
+ * @internal
+ * @brief Hängt einen 32-Bit-Wert in Little-Endian-Reihenfolge an.
+ */
+static void emit32(JitCompiler *self, uint32_t value) {
+	for (int i = 0; i < 4; ++i) {
+		vecPush(self->code) = (unsigned char) (value >> 8*i);
+	}
+}
+
+/**
+ * @internal
+ * @brief Hängt einen 64-Bit-Wert in Little-Endian-Reihenfolge an.
+ */
+static void emit64(JitCompiler *self, uint64_t value) {
+	for (int i = 0; i < 8; ++i) {
+		vecPush(self->code) = (unsigned char) (value >> 8*i);
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt die Position des nächsten Bytes zurück.
+ */
+static inline unsigned int here(const JitCompiler *self) {
+	return vecLen(self->code);
+}
+
+/**
+ * @internal
+ * @brief Hängt einen Sprung mit 32-Bit-Distanz an und gibt die Position der
+ * Distanz zurück.
+ *
+ * @param op Der Opcode; `0x0F8x` für bedingte Sprünge, sonst `jmp`.
+ */
+static unsigned int emitJump(JitCompiler *self, unsigned int op) {
+	if (op > 0xFF) {
+		EMIT(self, 0x0F, (unsigned char) op);
+	} else {
+		EMIT(self, (unsigned char) op);
+	}
+	
+	emit32(self, 0);
+	return here(self) - 4;
+}
+
+/**
+ * @internal
+ * @brief Setzt das Ziel des Sprunges, dessen Distanz bei \p at liegt.
+ */
+static void patchJump(JitCompiler *self, unsigned int at, unsigned int target) {
+	uint32_t rel = (uint32_t) ((int32_t) target - (int32_t) (at + 4));
+	
+	for (int i = 0; i < 4; ++i) {
+		self->code[at + i] = (unsigned char) (rel >> 8*i);
+	}
+}
+
+/** @internal @brief Opcodes der verwendeten Sprünge. */
+enum { JMP = 0xE9, JZ = 0x0F84, JNZ = 0x0F85 };
+
+/**
+ * @internal
+ * @brief Lädt die Adresse einer Funktion nach `rax` und ruft sie auf.
+ *
+ * Der Stack wird dabei gemäß System V ABI auf 16 Byte ausgerichtet.
+ */
+static void emitCall(JitCompiler *self, const void *func_ptr, size_t size) {
+	uint64_t addr = 0;
+	memcpy(&addr, func_ptr, size);
+	
+	if (self->depth % 2) { EMIT(self, 0x48, 0x83, 0xEC, 0x08); } /* sub rsp, 8 */
+	EMIT(self, 0x48, 0xB8); emit64(self, addr);                  /* mov rax, imm64 */
+	EMIT(self, 0xFF, 0xD0);                                      /* call rax */
+	if (self->depth % 2) { EMIT(self, 0x48, 0x83, 0xC4, 0x08); } /* add rsp, 8 */
+}
+
+/**
+ * @internal
+ * @brief Lädt den Kontext der Laufzeitumgebung nach `rdi`.
+ */
+static void emitCtx(JitCompiler *self) {
+	EMIT(self, 0x48, 0xBF); emit64(self, (uint64_t) (uintptr_t) self->env->ctx); /* mov rdi, imm64 */
+}
+
+/**
+ * @internal
+ * @brief Sichert `rax` auf dem Stack.
+ */
+static inline void emitPush(JitCompiler *self) {
+	EMIT(self, 0x50); /* push rax */
+	++self->depth;
+}
+
+/**
+ * @internal
+ * @brief Erzeugt eine implizite Typumwandlung von \p from nach \p to.
+ */
+static void emitConvert(JitCompiler *self, DataType from, DataType to) {
+	if (from == TYPE_INT && to == TYPE_FLOAT) {
+		EMIT(self, 0xF2, 0x0F, 0x2A, 0xC0);       /* cvtsi2sd xmm0, eax */
+		EMIT(self, 0x66, 0x48, 0x0F, 0x7E, 0xC0); /* movq rax, xmm0 */
+	}
+}
+
+/**
+ * @internal
+ * @brief Erzeugt einen Lese- oder Schreibzugriff zwischen `rax` und der
+ * Variablen \p id.
+ */
+static void emitVar(JitCompiler *self, DefId id, int store) {
+	const DefInfo *def = &self->defs[id.index];
+	
+	if (def->tag == SYM_DEF_LOCAL_VAR) {
+		EMIT(self, 0x48, store ? 0x89 : 0x8B, 0x85);          /* mov [rbp+d], rax / mov rax, [rbp+d] */
+		emit32(self, (uint32_t) -(int32_t) (8*(def->var.offset + 1)));
+	} else {
+		assert(def->tag == SYM_DEF_GLOBAL_VAR);
+		EMIT(self, 0x48, 0xB9);                               /* mov rcx, imm64 */
+		emit64(self, (uint64_t) (uintptr_t) &self->env->globals[def->var.offset]);
+		EMIT(self, 0x48, store ? 0x89 : 0x8B, 0x01);          /* mov [rcx], rax / mov rax, [rcx] */
+	}
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine Zuweisung; der Wert verbleibt in `rax`.
+ */
+static void compileAssign(JitCompiler *self, const Assign *assign) {
+	compileExpr(self, assign->rhs);
+	emitConvert(self, assign->rhs->data_type, self->defs[assign->lhs.res.index].var.data_type);
+	emitVar(self, assign->lhs.res, 1);
+}
+
+/**
+ * @internal
+ * @brief Übersetzt die Initialisierung einer Variablen.
+ */
+static void compileVarDef(JitCompiler *self, const VarDef *var_def) {
+	if (var_def->init.tag == EXPR_INVALID) { return; }
+	
+	compileExpr(self, &var_def->init);
+	emitConvert(self, var_def->init.data_type, var_def->data_type);
+	emitVar(self, var_def->res_ident.res, 1);
+}
+
+/**
+ * @internal
+ * @brief Übersetzt einen Funktionsaufruf über `JitEnv.call`.
+ *
+ * Die Argumente werden der Reihe nach auf den Stack gelegt, so dass `rsp`
+ * anschließend auf das letzte Argument zeigt.
+ */
+static void compileCall(JitCompiler *self, const FuncCall *call) {
+	const FuncInfo *func = &self->defs[call->res_ident.res.index].func;
+	const FuncDef *def = &self->ast->items[func->item_id.index].func_def;
+	
+	for (unsigned int i = 0; i < func->param_count; ++i) {
+		compileExpr(self, &call->args[i]);
+		emitConvert(self, call->args[i].data_type, def->params[i].data_type);
+		emitPush(self);
+	}
+	
+	EMIT(self, 0x48, 0x89, 0xE2);                                  /* mov rdx, rsp */
+	emitCtx(self);
+	EMIT(self, 0xBE); emit32(self, call->res_ident.res.index);     /* mov esi, imm32 */
+	emitCall(self, &self->env->call, sizeof(self->env->call));
+	
+	if (func->param_count > 0) {
+		EMIT(self, 0x48, 0x81, 0xC4); emit32(self, 8*func->param_count); /* add rsp, imm32 */
+		self->depth -= func->param_count;
+	}
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine binäre Operation.
+ *
+ * Der linke Operand liegt anschließend in `rax` bzw. `xmm0`, der rechte in
+ * `rcx` bzw. `xmm1`.
+ */
+static void compileBinOp(JitCompiler *self, const BinOpExpr *bin) {
+	unsigned int jump;
+	
+	switch (bin->op) {
+	case BIN_OP_LOG_OR:
+	case BIN_OP_LOG_AND:
+		compileExpr(self, bin->lhs);
+		EMIT(self, 0x85, 0xC0);                                   /* test eax, eax */
+		jump = emitJump(self, bin->op == BIN_OP_LOG_OR ? JNZ : JZ);
+		compileExpr(self, bin->rhs);
+		patchJump(self, jump, here(self));
+		return;
+		
+	default:
+		break;
+	}
+	
+	int is_float = bin->lhs->data_type == TYPE_FLOAT || bin->rhs->data_type == TYPE_FLOAT;
+	
+	compileExpr(self, bin->lhs);
+	if (is_float) { emitConvert(self, bin->lhs->data_type, TYPE_FLOAT); }
+	emitPush(self);
+	compileExpr(self, bin->rhs);
+	if (is_float) { emitConvert(self, bin->rhs->data_type, TYPE_FLOAT); }
+	EMIT(self, 0x48, 0x89, 0xC1);                                 /* mov rcx, rax */
+	EMIT(self, 0x58);                                             /* pop rax */
+	--self->depth;
+	
+	if (is_float) {
+		EMIT(self, 0x66, 0x48, 0x0F, 0x6E, 0xC0);                 /* movq xmm0, rax */
+		EMIT(self, 0x66, 0x48, 0x0F, 0x6E, 0xC9);                 /* movq xmm1, rcx */
+		
+		switch (bin->op) {
+		case BIN_OP_ADD:
+		case BIN_OP_SUB:
+		case BIN_OP_MUL:
+		case BIN_OP_DIV:
+			EMIT(self, 0xF2, 0x0F, FLOAT_ARITH[bin->op], 0xC1);   /* op xmm0, xmm1 */
+			EMIT(self, 0x66, 0x48, 0x0F, 0x7E, 0xC0);             /* movq rax, xmm0 */
+			return;
+			
+		/* ungeordnete Vergleiche (NaN) setzen ZF, PF und CF */
+		case BIN_OP_EQ:
+			EMIT(self, 0x66, 0x0F, 0x2E, 0xC1);                   /* ucomisd xmm0, xmm1 */
+			EMIT(self, 0x0F, 0x94, 0xC0, 0x0F, 0x9B, 0xC1);       /* sete al; setnp cl */
+			EMIT(self, 0x20, 0xC8);                               /* and al, cl */
+			break;
+			
+		case BIN_OP_NEQ:
+			EMIT(self, 0x66, 0x0F, 0x2E, 0xC1);                   /* ucomisd xmm0, xmm1 */
+			EMIT(self, 0x0F, 0x95, 0xC0, 0x0F, 0x9A, 0xC1);       /* setne al; setp cl */
+			EMIT(self, 0x08, 0xC8);                               /* or al, cl */
+			break;
+			
+		case BIN_OP_LT:
+		case BIN_OP_LEQ:
+			EMIT(self, 0x66, 0x0F, 0x2E, 0xC8);                   /* ucomisd xmm1, xmm0 */
+			EMIT(self, 0x0F, bin->op == BIN_OP_LT ? 0x97 : 0x93, 0xC0); /* seta al / setae al */
+			break;
+			
+		case BIN_OP_GT:
+		case BIN_OP_GEQ:
+			EMIT(self, 0x66, 0x0F, 0x2E, 0xC1);                   /* ucomisd xmm0, xmm1 */
+			EMIT(self, 0x0F, bin->op == BIN_OP_GT ? 0x97 : 0x93, 0xC0); /* seta al / setae al */
+			break;
+			
+		default:
+			assert(0);
+			break;
+		}
+		
+		EMIT(self, 0x0F, 0xB6, 0xC0);                             /* movzx eax, al */
+		return;
+	}
+	
+	switch (bin->op) {
+	case BIN_OP_ADD: EMIT(self, 0x01, 0xC8); break;               /* add eax, ecx */
+	case BIN_OP_SUB: EMIT(self, 0x29, 0xC8); break;               /* sub eax, ecx */
+	case BIN_OP_MUL: EMIT(self, 0x0F, 0xAF, 0xC1); break;         /* imul eax, ecx */
+	case BIN_OP_DIV: EMIT(self, 0x99, 0xF7, 0xF9); break;         /* cdq; idiv ecx */
+	
+	default:
+		EMIT(self, 0x39, 0xC8);                                   /* cmp eax, ecx */
+		EMIT(self, 0x0F, INT_SETCC[bin->op], 0xC0);               /* setcc al */
+		EMIT(self, 0x0F, 0xB6, 0xC0);                             /* movzx eax, al */
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Übersetzt einen Ausdruck, dessen Wert anschließend in `rax` liegt.
+ */
+static void compileExpr(JitCompiler *self, const Expr *expr) {
+	switch (expr->tag) {
+	case EXPR_ASSIGN:
+		compileAssign(self, &expr->assign);
+		break;
+		
+	case EXPR_BIN_OP:
+		compileBinOp(self, &expr->bin_op);
+		break;
+		
+	case EXPR_UNARY_MINUS:
+		compileExpr(self, expr->unary_minus);
+		
+		if (expr->data_type == TYPE_FLOAT) {
+			EMIT(self, 0x48, 0xB9); emit64(self, UINT64_C(1) << 63); /* mov rcx, imm64 */
+			EMIT(self, 0x48, 0x31, 0xC8);                             /* xor rax, rcx */
+		} else {
+			EMIT(self, 0xF7, 0xD8);                                   /* neg eax */
+		}
+		break;
+		
+	case EXPR_CALL:
+		compileCall(self, &expr->call);
+		break;
+		
+	case EXPR_LITERAL:
+		switch (expr->literal.tag) {
+		case LITERAL_INT:
+			EMIT(self, 0xB8); emit32(self, (uint32_t) expr->literal.iVal);      /* mov eax, imm32 */
+			break;
+			
+		case LITERAL_BOOL:
+			EMIT(self, 0xB8); emit32(self, expr->literal.bVal != 0);            /* mov eax, imm32 */
+			break;
+			
+		case LITERAL_FLOAT: {
+			uint64_t bits;
+			memcpy(&bits, &expr->literal.fVal, sizeof(bits));
+			EMIT(self, 0x48, 0xB8); emit64(self, bits);                         /* mov rax, imm64 */
+			break;
+		}
+		
+		case LITERAL_STRING:
+			EMIT(self, 0x48, 0xB8); emit64(self, (uint64_t) (uintptr_t) expr->literal.sVal);
+			break;
+		}
+		break;
+		
+	case EXPR_VAR:
+		emitVar(self, expr->var.res, 0);
+		break;
+		
+	case EXPR_INVALID:
+		assert(0);
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine Bedingung und einen Sprung, der bei \p op (`JZ` oder
+ * `JNZ`) ausgeführt wird. Gibt die Position der Sprungdistanz zurück.
+ */
+static unsigned int compileBranch(JitCompiler *self, const Expr *cond, unsigned int op) {
+	compileExpr(self, cond);
+	EMIT(self, 0x85, 0xC0);                                           /* test eax, eax */
+	return emitJump(self, op);
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine Anweisung.
+ *
+ * Schleifen werden wie im Bytecode mit der Bedingung am Ende übersetzt.
+ */
+static void compileStmt(JitCompiler *self, const Stmt *stmt) {
+	unsigned int jump, loop;
+	
+	switch (stmt->tag) {
+	case STMT_EMPTY:
+		break;
+		
+	case STMT_IF:
+		jump = compileBranch(self, &stmt->if_stmt.cond, JZ);
+		compileStmt(self, stmt->if_stmt.if_true);
+		
+		if (stmt->if_stmt.if_false->tag != STMT_EMPTY) {
+			unsigned int skip = emitJump(self, JMP);
+			patchJump(self, jump, here(self));
+			compileStmt(self, stmt->if_stmt.if_false);
+			jump = skip;
+		}
+		
+		patchJump(self, jump, here(self));
+		break;
+		
+	case STMT_FOR: {
+		const ForStmt *for_stmt = &stmt->for_stmt;
+		
+		if (for_stmt->init.tag == FOR_INIT_VAR_DEF) {
+			compileVarDef(self, &for_stmt->init.var_def);
+		} else {
+			compileAssign(self, &for_stmt->init.assign);
+		}
+		
+		jump = emitJump(self, JMP);
+		loop = here(self);
+		compileStmt(self, for_stmt->body);
+		compileAssign(self, &for_stmt->update);
+		patchJump(self, jump, here(self));
+		patchJump(self, compileBranch(self, &for_stmt->cond, JNZ), loop);
+		break;
+	}
+	
+	case STMT_WHILE:
+		jump = emitJump(self, JMP);
+		loop = here(self);
+		compileStmt(self, stmt->while_stmt.body);
+		patchJump(self, jump, here(self));
+		patchJump(self, compileBranch(self, &stmt->while_stmt.cond, JNZ), loop);
+		break;
+		
+	case STMT_DO_WHILE:
+		loop = here(self);
+		compileStmt(self, stmt->do_while_stmt.body);
+		patchJump(self, compileBranch(self, &stmt->do_while_stmt.cond, JNZ), loop);
+		break;
+		
+	case STMT_RETURN:
+		if (stmt->return_stmt.tag != EXPR_INVALID) {
+			compileExpr(self, &stmt->return_stmt);
+			emitConvert(self, stmt->return_stmt.data_type, self->ret_type);
+		}
+		
+		vecPush(self->returns) = emitJump(self, JMP);
+		break;
+		
+	case STMT_PRINT:
+		vecForEach(const Expr *expr, stmt->print_stmt.expressions) {
+			compileExpr(self, expr);
+			EMIT(self, 0x48, 0x89, 0xC6);                             /* mov rsi, rax */
+			emitCtx(self);
+			EMIT(self, 0xBA); emit32(self, expr->data_type);          /* mov edx, imm32 */
+			emitCall(self, &self->env->print, sizeof(self->env->print));
+		}
+		
+		emitCtx(self);
+		emitCall(self, &self->env->newline, sizeof(self->env->newline));
+		break;
+		
+	case STMT_VAR_DEF:
+		compileVarDef(self, &stmt->var_def);
+		break;
+		
+	case STMT_ASSIGN:
+		compileAssign(self, &stmt->assign);
+		break;
+		
+	case STMT_CALL:
+		compileCall(self, &stmt->call);
+		break;
+		
+	case STMT_BLOCK:
+		vecForEach(const Stmt *inner, stmt->block.statements) {
+			compileStmt(self, inner);
+		}
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Kopiert den erzeugten Code in einen ausführbaren Speicherbereich.
+ */
+static void* jitMap(const JitCompiler *self, JitCode *code) {
+	code->size = vecLen(self->code);
+	code->base = mmap(NULL, code->size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	
+	if (code->base == MAP_FAILED) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	memcpy(code->base, self->code, code->size);
+	
+	if (mprotect(code->base, code->size, PROT_READ | PROT_EXEC) != 0) {
+		fputs("failed to map executable memory\n", stderr);
+		exit(-1);
+	}
+	
+	return code->base;
+}
+
+#endif
+
+/* *** implementation ******************************************************* */
+
+int jitAvailable(void) {
+	return JIT_AVAILABLE;
+}
+
+#if JIT_AVAILABLE
+
+JitEntry jitCompile(const Program *ast, const SymDefTable *tab, DefId func, const JitEnv *env, JitCode *code) {
+	const FuncInfo *info = &tab->definitions[func.index].func;
+	const FuncDef *def = &ast->items[info->item_id.index].func_def;
+	uint32_t frame = (8*vecLen(info->local_vars) + 15) & ~15u;
+	JitCompiler self = {
+		.ast = ast,
+		.defs = tab->definitions,
+		.env = env,
+		.ret_type = info->return_type
+	};
+	
+	/* prologue: create the frame and copy the arguments into it */
+	EMIT(&self, 0x55);                                                /* push rbp */
+	EMIT(&self, 0x48, 0x89, 0xE5);                                    /* mov rbp, rsp */
+	EMIT(&self, 0x48, 0x81, 0xEC); emit32(&self, frame);              /* sub rsp, imm32 */
+	
+	for (unsigned int i = 0; i < info->param_count; ++i) {
+		EMIT(&self, 0x48, 0x8B, 0x87); emit32(&self, 8*i);            /* mov rax, [rdi+d] */
+		EMIT(&self, 0x48, 0x89, 0x85); emit32(&self, (uint32_t) -(int32_t) (8*(i + 1)));
+	}
+	
+	vecForEach(const Stmt *stmt, def->statements) {
+		compileStmt(&self, stmt);
+	}
+	
+	/* epilogue: a missing return statement yields 0 */
+	EMIT(&self, 0x31, 0xC0);                                          /* xor eax, eax */
+	
+	vecForEach(unsigned int *at, self.returns) {
+		patchJump(&self, *at, here(&self));
+	}
+	
+	EMIT(&self, 0xC9, 0xC3);                                          /* leave; ret */
+	assert(self.depth == 0);
+	
+	void *base = jitMap(&self, code);
+	JitEntry entry;
+	memcpy(&entry, &base, sizeof(entry));
+	
+	vecRelease(self.code);
+	vecRelease(self.returns);
+	return entry;
+}
+
+void jitRelease(JitCode *code) {
+	if (code->base != NULL) {
+		munmap(code->base, code->size);
+		code->base = NULL;
+	}
+}
+
+#else
+
+JitEntry jitCompile(const Program *ast, const SymDefTable *tab, DefId func, const JitEnv *env, JitCode *code) {
+	(void) ast; (void) tab; (void) func; (void) env;
+	*code = (JitCode) { NULL, 0 };
+	return NULL;
+}
+
+void jitRelease(JitCode *code) {
+	(void) code;
+}
+
+#endif
@@ -0,0 +1,107 @@
+/***************************************************************************//**
+ * @file jit.h
+ * @brief Template-JIT für C1-Funktionen auf Linux x86-64.
+ *
+ * # Überblick
+ *
+ * Eine Funktion wird in einem einzigen Durchlauf über ihren Syntaxbaum in
+ * Maschinencode übersetzt, wobei jeder Knoten ein festes Codemuster
+ * (*Template*) erzeugt. Es findet keine Registervergabe statt:
+ *
+ * - Das Ergebnis jedes Ausdrucks liegt als Bitmuster eines `Value` in `rax`.
+ *   `int` und `bool` verwenden die unteren 32 Bit, `float` wird für
+ *   Berechnungen nach `xmm0` und `xmm1` kopiert.
+ * - Der linke Operand einer binären Operation wird während der Berechnung des
+ *   rechten Operanden auf dem Maschinenstack gesichert.
+ * - Die lokalen Variablen liegen in einem Frame unterhalb von `rbp`, dessen
+ *   Größe sich aus `FuncInfo.local_vars` ergibt; jede Variable belegt den
+ *   Slot `VarInfo.offset`.
+ * - Globale Variablen werden über ihre absolute Adresse angesprochen.
+ * - Funktionsaufrufe und die `print`-Anweisung rufen die Rückruffunktionen
+ *   aus `JitEnv` auf. Die gerufene Funktion kann somit interpretiert oder
+ *   ebenfalls übersetzt sein.
+ *
+ * Der Code wird in einen mit `mmap` angelegten Speicherbereich geschrieben,
+ * der vor der Ausführung von schreibbar auf ausführbar umgestellt wird. Auf
+ * anderen Plattformen steht der JIT nicht zur Verfügung (siehe
+ * `jitAvailable()`), so dass alle Funktionen interpretiert werden.
+ ******************************************************************************/
+
+#ifndef JIT_H_INCLUDED
+#define JIT_H_INCLUDED
+
+/* *** Includes ************************************************************* */
+
+#include <stddef.h>
+#include "ast.h"
+#include "symtab.h"
+#include "interp.h"
+
+/* *** Strukturen *********************************************************** */
+
+/**
+ * @brief Einsprungpunkt einer übersetzten Funktion.
+ *
+ * Die Funktion erhält ihre Argumente in Aufrufreihenfolge und gibt ihren
+ * Rückgabewert zurück. Fehlt die `return`-Anweisung, ist dieser `0`.
+ */
+typedef Value (*JitEntry)(const Value *args);
+
+/**
+ * @brief Die Laufzeitumgebung, auf die übersetzter Code zugreift.
+ */
+typedef struct JitEnv {
+	void *ctx;      /**<@brief Erster Parameter aller Rückruffunktionen. */
+	Value *globals; /**<@brief Speicher der globalen Variablen. */
+	
+	/**
+	 * @brief Ruft die Funktion mit der `DefId` \p func auf.
+	 *
+	 * Die Argumente liegen in \p args in umgekehrter Reihenfolge vor und sind
+	 * bereits in die Parametertypen umgewandelt.
+	 */
+	Value (*call)(void *ctx, unsigned int func, const Value *args);
+	
+	/** @brief Gibt einen Wert der `print`-Anweisung aus. */
+	void (*print)(void *ctx, Value value, DataType type);
+	
+	/** @brief Beendet die Ausgabe einer `print`-Anweisung. */
+	void (*newline)(void *ctx);
+} JitEnv;
+
+/**
+ * @brief Der ausführbare Speicher einer übersetzten Funktion.
+ */
+typedef struct JitCode {
+	void *base;  /**<@brief Beginn des Speicherbereichs. */
+	size_t size; /**<@brief Größe des Speicherbereichs in Byte. */
+} JitCode;
+
+/* *** Öffentliche Schnittstelle ******************************************** */
+
+/**
+ * @brief Gibt zurück, ob der JIT auf dieser Plattform zur Verfügung steht.
+ * @return 1 auf Linux x86-64, sonst 0.
+ */
+extern int jitAvailable(void);
+
+/**
+ * @brief Übersetzt eine Funktion in Maschinencode.
+ *
+ * @param ast  Die Wurzel des abstrakten Syntaxbaumes.
+ * @param tab  Die Definitionstabelle des Programms.
+ * @param func Die `DefId` der zu übersetzenden Funktion.
+ * @param env  Die Laufzeitumgebung; muss so lange leben wie der Code.
+ * @param code Nimmt den Speicherbereich des Codes auf.
+ * @return Der Einsprungpunkt oder `NULL`, falls der JIT nicht zur Verfügung
+ *         steht.
+ */
+extern JitEntry jitCompile(const Program *ast, const SymDefTable *tab, DefId func, const JitEnv *env, JitCode *code);
+
+/**
+ * @brief Gibt den Speicher einer übersetzten Funktion frei.
+ * @param code Der freizugebende Speicherbereich.
+ */
+extern void jitRelease(JitCode *code);
+
+#endif
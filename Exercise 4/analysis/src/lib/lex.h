@@ -0,0 +1,101 @@
+/***************************************************************************//**
+ * @file lex.h
+ * @brief Kontext des Scanners für den reentranten Parser.
+ *
+ * # Überblick
+ *
+ * `lexer.l` wird mit `%option reentrant bison-bridge` übersetzt und der
+ * Parser mit `%define api.pure full`, so dass weder Scanner noch Parser
+ * globale Variablen wie `yyin`, `yylval` oder `yylineno` verwenden. Der
+ * gesamte Zustand des Scanners liegt stattdessen in einem `Lexer`, den der
+ * Parser über `%lex-param` an `yylex()` weiterreicht. Ein `Lexer` enthält je
+ * nach Modus den Zustand des von flex erzeugten oder des handgeschriebenen
+ * Scanners aus `scan.h`.
+ *
+ * Die Funktionen sind im Benutzerteil von `lexer.l` umgesetzt, damit sie die
+ * Schnittstelle des reentranten Scanners mit den von flex erzeugten
+ * Deklarationen aufrufen.
+ *
+ * Verschiedene `Lexer` sind voneinander unabhängig und können gleichzeitig
+ * in verschiedenen Threads verwendet werden. Ein `Lexer` scannt genau eine
+ * Eingabe, die beim Erzeugen festgelegt wird.
+ ******************************************************************************/
+
+#ifndef LEX_H_INCLUDED
+#define LEX_H_INCLUDED
+
+/* *** Includes ************************************************************* */
+
+#include <stdio.h>
+#include <stddef.h>
+#include "scan.h"
+
+/* *** Strukturen *********************************************************** */
+
+/* der Typ des Zustandes eines reentranten flex-Scanners, wie ihn flex erzeugt */
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void* yyscan_t;
+#endif
+
+/**
+ * @brief Der Kontext eines Scanners.
+ */
+typedef struct Lexer {
+	ScanMode mode;  /**<@brief Der verwendete Scanner. */
+	yyscan_t flex;  /**<@brief Der Zustand von flex im Modus `SCAN_FLEX`, sonst `NULL`. */
+	Scanner dfa;    /**<@brief Der Zustand des Scanners im Modus `SCAN_DFA`. */
+} Lexer;
+
+/* *** Öffentliche Schnittstelle ******************************************** */
+
+/**
+ * @brief Erzeugt einen flex-Scanner, der aus einem Strom liest.
+ * @param input Der Eingabestrom.
+ * @return Der Kontext des Scanners.
+ */
+extern Lexer lexerFromStream(FILE *input);
+
+/**
+ * @brief Erzeugt einen Scanner, der einen Puffer an Ort und Stelle scannt.
+ *
+ * @param mode Der zu verwendende Scanner.
+ * @param data Der Quelltext, gefolgt von `SOURCE_PADDING` Nullbytes. Der
+ *             Puffer muss beschreibbar sein und den Kontext überdauern.
+ *             Fehlen die Nullbytes, scannt flex eine Kopie des Puffers.
+ * @param len  Die Länge des Quelltextes ohne die Nullbytes.
+ * @return Der Kontext des Scanners.
+ */
+extern Lexer lexerFromBuffer(ScanMode mode, char *data, size_t len);
+
+/**
+ * @brief Erzeugt einen Scanner für eine nullterminierte Zeichenkette.
+ *
+ * @param mode Der zu verwendende Scanner.
+ * @param str  Die Eingabe, die den Kontext im Modus `SCAN_DFA` überdauern muss.
+ * @return Der Kontext des Scanners.
+ */
+extern Lexer lexerFromString(ScanMode mode, const char *str);
+
+/**
+ * @brief Gibt den Kontext eines Scanners frei.
+ * @param self Der freizugebende Kontext.
+ */
+extern void lexerRelease(Lexer *self);
+
+/**
+ * @brief Gibt die Zeilennummer des zuletzt gelesenen Tokens zurück.
+ * @param self Der Kontext.
+ */
+extern int lexerLine(const Lexer *self);
+
+/**
+ * @brief Liest das nächste Token mit dem Scanner des Kontextes.
+ *
+ * @param lval Der semantische Wert des Tokens.
+ * @param self Der Kontext.
+ * @return Das Token, `EOF` am Ende der Eingabe.
+ */
+extern int yylex(union YYSTYPE *lval, Lexer *self);
+
+#endif
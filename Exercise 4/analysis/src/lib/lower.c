@@ -0,0 +1,730 @@
+/***************************************************************************//**
+ * @file lower.c
+ * @brief Absenkung in die typspezialisierte Darstellung und deren Auswertung.
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "lower.h"
+#include "vec.h"
+
+/* *** internal structures ************************************************** */
+
+/**
+ * @internal
+ * @brief Zustand der Absenkung.
+ */
+typedef struct {
+	const Program *ast;     /**<@brief Der abgesenkte Syntaxbaum. */
+	const DefInfo *defs;    /**<@brief Die Definitionstabelle. */
+	DataType ret_type;      /**<@brief Rückgabetyp der aktuellen Funktion. */
+} Lowering;
+
+/**
+ * @internal
+ * @brief Ergebnis der Ausführung einer Anweisung.
+ */
+typedef enum {
+	FLOW_NEXT,  /**<@brief Fortsetzung mit der nächsten Anweisung. */
+	FLOW_RETURN /**<@brief Rückkehr aus der aktuellen Funktion. */
+} Flow;
+
+/**
+ * @internal
+ * @brief Zustand des Auswerters.
+ */
+typedef struct {
+	const LowProgram *prog; /**<@brief Das ausgeführte Programm. */
+	Value *globals;         /**<@brief Speicher der globalen Variablen. */
+	Value *stack;           /**<@brief Flacher Speicher aller Stack-Frames. */
+	unsigned int base;      /**<@brief Beginn des aktuellen Stack-Frames. */
+	unsigned int top;       /**<@brief Erster freier Eintrag im Stack. */
+	unsigned int cap;       /**<@brief Kapazität des Stacks. */
+	Value ret;              /**<@brief Rückgabewert der aktuellen Funktion. */
+	Out *out;               /**<@brief Ausgabepuffer für `print`. */
+} LowInterp;
+
+/* *** internal constants *************************************************** */
+
+/** @internal @brief Operationen binärer Ausdrücke auf `int`. */
+static const LowOp INT_OPS[] = {
+	[BIN_OP_ADD] = LOW_ADD_I,
+	[BIN_OP_SUB] = LOW_SUB_I,
+	[BIN_OP_MUL] = LOW_MUL_I,
+	[BIN_OP_DIV] = LOW_DIV_I,
+	[BIN_OP_EQ]  = LOW_EQ_I,
+	[BIN_OP_NEQ] = LOW_NEQ_I,
+	[BIN_OP_LT]  = LOW_LT_I,
+	[BIN_OP_GT]  = LOW_GT_I,
+	[BIN_OP_LEQ] = LOW_LEQ_I,
+	[BIN_OP_GEQ] = LOW_GEQ_I,
+};
+
+/** @internal @brief Operationen binärer Ausdrücke auf `float`. */
+static const LowOp FLOAT_OPS[] = {
+	[BIN_OP_ADD] = LOW_ADD_F,
+	[BIN_OP_SUB] = LOW_SUB_F,
+	[BIN_OP_MUL] = LOW_MUL_F,
+	[BIN_OP_DIV] = LOW_DIV_F,
+	[BIN_OP_EQ]  = LOW_EQ_F,
+	[BIN_OP_NEQ] = LOW_NEQ_F,
+	[BIN_OP_LT]  = LOW_LT_F,
+	[BIN_OP_GT]  = LOW_GT_F,
+	[BIN_OP_LEQ] = LOW_LEQ_F,
+	[BIN_OP_GEQ] = LOW_GEQ_F,
+};
+
+/* *** internal helpers ***************************************************** */
+
+/* forward declarations */
+static LowExpr lowerExpr(Lowering*, const Expr*);
+static void lowerStmt(Lowering*, const Stmt*, LowStmt**);
+static Value lowEval(LowInterp*, const LowExpr*);
+static Flow lowExec(LowInterp*, const LowStmt*);
+static void lowExprRelease(LowExpr*);
+static void lowStmtsRelease(LowStmt*);
+
+/**
+ * @internal
+ * @brief Kopiert einen Wert auf den Heap.
+ */
+static void* BOX(void *ptr, size_t size) {
+	void *result = malloc(size);
+	
+	if (result == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	memcpy(result, ptr, size);
+	return result;
+}
+
+/**
+ * @internal
+ * @brief Hilfsmakro, um Instanzen unterschiedlicher Typen auf den Heap zu
+ * kopieren.
+ */
+#define BOX(instance) \
+	BOX(&instance, sizeof(instance))
+	
+/**
+ * @internal
+ * @brief Erzeugt einen Ausdruck mit zwei Operanden.
+ */
+static LowExpr lowBinary(LowOp op, LowExpr lhs, LowExpr rhs) {
+	return (LowExpr) { .op = op, .lhs = BOX(lhs), .rhs = BOX(rhs) };
+}
+
+/**
+ * @internal
+ * @brief Senkt einen Ausdruck ab und wandelt ihn implizit in \p type um.
+ *
+ * Konstanten werden direkt umgewandelt.
+ */
+static LowExpr lowerConverted(Lowering *self, const Expr *expr, DataType type) {
+	LowExpr result = lowerExpr(self, expr);
+	
+	if (expr->data_type == TYPE_INT && type == TYPE_FLOAT) {
+		if (result.op == LOW_CONST) {
+			result.value.f = result.value.i;
+		} else {
+			result = (LowExpr) { .op = LOW_I2F, .lhs = BOX(result) };
+		}
+	}
+	
+	return result;
+}
+
+/**
+ * @internal
+ * @brief Senkt eine Zuweisung des Wertes \p value an die Variable \p id ab.
+ */
+static LowExpr lowerStore(Lowering *self, DefId id, const Expr *value) {
+	const DefInfo *def = &self->defs[id.index];
+	LowExpr rhs = lowerConverted(self, value, def->var.data_type);
+	
+	return (LowExpr) {
+		.op = def->tag == SYM_DEF_LOCAL_VAR ? LOW_SET_LOCAL : LOW_SET_GLOBAL,
+		.slot = def->var.offset,
+		.lhs = BOX(rhs)
+	};
+}
+
+/**
+ * @internal
+ * @brief Senkt einen Funktionsaufruf ab.
+ */
+static LowExpr lowerCall(Lowering *self, const FuncCall *call) {
+	const FuncInfo *func = &self->defs[call->res_ident.res.index].func;
+	const FuncDef *def = &self->ast->items[func->item_id.index].func_def;
+	LowExpr result = { .op = LOW_CALL, .func = func->item_id.index };
+	
+	for (unsigned int i = 0; i < func->param_count; ++i) {
+		vecPush(result.args) = lowerConverted(self, &call->args[i], def->params[i].data_type);
+	}
+	
+	return result;
+}
+
+/**
+ * @internal
+ * @brief Senkt eine binäre Operation ab.
+ */
+static LowExpr lowerBinOp(Lowering *self, const BinOpExpr *bin) {
+	const Expr *lhs = bin->lhs, *rhs = bin->rhs;
+	
+	switch (bin->op) {
+	case BIN_OP_LOG_OR:
+		return lowBinary(LOW_OR, lowerExpr(self, lhs), lowerExpr(self, rhs));
+		
+	case BIN_OP_LOG_AND:
+		return lowBinary(LOW_AND, lowerExpr(self, lhs), lowerExpr(self, rhs));
+		
+	case BIN_OP_EQ:
+	case BIN_OP_NEQ:
+		if (lhs->data_type == TYPE_BOOL) {
+			return lowBinary(bin->op == BIN_OP_EQ ? LOW_EQ_B : LOW_NEQ_B,
+				lowerExpr(self, lhs), lowerExpr(self, rhs));
+		}
+		break;
+		
+	default:
+		break;
+	}
+	
+	if (lhs->data_type == TYPE_FLOAT || rhs->data_type == TYPE_FLOAT) {
+		return lowBinary(FLOAT_OPS[bin->op],
+			lowerConverted(self, lhs, TYPE_FLOAT),
+			lowerConverted(self, rhs, TYPE_FLOAT));
+	}
+	
+	return lowBinary(INT_OPS[bin->op], lowerExpr(self, lhs), lowerExpr(self, rhs));
+}
+
+/**
+ * @internal
+ * @brief Senkt einen Ausdruck ab.
+ */
+static LowExpr lowerExpr(Lowering *self, const Expr *expr) {
+	switch (expr->tag) {
+	case EXPR_ASSIGN:
+		return lowerStore(self, expr->assign.lhs.res, expr->assign.rhs);
+		
+	case EXPR_BIN_OP:
+		return lowerBinOp(self, &expr->bin_op);
+		
+	case EXPR_UNARY_MINUS: {
+		LowExpr operand = lowerExpr(self, expr->unary_minus);
+		return (LowExpr) {
+			.op = expr->data_type == TYPE_FLOAT ? LOW_NEG_F : LOW_NEG_I,
+			.lhs = BOX(operand)
+		};
+	}
+	
+	case EXPR_CALL:
+		return lowerCall(self, &expr->call);
+		
+	case EXPR_LITERAL:
+		switch (expr->literal.tag) {
+		case LITERAL_INT:
+			return (LowExpr) { .op = LOW_CONST, .value.i = expr->literal.iVal };
+			
+		case LITERAL_FLOAT:
+			return (LowExpr) { .op = LOW_CONST, .value.f = expr->literal.fVal };
+			
+		case LITERAL_BOOL:
+			return (LowExpr) { .op = LOW_CONST, .value.i = expr->literal.bVal != 0 };
+			
+		case LITERAL_STRING:
+			return (LowExpr) { .op = LOW_CONST, .value.s = expr->literal.sVal };
+		}
+		break;
+		
+	case EXPR_VAR: {
+		const DefInfo *def = &self->defs[expr->var.res.index];
+		return (LowExpr) {
+			.op = def->tag == SYM_DEF_LOCAL_VAR ? LOW_LOCAL : LOW_GLOBAL,
+			.slot = def->var.offset
+		};
+	}
+	
+	case EXPR_INVALID:
+		break;
+	}
+	
+	assert(0);
+	return (LowExpr) { .op = LOW_CONST };
+}
+
+/**
+ * @internal
+ * @brief Senkt die Initialisierung einer Variablen ab und hängt sie an
+ * \p out an.
+ */
+static void lowerVarDef(Lowering *self, const VarDef *var_def, LowStmt **out) {
+	if (var_def->init.tag == EXPR_INVALID) { return; }
+	
+	LowExpr store = lowerStore(self, var_def->res_ident.res, &var_def->init);
+	vecPush(*out) = (LowStmt) { .tag = LOW_STMT_EXPR, .expr = BOX(store) };
+}
+
+/**
+ * @internal
+ * @brief Senkt eine einzelne Anweisung in eine eigene Anweisungsliste ab.
+ */
+static LowStmt* lowerBody(Lowering *self, const Stmt *stmt) {
+	LowStmt *body = NULL;
+	lowerStmt(self, stmt, &body);
+	return body;
+}
+
+/**
+ * @internal
+ * @brief Senkt eine Anweisung ab und hängt das Ergebnis an \p out an.
+ *
+ * Leere Anweisungen und Variablendefinitionen ohne Initialisierung erzeugen
+ * keine Anweisung, Blöcke werden eingebettet.
+ */
+static void lowerStmt(Lowering *self, const Stmt *stmt, LowStmt **out) {
+	LowExpr expr;
+	
+	switch (stmt->tag) {
+	case STMT_EMPTY:
+		break;
+		
+	case STMT_IF:
+		expr = lowerExpr(self, &stmt->if_stmt.cond);
+		vecPush(*out) = (LowStmt) {
+			.tag = LOW_STMT_IF,
+			.if_stmt.cond = BOX(expr),
+			.if_stmt.then = lowerBody(self, stmt->if_stmt.if_true),
+			.if_stmt.otherwise = lowerBody(self, stmt->if_stmt.if_false)
+		};
+		break;
+		
+	case STMT_FOR: {
+		const ForStmt *for_stmt = &stmt->for_stmt;
+		
+		if (for_stmt->init.tag == FOR_INIT_VAR_DEF) {
+			lowerVarDef(self, &for_stmt->init.var_def, out);
+		} else {
+			LowExpr init = lowerStore(self, for_stmt->init.assign.lhs.res, for_stmt->init.assign.rhs);
+			vecPush(*out) = (LowStmt) { .tag = LOW_STMT_EXPR, .expr = BOX(init) };
+		}
+		
+		LowExpr cond = lowerExpr(self, &for_stmt->cond);
+		LowExpr step = lowerStore(self, for_stmt->update.lhs.res, for_stmt->update.rhs);
+		vecPush(*out) = (LowStmt) {
+			.tag = LOW_STMT_LOOP,
+			.loop.cond = BOX(cond),
+			.loop.body = lowerBody(self, for_stmt->body),
+			.loop.step = BOX(step)
+		};
+		break;
+	}
+	
+	case STMT_WHILE:
+		expr = lowerExpr(self, &stmt->while_stmt.cond);
+		vecPush(*out) = (LowStmt) {
+			.tag = LOW_STMT_LOOP,
+			.loop.cond = BOX(expr),
+			.loop.body = lowerBody(self, stmt->while_stmt.body)
+		};
+		break;
+		
+	case STMT_DO_WHILE:
+		expr = lowerExpr(self, &stmt->do_while_stmt.cond);
+		vecPush(*out) = (LowStmt) {
+			.tag = LOW_STMT_DO,
+			.loop.cond = BOX(expr),
+			.loop.body = lowerBody(self, stmt->do_while_stmt.body)
+		};
+		break;
+		
+	case STMT_RETURN:
+		if (stmt->return_stmt.tag == EXPR_INVALID) {
+			vecPush(*out) = (LowStmt) { .tag = LOW_STMT_RETURN };
+		} else {
+			expr = lowerConverted(self, &stmt->return_stmt, self->ret_type);
+			vecPush(*out) = (LowStmt) { .tag = LOW_STMT_RETURN, .expr = BOX(expr) };
+		}
+		break;
+		
+	case STMT_PRINT: {
+		LowPrint *print = NULL;
+		
+		vecForEach(const Expr *arg, stmt->print_stmt.expressions) {
+			vecPush(print) = (LowPrint) { lowerExpr(self, arg), arg->data_type };
+		}
+		
+		vecPush(*out) = (LowStmt) { .tag = LOW_STMT_PRINT, .print = print };
+		break;
+	}
+	
+	case STMT_VAR_DEF:
+		lowerVarDef(self, &stmt->var_def, out);
+		break;
+		
+	case STMT_ASSIGN:
+		expr = lowerStore(self, stmt->assign.lhs.res, stmt->assign.rhs);
+		vecPush(*out) = (LowStmt) { .tag = LOW_STMT_EXPR, .expr = BOX(expr) };
+		break;
+		
+	case STMT_CALL:
+		expr = lowerCall(self, &stmt->call);
+		vecPush(*out) = (LowStmt) { .tag = LOW_STMT_EXPR, .expr = BOX(expr) };
+		break;
+		
+	case STMT_BLOCK:
+		vecForEach(const Stmt *inner, stmt->block.statements) {
+			lowerStmt(self, inner, out);
+		}
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Reserviert einen neuen Stack-Frame mit \p size Einträgen und gibt
+ * dessen Beginn zurück.
+ */
+static unsigned int lowReserve(LowInterp *self, unsigned int size) {
+	unsigned int frame = self->top;
+	
+	if (self->top + size > self->cap) {
+		while (self->top + size > self->cap) {
+			self->cap = self->cap ? 2*self->cap : 256;
+		}
+		
+		self->stack = realloc(self->stack, self->cap*sizeof(*self->stack));
+		if (self->stack == NULL) {
+			fputs("out-of-memory error\n", stderr);
+			exit(-1);
+		}
+	}
+	
+	self->top += size;
+	return frame;
+}
+
+/**
+ * @internal
+ * @brief Ruft eine Funktion mit den übergebenen Argumenten auf.
+ *
+ * Die Argumente werden von links nach rechts berechnet und direkt in den
+ * neuen Frame geschrieben.
+ */
+static Value lowCall(LowInterp *self, const LowExpr *call) {
+	const LowFunc *func = &self->prog->funcs[call->func];
+	unsigned int frame = lowReserve(self, func->frame_size);
+	
+	for (unsigned int i = 0; i < func->param_count; ++i) {
+		Value arg = lowEval(self, &call->args[i]);
+		self->stack[frame + i] = arg;
+	}
+	
+	unsigned int base = self->base;
+	self->base = frame;
+	
+	vecForEach(const LowStmt *stmt, func->body) {
+		if (lowExec(self, stmt) == FLOW_RETURN) { break; }
+	}
+	
+	self->base = base;
+	self->top = frame;
+	return self->ret;
+}
+
+/**
+ * @internal
+ * @brief Berechnet den Wert eines Ausdrucks.
+ *
+ * Beide Operanden werden in getrennten Deklarationen berechnet, damit die
+ * Auswertungsreihenfolge von links nach rechts garantiert ist.
+ */
+static Value lowEval(LowInterp *self, const LowExpr *expr) {
+	Value result;
+	
+/* Hilfsmakros für binäre Operationen */
+#define ARITH_I(OP) { \
+	Value lhs = lowEval(self, expr->lhs); \
+	Value rhs = lowEval(self, expr->rhs); \
+	result.i = (int) ((unsigned int) lhs.i OP (unsigned int) rhs.i); \
+	return result; \
+}
+#define BINARY(DST, SRC, OP) { \
+	Value lhs = lowEval(self, expr->lhs); \
+	Value rhs = lowEval(self, expr->rhs); \
+	result.DST = lhs.SRC OP rhs.SRC; \
+	return result; \
+}
+	
+	switch (expr->op) {
+	case LOW_CONST:
+		return expr->value;
+		
+	case LOW_LOCAL:
+		return self->stack[self->base + expr->slot];
+		
+	case LOW_GLOBAL:
+		return self->globals[expr->slot];
+		
+	case LOW_SET_LOCAL:
+		result = lowEval(self, expr->lhs);
+		self->stack[self->base + expr->slot] = result;
+		return result;
+		
+	case LOW_SET_GLOBAL:
+		result = lowEval(self, expr->lhs);
+		self->globals[expr->slot] = result;
+		return result;
+		
+	case LOW_CALL:
+		return lowCall(self, expr);
+		
+	case LOW_I2F:
+		result.f = lowEval(self, expr->lhs).i;
+		return result;
+		
+	case LOW_NEG_I:
+		result.i = (int) (0u - (unsigned int) lowEval(self, expr->lhs).i);
+		return result;
+		
+	case LOW_NEG_F:
+		result.f = -lowEval(self, expr->lhs).f;
+		return result;
+		
+	case LOW_ADD_I: ARITH_I(+)
+	case LOW_SUB_I: ARITH_I(-)
+	case LOW_MUL_I: ARITH_I(*)
+	case LOW_DIV_I: BINARY(i, i, /)
+	case LOW_ADD_F: BINARY(f, f, +)
+	case LOW_SUB_F: BINARY(f, f, -)
+	case LOW_MUL_F: BINARY(f, f, *)
+	case LOW_DIV_F: BINARY(f, f, /)
+	case LOW_EQ_I:  BINARY(i, i, ==)
+	case LOW_NEQ_I: BINARY(i, i, !=)
+	case LOW_LT_I:  BINARY(i, i, <)
+	case LOW_GT_I:  BINARY(i, i, >)
+	case LOW_LEQ_I: BINARY(i, i, <=)
+	case LOW_GEQ_I: BINARY(i, i, >=)
+	case LOW_EQ_F:  BINARY(i, f, ==)
+	case LOW_NEQ_F: BINARY(i, f, !=)
+	case LOW_LT_F:  BINARY(i, f, <)
+	case LOW_GT_F:  BINARY(i, f, >)
+	case LOW_LEQ_F: BINARY(i, f, <=)
+	case LOW_GEQ_F: BINARY(i, f, >=)
+	case LOW_EQ_B:  BINARY(i, i, ==)
+	case LOW_NEQ_B: BINARY(i, i, !=)
+	
+	case LOW_AND:
+		result.i = lowEval(self, expr->lhs).i && lowEval(self, expr->rhs).i;
+		return result;
+		
+	case LOW_OR:
+		result.i = lowEval(self, expr->lhs).i || lowEval(self, expr->rhs).i;
+		return result;
+	}
+	
+#undef ARITH_I
+#undef BINARY
+	
+	assert(0);
+	result.i = 0;
+	return result;
+}
+
+/**
+ * @internal
+ * @brief Führt eine Liste von Anweisungen der Reihe nach aus.
+ */
+static Flow lowExecAll(LowInterp *self, const LowStmt *stmts) {
+	vecForEach(const LowStmt *stmt, stmts) {
+		if (lowExec(self, stmt) == FLOW_RETURN) { return FLOW_RETURN; }
+	}
+	
+	return FLOW_NEXT;
+}
+
+/**
+ * @internal
+ * @brief Führt eine Anweisung aus.
+ */
+static Flow lowExec(LowInterp *self, const LowStmt *stmt) {
+	switch (stmt->tag) {
+	case LOW_STMT_EXPR:
+		lowEval(self, stmt->expr);
+		break;
+		
+	case LOW_STMT_IF:
+		return lowExecAll(self, lowEval(self, stmt->if_stmt.cond).i
+			? stmt->if_stmt.then
+			: stmt->if_stmt.otherwise);
+			
+	case LOW_STMT_LOOP:
+		while (lowEval(self, stmt->loop.cond).i) {
+			if (lowExecAll(self, stmt->loop.body) == FLOW_RETURN) { return FLOW_RETURN; }
+			if (stmt->loop.step != NULL) { lowEval(self, stmt->loop.step); }
+		}
+		break;
+		
+	case LOW_STMT_DO:
+		do {
+			if (lowExecAll(self, stmt->loop.body) == FLOW_RETURN) { return FLOW_RETURN; }
+		} while (lowEval(self, stmt->loop.cond).i);
+		break;
+		
+	case LOW_STMT_RETURN:
+		if (stmt->expr != NULL) {
+			self->ret = lowEval(self, stmt->expr);
+		}
+		return FLOW_RETURN;
+		
+	case LOW_STMT_PRINT:
+		vecForEach(const LowPrint *print, stmt->print) {
+			interpValuePrint(lowEval(self, &print->expr), print->type, self->out);
+		}
+		outChar(self->out, '\n');
+		break;
+	}
+	
+	return FLOW_NEXT;
+}
+
+/**
+ * @internal
+ * @brief Gibt den Speicher eines Ausdrucks frei.
+ */
+static void lowExprRelease(LowExpr *self) {
+	if (self->lhs != NULL) {
+		lowExprRelease(self->lhs);
+		free(self->lhs);
+	}
+	
+	if (self->rhs != NULL) {
+		lowExprRelease(self->rhs);
+		free(self->rhs);
+	}
+	
+	vecForEach(LowExpr *arg, self->args) {
+		lowExprRelease(arg);
+	}
+	
+	vecRelease(self->args);
+}
+
+/**
+ * @internal
+ * @brief Gibt einen geboxten Ausdruck frei, falls vorhanden.
+ */
+static void lowExprFree(LowExpr *self) {
+	if (self != NULL) {
+		lowExprRelease(self);
+		free(self);
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt den Speicher einer Anweisungsliste frei.
+ */
+static void lowStmtsRelease(LowStmt *stmts) {
+	vecForEach(LowStmt *stmt, stmts) {
+		switch (stmt->tag) {
+		case LOW_STMT_EXPR:
+		case LOW_STMT_RETURN:
+			lowExprFree(stmt->expr);
+			break;
+			
+		case LOW_STMT_IF:
+			lowExprFree(stmt->if_stmt.cond);
+			lowStmtsRelease(stmt->if_stmt.then);
+			lowStmtsRelease(stmt->if_stmt.otherwise);
+			break;
+			
+		case LOW_STMT_LOOP:
+		case LOW_STMT_DO:
+			lowExprFree(stmt->loop.cond);
+			lowStmtsRelease(stmt->loop.body);
+			lowExprFree(stmt->loop.step);
+			break;
+			
+		case LOW_STMT_PRINT:
+			vecForEach(LowPrint *print, stmt->print) {
+				lowExprRelease(&print->expr);
+			}
+			vecRelease(stmt->print);
+			break;
+		}
+	}
+	
+	vecRelease(stmts);
+}
+
+/* *** implementation ******************************************************* */
+
+LowProgram lowerProgram(const Program *ast, const SymDefTable *tab) {
+	Lowering self = { .ast = ast, .defs = tab->definitions };
+	LowProgram result = {
+		.global_count = tab->global_count,
+		.main_func = tab->definitions[tab->main_func.index].func.item_id.index
+	};
+	
+	vecForEach(const Item *item, ast->items) {
+		(void) item;
+		vecPush(result.funcs) = (LowFunc) { 0 };
+	}
+	
+	vecForEach(const DefInfo *def, tab->definitions) {
+		if (def->tag != SYM_DEF_FUNC) { continue; }
+		
+		const FuncDef *func_def = &ast->items[def->func.item_id.index].func_def;
+		LowFunc *func = &result.funcs[def->func.item_id.index];
+		
+		self.ret_type = def->func.return_type;
+		func->frame_size = vecLen(def->func.local_vars);
+		func->param_count = def->func.param_count;
+		
+		vecForEach(const Stmt *stmt, func_def->statements) {
+			lowerStmt(&self, stmt, &func->body);
+		}
+	}
+	
+	vecForEach(const Item *item, ast->items) {
+		if (item->tag == ITEM_GLOBAL_VAR) {
+			lowerVarDef(&self, &item->var_def, &result.init);
+		}
+	}
+	
+	return result;
+}
+
+void lowRun(const LowProgram *prog, Out *out) {
+	LowInterp self = {
+		.prog = prog,
+		.globals = calloc(prog->global_count + 1, sizeof(Value)),
+		.out = out
+	};
+	
+	if (self.globals == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	lowExecAll(&self, prog->init);
+	lowCall(&self, &(LowExpr) { .op = LOW_CALL, .func = prog->main_func });
+	
+	free(self.globals);
+	free(self.stack);
+}
+
+void lowRelease(LowProgram *self) {
+	vecForEach(LowFunc *func, self->funcs) {
+		lowStmtsRelease(func->body);
+	}
+	
+	vecRelease(self->funcs);
+	lowStmtsRelease(self->init);
+}
@@ -0,0 +1,186 @@
+/***************************************************************************//**
+ * @file lower.h
+ * @brief Typspezialisierte Zwischendarstellung für C1-Programme.
+ *
+ * # Überblick
+ *
+ * Nach der semantischen Analyse besitzt jeder Ausdruck einen festen
+ * Datentyp. Die hier beschriebene Absenkung (*lowering*) übersetzt den
+ * abstrakten Syntaxbaum in einen Baum, dessen Operationen bereits nach diesen
+ * Typen spezialisiert sind:
+ *
+ * - Arithmetik auf `int` und `float` sowie Vergleiche von `int`, `float` und
+ *   `bool` sind jeweils eigene Operationen.
+ * - Die implizite Umwandlung von `int` nach `float` aus den
+ *   Kompatibilitätsregeln der Sprache wird als eigener Knoten `LOW_I2F`
+ *   explizit gemacht.
+ * - Variablenzugriffe verweisen direkt auf ihren Speicherplatz, Funktions-
+ *   aufrufe direkt auf die gerufene Funktion.
+ * - Blöcke werden in die umgebende Anweisungsliste eingebettet und
+ *   `for`-Schleifen in eine Initialisierung und eine Schleife mit optionaler
+ *   Fortschaltung zerlegt.
+ *
+ * Der zugehörige Auswerter legt alle Werte als untypisierte 8-Byte-Slots
+ * (`Value`) ab und führt zur Laufzeit keinerlei Typprüfungen durch.
+ ******************************************************************************/
+
+#ifndef LOWER_H_INCLUDED
+#define LOWER_H_INCLUDED
+
+/* *** Includes ************************************************************* */
+
+#include <stdio.h>
+#include "ast.h"
+#include "symtab.h"
+#include "interp.h"
+
+/* *** Strukturen *********************************************************** */
+
+/**
+ * @brief Die Operationen der typspezialisierten Ausdrücke.
+ */
+typedef enum LowOp {
+	LOW_CONST,      /**<@brief Konstanter Wert `value`. */
+	LOW_LOCAL,      /**<@brief Lokale Variable `slot`. */
+	LOW_GLOBAL,     /**<@brief Globale Variable `slot`. */
+	LOW_SET_LOCAL,  /**<@brief Zuweisung von `lhs` an lokale Variable `slot`. */
+	LOW_SET_GLOBAL, /**<@brief Zuweisung von `lhs` an globale Variable `slot`. */
+	LOW_CALL,       /**<@brief Aufruf der Funktion `func` mit `args`. */
+	LOW_I2F,        /**<@brief Umwandlung von `lhs` nach `float`. */
+	LOW_NEG_I,
+	LOW_NEG_F,
+	LOW_ADD_I,
+	LOW_SUB_I,
+	LOW_MUL_I,
+	LOW_DIV_I,
+	LOW_ADD_F,
+	LOW_SUB_F,
+	LOW_MUL_F,
+	LOW_DIV_F,
+	LOW_EQ_I,
+	LOW_NEQ_I,
+	LOW_LT_I,
+	LOW_GT_I,
+	LOW_LEQ_I,
+	LOW_GEQ_I,
+	LOW_EQ_F,
+	LOW_NEQ_F,
+	LOW_LT_F,
+	LOW_GT_F,
+	LOW_LEQ_F,
+	LOW_GEQ_F,
+	LOW_EQ_B,
+	LOW_NEQ_B,
+	LOW_AND,        /**<@brief Logisches Und mit Kurzschlussauswertung. */
+	LOW_OR          /**<@brief Logisches Oder mit Kurzschlussauswertung. */
+} LowOp;
+
+/**
+ * @brief Ein typspezialisierter Ausdruck.
+ */
+typedef struct LowExpr {
+	LowOp op;
+
+	union {
+		Value value;       /**<@brief Wert für `LOW_CONST`. */
+		unsigned int slot; /**<@brief Speicherplatz einer Variablen. */
+		unsigned int func; /**<@brief Gerufene Funktion (`ItemId`). */
+	};
+
+	struct LowExpr *lhs;  /**<@brief (Linker) Operand. */
+	struct LowExpr *rhs;  /**<@brief Rechter Operand. */
+	struct LowExpr *args; /**<@brief Vektor der Argumente für `LOW_CALL`. */
+} LowExpr;
+
+/**
+ * @brief Ein Ausdruck der `print`-Anweisung mit seinem Datentyp.
+ */
+typedef struct LowPrint {
+	LowExpr expr;
+	DataType type;
+} LowPrint;
+
+/**
+ * @brief Eine Anweisung der typspezialisierten Darstellung.
+ *
+ * Alle Anweisungslisten sind Vektoren.
+ */
+typedef struct LowStmt {
+	enum {
+		LOW_STMT_EXPR,   /**<@brief Ausdruck, dessen Wert verworfen wird. */
+		LOW_STMT_IF,
+		LOW_STMT_LOOP,   /**<@brief Kopfgesteuerte Schleife. */
+		LOW_STMT_DO,     /**<@brief Fußgesteuerte Schleife. */
+		LOW_STMT_RETURN,
+		LOW_STMT_PRINT
+	} tag;
+
+	union {
+		/** Ausdruck (`LOW_STMT_EXPR`) oder Rückgabewert (`LOW_STMT_RETURN`). */
+		LowExpr *expr;
+
+		struct {
+			LowExpr *cond;
+			struct LowStmt *then;
+			struct LowStmt *otherwise;
+		} if_stmt;
+
+		/** `LOW_STMT_LOOP` und `LOW_STMT_DO`; `step` kann `NULL` sein. */
+		struct {
+			LowExpr *cond;
+			struct LowStmt *body;
+			LowExpr *step;
+		} loop;
+
+		LowPrint *print;
+	};
+} LowStmt;
+
+/**
+ * @brief Eine abgesenkte Funktion.
+ */
+typedef struct LowFunc {
+	LowStmt *body;            /**<@brief Die Anweisungen der Funktion. */
+	unsigned int frame_size;  /**<@brief Anzahl lokaler Variablen. */
+	unsigned int param_count; /**<@brief Anzahl der Parameter. */
+} LowFunc;
+
+/**
+ * @brief Ein abgesenktes Programm.
+ */
+typedef struct LowProgram {
+	LowFunc *funcs;            /**<@brief Funktionen, indiziert durch `ItemId`. */
+	LowStmt *init;             /**<@brief Initialisierung globaler Variablen. */
+	unsigned int global_count; /**<@brief Anzahl globaler Variablen. */
+	unsigned int main_func;    /**<@brief `ItemId` der Funktion `main()`. */
+} LowProgram;
+
+/* *** Öffentliche Schnittstelle ******************************************** */
+
+/**
+ * @brief Senkt ein semantisch analysiertes Programm ab.
+ *
+ * Zeichenkettenkonstanten verweisen weiterhin in den Syntaxbaum, der somit
+ * mindestens so lange leben muss wie das Ergebnis.
+ *
+ * @param ast Die Wurzel des abstrakten Syntaxbaumes.
+ * @param tab Die Definitionstabelle des Programms.
+ * @return Das abgesenkte Programm.
+ */
+extern LowProgram lowerProgram(const Program *ast, const SymDefTable *tab);
+
+/**
+ * @brief Führt ein abgesenktes Programm aus.
+ *
+ * @param self Das auszuführende Programm.
+ * @param out  Der Ausgabepuffer für die `print`-Anweisung.
+ */
+extern void lowRun(const LowProgram *self, Out *out);
+
+/**
+ * @brief Gibt den Speicher eines abgesenkten Programms frei.
+ * @param self Das freizugebende Programm.
+ */
+extern void lowRelease(LowProgram *self);
+
+#endif
@@ -0,0 +1,2715 @@
+/***************************************************************************//**
+ * @file opt.c
+ * @brief Implementation der Optimierungen auf dem Syntaxbaum.
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <assert.h>
+#include "opt.h"
+#include "vec.h"
+
+/* *** internal structures ************************************************** */
+
+/**
+ * @internal
+ * @brief Zustand der Entfernung toten Codes.
+ */
+typedef struct {
+	unsigned int *reads;  /**<@brief Anzahl lesender Zugriffe je `DefId`. */
+	unsigned int removed; /**<@brief Anzahl entfernter Anweisungen. */
+	int changed;          /**<@brief Ob der Syntaxbaum verändert wurde. */
+} Dce;
+
+/**
+ * @internal
+ * @brief Wirkungen einer Funktion oder Schleife, die das Verschieben von
+ * Ausdrücken einschränken.
+ */
+enum {
+	EFFECT_READS_GLOBAL  = 1, /**<@brief Liest eine globale Variable. */
+	EFFECT_WRITES_GLOBAL = 2, /**<@brief Schreibt eine globale Variable. */
+	EFFECT_PRINTS        = 4, /**<@brief Führt eine `print`-Anweisung aus. */
+	EFFECT_MAY_FAIL      = 8  /**<@brief Kann abbrechen oder nicht terminieren. */
+};
+
+/**
+ * @internal
+ * @brief Ergebnis der Untersuchung eines Funktionsrumpfes oder einer Schleife.
+ */
+typedef struct {
+	const DefInfo *defs;           /**<@brief Die Definitionstabelle. */
+	const unsigned char *effects;  /**<@brief Bekannte Wirkungen je `DefId` einer Funktion oder `NULL`. */
+	unsigned char *assigned;       /**<@brief Markiert zugewiesene Variablen je `DefId` oder `NULL`. */
+	unsigned char flags;           /**<@brief Die gefundenen Wirkungen. */
+	DefId *callees;                /**<@brief Vektor der aufgerufenen Funktionen. */
+} Scan;
+
+/**
+ * @internal
+ * @brief Zustand der Verschiebung schleifeninvarianter Ausdrücke.
+ */
+typedef struct {
+	SymDefTable *tab;            /**<@brief Die um Hilfsvariablen erweiterte Definitionstabelle. */
+	unsigned char *effects;      /**<@brief Wirkungen je `DefId` einer Funktion. */
+	DefId func;                  /**<@brief Die Funktion, deren Schleifen untersucht werden. */
+	unsigned char *assigned;     /**<@brief In der aktuellen Schleife zugewiesene Variablen je `DefId`. */
+	unsigned int assigned_count; /**<@brief Länge von `assigned`. */
+	int writes_global;           /**<@brief Ob die aktuelle Schleife globale Variablen schreiben kann. */
+	int clean;                   /**<@brief Ob bisher im Schleifenrumpf nichts Beobachtbares ausgewertet wurde. */
+	int unsafe;                  /**<@brief Ob ein möglicherweise abbrechender Ausdruck verschoben wurde. */
+	Stmt *hoists;                /**<@brief Vektor der Definitionen der Hilfsvariablen der aktuellen Schleife. */
+	unsigned int temps;          /**<@brief Anzahl angelegter Hilfsvariablen. */
+	unsigned int hoisted;        /**<@brief Anzahl ersetzter Ausdrücke. */
+} Licm;
+
+/**
+ * @internal
+ * @brief Art, in der ein Parameter beim Einsetzen eines Ausdrucks ersetzt wird.
+ */
+enum {
+	PARAM_SUBST, /**<@brief Jede Verwendung wird durch eine Kopie des Arguments ersetzt. */
+	PARAM_BIND,  /**<@brief Die erste Verwendung weist das Argument einer Hilfsvariablen zu. */
+	PARAM_DROP   /**<@brief Der Parameter wird nicht verwendet, das Argument entfällt. */
+};
+
+/**
+ * @internal
+ * @brief Ersetzungen beim Kopieren eines Funktionsrumpfes an eine
+ * Aufrufstelle.
+ */
+typedef struct {
+	const DefId *map;           /**<@brief Neue `DefId` je `DefId` oder `NULL`. */
+	const DefId *params;        /**<@brief Die Parameter der eingesetzten Funktion oder `NULL`. */
+	unsigned int param_count;   /**<@brief Anzahl der Parameter. */
+	Expr *args;                 /**<@brief Die Argumente des Aufrufs; gebundene werden verschoben. */
+	const unsigned char *modes; /**<@brief Art der Ersetzung je Parameter. */
+	const Expr **sites;         /**<@brief Die Verwendung, an der ein Parameter gebunden wird. */
+	const DefId *temps;         /**<@brief Die Hilfsvariable je gebundenem Parameter. */
+} Subst;
+
+/**
+ * @internal
+ * @brief Prüfung, ob die Argumente eines eingesetzten Ausdrucks bei der ersten
+ * Verwendung ihres Parameters berechnet werden dürfen.
+ */
+typedef struct {
+	const DefInfo *defs;        /**<@brief Die Definitionstabelle. */
+	const DefId *params;        /**<@brief Die Parameter der eingesetzten Funktion. */
+	unsigned int param_count;   /**<@brief Anzahl der Parameter. */
+	const unsigned char *modes; /**<@brief Art der Ersetzung je Parameter. */
+	const Expr **sites;         /**<@brief Die gefundene Verwendung je gebundenem Parameter. */
+	int ok;                     /**<@brief Ob die Reihenfolge der Auswertung erhalten bleibt. */
+} Binding;
+
+/**
+ * @internal
+ * @brief Zustand des Inlinings.
+ */
+typedef struct {
+	Program *ast;             /**<@brief Der Syntaxbaum. */
+	SymDefTable *tab;         /**<@brief Die um Hilfsvariablen erweiterte Definitionstabelle. */
+	unsigned int threshold;   /**<@brief Maximale Größe eines eingesetzten Funktionsrumpfes. */
+	DefId **callees;          /**<@brief Vektor der aufgerufenen Funktionen je `DefId`. */
+	unsigned char *recursive; /**<@brief Ob eine Funktion sich selbst aufrufen kann, je `DefId`. */
+	unsigned char *done;      /**<@brief Ob eine Funktion bereits bearbeitet wurde, je `DefId`. */
+	DefId func;               /**<@brief Die Funktion, deren Aufrufe ersetzt werden. */
+	unsigned int inlined;     /**<@brief Anzahl ersetzter Aufrufe. */
+} Inliner;
+
+/* *** internal helpers ***************************************************** */
+
+/* forward declarations */
+static void foldExpr(Expr*, unsigned int*);
+static void foldStmt(Stmt*, unsigned int*);
+static void dceStmt(Dce*, Stmt*);
+static void scanStmt(Scan*, const Stmt*);
+static void licmStmt(Licm*, Stmt*);
+static void dropExpr(Expr*);
+static void inlineList(Inliner*, Stmt**);
+
+/**
+ * @internal
+ * @brief Gibt zurück, ob \p expr ein Literal mit dem Zahlenwert \p value ist.
+ */
+static int isNumber(const Expr *expr, int value) {
+	if (expr->tag != EXPR_LITERAL) { return 0; }
+	
+	switch (expr->literal.tag) {
+	case LITERAL_INT:   return expr->literal.iVal == value;
+	case LITERAL_FLOAT: return expr->literal.fVal == value;
+	default:            return 0;
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt zurück, ob \p expr das Literal `true` bzw. `false` ist.
+ */
+static inline int isBool(const Expr *expr, int value) {
+	return expr->tag == EXPR_LITERAL && expr->literal.tag == LITERAL_BOOL && (expr->literal.bVal != 0) == value;
+}
+
+/**
+ * @internal
+ * @brief Gibt einen Ausdruck samt der Speicher seiner Operanden frei.
+ */
+static void releaseExpr(Expr *expr) {
+	switch (expr->tag) {
+	case EXPR_BIN_OP:
+		dropExpr(expr->bin_op.lhs);
+		dropExpr(expr->bin_op.rhs);
+		break;
+		
+	case EXPR_UNARY_MINUS:
+		dropExpr(expr->unary_minus);
+		break;
+		
+	default:
+		astExprRelease(expr);
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt einen Teilausdruck samt seines Speichers frei.
+ */
+static void dropExpr(Expr *expr) {
+	releaseExpr(expr);
+	free(expr);
+}
+
+/**
+ * @internal
+ * @brief Ersetzt einen Ausdruck durch seinen Teilausdruck \p keep und gibt
+ * den Teilausdruck \p drop frei, der `NULL` sein kann.
+ */
+static void replaceExpr(Expr *expr, Expr *keep, Expr *drop, unsigned int *removed) {
+	Expr tmp = *keep;
+	free(keep);
+	
+	if (drop != NULL) {
+		*removed += optExprSize(drop);
+		dropExpr(drop);
+	}
+	
+	*removed += 1;
+	*expr = tmp;
+}
+
+/**
+ * @internal
+ * @brief Ersetzt eine Operation durch ein Literal; der Typ des Ausdrucks
+ * bleibt erhalten.
+ */
+static void replaceWithLiteral(Expr *expr, Literal literal, unsigned int *removed) {
+	*removed += optExprSize(expr) - 1;
+	DataType type = expr->data_type;
+	
+	if (expr->tag == EXPR_BIN_OP) {
+		dropExpr(expr->bin_op.lhs);
+		dropExpr(expr->bin_op.rhs);
+	} else {
+		dropExpr(expr->unary_minus);
+	}
+	
+	*expr = (Expr) { .tag = EXPR_LITERAL, .data_type = type, .literal = literal };
+}
+
+/**
+ * @internal
+ * @brief Gibt den Zahlenwert eines `int`- oder `float`-Literals zurück.
+ */
+static inline double toFloat(const Literal *literal) {
+	return literal->tag == LITERAL_FLOAT ? literal->fVal : literal->iVal;
+}
+
+/**
+ * @internal
+ * @brief Berechnet eine Operation auf zwei Literalen.
+ *
+ * @return `0`, falls die Operation zur Laufzeit ausgewertet werden muss, da
+ *         ihr Ergebnis überläuft, nicht endlich ist oder durch `0` geteilt
+ *         wird.
+ */
+static int foldLiterals(BinOp op, const Literal *lhs, const Literal *rhs, Literal *result) {
+	if (lhs->tag == LITERAL_FLOAT || rhs->tag == LITERAL_FLOAT) {
+		double a = toFloat(lhs), b = toFloat(rhs);
+		
+		double value;
+		
+		switch (op) {
+		case BIN_OP_ADD: value = a + b; break;
+		case BIN_OP_SUB: value = a - b; break;
+		case BIN_OP_MUL: value = a * b; break;
+		case BIN_OP_DIV: value = a / b; break;
+		case BIN_OP_EQ:  *result = (Literal) { LITERAL_BOOL, .bVal = a == b }; return 1;
+		case BIN_OP_NEQ: *result = (Literal) { LITERAL_BOOL, .bVal = a != b }; return 1;
+		case BIN_OP_LT:  *result = (Literal) { LITERAL_BOOL, .bVal = a < b }; return 1;
+		case BIN_OP_GT:  *result = (Literal) { LITERAL_BOOL, .bVal = a > b }; return 1;
+		case BIN_OP_LEQ: *result = (Literal) { LITERAL_BOOL, .bVal = a <= b }; return 1;
+		case BIN_OP_GEQ: *result = (Literal) { LITERAL_BOOL, .bVal = a >= b }; return 1;
+		default:         return 0;
+		}
+		
+		/* like in the source, literals are always finite */
+		if (!isfinite(value)) { return 0; }
+		
+		*result = (Literal) { LITERAL_FLOAT, .fVal = value };
+		return 1;
+	}
+	
+	/* `bool` literals compare like `int` literals */
+	long long a = lhs->tag == LITERAL_BOOL ? lhs->bVal != 0 : lhs->iVal;
+	long long b = rhs->tag == LITERAL_BOOL ? rhs->bVal != 0 : rhs->iVal;
+	long long value;
+	
+	switch (op) {
+	case BIN_OP_ADD: value = a + b; break;
+	case BIN_OP_SUB: value = a - b; break;
+	case BIN_OP_MUL: value = a * b; break;
+	
+	case BIN_OP_DIV:
+		if (b == 0) { return 0; }
+		value = a / b;
+		break;
+		
+	case BIN_OP_EQ:  *result = (Literal) { LITERAL_BOOL, .bVal = a == b }; return 1;
+	case BIN_OP_NEQ: *result = (Literal) { LITERAL_BOOL, .bVal = a != b }; return 1;
+	case BIN_OP_LT:  *result = (Literal) { LITERAL_BOOL, .bVal = a < b }; return 1;
+	case BIN_OP_GT:  *result = (Literal) { LITERAL_BOOL, .bVal = a > b }; return 1;
+	case BIN_OP_LEQ: *result = (Literal) { LITERAL_BOOL, .bVal = a <= b }; return 1;
+	case BIN_OP_GEQ: *result = (Literal) { LITERAL_BOOL, .bVal = a >= b }; return 1;
+	default:         return 0;
+	}
+	
+	/* the product of two `int` values always fits into `long long` */
+	if (value < INT_MIN || value > INT_MAX) { return 0; }
+	
+	*result = (Literal) { LITERAL_INT, .iVal = (int) value };
+	return 1;
+}
+
+/**
+ * @internal
+ * @brief Faltet `&&` und `||` mit einem literalen Operanden.
+ *
+ * Ein literaler linker Operand entscheidet, ob der rechte ausgewertet wird;
+ * ein literaler rechter Operand kann den linken nur ersetzen, wenn dieser
+ * keine Seiteneffekte hat.
+ */
+static void foldLogical(Expr *expr, unsigned int *removed) {
+	BinOpExpr *bin = &expr->bin_op;
+	int is_or = bin->op == BIN_OP_LOG_OR;
+	
+	if (bin->lhs->tag == EXPR_LITERAL) {
+		/* `true || x` and `false && x` never evaluate `x` */
+		if (isBool(bin->lhs, is_or)) {
+			replaceExpr(expr, bin->lhs, bin->rhs, removed);
+		} else {
+			replaceExpr(expr, bin->rhs, bin->lhs, removed);
+		}
+	} else if (bin->rhs->tag == EXPR_LITERAL) {
+		if (!isBool(bin->rhs, is_or)) {
+			replaceExpr(expr, bin->lhs, bin->rhs, removed);
+		} else if (optExprIsPure(bin->lhs)) {
+			replaceExpr(expr, bin->rhs, bin->lhs, removed);
+		}
+	}
+}
+
+/**
+ * @internal
+ * @brief Vereinfacht algebraische Identitäten mit einem literalen Operanden.
+ *
+ * Ein Operand ersetzt die Operation nur, wenn er bereits deren Typ hat, so
+ * dass keine implizite Umwandlung verloren geht. `x + 0.0` ist wegen
+ * `-0.0 + 0.0 == +0.0` keine Identität und `x * 0` nur für `int`.
+ */
+static void foldIdentity(Expr *expr, unsigned int *removed) {
+	BinOpExpr *bin = &expr->bin_op;
+	Expr *lhs = bin->lhs, *rhs = bin->rhs;
+	int lhs_same = lhs->data_type == expr->data_type;
+	int rhs_same = rhs->data_type == expr->data_type;
+	int is_int = expr->data_type == TYPE_INT;
+	
+	switch (bin->op) {
+	case BIN_OP_ADD:
+		if (is_int && isNumber(rhs, 0)) {
+			replaceExpr(expr, lhs, rhs, removed);
+		} else if (is_int && isNumber(lhs, 0)) {
+			replaceExpr(expr, rhs, lhs, removed);
+		}
+		break;
+		
+	case BIN_OP_SUB:
+		if (lhs_same && isNumber(rhs, 0)) {
+			replaceExpr(expr, lhs, rhs, removed);
+		}
+		break;
+		
+	case BIN_OP_MUL:
+		if (lhs_same && isNumber(rhs, 1)) {
+			replaceExpr(expr, lhs, rhs, removed);
+		} else if (rhs_same && isNumber(lhs, 1)) {
+			replaceExpr(expr, rhs, lhs, removed);
+		} else if (is_int && isNumber(rhs, 0) && optExprIsPure(lhs)) {
+			replaceExpr(expr, rhs, lhs, removed);
+		} else if (is_int && isNumber(lhs, 0) && optExprIsPure(rhs)) {
+			replaceExpr(expr, lhs, rhs, removed);
+		}
+		break;
+		
+	case BIN_OP_DIV:
+		if (lhs_same && isNumber(rhs, 1)) {
+			replaceExpr(expr, lhs, rhs, removed);
+		}
+		break;
+		
+	/* `x == true` and `x != false` are `x` itself */
+	case BIN_OP_EQ:
+	case BIN_OP_NEQ: {
+		int value = bin->op == BIN_OP_EQ;
+		
+		if (lhs->data_type == TYPE_BOOL && isBool(rhs, value)) {
+			replaceExpr(expr, lhs, rhs, removed);
+		} else if (rhs->data_type == TYPE_BOOL && isBool(lhs, value)) {
+			replaceExpr(expr, rhs, lhs, removed);
+		}
+		break;
+	}
+	
+	default:
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Faltet eine binäre Operation, deren Operanden bereits gefaltet sind.
+ */
+static void foldBinOp(Expr *expr, unsigned int *removed) {
+	BinOpExpr *bin = &expr->bin_op;
+	
+	if (bin->op == BIN_OP_LOG_OR || bin->op == BIN_OP_LOG_AND) {
+		foldLogical(expr, removed);
+		return;
+	}
+	
+	Literal result;
+	
+	if (bin->lhs->tag == EXPR_LITERAL && bin->rhs->tag == EXPR_LITERAL) {
+		if (foldLiterals(bin->op, &bin->lhs->literal, &bin->rhs->literal, &result)) {
+			replaceWithLiteral(expr, result, removed);
+		}
+		return;
+	}
+	
+	foldIdentity(expr, removed);
+}
+
+/**
+ * @internal
+ * @brief Faltet einen Ausdruck von den Blättern zur Wurzel.
+ */
+static void foldExpr(Expr *expr, unsigned int *removed) {
+	switch (expr->tag) {
+	case EXPR_ASSIGN:
+		foldExpr(expr->assign.rhs, removed);
+		break;
+		
+	case EXPR_BIN_OP:
+		foldExpr(expr->bin_op.lhs, removed);
+		foldExpr(expr->bin_op.rhs, removed);
+		foldBinOp(expr, removed);
+		break;
+		
+	case EXPR_UNARY_MINUS: {
+		Expr *inner = expr->unary_minus;
+		foldExpr(inner, removed);
+		
+		if (inner->tag == EXPR_UNARY_MINUS) {
+			/* `-(-x)` is `x` even for the wrapping `-INT_MIN` */
+			Expr *value = inner->unary_minus;
+			free(inner);
+			replaceExpr(expr, value, NULL, removed);
+			*removed += 1;
+		} else if (inner->tag == EXPR_LITERAL && inner->literal.tag == LITERAL_FLOAT) {
+			replaceWithLiteral(expr, (Literal) { LITERAL_FLOAT, .fVal = -inner->literal.fVal }, removed);
+		} else if (inner->tag == EXPR_LITERAL && inner->literal.tag == LITERAL_INT && inner->literal.iVal != INT_MIN) {
+			replaceWithLiteral(expr, (Literal) { LITERAL_INT, .iVal = -inner->literal.iVal }, removed);
+		}
+		break;
+	}
+	
+	case EXPR_CALL:
+		vecForEach(Expr *arg, expr->call.args) {
+			foldExpr(arg, removed);
+		}
+		break;
+		
+	case EXPR_INVALID:
+	case EXPR_LITERAL:
+	case EXPR_VAR:
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Faltet alle Ausdrücke einer Anweisung.
+ */
+static void foldStmt(Stmt *stmt, unsigned int *removed) {
+	switch (stmt->tag) {
+	case STMT_EMPTY:
+		break;
+		
+	case STMT_IF:
+		foldExpr(&stmt->if_stmt.cond, removed);
+		foldStmt(stmt->if_stmt.if_true, removed);
+		foldStmt(stmt->if_stmt.if_false, removed);
+		break;
+		
+	case STMT_FOR:
+		if (stmt->for_stmt.init.tag == FOR_INIT_VAR_DEF) {
+			foldExpr(&stmt->for_stmt.init.var_def.init, removed);
+		} else {
+			foldExpr(stmt->for_stmt.init.assign.rhs, removed);
+		}
+		
+		foldExpr(&stmt->for_stmt.cond, removed);
+		foldExpr(stmt->for_stmt.update.rhs, removed);
+		foldStmt(stmt->for_stmt.body, removed);
+		break;
+		
+	case STMT_WHILE:
+	case STMT_DO_WHILE:
+		foldExpr(&stmt->while_stmt.cond, removed);
+		foldStmt(stmt->while_stmt.body, removed);
+		break;
+		
+	case STMT_RETURN:
+		foldExpr(&stmt->return_stmt, removed);
+		break;
+		
+	case STMT_PRINT:
+		vecForEach(Expr *expr, stmt->print_stmt.expressions) {
+			foldExpr(expr, removed);
+		}
+		break;
+		
+	case STMT_VAR_DEF:
+		foldExpr(&stmt->var_def.init, removed);
+		break;
+		
+	case STMT_ASSIGN:
+		foldExpr(stmt->assign.rhs, removed);
+		break;
+		
+	case STMT_CALL:
+		vecForEach(Expr *arg, stmt->call.args) {
+			foldExpr(arg, removed);
+		}
+		break;
+		
+	case STMT_BLOCK:
+		vecForEach(Stmt *inner, stmt->block.statements) {
+			foldStmt(inner, removed);
+		}
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt die Anzahl der Anweisungsknoten in einer Anweisung zurück.
+ */
+static unsigned int stmtSize(const Stmt *stmt) {
+	unsigned int size = 1;
+	
+	switch (stmt->tag) {
+	case STMT_IF:
+		size += stmtSize(stmt->if_stmt.if_true) + stmtSize(stmt->if_stmt.if_false);
+		break;
+		
+	case STMT_FOR:
+		size += stmtSize(stmt->for_stmt.body);
+		break;
+		
+	case STMT_WHILE:
+	case STMT_DO_WHILE:
+		size += stmtSize(stmt->while_stmt.body);
+		break;
+		
+	case STMT_BLOCK:
+		vecForEach(const Stmt *inner, stmt->block.statements) {
+			size += stmtSize(inner);
+		}
+		break;
+		
+	default:
+		break;
+	}
+	
+	return size;
+}
+
+/**
+ * @internal
+ * @brief Gibt eine Anweisung frei und zählt ihre Anweisungsknoten als
+ * entfernt.
+ */
+static void dropStmt(Dce *self, Stmt *stmt) {
+	self->removed += stmtSize(stmt);
+	astStmtRelease(stmt);
+	self->changed = 1;
+}
+
+/**
+ * @internal
+ * @brief Ersetzt eine Anweisung durch die Anweisung \p keep, auf die sie
+ * verweist, und gibt \p drop frei, das `NULL` sein kann.
+ */
+static void replaceStmt(Dce *self, Stmt *stmt, Stmt *keep, Stmt *drop) {
+	Stmt tmp = *keep;
+	free(keep);
+	
+	if (drop != NULL) {
+		dropStmt(self, drop);
+		free(drop);
+	}
+	
+	self->removed += 1;
+	self->changed = 1;
+	*stmt = tmp;
+}
+
+/**
+ * @internal
+ * @brief Ersetzt eine Anweisung durch die leere Anweisung.
+ */
+static void clearStmt(Dce *self, Stmt *stmt) {
+	dropStmt(self, stmt);
+	*stmt = (Stmt) { .tag = STMT_EMPTY };
+}
+
+/**
+ * @internal
+ * @brief Zählt die lesenden Zugriffe auf jede Variable in einem Ausdruck.
+ */
+static void countReads(unsigned int *reads, const Expr *expr) {
+	switch (expr->tag) {
+	case EXPR_ASSIGN:
+		countReads(reads, expr->assign.rhs);
+		break;
+		
+	case EXPR_BIN_OP:
+		countReads(reads, expr->bin_op.lhs);
+		countReads(reads, expr->bin_op.rhs);
+		break;
+		
+	case EXPR_UNARY_MINUS:
+		countReads(reads, expr->unary_minus);
+		break;
+		
+	case EXPR_CALL:
+		vecForEach(const Expr *arg, expr->call.args) {
+			countReads(reads, arg);
+		}
+		break;
+		
+	case EXPR_VAR:
+		++reads[expr->var.res.index];
+		break;
+		
+	case EXPR_INVALID:
+	case EXPR_LITERAL:
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Zählt die lesenden Zugriffe auf jede Variable in einer Anweisung.
+ */
+static void countStmtReads(unsigned int *reads, const Stmt *stmt) {
+	switch (stmt->tag) {
+	case STMT_EMPTY:
+		break;
+		
+	case STMT_IF:
+		countReads(reads, &stmt->if_stmt.cond);
+		countStmtReads(reads, stmt->if_stmt.if_true);
+		countStmtReads(reads, stmt->if_stmt.if_false);
+		break;
+		
+	case STMT_FOR:
+		if (stmt->for_stmt.init.tag == FOR_INIT_VAR_DEF) {
+			countReads(reads, &stmt->for_stmt.init.var_def.init);
+		} else {
+			countReads(reads, stmt->for_stmt.init.assign.rhs);
+		}
+		
+		countReads(reads, &stmt->for_stmt.cond);
+		countReads(reads, stmt->for_stmt.update.rhs);
+		countStmtReads(reads, stmt->for_stmt.body);
+		break;
+		
+	case STMT_WHILE:
+	case STMT_DO_WHILE:
+		countReads(reads, &stmt->while_stmt.cond);
+		countStmtReads(reads, stmt->while_stmt.body);
+		break;
+		
+	case STMT_RETURN:
+		countReads(reads, &stmt->return_stmt);
+		break;
+		
+	case STMT_PRINT:
+		vecForEach(const Expr *expr, stmt->print_stmt.expressions) {
+			countReads(reads, expr);
+		}
+		break;
+		
+	case STMT_VAR_DEF:
+		countReads(reads, &stmt->var_def.init);
+		break;
+		
+	case STMT_ASSIGN:
+		countReads(reads, stmt->assign.rhs);
+		break;
+		
+	case STMT_CALL:
+		vecForEach(const Expr *arg, stmt->call.args) {
+			countReads(reads, arg);
+		}
+		break;
+		
+	case STMT_BLOCK:
+		vecForEach(const Stmt *inner, stmt->block.statements) {
+			countStmtReads(reads, inner);
+		}
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt zurück, ob nach einer Anweisung folgender Code unerreichbar ist.
+ *
+ * Da C1 kein `break` kennt, verlässt der Kontrollfluss eine Schleife mit der
+ * Bedingung `true` nur über `return`.
+ */
+static int terminates(const Stmt *stmt) {
+	switch (stmt->tag) {
+	case STMT_RETURN:
+		return 1;
+		
+	case STMT_IF:
+		return terminates(stmt->if_stmt.if_true) && terminates(stmt->if_stmt.if_false);
+		
+	case STMT_FOR:
+		return isBool(&stmt->for_stmt.cond, 1);
+		
+	case STMT_WHILE:
+		return isBool(&stmt->while_stmt.cond, 1);
+		
+	case STMT_DO_WHILE:
+		return isBool(&stmt->do_while_stmt.cond, 1) || terminates(stmt->do_while_stmt.body);
+		
+	case STMT_BLOCK:
+		vecForEach(const Stmt *inner, stmt->block.statements) {
+			if (terminates(inner)) { return 1; }
+		}
+		return 0;
+		
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @internal
+ * @brief Entfernt leere und unerreichbare Anweisungen aus einer Folge von
+ * Anweisungen.
+ */
+static void dceStmts(Dce *self, Stmt *stmts) {
+	unsigned int count = 0;
+	int reachable = 1;
+	
+	for (unsigned int i = 0; i < vecLen(stmts); ++i) {
+		Stmt *stmt = &stmts[i];
+		
+		if (!reachable) {
+			dropStmt(self, stmt);
+			continue;
+		}
+		
+		dceStmt(self, stmt);
+		reachable = !terminates(stmt);
+		
+		if (stmt->tag == STMT_EMPTY) { continue; }
+		
+		stmts[count++] = *stmt;
+	}
+	
+	while (vecLen(stmts) > count) {
+		(void) vecPop(stmts);
+	}
+}
+
+/**
+ * @internal
+ * @brief Vereinfacht eine Anweisung und die in ihr enthaltenen Anweisungen.
+ */
+static void dceStmt(Dce *self, Stmt *stmt) {
+	switch (stmt->tag) {
+	case STMT_IF: {
+		IfStmt *if_stmt = &stmt->if_stmt;
+		
+		if (if_stmt->cond.tag == EXPR_LITERAL) {
+			int taken = isBool(&if_stmt->cond, 1);
+			astExprRelease(&if_stmt->cond);
+			
+			if (taken) {
+				replaceStmt(self, stmt, if_stmt->if_true, if_stmt->if_false);
+			} else {
+				replaceStmt(self, stmt, if_stmt->if_false, if_stmt->if_true);
+			}
+			
+			dceStmt(self, stmt);
+			break;
+		}
+		
+		dceStmt(self, if_stmt->if_true);
+		dceStmt(self, if_stmt->if_false);
+		break;
+	}
+	
+	case STMT_FOR: {
+		ForStmt *for_stmt = &stmt->for_stmt;
+		
+		/* only the initialisation of a loop that never runs remains */
+		if (isBool(&for_stmt->cond, 0)) {
+			ForInit init = for_stmt->init;
+			
+			astExprRelease(&for_stmt->cond);
+			astAssignRelease(&for_stmt->update);
+			dropStmt(self, for_stmt->body);
+			free(for_stmt->body);
+			self->removed += 1;
+			
+			if (init.tag == FOR_INIT_VAR_DEF) {
+				*stmt = (Stmt) { .tag = STMT_VAR_DEF, .var_def = init.var_def };
+			} else {
+				*stmt = (Stmt) { .tag = STMT_ASSIGN, .assign = init.assign };
+			}
+			
+			dceStmt(self, stmt);
+			break;
+		}
+		
+		dceStmt(self, for_stmt->body);
+		break;
+	}
+	
+	case STMT_WHILE:
+		if (isBool(&stmt->while_stmt.cond, 0)) {
+			clearStmt(self, stmt);
+			break;
+		}
+		
+		dceStmt(self, stmt->while_stmt.body);
+		break;
+		
+	case STMT_DO_WHILE:
+		/* the body of `do ... while (false)` runs exactly once */
+		if (isBool(&stmt->do_while_stmt.cond, 0)) {
+			replaceStmt(self, stmt, stmt->do_while_stmt.body, NULL);
+			dceStmt(self, stmt);
+			break;
+		}
+		
+		dceStmt(self, stmt->do_while_stmt.body);
+		break;
+		
+	case STMT_VAR_DEF:
+		if (self->reads[stmt->var_def.res_ident.res.index] == 0 && optExprIsPure(&stmt->var_def.init)) {
+			clearStmt(self, stmt);
+		}
+		break;
+		
+	case STMT_ASSIGN:
+		if (self->reads[stmt->assign.lhs.res.index] == 0 && optExprIsPure(stmt->assign.rhs)) {
+			clearStmt(self, stmt);
+		}
+		break;
+		
+	case STMT_BLOCK:
+		dceStmts(self, stmt->block.statements);
+		
+		if (vecIsEmpty(stmt->block.statements)) {
+			clearStmt(self, stmt);
+		}
+		break;
+		
+	default:
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Legt einen Ausdruck in eigenem Speicher ab.
+ */
+static Expr* boxExpr(Expr expr) {
+	Expr *box = malloc(sizeof(Expr));
+	
+	if (box == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	*box = expr;
+	return box;
+}
+
+/**
+ * @internal
+ * @brief Legt eine Anweisung in eigenem Speicher ab.
+ */
+static Stmt* boxStmt(Stmt stmt) {
+	Stmt *box = malloc(sizeof(Stmt));
+	
+	if (box == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	*box = stmt;
+	return box;
+}
+
+/**
+ * @internal
+ * @brief Gibt die Nummer des Parameters zurück, auf den \p id verweist, oder
+ * `-1`, falls \p id kein ersetzter Parameter ist.
+ */
+static int paramIndex(const Subst *subst, DefId id) {
+	if (subst == NULL || subst->params == NULL) { return -1; }
+	
+	for (unsigned int i = 0; i < subst->param_count; ++i) {
+		if (subst->params[i].index == id.index) { return (int) i; }
+	}
+	
+	return -1;
+}
+
+/**
+ * @internal
+ * @brief Kopiert einen aufgelösten Bezeichner und bildet seine Definition ab.
+ */
+static ResIdent copyIdent(const ResIdent *ident, const Subst *subst) {
+	return (ResIdent) {
+		.ident = ident->ident,
+		.res = subst != NULL && subst->map != NULL ? subst->map[ident->res.index] : ident->res
+	};
+}
+
+/**
+ * @internal
+ * @brief Erstellt eine tiefe Kopie eines Ausdrucks und wendet dabei die
+ * Ersetzungen \p subst an, das `NULL` sein kann.
+ */
+static Expr copyExprWith(const Expr *expr, const Subst *subst) {
+	Expr copy = *expr;
+	
+	switch (expr->tag) {
+	case EXPR_ASSIGN:
+		copy.assign.lhs = copyIdent(&expr->assign.lhs, subst);
+		copy.assign.rhs = boxExpr(copyExprWith(expr->assign.rhs, subst));
+		break;
+		
+	case EXPR_BIN_OP:
+		copy.bin_op.lhs = boxExpr(copyExprWith(expr->bin_op.lhs, subst));
+		copy.bin_op.rhs = boxExpr(copyExprWith(expr->bin_op.rhs, subst));
+		break;
+		
+	case EXPR_UNARY_MINUS:
+		copy.unary_minus = boxExpr(copyExprWith(expr->unary_minus, subst));
+		break;
+		
+	case EXPR_CALL:
+		copy.call.res_ident = copyIdent(&expr->call.res_ident, subst);
+		vecInit(copy.call.args);
+		
+		vecForEach(const Expr *arg, expr->call.args) {
+			Expr arg_copy = copyExprWith(arg, subst);
+			vecPush(copy.call.args) = arg_copy;
+		}
+		break;
+		
+	case EXPR_LITERAL:
+		/* string literals are interned, the copy shares them */
+		break;
+		
+	case EXPR_VAR: {
+		int param = paramIndex(subst, expr->var.res);
+		
+		if (param < 0) {
+			copy.var = copyIdent(&expr->var, subst);
+		} else if (subst->modes[param] == PARAM_SUBST) {
+			copy = copyExprWith(&subst->args[param], NULL);
+		} else if (subst->sites[param] == expr) {
+			/* the argument is computed where its parameter is first read */
+			copy.tag = EXPR_ASSIGN;
+			copy.assign.lhs = (ResIdent) { .ident = expr->var.ident, .res = subst->temps[param] };
+			copy.assign.rhs = boxExpr(subst->args[param]);
+		} else {
+			copy.var = (ResIdent) { .ident = expr->var.ident, .res = subst->temps[param] };
+		}
+		break;
+	}
+	
+	case EXPR_INVALID:
+		break;
+	}
+	
+	return copy;
+}
+
+/**
+ * @internal
+ * @brief Erstellt eine tiefe Kopie eines Ausdrucks.
+ */
+static inline Expr copyExpr(const Expr *expr) {
+	return copyExprWith(expr, NULL);
+}
+
+/**
+ * @internal
+ * @brief Kopiert eine Zuweisung.
+ */
+static Assign copyAssign(const Assign *assign, const Subst *subst) {
+	return (Assign) {
+		.lhs = copyIdent(&assign->lhs, subst),
+		.rhs = boxExpr(copyExprWith(assign->rhs, subst))
+	};
+}
+
+/**
+ * @internal
+ * @brief Kopiert eine Variablendefinition.
+ */
+static VarDef copyVarDef(const VarDef *var_def, const Subst *subst) {
+	return (VarDef) {
+		.data_type = var_def->data_type,
+		.res_ident = copyIdent(&var_def->res_ident, subst),
+		.init = copyExprWith(&var_def->init, subst)
+	};
+}
+
+/**
+ * @internal
+ * @brief Kopiert einen Vektor von Ausdrücken.
+ */
+static Expr* copyExprs(const Expr *exprs, const Subst *subst) {
+	Expr *copy = NULL;
+	vecInit(copy);
+	
+	vecForEach(const Expr *expr, exprs) {
+		Expr expr_copy = copyExprWith(expr, subst);
+		vecPush(copy) = expr_copy;
+	}
+	
+	return copy;
+}
+
+/**
+ * @internal
+ * @brief Erstellt eine tiefe Kopie einer Anweisung und bildet dabei die
+ * Definitionen aller Bezeichner über \p subst ab.
+ */
+static Stmt copyStmt(const Stmt *stmt, const Subst *subst) {
+	Stmt copy = *stmt;
+	
+	switch (stmt->tag) {
+	case STMT_EMPTY:
+		break;
+		
+	case STMT_IF:
+		copy.if_stmt.cond = copyExprWith(&stmt->if_stmt.cond, subst);
+		copy.if_stmt.if_true = boxStmt(copyStmt(stmt->if_stmt.if_true, subst));
+		copy.if_stmt.if_false = boxStmt(copyStmt(stmt->if_stmt.if_false, subst));
+		break;
+		
+	case STMT_FOR:
+		if (stmt->for_stmt.init.tag == FOR_INIT_VAR_DEF) {
+			copy.for_stmt.init.var_def = copyVarDef(&stmt->for_stmt.init.var_def, subst);
+		} else {
+			copy.for_stmt.init.assign = copyAssign(&stmt->for_stmt.init.assign, subst);
+		}
+		
+		copy.for_stmt.cond = copyExprWith(&stmt->for_stmt.cond, subst);
+		copy.for_stmt.update = copyAssign(&stmt->for_stmt.update, subst);
+		copy.for_stmt.body = boxStmt(copyStmt(stmt->for_stmt.body, subst));
+		break;
+		
+	case STMT_WHILE:
+	case STMT_DO_WHILE:
+		copy.while_stmt.cond = copyExprWith(&stmt->while_stmt.cond, subst);
+		copy.while_stmt.body = boxStmt(copyStmt(stmt->while_stmt.body, subst));
+		break;
+		
+	case STMT_RETURN:
+		copy.return_stmt = copyExprWith(&stmt->return_stmt, subst);
+		break;
+		
+	case STMT_PRINT:
+		copy.print_stmt.expressions = copyExprs(stmt->print_stmt.expressions, subst);
+		break;
+		
+	case STMT_VAR_DEF:
+		copy.var_def = copyVarDef(&stmt->var_def, subst);
+		break;
+		
+	case STMT_ASSIGN:
+		copy.assign = copyAssign(&stmt->assign, subst);
+		break;
+		
+	case STMT_CALL:
+		copy.call.res_ident = copyIdent(&stmt->call.res_ident, subst);
+		copy.call.args = copyExprs(stmt->call.args, subst);
+		break;
+		
+	case STMT_BLOCK:
+		copy.block.statements = NULL;
+		vecInit(copy.block.statements);
+		
+		vecForEach(const Stmt *inner, stmt->block.statements) {
+			Stmt inner_copy = copyStmt(inner, subst);
+			vecPush(copy.block.statements) = inner_copy;
+		}
+		break;
+	}
+	
+	return copy;
+}
+
+/**
+ * @internal
+ * @brief Legt eine neue lokale Variable der Funktion \p func an.
+ */
+static DefId newLocal(SymDefTable *tab, DefId func, Ident name, DataType type) {
+	DefId id = { vecLen(tab->definitions) };
+	FuncInfo *info = &tab->definitions[func.index].func;
+	unsigned int offset = vecLen(info->local_vars);
+	
+	/* the push may move the definitions, so the function is updated first */
+	vecPush(info->local_vars) = id;
+	vecPush(tab->definitions) = (DefInfo) {
+		.tag = SYM_DEF_LOCAL_VAR,
+		.ident = name,
+		.var = { .data_type = type, .offset = offset }
+	};
+	
+	return id;
+}
+
+/**
+ * @internal
+ * @brief Gibt zurück, ob zwei Ausdrücke strukturell gleich sind.
+ */
+static int exprEqual(const Expr *a, const Expr *b) {
+	if (a->tag != b->tag || a->data_type != b->data_type) { return 0; }
+	
+	switch (a->tag) {
+	case EXPR_LITERAL:
+		if (a->literal.tag != b->literal.tag) { return 0; }
+		
+		switch (a->literal.tag) {
+		case LITERAL_INT:    return a->literal.iVal == b->literal.iVal;
+		case LITERAL_FLOAT:  return memcmp(&a->literal.fVal, &b->literal.fVal, sizeof(double)) == 0;
+		case LITERAL_BOOL:   return (a->literal.bVal != 0) == (b->literal.bVal != 0);
+		case LITERAL_STRING: return a->literal.sVal == b->literal.sVal;
+		}
+		return 0;
+		
+	case EXPR_VAR:
+		return a->var.res.index == b->var.res.index;
+		
+	case EXPR_UNARY_MINUS:
+		return exprEqual(a->unary_minus, b->unary_minus);
+		
+	case EXPR_BIN_OP:
+		return a->bin_op.op == b->bin_op.op && exprEqual(a->bin_op.lhs, b->bin_op.lhs) && exprEqual(a->bin_op.rhs, b->bin_op.rhs);
+		
+	case EXPR_CALL:
+		if (a->call.res_ident.res.index != b->call.res_ident.res.index) { return 0; }
+		if (vecLen(a->call.args) != vecLen(b->call.args)) { return 0; }
+		
+		for (unsigned int i = 0; i < vecLen(a->call.args); ++i) {
+			if (!exprEqual(&a->call.args[i], &b->call.args[i])) { return 0; }
+		}
+		return 1;
+		
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt zurück, ob eine Operation eine ganzzahlige Division ist, die
+ * abbrechen kann, weil ihr Divisor `0` oder `-1` sein könnte.
+ */
+static int mayTrap(const Expr *expr) {
+	const BinOpExpr *bin = &expr->bin_op;
+	
+	return bin->op == BIN_OP_DIV && expr->data_type == TYPE_INT
+		&& !(bin->rhs->tag == EXPR_LITERAL && bin->rhs->literal.iVal != 0 && bin->rhs->literal.iVal != -1);
+}
+
+/**
+ * @internal
+ * @brief Markiert eine zugewiesene Variable.
+ */
+static void scanAssigned(Scan *self, DefId id) {
+	if (self->assigned != NULL) { self->assigned[id.index] = 1; }
+	if (self->defs[id.index].tag == SYM_DEF_GLOBAL_VAR) { self->flags |= EFFECT_WRITES_GLOBAL; }
+}
+
+/**
+ * @internal
+ * @brief Sammelt die Wirkungen eines Ausdrucks.
+ */
+static void scanExpr(Scan *self, const Expr *expr) {
+	switch (expr->tag) {
+	case EXPR_ASSIGN:
+		scanExpr(self, expr->assign.rhs);
+		scanAssigned(self, expr->assign.lhs.res);
+		break;
+		
+	case EXPR_BIN_OP:
+		scanExpr(self, expr->bin_op.lhs);
+		scanExpr(self, expr->bin_op.rhs);
+		if (mayTrap(expr)) { self->flags |= EFFECT_MAY_FAIL; }
+		break;
+		
+	case EXPR_UNARY_MINUS:
+		scanExpr(self, expr->unary_minus);
+		break;
+		
+	case EXPR_CALL:
+		vecForEach(const Expr *arg, expr->call.args) {
+			scanExpr(self, arg);
+		}
+		
+		vecPush(self->callees) = expr->call.res_ident.res;
+		if (self->effects != NULL) { self->flags |= self->effects[expr->call.res_ident.res.index]; }
+		break;
+		
+	case EXPR_VAR:
+		if (self->defs[expr->var.res.index].tag == SYM_DEF_GLOBAL_VAR) { self->flags |= EFFECT_READS_GLOBAL; }
+		break;
+		
+	case EXPR_INVALID:
+	case EXPR_LITERAL:
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Sammelt die Wirkungen einer Anweisung; jede Schleife gilt als
+ * möglicherweise nicht terminierend.
+ */
+static void scanStmt(Scan *self, const Stmt *stmt) {
+	switch (stmt->tag) {
+	case STMT_EMPTY:
+		break;
+		
+	case STMT_IF:
+		scanExpr(self, &stmt->if_stmt.cond);
+		scanStmt(self, stmt->if_stmt.if_true);
+		scanStmt(self, stmt->if_stmt.if_false);
+		break;
+		
+	case STMT_FOR:
+		if (stmt->for_stmt.init.tag == FOR_INIT_VAR_DEF) {
+			scanExpr(self, &stmt->for_stmt.init.var_def.init);
+			scanAssigned(self, stmt->for_stmt.init.var_def.res_ident.res);
+		} else {
+			scanExpr(self, stmt->for_stmt.init.assign.rhs);
+			scanAssigned(self, stmt->for_stmt.init.assign.lhs.res);
+		}
+		
+		scanExpr(self, &stmt->for_stmt.cond);
+		scanExpr(self, stmt->for_stmt.update.rhs);
+		scanAssigned(self, stmt->for_stmt.update.lhs.res);
+		scanStmt(self, stmt->for_stmt.body);
+		self->flags |= EFFECT_MAY_FAIL;
+		break;
+		
+	case STMT_WHILE:
+	case STMT_DO_WHILE:
+		scanExpr(self, &stmt->while_stmt.cond);
+		scanStmt(self, stmt->while_stmt.body);
+		self->flags |= EFFECT_MAY_FAIL;
+		break;
+		
+	case STMT_RETURN:
+		scanExpr(self, &stmt->return_stmt);
+		break;
+		
+	case STMT_PRINT:
+		vecForEach(const Expr *expr, stmt->print_stmt.expressions) {
+			scanExpr(self, expr);
+		}
+		self->flags |= EFFECT_PRINTS;
+		break;
+		
+	case STMT_VAR_DEF:
+		scanExpr(self, &stmt->var_def.init);
+		scanAssigned(self, stmt->var_def.res_ident.res);
+		break;
+		
+	case STMT_ASSIGN:
+		scanExpr(self, stmt->assign.rhs);
+		scanAssigned(self, stmt->assign.lhs.res);
+		break;
+		
+	case STMT_CALL: {
+		/* a call statement is scanned like a call expression */
+		Expr call = { .tag = EXPR_CALL, .call = stmt->call };
+		scanExpr(self, &call);
+		break;
+	}
+	
+	case STMT_BLOCK:
+		vecForEach(const Stmt *inner, stmt->block.statements) {
+			scanStmt(self, inner);
+		}
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt zurück, ob eine Funktion sich selbst direkt oder indirekt
+ * aufrufen kann.
+ */
+static int isRecursive(DefId **callees, unsigned int count, unsigned int func) {
+	unsigned char *seen = calloc(count, 1);
+	unsigned int *stack = NULL;
+	int found = 0;
+	
+	if (seen == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	vecPush(stack) = func;
+	
+	while (!found && !vecIsEmpty(stack)) {
+		unsigned int caller = vecPop(stack);
+		
+		vecForEach(const DefId *callee, callees[caller]) {
+			if (callee->index == func) { found = 1; }
+			if (seen[callee->index]) { continue; }
+			
+			seen[callee->index] = 1;
+			vecPush(stack) = callee->index;
+		}
+	}
+	
+	vecRelease(stack);
+	free(seen);
+	return found;
+}
+
+/**
+ * @internal
+ * @brief Sammelt die direkten Wirkungen und die aufgerufenen Funktionen jeder
+ * Funktion.
+ *
+ * @param effects Nimmt die Wirkungen je `DefId` auf.
+ * @return Der Vektor der aufgerufenen Funktionen je `DefId`, der mit
+ *         `releaseCallees()` freizugeben ist.
+ */
+static DefId** scanFunctions(const Program *ast, const SymDefTable *tab, unsigned char *effects) {
+	unsigned int count = vecLen(tab->definitions);
+	DefId **callees = calloc(count + 1, sizeof(DefId*));
+	
+	if (callees == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	for (unsigned int i = 0; i < count; ++i) {
+		if (tab->definitions[i].tag != SYM_DEF_FUNC) { continue; }
+		
+		Scan scan = { .defs = tab->definitions };
+		const FuncDef *func = &ast->items[tab->definitions[i].func.item_id.index].func_def;
+		
+		vecForEach(const Stmt *stmt, func->statements) {
+			scanStmt(&scan, stmt);
+		}
+		
+		if (effects != NULL) { effects[i] = scan.flags; }
+		callees[i] = scan.callees;
+	}
+	
+	return callees;
+}
+
+/**
+ * @internal
+ * @brief Gibt die Vektoren aus `scanFunctions()` frei.
+ */
+static void releaseCallees(DefId **callees, unsigned int count) {
+	for (unsigned int i = 0; i < count; ++i) {
+		vecRelease(callees[i]);
+	}
+	
+	free(callees);
+}
+
+/**
+ * @internal
+ * @brief Gibt zurück, ob ein Ausdruck eine Variable liest oder eine Funktion
+ * aufruft, seine Verschiebung also Arbeit spart.
+ */
+static int readsOperand(const Expr *expr) {
+	switch (expr->tag) {
+	case EXPR_VAR:
+	case EXPR_CALL:
+		return 1;
+		
+	case EXPR_UNARY_MINUS:
+		return readsOperand(expr->unary_minus);
+		
+	case EXPR_BIN_OP:
+		return readsOperand(expr->bin_op.lhs) || readsOperand(expr->bin_op.rhs);
+		
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt zurück, ob ein Ausdruck in jeder Iteration der aktuellen
+ * Schleife denselben Wert hat und ohne Seiteneffekte berechnet wird.
+ */
+static int isInvariant(const Licm *self, const Expr *expr) {
+	switch (expr->tag) {
+	case EXPR_LITERAL:
+		return 1;
+		
+	case EXPR_VAR: {
+		unsigned int id = expr->var.res.index;
+		
+		if (id >= self->assigned_count || self->assigned[id]) { return 0; }
+		return self->tab->definitions[id].tag != SYM_DEF_GLOBAL_VAR || !self->writes_global;
+	}
+	
+	case EXPR_UNARY_MINUS:
+		return isInvariant(self, expr->unary_minus);
+		
+	case EXPR_BIN_OP:
+		return isInvariant(self, expr->bin_op.lhs) && isInvariant(self, expr->bin_op.rhs);
+		
+	case EXPR_CALL: {
+		unsigned char effects = self->effects[expr->call.res_ident.res.index];
+		
+		if (effects & (EFFECT_WRITES_GLOBAL | EFFECT_PRINTS)) { return 0; }
+		if ((effects & EFFECT_READS_GLOBAL) && self->writes_global) { return 0; }
+		
+		vecForEach(const Expr *arg, expr->call.args) {
+			if (!isInvariant(self, arg)) { return 0; }
+		}
+		return 1;
+	}
+	
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt zurück, ob die Auswertung eines Ausdrucks abbrechen oder nicht
+ * terminieren kann.
+ */
+static int mayFail(const Licm *self, const Expr *expr) {
+	switch (expr->tag) {
+	case EXPR_ASSIGN:
+		return mayFail(self, expr->assign.rhs);
+		
+	case EXPR_UNARY_MINUS:
+		return mayFail(self, expr->unary_minus);
+		
+	case EXPR_BIN_OP:
+		return mayTrap(expr) || mayFail(self, expr->bin_op.lhs) || mayFail(self, expr->bin_op.rhs);
+		
+	case EXPR_CALL:
+		if (self->effects[expr->call.res_ident.res.index] & EFFECT_MAY_FAIL) { return 1; }
+		
+		vecForEach(const Expr *arg, expr->call.args) {
+			if (mayFail(self, arg)) { return 1; }
+		}
+		return 0;
+		
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @internal
+ * @brief Legt eine neue Hilfsvariable der aktuellen Funktion an.
+ */
+static DefId newTemp(Licm *self, DataType type) {
+	char name[24];
+	int len = snprintf(name, sizeof(name), "licm%u", self->temps++);
+	return newLocal(self->tab, self->func, internString(name, len), type);
+}
+
+/**
+ * @internal
+ * @brief Ersetzt einen Ausdruck durch eine Hilfsvariable, die vor der
+ * Schleife mit ihm initialisiert wird; gleiche Ausdrücke teilen sich eine
+ * Variable.
+ */
+static void hoistExpr(Licm *self, Expr *expr) {
+	DataType type = expr->data_type;
+	const Stmt *same = NULL;
+	DefId id;
+	
+	vecForEach(const Stmt *hoist, self->hoists) {
+		if (exprEqual(&hoist->var_def.init, expr)) {
+			same = hoist;
+			break;
+		}
+	}
+	
+	if (same != NULL) {
+		id = same->var_def.res_ident.res;
+		releaseExpr(expr);
+	} else {
+		id = newTemp(self, type);
+		vecPush(self->hoists) = (Stmt) {
+			.tag = STMT_VAR_DEF,
+			.var_def = {
+				.data_type = type,
+				.res_ident = { .ident = self->tab->definitions[id.index].ident, .res = id },
+				.init = *expr
+			}
+		};
+	}
+	
+	*expr = (Expr) {
+		.tag = EXPR_VAR,
+		.data_type = type,
+		.var = { .ident = self->tab->definitions[id.index].ident, .res = id }
+	};
+	self->hoisted += 1;
+}
+
+/**
+ * @internal
+ * @brief Verschiebt die größten invarianten Teilausdrücke eines Ausdrucks.
+ *
+ * Ausdrücke, die abbrechen können, werden nur verschoben, wenn \p unsafe
+ * gesetzt ist und in der aktuellen Iteration zuvor nichts ausgewertet wurde,
+ * dessen Wirkung beobachtbar ist.
+ */
+static void licmExpr(Licm *self, Expr *expr, int unsafe) {
+	if ((expr->tag == EXPR_BIN_OP || expr->tag == EXPR_UNARY_MINUS || expr->tag == EXPR_CALL)
+		&& readsOperand(expr) && isInvariant(self, expr)) {
+		int fails = mayFail(self, expr);
+		
+		if (!fails || (unsafe && self->clean)) {
+			hoistExpr(self, expr);
+			self->unsafe |= fails;
+			return;
+		}
+	}
+	
+	switch (expr->tag) {
+	case EXPR_ASSIGN:
+		licmExpr(self, expr->assign.rhs, unsafe);
+		break;
+		
+	case EXPR_BIN_OP: {
+		BinOp op = expr->bin_op.op;
+		
+		/* the right operand of `&&` and `||` is not always evaluated */
+		licmExpr(self, expr->bin_op.lhs, unsafe);
+		licmExpr(self, expr->bin_op.rhs, unsafe && op != BIN_OP_LOG_AND && op != BIN_OP_LOG_OR);
+		if (mayTrap(expr)) { self->clean = 0; }
+		break;
+	}
+	
+	case EXPR_UNARY_MINUS:
+		licmExpr(self, expr->unary_minus, unsafe);
+		break;
+		
+	case EXPR_CALL:
+		vecForEach(Expr *arg, expr->call.args) {
+			licmExpr(self, arg, unsafe);
+		}
+		
+		if (self->effects[expr->call.res_ident.res.index] & (EFFECT_PRINTS | EFFECT_MAY_FAIL)) {
+			self->clean = 0;
+		}
+		break;
+		
+	default:
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Verschiebt die invarianten Teilausdrücke einer Anweisung im
+ * Rumpf der aktuellen Schleife.
+ */
+static void licmStmt(Licm *self, Stmt *stmt) {
+	switch (stmt->tag) {
+	case STMT_EMPTY:
+		break;
+		
+	case STMT_IF:
+		licmExpr(self, &stmt->if_stmt.cond, 0);
+		licmStmt(self, stmt->if_stmt.if_true);
+		licmStmt(self, stmt->if_stmt.if_false);
+		break;
+		
+	case STMT_FOR:
+		if (stmt->for_stmt.init.tag == FOR_INIT_VAR_DEF) {
+			licmExpr(self, &stmt->for_stmt.init.var_def.init, 0);
+		} else {
+			licmExpr(self, stmt->for_stmt.init.assign.rhs, 0);
+		}
+		
+		licmExpr(self, &stmt->for_stmt.cond, 0);
+		licmExpr(self, stmt->for_stmt.update.rhs, 0);
+		licmStmt(self, stmt->for_stmt.body);
+		break;
+		
+	case STMT_WHILE:
+	case STMT_DO_WHILE:
+		licmExpr(self, &stmt->while_stmt.cond, 0);
+		licmStmt(self, stmt->while_stmt.body);
+		break;
+		
+	case STMT_RETURN:
+		licmExpr(self, &stmt->return_stmt, 0);
+		break;
+		
+	case STMT_PRINT:
+		vecForEach(Expr *expr, stmt->print_stmt.expressions) {
+			licmExpr(self, expr, 0);
+		}
+		break;
+		
+	case STMT_VAR_DEF:
+		licmExpr(self, &stmt->var_def.init, 0);
+		break;
+		
+	case STMT_ASSIGN:
+		licmExpr(self, stmt->assign.rhs, 0);
+		break;
+		
+	case STMT_CALL:
+		vecForEach(Expr *arg, stmt->call.args) {
+			licmExpr(self, arg, 0);
+		}
+		break;
+		
+	case STMT_BLOCK:
+		vecForEach(Stmt *inner, stmt->block.statements) {
+			licmStmt(self, inner);
+		}
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Verschiebt die invarianten Teilausdrücke eines Schleifenrumpfes.
+ *
+ * Die führenden Zuweisungen und Definitionen des Rumpfes werden in jeder
+ * Iteration vor allem anderen ausgewertet; aus ihnen dürfen auch Ausdrücke
+ * verschoben werden, die abbrechen können.
+ */
+static void licmBody(Licm *self, Stmt *body) {
+	Stmt *stmts = body->tag == STMT_BLOCK ? body->block.statements : body;
+	unsigned int count = body->tag == STMT_BLOCK ? vecLen(stmts) : 1;
+	
+	self->clean = 1;
+	
+	for (unsigned int i = 0; i < count; ++i) {
+		Stmt *stmt = &stmts[i];
+		
+		switch (stmt->tag) {
+		case STMT_EMPTY:
+			break;
+			
+		case STMT_VAR_DEF:
+			licmExpr(self, &stmt->var_def.init, 1);
+			break;
+			
+		case STMT_ASSIGN:
+			licmExpr(self, stmt->assign.rhs, 1);
+			break;
+			
+		default:
+			self->clean = 0;
+			licmStmt(self, stmt);
+			break;
+		}
+	}
+}
+
+/**
+ * @internal
+ * @brief Ersetzt eine `for`- oder `while`-Schleife durch eine `do while`-Schleife,
+ * der die Prüfung ihrer Bedingung \p guard und die Hilfsvariablen vorangehen.
+ *
+ * Ausdrücke, die abbrechen können, dürfen nur ausgewertet werden, wenn der
+ * Rumpf mindestens einmal ausgeführt wird.
+ */
+static void guardLoop(Licm *self, Stmt *stmt, Expr guard) {
+	Stmt *outer = NULL;
+	Stmt *body;
+	Expr cond;
+	
+	vecInit(outer);
+	
+	if (stmt->tag == STMT_FOR) {
+		ForStmt *for_stmt = &stmt->for_stmt;
+		Stmt *inner = NULL;
+		
+		if (for_stmt->init.tag == FOR_INIT_VAR_DEF) {
+			vecPush(outer) = (Stmt) { .tag = STMT_VAR_DEF, .var_def = for_stmt->init.var_def };
+		} else {
+			vecPush(outer) = (Stmt) { .tag = STMT_ASSIGN, .assign = for_stmt->init.assign };
+		}
+		
+		vecInit(inner);
+		vecPush(inner) = *for_stmt->body;
+		vecPush(inner) = (Stmt) { .tag = STMT_ASSIGN, .assign = for_stmt->update };
+		free(for_stmt->body);
+		
+		body = boxStmt((Stmt) { .tag = STMT_BLOCK, .block = { inner } });
+		cond = for_stmt->cond;
+	} else {
+		body = stmt->while_stmt.body;
+		cond = stmt->while_stmt.cond;
+	}
+	
+	vecPush(self->hoists) = (Stmt) { .tag = STMT_DO_WHILE, .do_while_stmt = { .cond = cond, .body = body } };
+	vecPush(outer) = (Stmt) {
+		.tag = STMT_IF,
+		.if_stmt = {
+			.cond = guard,
+			.if_true = boxStmt((Stmt) { .tag = STMT_BLOCK, .block = { self->hoists } }),
+			.if_false = boxStmt((Stmt) { .tag = STMT_EMPTY })
+		}
+	};
+	
+	*stmt = (Stmt) { .tag = STMT_BLOCK, .block = { outer } };
+}
+
+/**
+ * @internal
+ * @brief Verschiebt die invarianten Ausdrücke einer Schleife vor die Schleife.
+ */
+static void licmLoop(Licm *self, Stmt *stmt) {
+	Scan scan = { .defs = self->tab->definitions, .effects = self->effects };
+	Expr guard = { .tag = EXPR_INVALID, .data_type = TYPE_VOID };
+	
+	self->assigned_count = vecLen(self->tab->definitions);
+	self->assigned = calloc(self->assigned_count, 1);
+	self->hoists = NULL;
+	self->unsafe = 0;
+	
+	if (self->assigned == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	scan.assigned = self->assigned;
+	scanStmt(&scan, stmt);
+	vecRelease(scan.callees);
+	self->writes_global = (scan.flags & EFFECT_WRITES_GLOBAL) != 0;
+	
+	switch (stmt->tag) {
+	case STMT_FOR:
+		guard = copyExpr(&stmt->for_stmt.cond);
+		licmExpr(self, &stmt->for_stmt.cond, 0);
+		licmBody(self, stmt->for_stmt.body);
+		licmExpr(self, stmt->for_stmt.update.rhs, 0);
+		break;
+		
+	case STMT_WHILE:
+		guard = copyExpr(&stmt->while_stmt.cond);
+		licmExpr(self, &stmt->while_stmt.cond, 0);
+		licmBody(self, stmt->while_stmt.body);
+		break;
+		
+	default:
+		licmBody(self, stmt->do_while_stmt.body);
+		licmExpr(self, &stmt->do_while_stmt.cond, 0);
+		break;
+	}
+	
+	free(self->assigned);
+	self->assigned = NULL;
+	
+	if (self->unsafe && stmt->tag != STMT_DO_WHILE) {
+		guardLoop(self, stmt, guard);
+		return;
+	}
+	
+	releaseExpr(&guard);
+	
+	if (vecIsEmpty(self->hoists)) {
+		vecRelease(self->hoists);
+		return;
+	}
+	
+	vecPush(self->hoists) = *stmt;
+	*stmt = (Stmt) { .tag = STMT_BLOCK, .block = { self->hoists } };
+}
+
+/**
+ * @internal
+ * @brief Bearbeitet alle Schleifen in einer Anweisung, innere Schleifen zuerst.
+ */
+static void licmNest(Licm *self, Stmt *stmt) {
+	switch (stmt->tag) {
+	case STMT_IF:
+		licmNest(self, stmt->if_stmt.if_true);
+		licmNest(self, stmt->if_stmt.if_false);
+		break;
+		
+	case STMT_FOR:
+		licmNest(self, stmt->for_stmt.body);
+		licmLoop(self, stmt);
+		break;
+		
+	case STMT_WHILE:
+	case STMT_DO_WHILE:
+		licmNest(self, stmt->while_stmt.body);
+		licmLoop(self, stmt);
+		break;
+		
+	case STMT_BLOCK:
+		vecForEach(Stmt *inner, stmt->block.statements) {
+			licmNest(self, inner);
+		}
+		break;
+		
+	default:
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt die Anzahl der Anweisungs- und Ausdrucksknoten in einer
+ * Anweisung zurück.
+ */
+static unsigned int codeSize(const Stmt *stmt) {
+	unsigned int size = 1;
+	
+	switch (stmt->tag) {
+	case STMT_EMPTY:
+		break;
+		
+	case STMT_IF:
+		size += optExprSize(&stmt->if_stmt.cond) + codeSize(stmt->if_stmt.if_true) + codeSize(stmt->if_stmt.if_false);
+		break;
+		
+	case STMT_FOR:
+		if (stmt->for_stmt.init.tag == FOR_INIT_VAR_DEF) {
+			size += optExprSize(&stmt->for_stmt.init.var_def.init);
+		} else {
+			size += optExprSize(stmt->for_stmt.init.assign.rhs);
+		}
+		
+		size += optExprSize(&stmt->for_stmt.cond) + optExprSize(stmt->for_stmt.update.rhs);
+		size += codeSize(stmt->for_stmt.body);
+		break;
+		
+	case STMT_WHILE:
+	case STMT_DO_WHILE:
+		size += optExprSize(&stmt->while_stmt.cond) + codeSize(stmt->while_stmt.body);
+		break;
+		
+	case STMT_RETURN:
+		size += optExprSize(&stmt->return_stmt);
+		break;
+		
+	case STMT_PRINT:
+		vecForEach(const Expr *expr, stmt->print_stmt.expressions) {
+			size += optExprSize(expr);
+		}
+		break;
+		
+	case STMT_VAR_DEF:
+		size += optExprSize(&stmt->var_def.init);
+		break;
+		
+	case STMT_ASSIGN:
+		size += optExprSize(stmt->assign.rhs);
+		break;
+		
+	case STMT_CALL:
+		vecForEach(const Expr *arg, stmt->call.args) {
+			size += optExprSize(arg);
+		}
+		break;
+		
+	case STMT_BLOCK:
+		vecForEach(const Stmt *inner, stmt->block.statements) {
+			size += codeSize(inner);
+		}
+		break;
+	}
+	
+	return size;
+}
+
+/**
+ * @internal
+ * @brief Gibt zurück, ob eine Anweisung eine `return`-Anweisung enthält.
+ */
+static int hasReturn(const Stmt *stmt) {
+	switch (stmt->tag) {
+	case STMT_RETURN:
+		return 1;
+		
+	case STMT_IF:
+		return hasReturn(stmt->if_stmt.if_true) || hasReturn(stmt->if_stmt.if_false);
+		
+	case STMT_FOR:
+		return hasReturn(stmt->for_stmt.body);
+		
+	case STMT_WHILE:
+	case STMT_DO_WHILE:
+		return hasReturn(stmt->while_stmt.body);
+		
+	case STMT_BLOCK:
+		vecForEach(const Stmt *inner, stmt->block.statements) {
+			if (hasReturn(inner)) { return 1; }
+		}
+		return 0;
+		
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt zurück, ob ein Ausdruck eine Zuweisung enthält.
+ */
+static int hasAssign(const Expr *expr) {
+	switch (expr->tag) {
+	case EXPR_ASSIGN:
+		return 1;
+		
+	case EXPR_BIN_OP:
+		return hasAssign(expr->bin_op.lhs) || hasAssign(expr->bin_op.rhs);
+		
+	case EXPR_UNARY_MINUS:
+		return hasAssign(expr->unary_minus);
+		
+	case EXPR_CALL:
+		vecForEach(const Expr *arg, expr->call.args) {
+			if (hasAssign(arg)) { return 1; }
+		}
+		return 0;
+		
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt den Funktionsrumpf zurück, falls der Aufruf von \p id ersetzt
+ * werden darf, sonst `NULL`.
+ */
+static const FuncDef* inlineCandidate(const Inliner *self, DefId id) {
+	const DefInfo *def = &self->tab->definitions[id.index];
+	
+	if (def->tag != SYM_DEF_FUNC || self->recursive[id.index] || id.index == self->func.index) { return NULL; }
+	
+	const FuncDef *func = &self->ast->items[def->func.item_id.index].func_def;
+	unsigned int size = 0;
+	
+	vecForEach(const Stmt *stmt, func->statements) {
+		size += codeSize(stmt);
+	}
+	
+	return size <= self->threshold ? func : NULL;
+}
+
+/**
+ * @internal
+ * @brief Legt eine Variable des Rufers für eine Variable der eingesetzten
+ * Funktion an.
+ */
+static DefId inlineLocal(Inliner *self, Ident func, DefId var) {
+	const DefInfo *def = &self->tab->definitions[var.index];
+	const char *prefix = internName(func), *ident = internName(def->ident);
+	DataType type = def->var.data_type;
+	size_t len = strlen(prefix) + strlen(ident) + 1;
+	char *name = malloc(len + 1);
+	
+	if (name == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	snprintf(name, len + 1, "%s_%s", prefix, ident);
+	DefId id = newLocal(self->tab, self->func, internString(name, len), type);
+	free(name);
+	return id;
+}
+
+/**
+ * @internal
+ * @brief Gibt zurück, ob alle zu bindenden Parameter gebunden sind.
+ */
+static int allBound(const Binding *self) {
+	for (unsigned int i = 0; i < self->param_count; ++i) {
+		if (self->modes[i] == PARAM_BIND && self->sites[i] == NULL) { return 0; }
+	}
+	
+	return 1;
+}
+
+/**
+ * @internal
+ * @brief Sucht in Auswertungsreihenfolge die erste Verwendung jedes zu
+ * bindenden Parameters.
+ *
+ * Die Argumente müssen in ihrer Reihenfolge und vor jeder Wirkung des
+ * Rumpfes berechnet werden; eine Verwendung, die nur bedingt ausgewertet wird,
+ * kann einen Parameter nicht binden.
+ */
+static void bindExpr(Binding *self, const Expr *expr, int cond) {
+	if (!self->ok) { return; }
+	
+	switch (expr->tag) {
+	case EXPR_VAR: {
+		Subst subst = { .params = self->params, .param_count = self->param_count };
+		int param = paramIndex(&subst, expr->var.res);
+		
+		if (param < 0) {
+			/* the pending arguments might change a global variable */
+			if (self->defs[expr->var.res.index].tag == SYM_DEF_GLOBAL_VAR && !allBound(self)) { self->ok = 0; }
+			break;
+		}
+		
+		if (self->modes[param] != PARAM_BIND || self->sites[param] != NULL) { break; }
+		
+		for (int i = 0; i < param; ++i) {
+			if (self->modes[i] == PARAM_BIND && self->sites[i] == NULL) { self->ok = 0; }
+		}
+		
+		if (cond) { self->ok = 0; }
+		self->sites[param] = expr;
+		break;
+	}
+	
+	case EXPR_ASSIGN: {
+		Subst subst = { .params = self->params, .param_count = self->param_count };
+		
+		bindExpr(self, expr->assign.rhs, cond);
+		if (paramIndex(&subst, expr->assign.lhs.res) >= 0 || !allBound(self)) { self->ok = 0; }
+		break;
+	}
+	
+	case EXPR_BIN_OP: {
+		BinOp op = expr->bin_op.op;
+		
+		bindExpr(self, expr->bin_op.lhs, cond);
+		bindExpr(self, expr->bin_op.rhs, cond || op == BIN_OP_LOG_AND || op == BIN_OP_LOG_OR);
+		if (mayTrap(expr) && !allBound(self)) { self->ok = 0; }
+		break;
+	}
+	
+	case EXPR_UNARY_MINUS:
+		bindExpr(self, expr->unary_minus, cond);
+		break;
+		
+	case EXPR_CALL:
+		vecForEach(const Expr *arg, expr->call.args) {
+			bindExpr(self, arg, cond);
+		}
+		
+		if (!allBound(self)) { self->ok = 0; }
+		break;
+		
+	default:
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Ersetzt einen Aufruf durch den Rückgabeausdruck der aufgerufenen
+ * Funktion, falls ihr Rumpf nur aus `return` besteht.
+ *
+ * Literale und lokale Variablen des Rufers werden direkt für ihre Parameter
+ * eingesetzt; alle anderen Argumente werden bei der ersten Verwendung ihres
+ * Parameters einer Hilfsvariablen zugewiesen.
+ *
+ * @return Ob der Aufruf ersetzt wurde.
+ */
+static int inlineExpr(Inliner *self, Expr *expr) {
+	DefId id = expr->call.res_ident.res;
+	const FuncDef *func = inlineCandidate(self, id);
+	
+	if (func == NULL || vecLen(func->statements) != 1 || func->statements[0].tag != STMT_RETURN) { return 0; }
+	
+	const FuncInfo *info = &self->tab->definitions[id.index].func;
+	const Expr *body = &func->statements[0].return_stmt;
+	
+	if (body->tag == EXPR_INVALID || body->data_type != info->return_type) { return 0; }
+	
+	/* the callee's variables stay put while the caller's grow */
+	const DefId *params = info->local_vars;
+	unsigned int count = info->param_count;
+	Expr *args = expr->call.args;
+	unsigned char *modes = calloc(count + 1, 1);
+	const Expr **sites = calloc(count + 1, sizeof(Expr*));
+	DefId *temps = calloc(count + 1, sizeof(DefId));
+	int assigns = 0;
+	
+	if (modes == NULL || sites == NULL || temps == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	for (unsigned int i = 0; i < count; ++i) {
+		assigns |= hasAssign(&args[i]);
+	}
+	
+	for (unsigned int i = 0; i < count; ++i) {
+		const Expr *arg = &args[i];
+		int local = arg->tag == EXPR_VAR && self->tab->definitions[arg->var.res.index].tag == SYM_DEF_LOCAL_VAR;
+		
+		modes[i] = PARAM_BIND;
+		
+		if (arg->data_type == self->tab->definitions[params[i].index].var.data_type
+			&& (arg->tag == EXPR_LITERAL || (local && !assigns))) {
+			modes[i] = PARAM_SUBST;
+		}
+	}
+	
+	Binding binding = {
+		.defs = self->tab->definitions,
+		.params = params,
+		.param_count = count,
+		.modes = modes,
+		.sites = sites,
+		.ok = 1
+	};
+	
+	bindExpr(&binding, body, 0);
+	
+	/* an unused argument may only be dropped if it has no effect */
+	for (unsigned int i = 0; i < count && binding.ok; ++i) {
+		if (modes[i] != PARAM_BIND || sites[i] != NULL) { continue; }
+		
+		if (optExprIsPure(&args[i])) {
+			modes[i] = PARAM_DROP;
+		} else {
+			binding.ok = 0;
+		}
+	}
+	
+	if (binding.ok) {
+		Ident name = self->tab->definitions[id.index].ident;
+		unsigned int def_count = vecLen(self->tab->definitions);
+		DefId *map = malloc((def_count + 1)*sizeof(DefId));
+		
+		if (map == NULL) {
+			fputs("out-of-memory error\n", stderr);
+			exit(-1);
+		}
+		
+		for (unsigned int i = 0; i < def_count; ++i) {
+			map[i] = (DefId) { i };
+		}
+		
+		/* helper variables of calls inlined into the callee before */
+		for (unsigned int i = count; i < vecLen(params); ++i) {
+			map[params[i].index] = inlineLocal(self, name, params[i]);
+		}
+		
+		for (unsigned int i = 0; i < count; ++i) {
+			if (modes[i] == PARAM_BIND) { temps[i] = inlineLocal(self, name, params[i]); }
+		}
+		
+		Subst subst = {
+			.map = map,
+			.params = params,
+			.param_count = count,
+			.args = args,
+			.modes = modes,
+			.sites = sites,
+			.temps = temps
+		};
+		
+		Expr result = copyExprWith(body, &subst);
+		
+		for (unsigned int i = 0; i < count; ++i) {
+			if (modes[i] != PARAM_BIND) { releaseExpr(&args[i]); }
+		}
+		
+		vecRelease(args);
+		free(map);
+		*expr = result;
+		self->inlined += 1;
+	}
+	
+	free(modes);
+	free(sites);
+	free(temps);
+	return binding.ok;
+}
+
+/**
+ * @internal
+ * @brief Ersetzt die Aufrufe in einem Ausdruck, innere Aufrufe zuerst.
+ */
+static void inlineExprs(Inliner *self, Expr *expr) {
+	switch (expr->tag) {
+	case EXPR_ASSIGN:
+		inlineExprs(self, expr->assign.rhs);
+		break;
+		
+	case EXPR_BIN_OP:
+		inlineExprs(self, expr->bin_op.lhs);
+		inlineExprs(self, expr->bin_op.rhs);
+		break;
+		
+	case EXPR_UNARY_MINUS:
+		inlineExprs(self, expr->unary_minus);
+		break;
+		
+	case EXPR_CALL:
+		vecForEach(Expr *arg, expr->call.args) {
+			inlineExprs(self, arg);
+		}
+		
+		inlineExpr(self, expr);
+		break;
+		
+	default:
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Ersetzt einen Aufruf, der als Anweisung, als rechte Seite einer
+ * Zuweisung oder Definition oder als Rückgabewert steht, durch einen Block
+ * mit dem Rumpf der aufgerufenen Funktion.
+ *
+ * Die Funktion darf nur als letzte Anweisung zurückkehren. Ihre Parameter
+ * und lokalen Variablen werden zu neuen Variablen des Rufers.
+ */
+static void inlineStmt(Inliner *self, Stmt *stmt) {
+	FuncCall *call;
+	
+	switch (stmt->tag) {
+	case STMT_CALL:
+		call = &stmt->call;
+		break;
+		
+	case STMT_ASSIGN:
+		if (stmt->assign.rhs->tag != EXPR_CALL) { return; }
+		call = &stmt->assign.rhs->call;
+		break;
+		
+	case STMT_VAR_DEF:
+		if (stmt->var_def.init.tag != EXPR_CALL) { return; }
+		call = &stmt->var_def.init.call;
+		break;
+		
+	case STMT_RETURN:
+		if (stmt->return_stmt.tag != EXPR_CALL) { return; }
+		call = &stmt->return_stmt.call;
+		break;
+		
+	default:
+		return;
+	}
+	
+	DefId id = call->res_ident.res;
+	const FuncDef *func = inlineCandidate(self, id);
+	
+	if (func == NULL) { return; }
+	
+	unsigned int len = vecLen(func->statements);
+	const Expr *ret = NULL;
+	
+	if (len > 0 && func->statements[len - 1].tag == STMT_RETURN) {
+		ret = &func->statements[--len].return_stmt;
+	}
+	
+	for (unsigned int i = 0; i < len; ++i) {
+		if (hasReturn(&func->statements[i])) { return; }
+	}
+	
+	const FuncInfo *info = &self->tab->definitions[id.index].func;
+	const DefId *vars = info->local_vars;
+	unsigned int var_count = vecLen(vars);
+	unsigned int param_count = info->param_count;
+	
+	/* a value is needed unless the call is a statement */
+	if (stmt->tag != STMT_CALL && info->return_type != TYPE_VOID && (ret == NULL || ret->tag == EXPR_INVALID)) { return; }
+	
+	unsigned int count = vecLen(self->tab->definitions);
+	Ident name = self->tab->definitions[id.index].ident;
+	DefId *map = malloc((count + 1)*sizeof(DefId));
+	Stmt *stmts = NULL;
+	
+	if (map == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	for (unsigned int i = 0; i < count; ++i) {
+		map[i] = (DefId) { i };
+	}
+	
+	for (unsigned int i = 0; i < var_count; ++i) {
+		map[vars[i].index] = inlineLocal(self, name, vars[i]);
+	}
+	
+	/* the arguments initialise the parameters in their order */
+	vecInit(stmts);
+	
+	for (unsigned int i = 0; i < param_count; ++i) {
+		const DefInfo *param = &self->tab->definitions[vars[i].index];
+		
+		vecPush(stmts) = (Stmt) {
+			.tag = STMT_VAR_DEF,
+			.var_def = {
+				.data_type = param->var.data_type,
+				.res_ident = { .ident = param->ident, .res = map[vars[i].index] },
+				.init = call->args[i]
+			}
+		};
+	}
+	
+	Subst subst = { .map = map };
+	
+	for (unsigned int i = 0; i < len; ++i) {
+		Stmt copy = copyStmt(&func->statements[i], &subst);
+		vecPush(stmts) = copy;
+	}
+	
+	Expr value = { .tag = EXPR_INVALID, .data_type = TYPE_VOID };
+	if (ret != NULL) { value = copyExprWith(ret, &subst); }
+	
+	vecRelease(call->args);
+	
+	switch (stmt->tag) {
+	case STMT_CALL:
+		/* the discarded result is only computed for its effects */
+		if (optExprIsPure(&value)) {
+			releaseExpr(&value);
+			break;
+		}
+		
+		vecPush(stmts) = (Stmt) {
+			.tag = STMT_VAR_DEF,
+			.var_def = {
+				.data_type = value.data_type,
+				.res_ident = { .ident = name, .res = newLocal(self->tab, self->func, name, value.data_type) },
+				.init = value
+			}
+		};
+		break;
+		
+	case STMT_ASSIGN:
+		free(stmt->assign.rhs);
+		vecPush(stmts) = (Stmt) { .tag = STMT_ASSIGN, .assign = { .lhs = stmt->assign.lhs, .rhs = boxExpr(value) } };
+		break;
+		
+	case STMT_VAR_DEF:
+		vecPush(stmts) = (Stmt) {
+			.tag = STMT_VAR_DEF,
+			.var_def = { .data_type = stmt->var_def.data_type, .res_ident = stmt->var_def.res_ident, .init = value }
+		};
+		break;
+		
+	default:
+		vecPush(stmts) = (Stmt) { .tag = STMT_RETURN, .return_stmt = value };
+		break;
+	}
+	
+	*stmt = (Stmt) { .tag = STMT_BLOCK, .block = { stmts } };
+	self->inlined += 1;
+	free(map);
+}
+
+/**
+ * @internal
+ * @brief Ersetzt die Aufrufe in einer Anweisung.
+ */
+static void inlineStmts(Inliner *self, Stmt *stmt) {
+	switch (stmt->tag) {
+	case STMT_EMPTY:
+		break;
+		
+	case STMT_IF:
+		inlineExprs(self, &stmt->if_stmt.cond);
+		inlineStmts(self, stmt->if_stmt.if_true);
+		inlineStmts(self, stmt->if_stmt.if_false);
+		break;
+		
+	case STMT_FOR:
+		if (stmt->for_stmt.init.tag == FOR_INIT_VAR_DEF) {
+			inlineExprs(self, &stmt->for_stmt.init.var_def.init);
+		} else {
+			inlineExprs(self, stmt->for_stmt.init.assign.rhs);
+		}
+		
+		inlineExprs(self, &stmt->for_stmt.cond);
+		inlineExprs(self, stmt->for_stmt.update.rhs);
+		inlineStmts(self, stmt->for_stmt.body);
+		break;
+		
+	case STMT_WHILE:
+	case STMT_DO_WHILE:
+		inlineExprs(self, &stmt->while_stmt.cond);
+		inlineStmts(self, stmt->while_stmt.body);
+		break;
+		
+	case STMT_RETURN:
+		inlineExprs(self, &stmt->return_stmt);
+		inlineStmt(self, stmt);
+		break;
+		
+	case STMT_PRINT:
+		vecForEach(Expr *expr, stmt->print_stmt.expressions) {
+			inlineExprs(self, expr);
+		}
+		break;
+		
+	case STMT_VAR_DEF:
+		inlineExprs(self, &stmt->var_def.init);
+		inlineStmt(self, stmt);
+		break;
+		
+	case STMT_ASSIGN:
+		inlineExprs(self, stmt->assign.rhs);
+		inlineStmt(self, stmt);
+		break;
+		
+	case STMT_CALL:
+		vecForEach(Expr *arg, stmt->call.args) {
+			inlineExprs(self, arg);
+		}
+		
+		inlineStmt(self, stmt);
+		break;
+		
+	case STMT_BLOCK:
+		inlineList(self, &stmt->block.statements);
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Ersetzt die Aufrufe in einer Anweisungsliste.
+ *
+ * Der Block, der eine Definition mit eingesetztem Aufruf ersetzt, wird in die
+ * Liste aufgelöst, damit die definierte Variable in ihrem Sichtbarkeitsbereich
+ * bleibt.
+ */
+static void inlineList(Inliner *self, Stmt **stmts) {
+	Stmt *result;
+	vecInit(result);
+	
+	vecForEach(Stmt *stmt, *stmts) {
+		int var_def = stmt->tag == STMT_VAR_DEF;
+		inlineStmts(self, stmt);
+		
+		if (var_def && stmt->tag == STMT_BLOCK) {
+			vecForEach(const Stmt *inner, stmt->block.statements) {
+				vecPush(result) = *inner;
+			}
+			
+			vecRelease(stmt->block.statements);
+		} else {
+			vecPush(result) = *stmt;
+		}
+	}
+	
+	vecRelease(*stmts);
+	*stmts = result;
+}
+
+/**
+ * @internal
+ * @brief Ersetzt die Aufrufe in einer Funktion, nachdem die Aufrufe in allen
+ * von ihr aufgerufenen Funktionen ersetzt wurden.
+ */
+static void inlineFunc(Inliner *self, unsigned int func) {
+	if (self->done[func]) { return; }
+	self->done[func] = 1;
+	
+	vecForEach(const DefId *callee, self->callees[func]) {
+		inlineFunc(self, callee->index);
+	}
+	
+	self->func = (DefId) { func };
+	FuncDef *def = &self->ast->items[self->tab->definitions[func].func.item_id.index].func_def;
+	
+	inlineList(self, &def->statements);
+}
+
+/* *** implementation ******************************************************* */
+
+void optProgram(Program *ast, SymDefTable *tab, unsigned int inline_threshold, OptStats *stats) {
+	OptStats local = { 0 };
+	
+	local.inlined = optInline(ast, tab, inline_threshold);
+	local.folded = optFold(ast);
+	local.eliminated = optDeadCode(ast, tab);
+	local.hoisted = optLoopInvariants(ast, tab);
+	
+	if (stats != NULL) {
+		stats->inlined += local.inlined;
+		stats->folded += local.folded;
+		stats->eliminated += local.eliminated;
+		stats->hoisted += local.hoisted;
+	}
+}
+
+void optStatsPrint(const OptStats *self, FILE *out) {
+	fprintf(out, "inline: %u call sites inlined\n", self->inlined);
+	fprintf(out, "fold: %u nodes removed\n", self->folded);
+	fprintf(out, "dce: %u statements removed\n", self->eliminated);
+	fprintf(out, "licm: %u expressions hoisted\n", self->hoisted);
+}
+
+unsigned int optFold(Program *ast) {
+	unsigned int removed = 0;
+	
+	vecForEach(Item *item, ast->items) {
+		if (item->tag == ITEM_GLOBAL_VAR) {
+			foldExpr(&item->var_def.init, &removed);
+		} else {
+			vecForEach(Stmt *stmt, item->func_def.statements) {
+				foldStmt(stmt, &removed);
+			}
+		}
+	}
+	
+	return removed;
+}
+
+unsigned int optDeadCode(Program *ast, const SymDefTable *tab) {
+	unsigned int count = vecLen(tab->definitions);
+	Dce self = { .reads = malloc((count + 1)*sizeof(unsigned int)) };
+	
+	if (self.reads == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	/* removing a statement may remove the last read of another variable */
+	do {
+		self.changed = 0;
+		memset(self.reads, 0, count*sizeof(unsigned int));
+		
+		vecForEach(const Item *item, ast->items) {
+			if (item->tag == ITEM_GLOBAL_VAR) {
+				countReads(self.reads, &item->var_def.init);
+			} else {
+				vecForEach(const Stmt *stmt, item->func_def.statements) {
+					countStmtReads(self.reads, stmt);
+				}
+			}
+		}
+		
+		vecForEach(Item *item, ast->items) {
+			if (item->tag == ITEM_FUNC) {
+				dceStmts(&self, item->func_def.statements);
+				continue;
+			}
+			
+			/* the definition itself is kept for the symbol table */
+			Expr *init = &item->var_def.init;
+			
+			if (init->tag != EXPR_INVALID && self.reads[item->var_def.res_ident.res.index] == 0 && optExprIsPure(init)) {
+				astExprRelease(init);
+				*init = (Expr) { .tag = EXPR_INVALID, .data_type = TYPE_VOID };
+				self.removed += 1;
+				self.changed = 1;
+			}
+		}
+	} while (self.changed);
+	
+	free(self.reads);
+	return self.removed;
+}
+
+unsigned int optInline(Program *ast, SymDefTable *tab, unsigned int threshold) {
+	unsigned int count = vecLen(tab->definitions);
+	Inliner self = {
+		.ast = ast,
+		.tab = tab,
+		.threshold = threshold,
+		.callees = scanFunctions(ast, tab, NULL),
+		.recursive = calloc(count + 1, 1),
+		.done = calloc(count + 1, 1)
+	};
+	
+	if (self.recursive == NULL || self.done == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	for (unsigned int i = 0; i < count; ++i) {
+		self.recursive[i] = tab->definitions[i].tag == SYM_DEF_FUNC && isRecursive(self.callees, count, i);
+	}
+	
+	/* callees first, so that their bodies are inlined with their own calls replaced */
+	for (unsigned int i = 0; i < count && threshold > 0; ++i) {
+		if (tab->definitions[i].tag == SYM_DEF_FUNC) { inlineFunc(&self, i); }
+	}
+	
+	releaseCallees(self.callees, count);
+	free(self.recursive);
+	free(self.done);
+	return self.inlined;
+}
+
+unsigned int optLoopInvariants(Program *ast, SymDefTable *tab) {
+	unsigned int count = vecLen(tab->definitions);
+	Licm self = { .tab = tab, .effects = calloc(count + 1, 1) };
+	int changed;
+	
+	if (self.effects == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	DefId **callees = scanFunctions(ast, tab, self.effects);
+	
+	/* recursion may exhaust the stack */
+	for (unsigned int i = 0; i < count; ++i) {
+		if (isRecursive(callees, count, i)) { self.effects[i] |= EFFECT_MAY_FAIL; }
+	}
+	
+	/* a function has the effects of all functions it calls */
+	do {
+		changed = 0;
+		
+		for (unsigned int i = 0; i < count; ++i) {
+			vecForEach(const DefId *callee, callees[i]) {
+				unsigned char effects = self.effects[i] | self.effects[callee->index];
+				
+				if (effects != self.effects[i]) {
+					self.effects[i] = effects;
+					changed = 1;
+				}
+			}
+		}
+	} while (changed);
+	
+	for (unsigned int i = 0; i < count; ++i) {
+		if (tab->definitions[i].tag != SYM_DEF_FUNC) { continue; }
+		
+		self.func = (DefId) { i };
+		
+		vecForEach(Stmt *stmt, ast->items[tab->definitions[i].func.item_id.index].func_def.statements) {
+			licmNest(&self, stmt);
+		}
+	}
+	
+	releaseCallees(callees, count);
+	free(self.effects);
+	return self.hoisted;
+}
+
+int optExprIsPure(const Expr *expr) {
+	switch (expr->tag) {
+	case EXPR_INVALID:
+	case EXPR_LITERAL:
+	case EXPR_VAR:
+		return 1;
+		
+	case EXPR_UNARY_MINUS:
+		return optExprIsPure(expr->unary_minus);
+		
+	case EXPR_BIN_OP: {
+		const BinOpExpr *bin = &expr->bin_op;
+		
+		if (mayTrap(expr)) { return 0; }
+		
+		return optExprIsPure(bin->lhs) && optExprIsPure(bin->rhs);
+	}
+	
+	case EXPR_ASSIGN:
+	case EXPR_CALL:
+		return 0;
+	}
+	
+	assert(0);
+	return 0;
+}
+
+unsigned int optExprSize(const Expr *expr) {
+	unsigned int size = 1;
+	
+	switch (expr->tag) {
+	case EXPR_INVALID:
+		return 0;
+		
+	case EXPR_ASSIGN:
+		size += optExprSize(expr->assign.rhs);
+		break;
+		
+	case EXPR_BIN_OP:
+		size += optExprSize(expr->bin_op.lhs) + optExprSize(expr->bin_op.rhs);
+		break;
+		
+	case EXPR_UNARY_MINUS:
+		size += optExprSize(expr->unary_minus);
+		break;
+		
+	case EXPR_CALL:
+		vecForEach(const Expr *arg, expr->call.args) {
+			size += optExprSize(arg);
+		}
+		break;
+		
+	case EXPR_LITERAL:
+	case EXPR_VAR:
+		break;
+	}
+	
+	return size;
+}
@@ -0,0 +1,153 @@
+/***************************************************************************//**
+ * @file opt.h
+ * @brief Optimierungen auf dem analysierten Syntaxbaum.
+ *
+ * # Überblick
+ *
+ * Die Optimierungen verändern den Syntaxbaum an Ort und Stelle, bevor er an
+ * eine der Ausführungsmaschinen oder Übersetzer übergeben wird. Sie erhalten
+ * die Semantik des Programms, insbesondere die Auswertung von links nach
+ * rechts und alle Seiteneffekte von Zuweisungen, Funktionsaufrufen und der
+ * `print`-Anweisung.
+ *
+ * - Das Inlining (`optInline()`) ersetzt Aufrufe kleiner, nicht rekursiver
+ *   Funktionen durch ihren Rumpf. Besteht der Rumpf nur aus `return`, wird der
+ *   Aufruf im umgebenden Ausdruck ersetzt, sonst als Block anstelle einer
+ *   Anweisung. Parameter und lokale Variablen der Funktion werden zu neuen
+ *   lokalen Variablen des Rufers.
+ * - Die Konstantenfaltung (`optFold()`) berechnet Operationen, deren Operanden
+ *   Literale sind, und vereinfacht algebraische Identitäten wie `x * 1`.
+ *   Ganzzahlige Operationen, deren Ergebnis überlaufen würde, Divisionen durch
+ *   `0` und Operationen mit nicht endlichem Ergebnis werden nicht gefaltet,
+ *   sondern zur Laufzeit ausgewertet.
+ * - Die Entfernung toten Codes (`optDeadCode()`) löscht unerreichbare
+ *   Anweisungen nach `return` und nach Schleifen mit der Bedingung `true`,
+ *   ersetzt `if`-Anweisungen mit literaler Bedingung durch den gewählten
+ *   Zweig und entfernt Definitionen und Zuweisungen von Variablen, die nie
+ *   gelesen werden, sofern ihr Wert ohne Seiteneffekte berechnet wird.
+ * - Die Verschiebung schleifeninvarianter Ausdrücke (`optLoopInvariants()`)
+ *   berechnet Ausdrücke, deren Variablen in einer Schleife nicht zugewiesen
+ *   werden, einmal vor der Schleife in einer neuen lokalen Variablen. Aufrufe
+ *   von Funktionen, die weder globale Variablen schreiben noch ausgeben, gelten
+ *   dabei als Ausdrücke ohne Seiteneffekte.
+ *
+ * Entfernte Knoten werden freigegeben; die Anzahl entfernter Knoten wird in
+ * `OptStats` gesammelt.
+ ******************************************************************************/
+
+#ifndef OPT_H_INCLUDED
+#define OPT_H_INCLUDED
+
+/* *** Includes ************************************************************* */
+
+#include <stdio.h>
+#include "ast.h"
+#include "symtab.h"
+
+/* *** Konstanten *********************************************************** */
+
+/** @brief Maximale Größe eines Funktionsrumpfes, der standardmäßig eingesetzt wird. */
+#define OPT_INLINE_THRESHOLD 16
+
+/* *** Strukturen *********************************************************** */
+
+/**
+ * @brief Statistik eines Optimierungslaufs.
+ */
+typedef struct OptStats {
+	unsigned int inlined;    /**<@brief Durch den Funktionsrumpf ersetzte Aufrufe. */
+	unsigned int folded;     /**<@brief Durch Konstantenfaltung entfernte Ausdrücke. */
+	unsigned int eliminated; /**<@brief Als tot entfernte Anweisungen. */
+	unsigned int hoisted;    /**<@brief Aus Schleifen verschobene Ausdrücke. */
+} OptStats;
+
+/* *** Öffentliche Schnittstelle ******************************************** */
+
+/**
+ * @brief Wendet alle Optimierungen auf ein semantisch analysiertes Programm an.
+ *
+ * @param ast              Die Wurzel des abstrakten Syntaxbaumes.
+ * @param tab              Die Definitionstabelle des Programms, die um
+ *                         Hilfsvariablen erweitert wird.
+ * @param inline_threshold Maximale Größe eingesetzter Funktionsrümpfe, `0`
+ *                         schaltet das Inlining ab.
+ * @param stats            Die Statistik, die um die Ergebnisse ergänzt wird,
+ *                         oder `NULL`.
+ */
+extern void optProgram(Program *ast, SymDefTable *tab, unsigned int inline_threshold, OptStats *stats);
+
+/**
+ * @brief Gibt die Statistik eines Optimierungslaufs aus.
+ * @param self Die auszugebende Statistik.
+ * @param out  Der Ausgabestrom.
+ */
+extern void optStatsPrint(const OptStats *self, FILE *out);
+
+/**
+ * @brief Ersetzt Aufrufe kleiner Funktionen durch ihren Rumpf.
+ *
+ * Eingesetzt werden nicht rekursive Funktionen, deren Rumpf höchstens
+ * \p threshold Anweisungs- und Ausdrucksknoten umfasst. Aufgerufene Funktionen
+ * werden vor ihren Rufern bearbeitet.
+ *
+ * @param ast       Die Wurzel des abstrakten Syntaxbaumes.
+ * @param tab       Die Definitionstabelle, die um die Variablen der
+ *                  eingesetzten Funktionen erweitert wird.
+ * @param threshold Maximale Größe eines eingesetzten Funktionsrumpfes.
+ * @return Die Anzahl der ersetzten Aufrufe.
+ */
+extern unsigned int optInline(Program *ast, SymDefTable *tab, unsigned int threshold);
+
+/**
+ * @brief Faltet konstante Ausdrücke und vereinfacht algebraische Identitäten.
+ *
+ * @param ast Die Wurzel des abstrakten Syntaxbaumes.
+ * @return Die Anzahl der entfernten Ausdrucksknoten.
+ */
+extern unsigned int optFold(Program *ast);
+
+/**
+ * @brief Entfernt unerreichbare und wirkungslose Anweisungen.
+ *
+ * @param ast Die Wurzel des abstrakten Syntaxbaumes.
+ * @param tab Die Definitionstabelle des Programms.
+ * @return Die Anzahl der entfernten Anweisungsknoten.
+ */
+extern unsigned int optDeadCode(Program *ast, const SymDefTable *tab);
+
+/**
+ * @brief Verschiebt schleifeninvariante Ausdrücke vor ihre Schleife.
+ *
+ * Innere Schleifen werden zuerst bearbeitet. Ein Ausdruck, der abbrechen oder
+ * nicht terminieren kann, etwa eine ganzzahlige Division oder der Aufruf
+ * einer Funktion mit Schleifen oder Rekursion, wird nur aus den führenden
+ * Zuweisungen des Schleifenrumpfes verschoben. Eine `for`- oder
+ * `while`-Schleife wird dafür in eine durch ihre Bedingung geschützte
+ * `do while`-Schleife umgeformt, so dass der Ausdruck nur ausgewertet wird,
+ * wenn der Rumpf mindestens einmal ausgeführt wird.
+ *
+ * @param ast Die Wurzel des abstrakten Syntaxbaumes.
+ * @param tab Die Definitionstabelle, die um je eine lokale Variable je
+ *            verschobenem Ausdruck erweitert wird.
+ * @return Die Anzahl der durch eine Hilfsvariable ersetzten Ausdrücke.
+ */
+extern unsigned int optLoopInvariants(Program *ast, SymDefTable *tab);
+
+/**
+ * @brief Gibt zurück, ob die Auswertung eines Ausdrucks frei von
+ * Seiteneffekten ist und nicht abbrechen kann.
+ *
+ * Zuweisungen und Funktionsaufrufe gelten immer als Seiteneffekt, ebenso
+ * ganzzahlige Divisionen, deren Divisor `0` sein könnte.
+ *
+ * @param expr Der zu prüfende Ausdruck.
+ */
+extern int optExprIsPure(const Expr *expr);
+
+/**
+ * @brief Gibt die Anzahl der Ausdrucksknoten in einem Ausdruck zurück.
+ * @param expr Der Ausdruck.
+ */
+extern unsigned int optExprSize(const Expr *expr);
+
+#endif
@@ -0,0 +1,208 @@
+/***************************************************************************//**
+ * @file out.c
+ * @brief Implementation der gepufferten Ausgabe.
+ ******************************************************************************/
+
+/* write, fileno, sigaction und sigaltstack gehören nicht zu C11 */
+#define _DEFAULT_SOURCE
+
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include "out.h"
+#include "fmt.h"
+
+/* *** internal structures ************************************************** */
+
+/** @internal @brief Maximale Länge einer formatierten ganzen Zahl. */
+#define INT_SIZE 11
+
+/** @internal @brief Der von `outGuard()` überwachte Ausgabepuffer oder `NULL`. */
+static Out *volatile guarded;
+
+/** @internal @brief Der Dateideskriptor des überwachten Stroms. */
+static int guarded_fd;
+
+/* *** internal helpers ***************************************************** */
+
+/**
+ * @internal
+ * @brief Gibt den Platz für \p len weitere Bytes im Puffer zurück oder
+ * `NULL`, falls der Puffer dafür zu klein ist.
+ */
+static char* reserve(Out *self, size_t len) {
+	if (self->size - self->len < len) { outFlush(self); }
+	return self->size >= len ? self->buf + self->len : NULL;
+}
+
+/**
+ * @internal
+ * @brief Gibt den überwachten Puffer bei Programmende aus.
+ */
+static void onExit(void) {
+	if (guarded != NULL) { outFlush(guarded); }
+}
+
+/**
+ * @internal
+ * @brief Gibt den überwachten Puffer aus und beendet das Programm mit dem
+ * empfangenen Signal.
+ *
+ * Im Signalhandler sind nur async-signal-sichere Funktionen erlaubt, daher
+ * wird der Puffer mit `write()` am Strom vorbei ausgegeben. Der Handler läuft
+ * auf einem eigenen Stapel, damit er auch nach einem Stapelüberlauf durch
+ * tiefe Rekursion ausgeführt werden kann, und ist wegen `SA_RESETHAND` beim
+ * erneuten Auslösen des Signals bereits zurückgesetzt.
+ */
+static void onSignal(int sig) {
+	Out *self = guarded;
+	
+	if (self != NULL) {
+		size_t done = 0;
+		
+		while (done < self->len) {
+			ssize_t written = write(guarded_fd, self->buf + done, self->len - done);
+			if (written <= 0) { break; }
+			done += written;
+		}
+		
+		self->len = 0;
+	}
+	
+	raise(sig);
+}
+
+/**
+ * @internal
+ * @brief Richtet einen eigenen Stapel für die Signalhandler ein und
+ * installiert `onSignal()` für die Signale eines Abbruchs.
+ */
+static void installHandlers(void) {
+	stack_t stack = { .ss_size = SIGSTKSZ };
+	stack.ss_sp = malloc(stack.ss_size);
+	
+	if (stack.ss_sp == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	sigaltstack(&stack, NULL);
+	
+	struct sigaction action = { .sa_handler = onSignal, .sa_flags = SA_ONSTACK | SA_RESETHAND };
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGFPE, &action, NULL);
+	sigaction(SIGSEGV, &action, NULL);
+	sigaction(SIGABRT, &action, NULL);
+}
+
+/* *** implementation ******************************************************* */
+
+Out outNew(FILE *file, size_t size) {
+	Out self = { .file = file, .size = size };
+	
+	if (size > 0) {
+		self.buf = malloc(size);
+		
+		if (self.buf == NULL) {
+			fputs("out-of-memory error\n", stderr);
+			exit(-1);
+		}
+	}
+	
+	return self;
+}
+
+void outRelease(Out *self) {
+	outFlush(self);
+	if (guarded == self) { guarded = NULL; }
+	free(self->buf);
+	self->buf = NULL;
+	self->size = 0;
+}
+
+void outFlush(Out *self) {
+	if (self->len > 0) {
+		fwrite(self->buf, 1, self->len, self->file);
+		self->len = 0;
+	}
+	
+	fflush(self->file);
+}
+
+void outGuard(Out *self) {
+	static int installed = 0;
+	
+	guarded_fd = fileno(self->file);
+	guarded = self;
+	
+	if (!installed) {
+		installed = 1;
+		atexit(onExit);
+		installHandlers();
+	}
+}
+
+void outWrite(Out *self, const char *data, size_t len) {
+	if (len == 0) { return; }
+	
+	if (self->size - self->len < len) {
+		outFlush(self);
+		
+		/* data that does not fit into the buffer bypasses it */
+		if (self->size < len) {
+			fwrite(data, 1, len, self->file);
+			fflush(self->file);
+			return;
+		}
+	}
+	
+	memcpy(self->buf + self->len, data, len);
+	self->len += len;
+}
+
+void outString(Out *self, const char *str) {
+	outWrite(self, str, strlen(str));
+}
+
+void outInt(Out *self, int value) {
+	char tmp[INT_SIZE];
+	char *dst = reserve(self, INT_SIZE);
+	if (dst == NULL) { dst = tmp; }
+	
+	unsigned int magnitude = value < 0 ? 0u - (unsigned int) value : (unsigned int) value;
+	size_t len = value < 0 ? 2 : 1;
+	
+	for (unsigned int rest = magnitude; rest >= 10; rest /= 10) {
+		++len;
+	}
+	
+	char *digit = dst + len;
+	
+	do {
+		*--digit = '0' + magnitude % 10;
+		magnitude /= 10;
+	} while (magnitude > 0);
+	
+	if (value < 0) { *dst = '-'; }
+	
+	if (dst == tmp) {
+		outWrite(self, tmp, len);
+	} else {
+		self->len += len;
+	}
+}
+
+void outFloat(Out *self, double value) {
+	char tmp[FMT_FLOAT_SIZE];
+	char *dst = reserve(self, FMT_FLOAT_SIZE);
+	if (dst == NULL) { dst = tmp; }
+	
+	size_t len = fmtFloat(dst, value);
+	
+	if (dst == tmp) {
+		outWrite(self, tmp, len);
+	} else {
+		self->len += len;
+	}
+}
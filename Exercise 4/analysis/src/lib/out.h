@@ -0,0 +1,121 @@
+/***************************************************************************//**
+ * @file out.h
+ * @brief Gepufferte Ausgabe der `print`-Anweisung.
+ *
+ * # Überblick
+ *
+ * Alle Ausführungsmaschinen schreiben die Ausgabe der `print`-Anweisung in
+ * einen `Out`-Puffer statt direkt in einen Strom der C-Bibliothek. Zahlen
+ * werden unmittelbar in den Puffer formatiert; an den Strom übergeben wird
+ * der Puffer nur, wenn er voll ist, bei `outFlush()` und `outRelease()` sowie
+ * nach `outGuard()` beim Programmende durch `exit()` und beim Abbruch durch
+ * ein Signal wie `SIGFPE`.
+ *
+ * Mit der Puffergröße `0` wird jede Ausgabe sofort an den Strom übergeben
+ * und dieser geleert, was die Fehlersuche in interaktiven Programmen
+ * erleichtert.
+ ******************************************************************************/
+
+#ifndef OUT_H_INCLUDED
+#define OUT_H_INCLUDED
+
+/* *** Includes ************************************************************* */
+
+#include <stdio.h>
+#include <stddef.h>
+
+/* *** Konstanten *********************************************************** */
+
+/** @brief Standardgröße des Ausgabepuffers in Bytes. */
+#define OUT_BUFFER_SIZE ((size_t) 1 << 16)
+
+/* *** Strukturen *********************************************************** */
+
+/**
+ * @brief Ein gepufferter Ausgabestrom.
+ */
+typedef struct Out {
+	FILE *file;  /**<@brief Der Zielstrom. */
+	char *buf;   /**<@brief Der Puffer oder `NULL` im ungepufferten Modus. */
+	size_t len;  /**<@brief Anzahl belegter Bytes im Puffer. */
+	size_t size; /**<@brief Größe des Puffers in Bytes. */
+} Out;
+
+/* *** Öffentliche Schnittstelle ******************************************** */
+
+/**
+ * @brief Erzeugt einen Ausgabepuffer für einen Strom.
+ *
+ * @param file Der Zielstrom.
+ * @param size Die Größe des Puffers in Bytes, `0` für ungepufferte Ausgabe.
+ */
+extern Out outNew(FILE *file, size_t size);
+
+/**
+ * @brief Übergibt den Inhalt des Puffers an den Strom und gibt den Puffer
+ * frei.
+ * @param self Der freizugebende Ausgabepuffer.
+ */
+extern void outRelease(Out *self);
+
+/**
+ * @brief Übergibt den Inhalt des Puffers an den Strom und leert diesen.
+ * @param self Der Ausgabepuffer.
+ */
+extern void outFlush(Out *self);
+
+/**
+ * @brief Sorgt dafür, dass der Puffer auch beim Aufruf von `exit()` und beim
+ * Abbruch durch `SIGFPE`, `SIGSEGV` oder `SIGABRT` ausgegeben wird, auch
+ * wenn der Abbruch durch einen Stapelüberlauf ausgelöst wurde.
+ *
+ * Es wird höchstens ein Puffer gleichzeitig überwacht; `outRelease()` beendet
+ * die Überwachung.
+ *
+ * @param self Der zu überwachende Ausgabepuffer.
+ */
+extern void outGuard(Out *self);
+
+/**
+ * @brief Schreibt \p len Bytes in den Puffer.
+ * @param self Der Ausgabepuffer.
+ * @param data Die zu schreibenden Bytes.
+ * @param len  Die Anzahl der Bytes.
+ */
+extern void outWrite(Out *self, const char *data, size_t len);
+
+/**
+ * @brief Schreibt eine nullterminierte Zeichenkette in den Puffer.
+ * @param self Der Ausgabepuffer.
+ * @param str  Die Zeichenkette.
+ */
+extern void outString(Out *self, const char *str);
+
+/**
+ * @brief Schreibt eine ganze Zahl in Dezimaldarstellung in den Puffer.
+ * @param self  Der Ausgabepuffer.
+ * @param value Die Zahl.
+ */
+extern void outInt(Out *self, int value);
+
+/**
+ * @brief Schreibt eine Fließkommazahl gemäß `fmtFloat()` in den Puffer.
+ * @param self  Der Ausgabepuffer.
+ * @param value Die Zahl.
+ */
+extern void outFloat(Out *self, double value);
+
+/**
+ * @brief Schreibt ein einzelnes Zeichen in den Puffer.
+ * @param self Der Ausgabepuffer.
+ * @param c    Das Zeichen.
+ */
+static inline void outChar(Out *self, char c) {
+	if (self->len < self->size) {
+		self->buf[self->len++] = c;
+	} else {
+		outWrite(self, &c, 1);
+	}
+}
+
+#endif
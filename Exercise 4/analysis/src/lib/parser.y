@@ -1,6 +1,8 @@
 %define parse.error verbose
 %define parse.trace
-%parse-param {ParseResult *out}
+%define api.pure full
+%parse-param {ParseResult *out} {Lexer *lexer}
+%lex-param {Lexer *lexer}
 
 %code requires {
 	#include <stdio.h>
@@ -9,12 +11,10 @@
 	#include "vec.h"
 	#include "symtab.h"
 	
+	#include "lex.h"
+	
 	/* Vorwärtsdeklaration für die yyparse()-Funktion */
 	typedef struct ParseResult ParseResult;
-	
-	extern int yylex(void);
-	extern int yylineno;
-	extern FILE *yyin;
 }
 
 %code provides {
@@ -25,7 +25,8 @@
 		enum ParseResultTag {
 			PARSE_OK,
 			PARSE_ERR_SYNTAX,
-			PARSE_ERR_SEMANTIC
+			PARSE_ERR_SEMANTIC,
+			PARSE_ERR_INPUT
 		} tag;
 		
 		union {
@@ -40,41 +41,112 @@
 	/**
 	 * Die obere Parse-Funktion: wandelt den Eingabestrom in einen AST (`Program`)
 	 * um oder gibt eine Fehlermeldung zurück, falls das Programm inkorrekt ist.
+	 * Scanner und Parser halten ihren Zustand in lokalen Kontexten, so dass
+	 * mehrere Threads gleichzeitig verschiedene Eingaben parsen können.
 	 */
 	extern ParseResult astParse(FILE *input);
 	
+	/**
+	 * Wie `astParse()`, scannt aber die in den Speicher eingeblendete Datei an
+	 * Ort und Stelle, ohne die Eingabe in den Puffer des Scanners zu kopieren.
+	 * Kann die Datei nicht gelesen werden, ist das Ergebnis `PARSE_ERR_INPUT`.
+	 * Ist `scanMode` gleich `SCAN_DFA`, wird der handgeschriebene Scanner
+	 * verwendet.
+	 */
+	extern ParseResult astParseMapped(const char *path);
+	
 	/**
 	 * Speichert die Fehlermeldung für den Rufer.
 	 * Die Funktion akzeptiert eine variable Argumentliste und nutzt die Syntax von
 	 * printf.
-	 * @param out  Zeiger auf das Ausgabeargument der parse-Funktion
-	 * @param msg  die Fehlermeldung
-	 * @param ...  variable Argumentliste für die Formatierung von \p msg
+	 * @param out    Zeiger auf das Ausgabeargument der parse-Funktion
+	 * @param lexer  der Scanner, dessen Zeilennummer gemeldet wird
+	 * @param msg    die Fehlermeldung
+	 * @param ...    variable Argumentliste für die Formatierung von \p msg
 	 */
-	extern void yyerror(ParseResult *out, const char *msg, ...);
+	extern void yyerror(ParseResult *out, Lexer *lexer, const char *msg, ...);
 }
 
 %code {
+	#include "source.h"
+	
 	/**
 	 * Meldet einen semantischen Fehler, falls die Bedingung zutrifft.
 	 */
 	#define DENY(COND, ...) do { \
 		if (COND) { \
-			yyerror(out, __VA_ARGS__); \
+			yyerror(out, lexer, __VA_ARGS__); \
 			out->tag = PARSE_ERR_SEMANTIC; \
 			YYABORT; \
 		} \
 	} while (0)
+	
+	/**
+	 * Erzeugt einen typisierten Ausdruck für eine binäre Operation und meldet
+	 * einen semantischen Fehler, falls die Operandentypen unzulässig sind.
+	 */
+	#define BIN_OP(RESULT, LHS, RHS, OP) do { \
+		DataType type = binOpType(OP, (LHS).data_type, (RHS).data_type); \
+		DENY(type == TYPE_VOID, "invalid operands of type '%s' and '%s' for operator %s", \
+			TYPE_NAMES[(LHS).data_type], TYPE_NAMES[(RHS).data_type], BIN_OP_NAMES[OP]); \
+		RESULT = astExprFromBinOpExpr(LHS, RHS, OP); \
+		RESULT.data_type = type; \
+	} while (0)
+	
+	/**
+	 * Gibt zurück, ob ein Wert vom Typ \p from an einer Stelle vom Typ \p to
+	 * verwendet werden darf, er also identisch oder in diesen konvertierbar ist.
+	 */
+	static bool isCompatible(DataType from, DataType to) {
+		return from == to || (from == TYPE_INT && to == TYPE_FLOAT);
+	}
+	
+	/**
+	 * Gibt zurück, ob ein Typ an arithmetischen Operationen teilnehmen darf.
+	 */
+	static bool isArithmetic(DataType type) {
+		return type == TYPE_INT || type == TYPE_FLOAT;
+	}
+	
+	/**
+	 * Berechnet den Ergebnistyp einer binären Operation.
+	 * 
+	 * @return der Ergebnistyp oder `TYPE_VOID`, falls die Operandentypen für
+	 *         den Operator unzulässig sind
+	 */
+	static DataType binOpType(BinOp op, DataType lhs, DataType rhs) {
+		switch (op) {
+		case BIN_OP_ADD:
+		case BIN_OP_SUB:
+		case BIN_OP_MUL:
+		case BIN_OP_DIV:
+			if (!isArithmetic(lhs) || !isArithmetic(rhs)) { return TYPE_VOID; }
+			return (lhs == TYPE_FLOAT || rhs == TYPE_FLOAT) ? TYPE_FLOAT : TYPE_INT;
+			
+		case BIN_OP_LOG_OR:
+		case BIN_OP_LOG_AND:
+			return (lhs == TYPE_BOOL && rhs == TYPE_BOOL) ? TYPE_BOOL : TYPE_VOID;
+			
+		default:
+			/* Zeichenketten sind kein Datentyp von C1 und damit genauso wenig
+			 * vergleichbar wie `void` */
+			if (lhs == TYPE_VOID || lhs == TYPE_STRING) { return TYPE_VOID; }
+			if (!isCompatible(lhs, rhs) && !isCompatible(rhs, lhs)) { return TYPE_VOID; }
+			return TYPE_BOOL;
+		}
+	}
 }
 
 %union {
 	/* lexical token types */
-	char *string;
+	const char *string;
+	Ident ident;
 	double floatValue;
 	int intValue;
 	
 	/* ast types */
 	Item item;
+	ForInit for_init;
 	
 	FuncDef func_def;
 	FuncParam func_param;
@@ -102,6 +174,7 @@
 
 /* define the printer routines for improved debug output */
 %printer { fprintf(yyoutput, "\"%s\"", $$); }     <string>
+%printer { fputs(internName($$), yyoutput); }     <ident>
 %printer { fprintf(yyoutput, "%g", $$); }         <floatValue>
 %printer { fprintf(yyoutput, "%i", $$); }         <intValue>
 %printer { astItemPrint(&$$, 0, yyoutput); }      <item>
@@ -112,6 +185,7 @@
 %printer { astStmtPrint(&$$, 0, yyoutput); }      <stmt>
 %printer { astIfStmtPrint(&$$, 0, yyoutput); }    <if_stmt>
 %printer { astForStmtPrint(&$$, 0, yyoutput); }   <for_stmt>
+%printer { astForInitPrint(&$$, 0, yyoutput); }   <for_init>
 %printer { astWhileStmtPrint(&$$, 0, yyoutput); } <while_stmt>
 %printer { astPrintStmtPrint(&$$, 0, yyoutput); } <print_stmt>
 %printer { astVarDefPrint(&$$, 0, yyoutput); }    <var_def>
@@ -119,7 +193,6 @@
 %printer { astExprPrint(&$$, 0, yyoutput); }      <expr>
 
 /* define destructors in order to prevent memory leaks */
-%destructor { free($$); }                 <string>
 %destructor { astItemRelease(&$$); }      <item>
 %destructor { astFuncDefRelease(&$$); }   <func_def>
 %destructor { astFuncParamRelease(&$$); } <func_param>
@@ -128,6 +201,7 @@
 %destructor { astStmtRelease(&$$); }      <stmt>
 %destructor { astIfStmtRelease(&$$); }    <if_stmt>
 %destructor { astForStmtRelease(&$$); }   <for_stmt>
+%destructor { astForInitRelease(&$$); }   <for_init>
 %destructor { astWhileStmtRelease(&$$); } <while_stmt>
 %destructor { astPrintStmtRelease(&$$); } <print_stmt>
 %destructor { astVarDefRelease(&$$); }    <var_def>
@@ -194,7 +268,7 @@
 %token <floatValue> FLOAT_LITERAL
 %token <intValue>   BOOL_LITERAL
 %token <string>     STRING_LITERAL
-%token <string>     IDENT
+%token <ident>      IDENT
 
 /* workaround for handling dangling else */
 /* LOWER_THAN_ELSE stands for a non-existing else */
@@ -211,6 +285,7 @@
 %type <stmts>       statementlist
 %type <if_stmt>     ifstatement
 %type <for_stmt>    forstatement
+%type <for_init>    forinit
 %type <while_stmt>  whilestatement dowhilestatement
 %type <print_stmt>  print
 %type <var_def>     declassignment
@@ -223,7 +298,13 @@
 %%
 
 start:
-	program
+	program {
+		DefInfo *def = symtabIndex(&out->tab, symtabResolve(&out->tab, internLiteral("main")));
+		DENY(def == NULL, "missing function 'main'");
+		DENY(def->tag != SYM_DEF_FUNC, "'main' is not a function");
+		DENY(def->func.return_type != TYPE_VOID, "'main' must return 'void'");
+		DENY(def->func.param_count != 0, "'main' must not take any parameters");
+	}
 	;
 
 /* see EBNF grammar for further information */
@@ -241,10 +322,16 @@ item:
 	}
 	;
 
+/* Parameter und lokale Variablen teilen sich einen Sichtbarkeitsbereich, der
+ * Funktionsname ist dagegen Teil des globalen Sichtbarkeitsbereiches */
 functiondefinition:
-	type IDENT[ident] '(' opt_parameterlist[params] ')' '{'
+	type IDENT[ident] '(' {
+		DENY(!symtabDefineFunc(&out->tab, $ident, $type), "redefinition of '%s'", internName($ident));
+		symtabScopeEnter(&out->tab);
+	} opt_parameterlist[params] ')' '{'
 		statementlist[body]
 	'}' {
+		symtabScopeLeave(&out->tab);
 		$$ = astFuncDefNew($type, $ident, $params, $body);
 	}
 	;
@@ -267,6 +354,8 @@ parameterlist:
 
 parameter:
 	type IDENT[ident] {
+		DENY($type == TYPE_VOID, "parameter '%s' declared 'void'", internName($ident));
+		DENY(!symtabDefineParam(&out->tab, $ident, $type), "redefinition of '%s'", internName($ident));
 		$$ = astFuncParamNew($type, $ident);
 	}
 	;
@@ -274,6 +363,22 @@ parameter:
 functioncall:
 	IDENT[ident] '(' opt_argumentlist[args] ')' {
 		$$ = astFuncCallNew($ident, $args);
+		$$.res_ident.res = symtabResolve(&out->tab, $$.res_ident.ident);
+
+		const DefInfo *def = symtabIndex(&out->tab, $$.res_ident.res);
+		DENY(def == NULL, "undeclared identifier '%s'", internName($$.res_ident.ident));
+		DENY(def->tag != SYM_DEF_FUNC, "'%s' is not a function", internName(def->ident));
+		DENY(vecLen($$.args) != def->func.param_count,
+			"'%s' expects %u arguments, but %u were given",
+			internName(def->ident), def->func.param_count, vecLen($$.args));
+
+		for (unsigned int i = 0; i < def->func.param_count; ++i) {
+			DataType arg = $$.args[i].data_type;
+			DataType param = symtabIndex(&out->tab, def->func.local_vars[i])->var.data_type;
+			DENY(!isCompatible(arg, param),
+				"argument %u of '%s' has type '%s', but '%s' was expected",
+				i + 1, internName(def->ident), TYPE_NAMES[arg], TYPE_NAMES[param]);
+		}
 	}
 	;
 
@@ -304,7 +409,8 @@ statementlist:
 	;
 
 block:
-	'{' statementlist[stmts] '}' {
+	'{' { symtabScopeEnter(&out->tab); } statementlist[stmts] '}' {
+		symtabScopeLeave(&out->tab);
 		$$ = astBlockNew($stmts);
 	}
 	;
@@ -345,6 +451,7 @@ statement:
 
 ifstatement:
 	KW_IF '(' assignment[cond] ')' statement[true] opt_else[false] {
+		DENY($cond.data_type != TYPE_BOOL, "condition of 'if' must be of type 'bool'");
 		$$ = astIfStmtNew($cond, $true, $false);
 	}
 	;
@@ -360,54 +467,81 @@ opt_else:
 	}
 	;
 
+/* die For-Anweisung öffnet einen eigenen Sichtbarkeitsbereich, der die
+ * Initialisierung und den Schleifenkörper umfasst */
 forstatement:
-	KW_FOR '(' declassignment[init] ';' expr[cond] ';' statassignment[update] ')' statement[body] {
-		$$ = astForStmtNew(
-			astForInitFromVarDef($init),
-			$cond, $update, $body
-		);
-	}
-	| KW_FOR '(' statassignment[init] ';' expr[cond] ';' statassignment[update] ')' statement[body] {
-		$$ = astForStmtNew(
-			astForInitFromAssign($init),
-			$cond, $update, $body
-		);
+	KW_FOR '(' { symtabScopeEnter(&out->tab); } forinit[init] ';' expr[cond] ';' statassignment[update] ')' statement[body] {
+		DENY($cond.data_type != TYPE_BOOL, "condition of 'for' must be of type 'bool'");
+		symtabScopeLeave(&out->tab);
+		$$ = astForStmtNew($init, $cond, $update, $body);
+	}
+	;
+
+forinit:
+	declassignment[init] {
+		$$ = astForInitFromVarDef($init);
+	}
+	| statassignment[init] {
+		$$ = astForInitFromAssign($init);
 	}
 	;
 
 dowhilestatement:
 	KW_DO statement[body] KW_WHILE '(' assignment[cond] ')' {
+		DENY($cond.data_type != TYPE_BOOL, "condition of 'do-while' must be of type 'bool'");
 		$$ = astWhileStmtNew($cond, $body);
 	}
 	;
 
 whilestatement:
 	KW_WHILE '(' assignment[cond] ')' statement[body] {
+		DENY($cond.data_type != TYPE_BOOL, "condition of 'while' must be of type 'bool'");
 		$$ = astWhileStmtNew($cond, $body);
 	}
 	;
 
 returnstatement:
 	KW_RETURN {
+		DataType type = symtabCurrentFunc(&out->tab)->return_type;
+		DENY(type != TYPE_VOID, "missing return value in function returning '%s'", TYPE_NAMES[type]);
 		$$ = astStmtFromReturn(NULL);
 	}
 	| KW_RETURN assignment[expr] {
+		DataType type = symtabCurrentFunc(&out->tab)->return_type;
+		DENY(type == TYPE_VOID, "return value in function returning 'void'");
+		DENY(!isCompatible($expr.data_type, type),
+			"returning '%s' from function returning '%s'",
+			TYPE_NAMES[$expr.data_type], TYPE_NAMES[type]);
 		$$ = astStmtFromReturn(&$expr);
 	}
 	;
 
 print:
 	KW_PRINT '(' opt_argumentlist[args] ')' {
+		vecForEach(Expr *arg, $args) {
+			DENY(arg->data_type == TYPE_VOID, "cannot print an expression of type 'void'");
+		}
 		$$ = astPrintStmtNew($args);
 	}
 	;
 
+/* die Variable wird erst nach ihrem Initialisierungsausdruck definiert, so
+ * dass sie sich darin nicht selbst referenzieren kann */
 declassignment:
 	type IDENT[ident] {
+		DENY($type == TYPE_VOID, "variable '%s' declared 'void'", internName($ident));
 		$$ = astVarDefNew($type, $ident, NULL);
+		$$.res_ident.res = symtabDefineVar(&out->tab, $$.res_ident.ident, $type);
+		DENY(defIdIsInvalid($$.res_ident.res), "redefinition of '%s'", internName($$.res_ident.ident));
 	}
 	| type IDENT[ident] ASSIGN assignment[init] {
+		DENY($type == TYPE_VOID, "variable '%s' declared 'void'", internName($ident));
+		DENY(!isCompatible($init.data_type, $type),
+			"initializing '%s' with an expression of type '%s'",
+			TYPE_NAMES[$type], TYPE_NAMES[$init.data_type]);
 		$$ = astVarDefNew($type, $ident, &$init);
+		$$.res_ident.res = symtabDefineVar(&out->tab, $$.res_ident.ident, $type);
+		DENY(defIdIsInvalid($$.res_ident.res), "redefinition of '%s'", internName($$.res_ident.ident));
 	}
 	;
 
@@ -421,12 +555,21 @@ type:
 statassignment:
 	IDENT[lhs] ASSIGN assignment[rhs] {
 		$$ = astAssignNew($lhs, $rhs);
+		$$.lhs.res = symtabResolve(&out->tab, $$.lhs.ident);
+
+		const DefInfo *def = symtabIndex(&out->tab, $$.lhs.res);
+		DENY(def == NULL, "undeclared identifier '%s'", internName($$.lhs.ident));
+		DENY(def->tag == SYM_DEF_FUNC, "cannot assign to function '%s'", internName(def->ident));
+		DENY(!isCompatible($$.rhs->data_type, def->var.data_type),
+			"assigning '%s' to variable '%s' of type '%s'",
+			TYPE_NAMES[$$.rhs->data_type], internName(def->ident), TYPE_NAMES[def->var.data_type]);
 	}
 	;
 
 assignment:
-	IDENT[lhs] ASSIGN assignment[rhs] {
-		$$ = astExprFromAssign(astAssignNew($lhs, $rhs));
+	statassignment[assign] {
+		$$ = astExprFromAssign($assign);
+		$$.data_type = symtabIndex(&out->tab, $assign.lhs.res)->var.data_type;
 	}
 	| expr
 	;
@@ -434,72 +577,86 @@ assignment:
 expr:
 	simpexpr
 	| simpexpr[lhs] EQ  simpexpr[rhs] {
-		$$ = astExprFromBinOpExpr($lhs, $rhs, BIN_OP_EQ);
+		BIN_OP($$, $lhs, $rhs, BIN_OP_EQ);
 	}
 	| simpexpr[lhs] NEQ simpexpr[rhs] {
-		$$ = astExprFromBinOpExpr($lhs, $rhs, BIN_OP_NEQ);
+		BIN_OP($$, $lhs, $rhs, BIN_OP_NEQ);
 	}
 	| simpexpr[lhs] LEQ simpexpr[rhs] {
-		$$ = astExprFromBinOpExpr($lhs, $rhs, BIN_OP_LEQ);
+		BIN_OP($$, $lhs, $rhs, BIN_OP_LEQ);
 	}
 	| simpexpr[lhs] GEQ simpexpr[rhs] {
-		$$ = astExprFromBinOpExpr($lhs, $rhs, BIN_OP_GEQ);
+		BIN_OP($$, $lhs, $rhs, BIN_OP_GEQ);
 	}
 	| simpexpr[lhs] LT simpexpr[rhs] {
-		$$ = astExprFromBinOpExpr($lhs, $rhs, BIN_OP_LT);
+		BIN_OP($$, $lhs, $rhs, BIN_OP_LT);
 	}
 	| simpexpr[lhs] GT simpexpr[rhs] {
-		$$ = astExprFromBinOpExpr($lhs, $rhs, BIN_OP_GT);
+		BIN_OP($$, $lhs, $rhs, BIN_OP_GT);
 	}
 	;
 
 simpexpr:
 	term
 	| simpexpr[lhs] ADD term[rhs] {
-		$$ = astExprFromBinOpExpr($lhs, $rhs, BIN_OP_ADD);
+		BIN_OP($$, $lhs, $rhs, BIN_OP_ADD);
 	}
 	| simpexpr[lhs] SUB term[rhs] {
-		$$ = astExprFromBinOpExpr($lhs, $rhs, BIN_OP_SUB);
+		BIN_OP($$, $lhs, $rhs, BIN_OP_SUB);
 	}
 	| simpexpr[lhs] LOG_OR term[rhs] {
-		$$ = astExprFromBinOpExpr($lhs, $rhs, BIN_OP_LOG_OR);
+		BIN_OP($$, $lhs, $rhs, BIN_OP_LOG_OR);
 	}
 	;
 
 term:
 	factor
 	| term[lhs] MUL factor[rhs] {
-		$$ = astExprFromBinOpExpr($lhs, $rhs, BIN_OP_MUL);
+		BIN_OP($$, $lhs, $rhs, BIN_OP_MUL);
 	}
 	| term[lhs] DIV factor[rhs] {
-		$$ = astExprFromBinOpExpr($lhs, $rhs, BIN_OP_DIV);
+		BIN_OP($$, $lhs, $rhs, BIN_OP_DIV);
 	}
 	| term[lhs] LOG_AND factor[rhs] {
-		$$ = astExprFromBinOpExpr($lhs, $rhs, BIN_OP_LOG_AND);
+		BIN_OP($$, $lhs, $rhs, BIN_OP_LOG_AND);
 	}
 	;
 
 factor:
 	SUB factor[val] {
+		DENY(!isArithmetic($val.data_type),
+			"invalid operand of type '%s' for unary minus", TYPE_NAMES[$val.data_type]);
 		$$ = astExprFromUnaryMinus($val);
+		$$.data_type = $val.data_type;
 	}
 	| INT_LITERAL[lit] {
 		$$ = astExprFromLiteral(astLiteralFromInt($lit));
+		$$.data_type = TYPE_INT;
 	}
 	| FLOAT_LITERAL[lit] {
 		$$ = astExprFromLiteral(astLiteralFromFloat($lit));
+		$$.data_type = TYPE_FLOAT;
 	}
 	| BOOL_LITERAL[lit] {
 		$$ = astExprFromLiteral(astLiteralFromBool($lit));
+		$$.data_type = TYPE_BOOL;
 	}
 	| STRING_LITERAL[lit] {
 		$$ = astExprFromLiteral(astLiteralFromString($lit));
+		$$.data_type = TYPE_STRING;
 	}
 	| IDENT[id] {
 		$$ = astExprFromIdent($id);
+		$$.var.res = symtabResolve(&out->tab, $$.var.ident);
+
+		const DefInfo *def = symtabIndex(&out->tab, $$.var.res);
+		DENY(def == NULL, "undeclared identifier '%s'", internName($$.var.ident));
+		DENY(def->tag == SYM_DEF_FUNC, "function '%s' used as a value", internName(def->ident));
+		$$.data_type = def->var.data_type;
 	}
 	| functioncall {
 		$$ = astExprFromFuncCall($functioncall);
+		$$.data_type = symtabIndex(&out->tab, $functioncall.res_ident.res)->func.return_type;
 	}
 	| '(' assignment ')' {
 		$$ = $assignment;
@@ -508,7 +665,7 @@ factor:
 
 %%
 
-void yyerror(ParseResult *out, const char* msg, ...) {
+void yyerror(ParseResult *out, Lexer *lexer, const char* msg, ...) {
 	va_list args;
 	int len = 0;
 	
@@ -522,7 +679,7 @@ void yyerror(ParseResult *out, const char* msg, ...) {
 	
 	/* print the message into the buffer */
 	va_start(args, msg);
-	len = snprintf(out->err, sizeof(out->err), "Error in line %d: ", yylineno);
+	len = snprintf(out->err, sizeof(out->err), "Error in line %d: ", lexerLine(lexer));
 	vsnprintf(out->err + len, sizeof(out->err) - len, msg, args);
 	va_end(args);
 }
@@ -533,7 +690,31 @@ ParseResult astParse(FILE *input) {
 		.ok = astProgramNew(),
 		.tab = symtabNew()
 	};
-	yyin = input;
-	yyparse(&out);
+	
+	Lexer lexer = lexerFromStream(input);
+	yyparse(&out, &lexer);
+	lexerRelease(&lexer);
+	return out;
+}
+
+ParseResult astParseMapped(const char *path) {
+	Source source = sourceNew(path);
+	
+	if (source.data == NULL) {
+		ParseResult out = { .tag = PARSE_ERR_INPUT };
+		snprintf(out.err, sizeof(out.err), "Failed to read c1 source file '%s'", path);
+		return out;
+	}
+	
+	ParseResult out = {
+		.tag = PARSE_OK,
+		.ok = astProgramNew(),
+		.tab = symtabNew()
+	};
+	
+	Lexer lexer = lexerFromBuffer(scanMode, source.data, source.len);
+	yyparse(&out, &lexer);
+	lexerRelease(&lexer);
+	sourceRelease(&source);
 	return out;
 }
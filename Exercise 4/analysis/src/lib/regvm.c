@@ -0,0 +1,753 @@
+/***************************************************************************//**
+ * @file regvm.c
+ * @brief Übersetzer und Implementation der Registermaschine.
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <assert.h>
+#include "regvm.h"
+#include "vec.h"
+
+/* *** internal structures ************************************************** */
+
+/**
+ * @internal
+ * @brief Zustand des Übersetzers.
+ *
+ * Register für Zwischenergebnisse werden stapelartig ab `locals` vergeben und
+ * nach jeder Anweisung vollständig freigegeben.
+ */
+typedef struct {
+	RegCode rc;             /**<@brief Der erzeugte Code. */
+	const Program *ast;     /**<@brief Der übersetzte Syntaxbaum. */
+	const DefInfo *defs;    /**<@brief Die Definitionstabelle. */
+	DataType ret_type;      /**<@brief Rückgabetyp der aktuellen Funktion. */
+	int locals;             /**<@brief Anzahl lokaler Variablen. */
+	int next;               /**<@brief Nächstes freies Register. */
+	int max;                /**<@brief Anzahl insgesamt benötigter Register. */
+} RegCompiler;
+
+/**
+ * @internal
+ * @brief Eintrag des Aufrufstacks.
+ */
+typedef struct {
+	unsigned int pc;   /**<@brief Index der Rücksprungadresse. */
+	unsigned int base; /**<@brief Erstes Register des Rufers. */
+	int dst;           /**<@brief Zielregister des Rückgabewertes. */
+} RegFrame;
+
+/* *** internal constants *************************************************** */
+
+/** @internal @brief Opcodes binärer Operationen auf `int` und `bool`. */
+static const RegOpcode INT_OPS[] = {
+	[BIN_OP_ADD] = ROP_ADD_I,
+	[BIN_OP_SUB] = ROP_SUB_I,
+	[BIN_OP_MUL] = ROP_MUL_I,
+	[BIN_OP_DIV] = ROP_DIV_I,
+	[BIN_OP_EQ]  = ROP_EQ_I,
+	[BIN_OP_NEQ] = ROP_NEQ_I,
+	[BIN_OP_LT]  = ROP_LT_I,
+	[BIN_OP_GT]  = ROP_GT_I,
+	[BIN_OP_LEQ] = ROP_LEQ_I,
+	[BIN_OP_GEQ] = ROP_GEQ_I,
+};
+
+/** @internal @brief Opcodes binärer Operationen auf `float`. */
+static const RegOpcode FLOAT_OPS[] = {
+	[BIN_OP_ADD] = ROP_ADD_F,
+	[BIN_OP_SUB] = ROP_SUB_F,
+	[BIN_OP_MUL] = ROP_MUL_F,
+	[BIN_OP_DIV] = ROP_DIV_F,
+	[BIN_OP_EQ]  = ROP_EQ_F,
+	[BIN_OP_NEQ] = ROP_NEQ_F,
+	[BIN_OP_LT]  = ROP_LT_F,
+	[BIN_OP_GT]  = ROP_GT_F,
+	[BIN_OP_LEQ] = ROP_LEQ_F,
+	[BIN_OP_GEQ] = ROP_GEQ_F,
+};
+
+/** @internal @brief Opcodes der `print`-Anweisung je Datentyp. */
+static const RegOpcode PRINT_OPS[] = {
+	[TYPE_BOOL]   = ROP_PRINT_B,
+	[TYPE_INT]    = ROP_PRINT_I,
+	[TYPE_FLOAT]  = ROP_PRINT_F,
+	[TYPE_STRING] = ROP_PRINT_S,
+};
+
+/* *** internal helpers ***************************************************** */
+
+/* forward declarations */
+static int compileExpr(RegCompiler*, const Expr*, int);
+static void compileStmt(RegCompiler*, const Stmt*);
+
+/**
+ * @internal
+ * @brief Hängt eine Instruktion an und gibt deren Index zurück.
+ */
+static unsigned int emit(RegCompiler *self, RegOpcode op, int a, int b, int c) {
+	vecPush(self->rc.code) = (RegInstr) { op, a, b, c };
+	return vecLen(self->rc.code) - 1;
+}
+
+/**
+ * @internal
+ * @brief Gibt den Index der nächsten Instruktion zurück.
+ */
+static inline unsigned int here(const RegCompiler *self) {
+	return vecLen(self->rc.code);
+}
+
+/**
+ * @internal
+ * @brief Reserviert ein Register für ein Zwischenergebnis.
+ */
+static int tempAlloc(RegCompiler *self) {
+	int reg = self->next++;
+	
+	if (self->next > self->max) {
+		self->max = self->next;
+	}
+	
+	return reg;
+}
+
+/**
+ * @internal
+ * @brief Gibt das Zielregister \p dst zurück oder reserviert ein neues, falls
+ * kein Ziel vorgegeben ist.
+ */
+static inline int target(RegCompiler *self, int dst) {
+	return dst >= 0 ? dst : tempAlloc(self);
+}
+
+/**
+ * @internal
+ * @brief Gibt zurück, ob \p reg ein Register für Zwischenergebnisse ist.
+ */
+static inline int isTemp(const RegCompiler *self, int reg) {
+	return reg >= self->locals;
+}
+
+/**
+ * @internal
+ * @brief Gibt zurück, ob ein Ausdruck eine Zuweisung enthält.
+ *
+ * Wird ein Operand direkt aus dem Register einer lokalen Variablen gelesen,
+ * muss dieser zuvor kopiert werden, falls ein später berechneter Operand die
+ * Variable überschreiben könnte. Gerufene Funktionen können lokale Variablen
+ * des Rufers nicht verändern.
+ */
+static int hasAssign(const Expr *expr) {
+	switch (expr->tag) {
+	case EXPR_ASSIGN:
+		return 1;
+		
+	case EXPR_BIN_OP:
+		return hasAssign(expr->bin_op.lhs) || hasAssign(expr->bin_op.rhs);
+		
+	case EXPR_UNARY_MINUS:
+		return hasAssign(expr->unary_minus);
+		
+	case EXPR_CALL:
+		vecForEach(const Expr *arg, expr->call.args) {
+			if (hasAssign(arg)) { return 1; }
+		}
+		return 0;
+		
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @internal
+ * @brief Übersetzt einen Ausdruck, so dass sein Wert im Register \p dst liegt.
+ */
+static void compileInto(RegCompiler *self, const Expr *expr, int dst) {
+	int reg = compileExpr(self, expr, dst);
+	
+	if (reg != dst) {
+		emit(self, ROP_MOV, dst, reg, 0);
+	}
+}
+
+/**
+ * @internal
+ * @brief Übersetzt einen Ausdruck mit impliziter Typumwandlung nach \p type.
+ *
+ * Ist \p dst nicht negativ, liegt der Wert anschließend in diesem Register.
+ */
+static int compileConverted(RegCompiler *self, const Expr *expr, DataType type, int dst) {
+	if (expr->data_type == TYPE_INT && type == TYPE_FLOAT) {
+		int reg = compileExpr(self, expr, -1);
+		int result = dst >= 0 ? dst : isTemp(self, reg) ? reg : tempAlloc(self);
+		
+		emit(self, ROP_I2F, result, reg, 0);
+		return result;
+	}
+	
+	if (dst >= 0) {
+		compileInto(self, expr, dst);
+		return dst;
+	}
+	
+	return compileExpr(self, expr, -1);
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine Zuweisung an eine Variable und gibt das Register mit
+ * dem zugewiesenen Wert zurück.
+ */
+static int compileStore(RegCompiler *self, DefId id, DataType type, const Expr *value) {
+	const DefInfo *def = &self->defs[id.index];
+	
+	if (def->tag == SYM_DEF_LOCAL_VAR) {
+		return compileConverted(self, value, type, def->var.offset);
+	}
+	
+	assert(def->tag == SYM_DEF_GLOBAL_VAR);
+	int reg = compileConverted(self, value, type, -1);
+	emit(self, ROP_SETG, def->var.offset, reg, 0);
+	return reg;
+}
+
+/**
+ * @internal
+ * @brief Übersetzt einen Funktionsaufruf.
+ *
+ * Das Zielregister wird vor den Argumenten reserviert, damit es nicht im
+ * Frame der gerufenen Funktion liegt.
+ */
+static int compileCall(RegCompiler *self, const FuncCall *call, int dst) {
+	const FuncInfo *func = &self->defs[call->res_ident.res.index].func;
+	const FuncDef *def = &self->ast->items[func->item_id.index].func_def;
+	int result = func->return_type == TYPE_VOID ? 0 : target(self, dst);
+	int first = self->next;
+	
+	for (unsigned int i = 0; i < func->param_count; ++i) {
+		tempAlloc(self);
+	}
+	
+	for (unsigned int i = 0; i < func->param_count; ++i) {
+		compileConverted(self, &call->args[i], def->params[i].data_type, first + i);
+		self->next = first + func->param_count;
+	}
+	
+	emit(self, ROP_CALL, result, func->item_id.index, first);
+	self->next = first;
+	return result;
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine binäre Operation.
+ */
+static int compileBinOp(RegCompiler *self, const BinOpExpr *bin, int dst) {
+	switch (bin->op) {
+	case BIN_OP_LOG_OR:
+	case BIN_OP_LOG_AND: {
+		/* das Ziel wird vor dem rechten Operanden beschrieben und darf daher
+		 * keine Variable sein, die dieser noch lesen könnte */
+		int result = dst >= 0 && isTemp(self, dst) ? dst : tempAlloc(self);
+		
+		compileInto(self, bin->lhs, result);
+		unsigned int jump = emit(self, bin->op == BIN_OP_LOG_OR ? ROP_JT : ROP_JF, result, 0, 0);
+		compileInto(self, bin->rhs, result);
+		self->rc.code[jump].b = here(self);
+		return result;
+	}
+	
+	default:
+		break;
+	}
+	
+	DataType type = bin->lhs->data_type == TYPE_FLOAT || bin->rhs->data_type == TYPE_FLOAT
+		? TYPE_FLOAT : TYPE_INT;
+	int mark = self->next;
+	int lhs = compileConverted(self, bin->lhs, type, -1);
+	
+	if (!isTemp(self, lhs) && hasAssign(bin->rhs)) {
+		int copy = tempAlloc(self);
+		emit(self, ROP_MOV, copy, lhs, 0);
+		lhs = copy;
+	}
+	
+	int rhs = compileConverted(self, bin->rhs, type, -1);
+	
+	/* die Operanden werden vor dem Ziel gelesen, so dass ihre Register
+	 * wiederverwendet werden können */
+	self->next = mark;
+	int result = target(self, dst);
+	
+	emit(self, (type == TYPE_FLOAT ? FLOAT_OPS : INT_OPS)[bin->op], result, lhs, rhs);
+	return result;
+}
+
+/**
+ * @internal
+ * @brief Übersetzt einen Ausdruck und gibt das Register mit seinem Wert
+ * zurück.
+ *
+ * Ist \p dst nicht negativ, wird es als Ziel bevorzugt; der Wert kann aber
+ * auch in einem anderen Register liegen, etwa bei lokalen Variablen.
+ */
+static int compileExpr(RegCompiler *self, const Expr *expr, int dst) {
+	switch (expr->tag) {
+	case EXPR_ASSIGN: {
+		const Assign *assign = &expr->assign;
+		DataType type = self->defs[assign->lhs.res.index].var.data_type;
+		return compileStore(self, assign->lhs.res, type, assign->rhs);
+	}
+	
+	case EXPR_BIN_OP:
+		return compileBinOp(self, &expr->bin_op, dst);
+		
+	case EXPR_UNARY_MINUS: {
+		int mark = self->next;
+		int reg = compileExpr(self, expr->unary_minus, -1);
+		
+		self->next = mark;
+		int result = target(self, dst);
+		emit(self, expr->data_type == TYPE_FLOAT ? ROP_NEG_F : ROP_NEG_I, result, reg, 0);
+		return result;
+	}
+	
+	case EXPR_CALL:
+		return compileCall(self, &expr->call, dst);
+		
+	case EXPR_LITERAL: {
+		int result = target(self, dst);
+		
+		switch (expr->literal.tag) {
+		case LITERAL_INT:
+			emit(self, ROP_LOADI, result, expr->literal.iVal, 0);
+			break;
+			
+		case LITERAL_BOOL:
+			emit(self, ROP_LOADI, result, expr->literal.bVal != 0, 0);
+			break;
+			
+		case LITERAL_FLOAT:
+			vecPush(self->rc.consts) = (Value) { .f = expr->literal.fVal };
+			emit(self, ROP_LOADK, result, vecLen(self->rc.consts) - 1, 0);
+			break;
+			
+		case LITERAL_STRING:
+			vecPush(self->rc.consts) = (Value) { .s = expr->literal.sVal };
+			emit(self, ROP_LOADK, result, vecLen(self->rc.consts) - 1, 0);
+			break;
+		}
+		
+		return result;
+	}
+	
+	case EXPR_VAR: {
+		const DefInfo *def = &self->defs[expr->var.res.index];
+		
+		if (def->tag == SYM_DEF_LOCAL_VAR) {
+			return def->var.offset;
+		}
+		
+		int result = target(self, dst);
+		emit(self, ROP_GETG, result, def->var.offset, 0);
+		return result;
+	}
+	
+	case EXPR_INVALID:
+		break;
+	}
+	
+	assert(0);
+	return 0;
+}
+
+/**
+ * @internal
+ * @brief Übersetzt die Initialisierung einer Variablen.
+ */
+static void compileVarDef(RegCompiler *self, const VarDef *var_def) {
+	if (var_def->init.tag != EXPR_INVALID) {
+		compileStore(self, var_def->res_ident.res, var_def->data_type, &var_def->init);
+	}
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine Bedingung und den Sprung, der von ihr abhängt.
+ */
+static unsigned int compileBranch(RegCompiler *self, const Expr *cond, RegOpcode op, int to) {
+	int reg = compileExpr(self, cond, -1);
+	return emit(self, op, reg, to, 0);
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine Anweisung.
+ *
+ * Nach jeder Anweisung sind alle Register für Zwischenergebnisse wieder frei.
+ * Schleifen werden wie bei der Stackmaschine mit der Bedingung am Ende
+ * übersetzt.
+ */
+static void compileStmt(RegCompiler *self, const Stmt *stmt) {
+	unsigned int jump, loop;
+	
+	switch (stmt->tag) {
+	case STMT_EMPTY:
+		break;
+		
+	case STMT_IF:
+		jump = compileBranch(self, &stmt->if_stmt.cond, ROP_JF, 0);
+		self->next = self->locals;
+		compileStmt(self, stmt->if_stmt.if_true);
+		
+		if (stmt->if_stmt.if_false->tag != STMT_EMPTY) {
+			unsigned int skip = emit(self, ROP_JMP, 0, 0, 0);
+			self->rc.code[jump].b = here(self);
+			compileStmt(self, stmt->if_stmt.if_false);
+			self->rc.code[skip].a = here(self);
+		} else {
+			self->rc.code[jump].b = here(self);
+		}
+		break;
+		
+	case STMT_FOR: {
+		const ForStmt *for_stmt = &stmt->for_stmt;
+		
+		if (for_stmt->init.tag == FOR_INIT_VAR_DEF) {
+			compileVarDef(self, &for_stmt->init.var_def);
+		} else {
+			const Assign *assign = &for_stmt->init.assign;
+			DataType type = self->defs[assign->lhs.res.index].var.data_type;
+			compileStore(self, assign->lhs.res, type, assign->rhs);
+		}
+		
+		self->next = self->locals;
+		jump = emit(self, ROP_JMP, 0, 0, 0);
+		loop = here(self);
+		compileStmt(self, for_stmt->body);
+		
+		DataType type = self->defs[for_stmt->update.lhs.res.index].var.data_type;
+		compileStore(self, for_stmt->update.lhs.res, type, for_stmt->update.rhs);
+		self->next = self->locals;
+		
+		self->rc.code[jump].a = here(self);
+		compileBranch(self, &for_stmt->cond, ROP_JT, loop);
+		break;
+	}
+	
+	case STMT_WHILE:
+		jump = emit(self, ROP_JMP, 0, 0, 0);
+		loop = here(self);
+		compileStmt(self, stmt->while_stmt.body);
+		self->rc.code[jump].a = here(self);
+		compileBranch(self, &stmt->while_stmt.cond, ROP_JT, loop);
+		break;
+		
+	case STMT_DO_WHILE:
+		loop = here(self);
+		compileStmt(self, stmt->do_while_stmt.body);
+		compileBranch(self, &stmt->do_while_stmt.cond, ROP_JT, loop);
+		break;
+		
+	case STMT_RETURN:
+		if (stmt->return_stmt.tag == EXPR_INVALID) {
+			emit(self, ROP_RET, 0, 0, 0);
+		} else {
+			int reg = compileConverted(self, &stmt->return_stmt, self->ret_type, -1);
+			emit(self, ROP_RET_V, reg, 0, 0);
+		}
+		break;
+		
+	case STMT_PRINT:
+		vecForEach(const Expr *expr, stmt->print_stmt.expressions) {
+			int reg = compileExpr(self, expr, -1);
+			emit(self, PRINT_OPS[expr->data_type], reg, 0, 0);
+			self->next = self->locals;
+		}
+		emit(self, ROP_PRINT_NL, 0, 0, 0);
+		break;
+		
+	case STMT_VAR_DEF:
+		compileVarDef(self, &stmt->var_def);
+		break;
+		
+	case STMT_ASSIGN: {
+		DataType type = self->defs[stmt->assign.lhs.res.index].var.data_type;
+		compileStore(self, stmt->assign.lhs.res, type, stmt->assign.rhs);
+		break;
+	}
+	
+	case STMT_CALL:
+		compileCall(self, &stmt->call, -1);
+		break;
+		
+	case STMT_BLOCK:
+		vecForEach(const Stmt *inner, stmt->block.statements) {
+			compileStmt(self, inner);
+		}
+		break;
+	}
+	
+	self->next = self->locals;
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine Funktion.
+ *
+ * Fehlt am Ende einer Funktion mit Rückgabewert die `return`-Anweisung, wird
+ * wie bei der Stackmaschine der Wert `0` zurückgegeben.
+ */
+static void compileFunc(RegCompiler *self, const FuncInfo *func) {
+	const FuncDef *def = &self->ast->items[func->item_id.index].func_def;
+	RegFunc *reg_func = &self->rc.funcs[func->item_id.index];
+	
+	self->ret_type = func->return_type;
+	self->locals = self->next = self->max = vecLen(func->local_vars);
+	reg_func->entry = here(self);
+	
+	vecForEach(const Stmt *stmt, def->statements) {
+		compileStmt(self, stmt);
+	}
+	
+	if (func->return_type == TYPE_VOID) {
+		emit(self, ROP_RET, 0, 0, 0);
+	} else {
+		int reg = tempAlloc(self);
+		emit(self, ROP_LOADI, reg, 0, 0);
+		emit(self, ROP_RET_V, reg, 0, 0);
+	}
+	
+	reg_func->reg_count = self->max;
+}
+
+/**
+ * @internal
+ * @brief Reserviert Speicher, ohne im Fehlerfall zurückzukehren.
+ */
+static void* regRealloc(void *ptr, size_t size) {
+	ptr = realloc(ptr, size);
+	
+	if (ptr == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	return ptr;
+}
+
+/* *** implementation ******************************************************* */
+
+RegCode regCompile(const Program *ast, const SymDefTable *tab) {
+	RegCompiler self = {
+		.rc = { .global_count = tab->global_count },
+		.ast = ast,
+		.defs = tab->definitions
+	};
+	
+	vecForEach(const Item *item, ast->items) {
+		(void) item;
+		vecPush(self.rc.funcs) = (RegFunc) { 0 };
+	}
+	
+	vecForEach(const DefInfo *def, tab->definitions) {
+		if (def->tag == SYM_DEF_FUNC) {
+			compileFunc(&self, &def->func);
+		}
+	}
+	
+	/* initialize the global variables and call main */
+	self.locals = self.next = self.max = 0;
+	self.rc.entry = here(&self);
+	
+	vecForEach(const Item *item, ast->items) {
+		if (item->tag == ITEM_GLOBAL_VAR) {
+			compileVarDef(&self, &item->var_def);
+			self.next = 0;
+		}
+	}
+	
+	emit(&self, ROP_CALL, 0, tab->definitions[tab->main_func.index].func.item_id.index, 0);
+	emit(&self, ROP_HALT, 0, 0, 0);
+	
+	self.rc.reg_count = self.max;
+	return self.rc;
+}
+
+void regRun(const RegCode *rc, Out *out, VmStats *stats) {
+	const RegInstr *code = rc->code;
+	const RegInstr *pc = code + rc->entry;
+	Value *globals = calloc(rc->global_count + 1, sizeof(Value));
+	size_t cap = rc->reg_count + 256;
+	Value *regs = regRealloc(NULL, cap*sizeof(Value));
+	Value *base = regs;
+	RegFrame *frames = NULL;
+	unsigned long long dispatches = 0;
+	
+	if (globals == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	for (;;) {
+		const RegInstr *ins = pc++;
+		++dispatches;
+		
+		switch (ins->op) {
+		case ROP_HALT:
+			goto halt;
+			
+		case ROP_MOV:
+			base[ins->a] = base[ins->b];
+			break;
+			
+		case ROP_LOADI:
+			base[ins->a].i = ins->b;
+			break;
+			
+		case ROP_LOADK:
+			base[ins->a] = rc->consts[ins->b];
+			break;
+			
+		case ROP_GETG:
+			base[ins->a] = globals[ins->b];
+			break;
+			
+		case ROP_SETG:
+			globals[ins->a] = base[ins->b];
+			break;
+			
+		case ROP_I2F:
+			base[ins->a].f = base[ins->b].i;
+			break;
+			
+		case ROP_NEG_I:
+			base[ins->a].i = (int) (0u - (unsigned int) base[ins->b].i);
+			break;
+			
+		case ROP_NEG_F:
+			base[ins->a].f = -base[ins->b].f;
+			break;
+			
+/* Hilfsmakros für binäre Operationen im Drei-Adress-Format */
+#define ARITH_I(OP) \
+			base[ins->a].i = (int) ((unsigned int) base[ins->b].i OP (unsigned int) base[ins->c].i); break
+#define BINARY(DST, SRC, OP) \
+			base[ins->a].DST = base[ins->b].SRC OP base[ins->c].SRC; break
+			
+		case ROP_ADD_I: ARITH_I(+);
+		case ROP_SUB_I: ARITH_I(-);
+		case ROP_MUL_I: ARITH_I(*);
+		case ROP_DIV_I: BINARY(i, i, /);
+		case ROP_ADD_F: BINARY(f, f, +);
+		case ROP_SUB_F: BINARY(f, f, -);
+		case ROP_MUL_F: BINARY(f, f, *);
+		case ROP_DIV_F: BINARY(f, f, /);
+		case ROP_EQ_I:  BINARY(i, i, ==);
+		case ROP_NEQ_I: BINARY(i, i, !=);
+		case ROP_LT_I:  BINARY(i, i, <);
+		case ROP_GT_I:  BINARY(i, i, >);
+		case ROP_LEQ_I: BINARY(i, i, <=);
+		case ROP_GEQ_I: BINARY(i, i, >=);
+		case ROP_EQ_F:  BINARY(i, f, ==);
+		case ROP_NEQ_F: BINARY(i, f, !=);
+		case ROP_LT_F:  BINARY(i, f, <);
+		case ROP_GT_F:  BINARY(i, f, >);
+		case ROP_LEQ_F: BINARY(i, f, <=);
+		case ROP_GEQ_F: BINARY(i, f, >=);
+		
+#undef ARITH_I
+#undef BINARY
+		
+		case ROP_JMP:
+			pc = code + ins->a;
+			break;
+			
+		case ROP_JT:
+			if (base[ins->a].i) { pc = code + ins->b; }
+			break;
+			
+		case ROP_JF:
+			if (!base[ins->a].i) { pc = code + ins->b; }
+			break;
+			
+		case ROP_CALL: {
+			const RegFunc *func = &rc->funcs[ins->b];
+			size_t frame = (size_t) (base - regs) + ins->c;
+			
+			/* grow the register file such that the whole frame fits */
+			if (frame + func->reg_count > cap) {
+				size_t caller = (size_t) (base - regs);
+				
+				while (frame + func->reg_count > cap) {
+					cap *= 2;
+				}
+				
+				regs = regRealloc(regs, cap*sizeof(Value));
+				base = regs + caller;
+			}
+			
+			vecPush(frames) = (RegFrame) { pc - code, base - regs, ins->a };
+			base = regs + frame;
+			pc = code + func->entry;
+			break;
+		}
+		
+		case ROP_RET: {
+			RegFrame frame = vecPop(frames);
+			base = regs + frame.base;
+			pc = code + frame.pc;
+			break;
+		}
+		
+		case ROP_RET_V: {
+			Value value = base[ins->a];
+			RegFrame frame = vecPop(frames);
+			base = regs + frame.base;
+			base[frame.dst] = value;
+			pc = code + frame.pc;
+			break;
+		}
+		
+		case ROP_PRINT_B:
+			interpValuePrint(base[ins->a], TYPE_BOOL, out);
+			break;
+			
+		case ROP_PRINT_I:
+			interpValuePrint(base[ins->a], TYPE_INT, out);
+			break;
+			
+		case ROP_PRINT_F:
+			interpValuePrint(base[ins->a], TYPE_FLOAT, out);
+			break;
+			
+		case ROP_PRINT_S:
+			interpValuePrint(base[ins->a], TYPE_STRING, out);
+			break;
+			
+		case ROP_PRINT_NL:
+			outChar(out, '\n');
+			break;
+			
+		case ROP_COUNT:
+			break;
+		}
+	}
+	
+halt:
+	if (stats != NULL) {
+		stats->dispatches = dispatches;
+	}
+	
+	vecRelease(frames);
+	free(regs);
+	free(globals);
+}
+
+void regRelease(RegCode *self) {
+	vecRelease(self->code);
+	vecRelease(self->consts);
+	vecRelease(self->funcs);
+}
@@ -0,0 +1,155 @@
+/***************************************************************************//**
+ * @file regvm.h
+ * @brief Registermaschine für C1-Programme.
+ *
+ * # Überblick
+ *
+ * Alternativ zur Stackmaschine (siehe `vm.h`) kann ein analysiertes Programm
+ * in Drei-Adress-Code für eine Registermaschine übersetzt werden. Jede
+ * Funktion besitzt einen Frame virtueller Register:
+ *
+ * - Die ersten `vecLen(FuncInfo.local_vars)` Register sind die lokalen
+ *   Variablen der Funktion, adressiert über `VarInfo.offset`. Die Parameter
+ *   liegen somit in den ersten `FuncInfo.param_count` Registern.
+ * - Dahinter folgen die Register für Zwischenergebnisse. Diese werden bei der
+ *   Übersetzung in einem linearen Durchlauf über jede Anweisung vergeben und
+ *   sind nur innerhalb einer Anweisung belegt, so dass jede Anweisung wieder
+ *   beim ersten freien Register beginnt.
+ *
+ * Da lokale Variablen direkt als Operanden verwendet werden, entfallen die
+ * Lade- und Speicherbefehle der Stackmaschine für diese vollständig. Alle
+ * Instruktionen sind wie bei der Stackmaschine nach dem Datentyp ihrer
+ * Operanden spezialisiert, z.B. `ADD_I r1, r2, r3` oder `ADD_F r1, r2, r3`.
+ *
+ * Für einen Funktionsaufruf werden die Argumente in aufeinanderfolgende
+ * Register geschrieben; das erste davon wird zum ersten Register des Frames
+ * der gerufenen Funktion.
+ ******************************************************************************/
+
+#ifndef REGVM_H_INCLUDED
+#define REGVM_H_INCLUDED
+
+/* *** Includes ************************************************************* */
+
+#include <stdio.h>
+#include "ast.h"
+#include "symtab.h"
+#include "interp.h"
+#include "vm.h"
+
+/* *** Strukturen *********************************************************** */
+
+/**
+ * @brief Die Opcodes der Registermaschine.
+ *
+ * Die Operanden `a`, `b` und `c` bezeichnen, sofern nicht anders angegeben,
+ * Register des aktuellen Frames; `a` ist dabei das Zielregister.
+ */
+typedef enum RegOpcode {
+	ROP_HALT,     /**<@brief Beendet die Ausführung. */
+	ROP_MOV,      /**<@brief `a = b` */
+	ROP_LOADI,    /**<@brief `a = ` Ganzzahl `b` */
+	ROP_LOADK,    /**<@brief `a = consts[b]` */
+	ROP_GETG,     /**<@brief `a = ` globale Variable `b` */
+	ROP_SETG,     /**<@brief globale Variable `a = b` */
+	ROP_I2F,      /**<@brief `a = (float) b` */
+	ROP_NEG_I,
+	ROP_NEG_F,
+	ROP_ADD_I,
+	ROP_SUB_I,
+	ROP_MUL_I,
+	ROP_DIV_I,
+	ROP_ADD_F,
+	ROP_SUB_F,
+	ROP_MUL_F,
+	ROP_DIV_F,
+	ROP_EQ_I,
+	ROP_NEQ_I,
+	ROP_LT_I,
+	ROP_GT_I,
+	ROP_LEQ_I,
+	ROP_GEQ_I,
+	ROP_EQ_F,
+	ROP_NEQ_F,
+	ROP_LT_F,
+	ROP_GT_F,
+	ROP_LEQ_F,
+	ROP_GEQ_F,
+	ROP_JMP,      /**<@brief Springt nach `a`. */
+	ROP_JT,       /**<@brief Springt nach `b`, falls `a` wahr ist. */
+	ROP_JF,       /**<@brief Springt nach `b`, falls `a` falsch ist. */
+	ROP_CALL,     /**<@brief `a = funcs[b](c, c+1, ...)` */
+	ROP_RET,      /**<@brief Kehrt ohne Wert zum Rufer zurück. */
+	ROP_RET_V,    /**<@brief Kehrt mit dem Wert in `a` zurück. */
+	ROP_PRINT_B,
+	ROP_PRINT_I,
+	ROP_PRINT_F,
+	ROP_PRINT_S,
+	ROP_PRINT_NL, /**<@brief Beendet die Ausgabe einer `print`-Anweisung. */
+	ROP_COUNT     /**<@brief Anzahl der Opcodes. */
+} RegOpcode;
+
+/**
+ * @brief Eine Drei-Adress-Instruktion.
+ */
+typedef struct RegInstr {
+	RegOpcode op; /**<@brief Die auszuführende Operation. */
+	int a;        /**<@brief Erster Operand, in der Regel das Ziel. */
+	int b;        /**<@brief Zweiter Operand. */
+	int c;        /**<@brief Dritter Operand. */
+} RegInstr;
+
+/**
+ * @brief Übersetzungsinformationen einer Funktion.
+ */
+typedef struct RegFunc {
+	unsigned int entry;     /**<@brief Index der ersten Instruktion. */
+	unsigned int reg_count; /**<@brief Anzahl der Register im Frame. */
+} RegFunc;
+
+/**
+ * @brief Ein für die Registermaschine übersetztes Programm.
+ *
+ * Die Ausführung beginnt bei `entry`. Der dort abgelegte Code initialisiert
+ * die globalen Variablen, ruft `main()` auf und hält anschließend an.
+ */
+typedef struct RegCode {
+	RegInstr *code;            /**<@brief Vektor aller Instruktionen. */
+	Value *consts;             /**<@brief Vektor der Konstanten. */
+	RegFunc *funcs;            /**<@brief Funktionen, indiziert durch `ItemId`. */
+	unsigned int global_count; /**<@brief Anzahl globaler Variablen. */
+	unsigned int entry;        /**<@brief Index der ersten Instruktion. */
+	unsigned int reg_count;    /**<@brief Registeranzahl des Einstiegscodes. */
+} RegCode;
+
+/* *** Öffentliche Schnittstelle ******************************************** */
+
+/**
+ * @brief Übersetzt ein semantisch analysiertes Programm für die
+ * Registermaschine.
+ *
+ * Zeichenkettenkonstanten verweisen weiterhin in den Syntaxbaum, der somit
+ * mindestens so lange leben muss wie der erzeugte Code.
+ *
+ * @param ast Die Wurzel des abstrakten Syntaxbaumes.
+ * @param tab Die Definitionstabelle des Programms.
+ * @return Der übersetzte Code.
+ */
+extern RegCode regCompile(const Program *ast, const SymDefTable *tab);
+
+/**
+ * @brief Führt ein für die Registermaschine übersetztes Programm aus.
+ *
+ * @param rc    Der auszuführende Code.
+ * @param out   Der Ausgabepuffer für die `print`-Anweisung.
+ * @param stats Nimmt die Laufzeitstatistik auf, falls nicht `NULL`.
+ */
+extern void regRun(const RegCode *rc, Out *out, VmStats *stats);
+
+/**
+ * @brief Gibt den Speicher des übersetzten Codes frei.
+ * @param self Der freizugebende Code.
+ */
+extern void regRelease(RegCode *self);
+
+#endif
@@ -0,0 +1,305 @@
+/***************************************************************************//**
+ * @file scan.c
+ * @brief Implementation des handgeschriebenen Scanners.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "scan.h"
+#include "intern.h"
+#include "skip.h"
+#include "parser.tab.h"
+
+/* *** internal structures ************************************************** */
+
+/**
+ * @internal
+ * @brief Die Zeichenklassen; alle Bytes ab `0x80` gehören zu `C_BAD`.
+ */
+enum {
+	C_BAD, /**<@brief Kein Token beginnt mit diesem Zeichen. */
+	C_END, /**<@brief Nullbyte, am Pufferende das Ende der Eingabe. */
+	C_SP,  /**<@brief Leerraum außer dem Zeilenumbruch. */
+	C_NL,  /**<@brief Zeilenumbruch. */
+	C_ID,  /**<@brief Buchstabe oder Unterstrich. */
+	C_NUM, /**<@brief Ziffer. */
+	C_DOT, /**<@brief Punkt, Beginn einer Fließkommazahl. */
+	C_STR, /**<@brief Anführungszeichen. */
+	C_DIV, /**<@brief Schrägstrich, Division oder Kommentar. */
+	C_ONE, /**<@brief Token aus genau einem Zeichen. */
+	C_TWO  /**<@brief Erstes Zeichen eines Tokens aus ein oder zwei Zeichen. */
+};
+
+/** @internal @brief Die Zeichenklassen der ASCII-Zeichen. */
+static const unsigned char CLASS[256] = {
+	C_END,  C_BAD,  C_BAD,  C_BAD,  C_BAD,  C_BAD,  C_BAD,  C_BAD, /* 0x00 */
+	C_BAD,  C_SP,   C_NL,   C_SP,   C_SP,   C_SP,   C_BAD,  C_BAD, /* 0x08 */
+	C_BAD,  C_BAD,  C_BAD,  C_BAD,  C_BAD,  C_BAD,  C_BAD,  C_BAD, /* 0x10 */
+	C_BAD,  C_BAD,  C_BAD,  C_BAD,  C_BAD,  C_BAD,  C_BAD,  C_BAD, /* 0x18 */
+	C_SP,   C_TWO,  C_STR,  C_BAD,  C_BAD,  C_BAD,  C_TWO,  C_BAD, /* 0x20 */
+	C_ONE,  C_ONE,  C_ONE,  C_ONE,  C_ONE,  C_ONE,  C_DOT,  C_DIV, /* 0x28 */
+	C_NUM,  C_NUM,  C_NUM,  C_NUM,  C_NUM,  C_NUM,  C_NUM,  C_NUM, /* 0x30 */
+	C_NUM,  C_NUM,  C_BAD,  C_ONE,  C_TWO,  C_TWO,  C_TWO,  C_BAD, /* 0x38 */
+	C_BAD,  C_ID,   C_ID,   C_ID,   C_ID,   C_ID,   C_ID,   C_ID,  /* 0x40 */
+	C_ID,   C_ID,   C_ID,   C_ID,   C_ID,   C_ID,   C_ID,   C_ID,  /* 0x48 */
+	C_ID,   C_ID,   C_ID,   C_ID,   C_ID,   C_ID,   C_ID,   C_ID,  /* 0x50 */
+	C_ID,   C_ID,   C_ID,   C_BAD,  C_BAD,  C_BAD,  C_BAD,  C_ID,  /* 0x58 */
+	C_BAD,  C_ID,   C_ID,   C_ID,   C_ID,   C_ID,   C_ID,   C_ID,  /* 0x60 */
+	C_ID,   C_ID,   C_ID,   C_ID,   C_ID,   C_ID,   C_ID,   C_ID,  /* 0x68 */
+	C_ID,   C_ID,   C_ID,   C_ID,   C_ID,   C_ID,   C_ID,   C_ID,  /* 0x70 */
+	C_ID,   C_ID,   C_ID,   C_ONE,  C_TWO,  C_ONE,  C_BAD,  C_BAD  /* 0x78 */
+};
+
+/** @internal @brief Die Token der Zeichen der Klasse `C_ONE`. */
+static const int SINGLE[128] = {
+	['+'] = ADD, ['-'] = SUB, ['*'] = MUL,
+	[';'] = ';', [','] = ',', ['('] = '(', [')'] = ')', ['{'] = '{', ['}'] = '}'
+};
+
+/**
+ * @internal
+ * @brief Ein Schlüsselwort oder Wahrheitswert in der perfekten Hashtabelle.
+ */
+typedef struct Keyword {
+	const char *word; /**<@brief Das Wort oder `NULL` für einen freien Platz. */
+	size_t len;       /**<@brief Die Länge des Wortes. */
+	int token;        /**<@brief Das zurückgegebene Token. */
+	int value;        /**<@brief Der Wert von `BOOL_LITERAL`. */
+} Keyword;
+
+/** @internal @brief Anzahl der Plätze der Schlüsselworttabelle. */
+#define KEYWORD_SLOTS 16
+
+/**
+ * @internal
+ * @brief Perfekte Hashfunktion über die Schlüsselwörter, die für diese
+ * dreizehn Wörter paarweise verschiedene Plätze liefert.
+ */
+#define KEYWORD_HASH(STR, LEN) \
+	(((LEN) + (unsigned char) (STR)[0] + 6 * (unsigned char) (STR)[(LEN) - 1]) & (KEYWORD_SLOTS - 1))
+	
+/** @internal @brief Die Schlüsselwörter an den Plätzen ihres Hashwertes. */
+static const Keyword KEYWORDS[KEYWORD_SLOTS] = {
+	[0]  = { "do",     2, KW_DO,        0 },
+	[2]  = { "void",   4, KW_VOID,      0 },
+	[3]  = { "float",  5, KW_FLOAT,     0 },
+	[4]  = { "int",    3, KW_INT,       0 },
+	[5]  = { "for",    3, KW_FOR,       0 },
+	[6]  = { "true",   4, BOOL_LITERAL, 1 },
+	[7]  = { "else",   4, KW_ELSE,      0 },
+	[9]  = { "false",  5, BOOL_LITERAL, 0 },
+	[10] = { "while",  5, KW_WHILE,     0 },
+	[12] = { "return", 6, KW_RETURN,    0 },
+	[13] = { "print",  5, KW_PRINT,     0 },
+	[14] = { "bool",   4, KW_BOOLEAN,   0 },
+	[15] = { "if",     2, KW_IF,        0 }
+};
+
+ScanMode scanMode = SCAN_FLEX;
+
+/* *** internal helpers ***************************************************** */
+
+/**
+ * @internal
+ * @brief Gibt die Zeichenklasse eines Zeichens zurück.
+ */
+static inline int classOf(char c) {
+	return CLASS[(unsigned char) c];
+}
+
+/**
+ * @internal
+ * @brief Gibt `1` zurück, falls \p c eine Ziffer ist.
+ */
+static inline int isDigit(char c) {
+	return classOf(c) == C_NUM;
+}
+
+/**
+ * @internal
+ * @brief Überspringt einen Blockkommentar hinter `/` `*` und gibt das Zeichen
+ * hinter seinem Ende oder `NULL` zurück, falls er nicht geschlossen wird.
+ *
+ * Wie in `lexer.l` verbraucht ein `*` das folgende Zeichen, falls es kein
+ * `/` ist, so dass etwa `**` `/` den Kommentar nicht beendet.
+ */
+static const char* skipComment(Scanner *self, const char *p) {
+	const char *limit = self->limit;
+	
+	for (;;) {
+		p = skipToStar(p, limit, &self->line);
+		if (limit - p < 2) { return NULL; }
+		if (p[1] == '/') { return p + 2; }
+		if (p[1] == '\n') { ++self->line; }
+		p += 2;
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt das Ende einer Ziffernfolge ab \p p zurück.
+ */
+static const char* skipDigits(const char *p) {
+	while (isDigit(*p)) { ++p; }
+	return p;
+}
+
+/**
+ * @internal
+ * @brief Liest eine ganze Zahl oder Fließkommazahl ab \p p, wobei \p p auf
+ * eine Ziffer oder einen Punkt vor einer Ziffer zeigt.
+ */
+static int lexNumber(Scanner *self, YYSTYPE *lval, const char *p) {
+	const char *end = skipDigits(p);
+	int isFloat = 0;
+	
+	if (*end == '.' && isDigit(end[1])) {
+		end = skipDigits(end + 1);
+		isFloat = 1;
+	}
+	
+	if (*end == 'e' || *end == 'E') {
+		const char *exp = end + 1;
+		if (*exp == '+' || *exp == '-') { ++exp; }
+		
+		if (isDigit(*exp)) {
+			end = skipDigits(exp);
+			isFloat = 1;
+		}
+	}
+	
+	self->cursor = end;
+	
+	/* the lexeme ends at a character strtod and strtol do not accept either */
+	if (isFloat) {
+		lval->floatValue = strtod(p, NULL);
+		return FLOAT_LITERAL;
+	}
+	
+	lval->intValue = strtol(p, NULL, 10);
+	return INT_LITERAL;
+}
+
+/**
+ * @internal
+ * @brief Liest einen Bezeichner, ein Schlüsselwort oder einen Wahrheitswert
+ * ab \p p.
+ */
+static int lexWord(Scanner *self, YYSTYPE *lval, const char *p) {
+	const char *end = p + 1;
+	
+	while (classOf(*end) == C_ID || classOf(*end) == C_NUM) { ++end; }
+	
+	size_t len = end - p;
+	const Keyword *kw = &KEYWORDS[KEYWORD_HASH(p, len)];
+	self->cursor = end;
+	
+	if (kw->len == len && memcmp(kw->word, p, len) == 0) {
+		lval->intValue = kw->value;
+		return kw->token;
+	}
+	
+	lval->ident = internString(p, len);
+	return IDENT;
+}
+
+/* *** implementation ******************************************************* */
+
+Scanner scanNew(const char *data, size_t len) {
+	return (Scanner) { .cursor = data, .limit = data + len, .line = 1 };
+}
+
+int scanLex(Scanner *self, YYSTYPE *lval) {
+	const char *p = self->cursor;
+	const char *limit = self->limit;
+	
+	for (;;) {
+		switch (classOf(*p)) {
+		case C_NL:
+			++self->line;
+			/* fall through */
+		case C_SP:
+			/* most runs are a single blank, longer ones are skipped vectorised */
+			if (classOf(*++p) == C_SP || classOf(*p) == C_NL) {
+				p = skipSpace(p, limit, &self->line);
+			}
+			
+			continue;
+			
+		case C_END:
+			if (p < limit) { break; }
+			
+			/* flex keeps reporting the unclosed comment at the end of input */
+			self->cursor = p;
+			return self->unclosed ? YYUNDEF : EOF;
+			
+		case C_ID:
+			return lexWord(self, lval, p);
+			
+		case C_DOT:
+			if (!isDigit(p[1])) { break; }
+			/* fall through */
+		case C_NUM:
+			return lexNumber(self, lval, p);
+			
+		case C_STR: {
+			const char *end = skipString(p + 1, limit);
+			if (end == limit || *end != '"') { break; }
+			
+			self->cursor = end + 1;
+			lval->string = internName(internString(p + 1, end - p - 1));
+			return STRING_LITERAL;
+		}
+		
+		case C_DIV:
+			if (p[1] == '/') {
+				/* a line comment needs its newline, otherwise it is division */
+				const char *nl = memchr(p + 2, '\n', limit - (p + 2));
+				
+				if (nl != NULL) {
+					++self->line;
+					p = nl + 1;
+					continue;
+				}
+			} else if (p[1] == '*') {
+				p = skipComment(self, p + 2);
+				
+				if (p == NULL) {
+					self->cursor = limit;
+					self->unclosed = 1;
+					return YYUNDEF;
+				}
+				
+				continue;
+			}
+			
+			self->cursor = p + 1;
+			return DIV;
+			
+		case C_ONE:
+			self->cursor = p + 1;
+			return SINGLE[(unsigned char) *p];
+			
+		case C_TWO: {
+			int token = YYUNDEF, paired = YYUNDEF;
+			
+			switch (*p) {
+			case '&': paired = p[1] == '&' ? LOG_AND : YYUNDEF; break;
+			case '|': paired = p[1] == '|' ? LOG_OR : YYUNDEF; break;
+			case '=': token = ASSIGN; paired = p[1] == '=' ? EQ : YYUNDEF; break;
+			case '!': paired = p[1] == '=' ? NEQ : YYUNDEF; break;
+			case '<': token = LT; paired = p[1] == '=' ? LEQ : YYUNDEF; break;
+			case '>': token = GT; paired = p[1] == '=' ? GEQ : YYUNDEF; break;
+			}
+			
+			self->cursor = p + (paired != YYUNDEF ? 2 : 1);
+			return paired != YYUNDEF ? paired : token;
+		}
+		}
+		
+		/* no rule matches, flex returns the single character as invalid */
+		self->cursor = p + 1;
+		return YYUNDEF;
+	}
+}
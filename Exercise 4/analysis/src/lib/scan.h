@@ -0,0 +1,86 @@
+/***************************************************************************//**
+ * @file scan.h
+ * @brief Handgeschriebener Scanner als Alternative zu dem von flex erzeugten.
+ *
+ * # Überblick
+ *
+ * Der Scanner liefert über `scanLex()` dieselben Token mit denselben
+ * semantischen Werten und denselben Zeilennummern wie `lexer.l`,
+ * einschließlich der Randfälle wie `//` ohne abschließenden Zeilenumbruch
+ * oder nicht geschlossener Kommentare. Ist der Modus eines `Lexer` (siehe
+ * `lex.h`) `SCAN_DFA`, leitet `yylex()` an ihn weiter, so dass der Parser
+ * unverändert bleibt. Sein gesamter Zustand liegt im `Scanner`, so dass
+ * mehrere Threads unabhängige Scanner verwenden können.
+ *
+ * Statt der Zustandstabellen von flex wird jedes Byte über eine Tabelle
+ * einer Zeichenklasse zugeordnet, deren Behandlung fest codiert ist. Für
+ * Bezeichner wird mit einer zur Übersetzungszeit gewählten perfekten
+ * Hashfunktion über Länge, erstes und letztes Zeichen der einzige in Frage
+ * kommende Schlüsselwort-Kandidat bestimmt und mit `memcmp()` bestätigt.
+ * Längeren Leerraum, Blockkommentare und Zeichenkettenliterale überspringt
+ * der Scanner vektorisiert mit den Funktionen aus `skip.h`.
+ *
+ * Der Scanner arbeitet direkt auf dem Puffer eines `Source` und schreibt im
+ * Gegensatz zu flex nicht hinein.
+ ******************************************************************************/
+
+#ifndef SCAN_H_INCLUDED
+#define SCAN_H_INCLUDED
+
+/* *** Includes ************************************************************* */
+
+#include <stddef.h>
+
+/* *** Strukturen *********************************************************** */
+
+/* Vorwärtsdeklaration des semantischen Wertes aus `parser.tab.h` */
+union YYSTYPE;
+
+/**
+ * @brief Der von `yylex()` verwendete Scanner.
+ */
+typedef enum ScanMode {
+	SCAN_FLEX, /**<@brief Der von flex erzeugte Scanner (Voreinstellung). */
+	SCAN_DFA   /**<@brief Der handgeschriebene Scanner aus `scan.c`. */
+} ScanMode;
+
+/**
+ * @brief Der Zustand des handgeschriebenen Scanners.
+ */
+typedef struct Scanner {
+	const char *cursor; /**<@brief Das nächste ungelesene Zeichen. */
+	const char *limit;  /**<@brief Das Ende der Eingabe, dort steht ein Nullbyte. */
+	int line;           /**<@brief Die aktuelle Zeilennummer. */
+	int unclosed;       /**<@brief `1`, falls die Eingabe in einem Kommentar endet. */
+} Scanner;
+
+/**
+ * @brief Der Scanner, den `astParse()` und `astParseMapped()` verwenden.
+ *
+ * Die Einstellung wird nur gelesen und sollte vor dem Start weiterer Threads
+ * gesetzt werden.
+ */
+extern ScanMode scanMode;
+
+/* *** Öffentliche Schnittstelle ******************************************** */
+
+/**
+ * @brief Erzeugt einen Scanner am Anfang eines Puffers.
+ *
+ * @param data Der Quelltext; `data[len]` muss ein Nullbyte sein, wie es
+ *             `sourceNew()` garantiert.
+ * @param len  Die Länge des Quelltextes ohne das Nullbyte.
+ * @return Der Scanner in Zeile `1`.
+ */
+extern Scanner scanNew(const char *data, size_t len);
+
+/**
+ * @brief Liest das nächste Token.
+ *
+ * @param self Der Scanner.
+ * @param lval Der semantische Wert des Tokens.
+ * @return Das Token wie von `yylex()`, `EOF` am Ende der Eingabe.
+ */
+extern int scanLex(Scanner *self, union YYSTYPE *lval);
+
+#endif
@@ -0,0 +1,274 @@
+/***************************************************************************//**
+ * @file skip.c
+ * @brief Implementation des vektorisierten Überspringens.
+ ******************************************************************************/
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include "skip.h"
+
+/**
+ * @internal
+ * @brief Gibt an, ob die Umsetzungen mit SSE2 und AVX2 übersetzt werden.
+ *
+ * Die Vektorfunktionen werden über `__attribute__((target))` für ihren
+ * Befehlssatz übersetzt, so dass der Rest der Bibliothek ohne `-mavx2` auf
+ * jedem x86-Prozessor läuft.
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define SKIP_X86 1
+	#include <immintrin.h>
+#else
+	#define SKIP_X86 0
+#endif
+
+/* *** internal structures ************************************************** */
+
+/**
+ * @internal
+ * @brief Die Funktionen einer Umsetzung.
+ */
+typedef struct Skipper {
+	const char* (*space)(const char *p, const char *limit, int *line);
+	const char* (*star)(const char *p, const char *limit, int *line);
+	const char* (*string)(const char *p, const char *limit);
+} Skipper;
+
+/* *** internal helpers ***************************************************** */
+
+/**
+ * @internal
+ * @brief Gibt `1` zurück, falls \p c Leerraum ist, also ein Leerzeichen oder
+ * eines der Steuerzeichen von `\t` bis `\r`.
+ */
+static inline int isSpace(char c) {
+	return c == ' ' || (unsigned char) (c - '\t') <= '\r' - '\t';
+}
+
+/** @internal @brief Skalare Umsetzung von `skipSpace()`. */
+static const char* spaceScalar(const char *p, const char *limit, int *line) {
+	for (; p < limit && isSpace(*p); ++p) {
+		if (*p == '\n') { ++*line; }
+	}
+	
+	return p;
+}
+
+/** @internal @brief Skalare Umsetzung von `skipToStar()`. */
+static const char* starScalar(const char *p, const char *limit, int *line) {
+	for (; p < limit && *p != '*'; ++p) {
+		if (*p == '\n') { ++*line; }
+	}
+	
+	return p;
+}
+
+/** @internal @brief Skalare Umsetzung von `skipString()`. */
+static const char* stringScalar(const char *p, const char *limit) {
+	while (p < limit && *p != '"' && *p != '\n') { ++p; }
+	return p;
+}
+
+#if SKIP_X86
+
+/** @internal @brief Anzahl der Bytes, die vor den Vektoren skalar untersucht werden. */
+#define PREFIX 16
+
+/**
+ * @internal
+ * @brief Gibt das Ende der skalar untersuchten Bytes ab \p p zurück.
+ */
+static inline const char* prefixEnd(const char *p, const char *limit) {
+	return limit - p < PREFIX ? limit : p + PREFIX;
+}
+
+/**
+ * @internal
+ * @brief Erzeugt die vektorisierten Suchschleifen für eine Vektorbreite.
+ *
+ * Die meisten Bereiche sind nur wenige Bytes lang, so dass die ersten
+ * `PREFIX` Bytes skalar untersucht werden. Danach verarbeiten die Schleifen
+ * ganze Vektoren, solange diese vor \p limit enden, und überlassen den Rest
+ * der skalaren Umsetzung. Die Funktionen
+ * `<kind>Mask<SUFFIX>()` liefern je Byte ein Bit für die Bytes, an denen die
+ * Suche endet, und für die Zeilenumbrüche.
+ */
+#define DEFINE_LOOPS(SUFFIX, WIDTH, TARGET) \
+	__attribute__((target(TARGET))) \
+	static const char* space##SUFFIX(const char *p, const char *limit, int *line) { \
+		const char *end = prefixEnd(p, limit); \
+		if ((p = spaceScalar(p, end, line)) < end) { return p; } \
+		for (; limit - p >= WIDTH; p += WIDTH) { \
+			uint32_t nl, stop = spaceMask##SUFFIX(p, &nl); \
+			if (stop != 0) { \
+				unsigned int at = __builtin_ctz(stop); \
+				*line += __builtin_popcount(nl & ((1u << at) - 1)); \
+				return p + at; \
+			} \
+			*line += __builtin_popcount(nl); \
+		} \
+		return spaceScalar(p, limit, line); \
+	} \
+	\
+	__attribute__((target(TARGET))) \
+	static const char* star##SUFFIX(const char *p, const char *limit, int *line) { \
+		const char *end = prefixEnd(p, limit); \
+		if ((p = starScalar(p, end, line)) < end) { return p; } \
+		for (; limit - p >= WIDTH; p += WIDTH) { \
+			uint32_t nl, stop = starMask##SUFFIX(p, &nl); \
+			if (stop != 0) { \
+				unsigned int at = __builtin_ctz(stop); \
+				*line += __builtin_popcount(nl & ((1u << at) - 1)); \
+				return p + at; \
+			} \
+			*line += __builtin_popcount(nl); \
+		} \
+		return starScalar(p, limit, line); \
+	} \
+	\
+	__attribute__((target(TARGET))) \
+	static const char* string##SUFFIX(const char *p, const char *limit) { \
+		const char *end = prefixEnd(p, limit); \
+		if ((p = stringScalar(p, end)) < end) { return p; } \
+		for (; limit - p >= WIDTH; p += WIDTH) { \
+			uint32_t stop = stringMask##SUFFIX(p); \
+			if (stop != 0) { return p + __builtin_ctz(stop); } \
+		} \
+		return stringScalar(p, limit); \
+	}
+	
+/** @internal @brief Die Leerraum-Maske von 16 Bytes mit SSE2. */
+__attribute__((target("sse2")))
+static inline uint32_t spaceMaskSse2(const char *p, uint32_t *nl) {
+	__m128i v = _mm_loadu_si128((const __m128i*) p);
+	
+	/* '\t' to '\r' are the bytes whose distance to '\t' is at most four */
+	__m128i ctrl = _mm_sub_epi8(v, _mm_set1_epi8('\t'));
+	ctrl = _mm_cmpeq_epi8(_mm_min_epu8(ctrl, _mm_set1_epi8('\r' - '\t')), ctrl);
+	__m128i space = _mm_or_si128(ctrl, _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')));
+	
+	*nl = _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+	return ~_mm_movemask_epi8(space) & 0xffffu;
+}
+
+/** @internal @brief Die Maske der Sterne von 16 Bytes mit SSE2. */
+__attribute__((target("sse2")))
+static inline uint32_t starMaskSse2(const char *p, uint32_t *nl) {
+	__m128i v = _mm_loadu_si128((const __m128i*) p);
+	*nl = _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('*')));
+}
+
+/** @internal @brief Die Maske der Enden einer Zeichenkette von 16 Bytes mit SSE2. */
+__attribute__((target("sse2")))
+static inline uint32_t stringMaskSse2(const char *p) {
+	__m128i v = _mm_loadu_si128((const __m128i*) p);
+	__m128i quote = _mm_cmpeq_epi8(v, _mm_set1_epi8('"'));
+	return _mm_movemask_epi8(_mm_or_si128(quote, _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))));
+}
+
+/** @internal @brief Die Leerraum-Maske von 32 Bytes mit AVX2. */
+__attribute__((target("avx2")))
+static inline uint32_t spaceMaskAvx2(const char *p, uint32_t *nl) {
+	__m256i v = _mm256_loadu_si256((const __m256i*) p);
+	
+	__m256i ctrl = _mm256_sub_epi8(v, _mm256_set1_epi8('\t'));
+	ctrl = _mm256_cmpeq_epi8(_mm256_min_epu8(ctrl, _mm256_set1_epi8('\r' - '\t')), ctrl);
+	__m256i space = _mm256_or_si256(ctrl, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')));
+	
+	*nl = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+	return ~(uint32_t) _mm256_movemask_epi8(space);
+}
+
+/** @internal @brief Die Maske der Sterne von 32 Bytes mit AVX2. */
+__attribute__((target("avx2")))
+static inline uint32_t starMaskAvx2(const char *p, uint32_t *nl) {
+	__m256i v = _mm256_loadu_si256((const __m256i*) p);
+	*nl = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+	return _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('*')));
+}
+
+/** @internal @brief Die Maske der Enden einer Zeichenkette von 32 Bytes mit AVX2. */
+__attribute__((target("avx2")))
+static inline uint32_t stringMaskAvx2(const char *p) {
+	__m256i v = _mm256_loadu_si256((const __m256i*) p);
+	__m256i quote = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'));
+	return _mm256_movemask_epi8(_mm256_or_si256(quote, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'))));
+}
+
+DEFINE_LOOPS(Sse2, 16, "sse2")
+DEFINE_LOOPS(Avx2, 32, "avx2")
+
+#endif
+
+/** @internal @brief Die Umsetzungen, indiziert durch `SkipLevel`. */
+static const Skipper SKIPPERS[] = {
+	[SKIP_SCALAR] = { spaceScalar, starScalar, stringScalar },
+#if SKIP_X86
+	[SKIP_SSE2]   = { spaceSse2, starSse2, stringSse2 },
+	[SKIP_AVX2]   = { spaceAvx2, starAvx2, stringAvx2 }
+#endif
+};
+
+/* the first call of any function selects the implementation */
+static const char* spaceDetect(const char *p, const char *limit, int *line);
+static const char* starDetect(const char *p, const char *limit, int *line);
+static const char* stringDetect(const char *p, const char *limit);
+
+/** @internal @brief Platzhalter, der beim ersten Aufruf die Umsetzung wählt. */
+static const Skipper DETECT = { spaceDetect, starDetect, stringDetect };
+
+/**
+ * @internal
+ * @brief Die gewählte Umsetzung; atomar, da mehrere Threads zugleich beim
+ * ersten Aufruf wählen können.
+ */
+static _Atomic(const Skipper*) active = &DETECT;
+
+static const char* spaceDetect(const char *p, const char *limit, int *line) {
+	skipSelect(skipDetect());
+	return active->space(p, limit, line);
+}
+
+static const char* starDetect(const char *p, const char *limit, int *line) {
+	skipSelect(skipDetect());
+	return active->star(p, limit, line);
+}
+
+static const char* stringDetect(const char *p, const char *limit) {
+	skipSelect(skipDetect());
+	return active->string(p, limit);
+}
+
+/* *** implementation ******************************************************* */
+
+SkipLevel skipDetect(void) {
+#if SKIP_X86
+	/* evaluates CPUID and whether the OS saves the AVX registers */
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) { return SKIP_AVX2; }
+	if (__builtin_cpu_supports("sse2")) { return SKIP_SSE2; }
+#endif
+	
+	return SKIP_SCALAR;
+}
+
+SkipLevel skipSelect(SkipLevel level) {
+	SkipLevel best = skipDetect();
+	if (level > best) { level = best; }
+	
+	active = &SKIPPERS[level];
+	return level;
+}
+
+const char* skipSpace(const char *p, const char *limit, int *line) {
+	return active->space(p, limit, line);
+}
+
+const char* skipToStar(const char *p, const char *limit, int *line) {
+	return active->star(p, limit, line);
+}
+
+const char* skipString(const char *p, const char *limit) {
+	return active->string(p, limit);
+}
@@ -0,0 +1,82 @@
+/***************************************************************************//**
+ * @file skip.h
+ * @brief Vektorisiertes Überspringen von Leerraum, Kommentaren und
+ * Zeichenketten für den handgeschriebenen Scanner.
+ *
+ * # Überblick
+ *
+ * Generierte Quelltexte bestehen zu einem großen Teil aus Einrückung und
+ * Kommentaren. Die Funktionen dieses Moduls suchen das Ende solcher Bereiche
+ * mit SSE2 16 und mit AVX2 32 Bytes auf einmal und zählen dabei die
+ * übersprungenen Zeilenumbrüche über eine Bitmaske.
+ *
+ * Die Umsetzung wird beim ersten Aufruf anhand der von `CPUID` gemeldeten
+ * Befehlssatzerweiterungen gewählt; auf anderen Architekturen als x86 und
+ * ohne GCC-kompatiblen Compiler steht nur die skalare Umsetzung zur
+ * Verfügung. Alle Umsetzungen lesen nie über `limit` hinaus und liefern
+ * dieselben Ergebnisse.
+ ******************************************************************************/
+
+#ifndef SKIP_H_INCLUDED
+#define SKIP_H_INCLUDED
+
+/* *** Strukturen *********************************************************** */
+
+/**
+ * @brief Die Umsetzungen in aufsteigender Breite.
+ */
+typedef enum SkipLevel {
+	SKIP_SCALAR, /**<@brief Byteweise Suche. */
+	SKIP_SSE2,   /**<@brief Suche mit 16 Bytes breiten Vektoren. */
+	SKIP_AVX2    /**<@brief Suche mit 32 Bytes breiten Vektoren. */
+} SkipLevel;
+
+/* *** Öffentliche Schnittstelle ******************************************** */
+
+/**
+ * @brief Gibt die breiteste vom Prozessor unterstützte Umsetzung zurück.
+ */
+extern SkipLevel skipDetect(void);
+
+/**
+ * @brief Wählt eine Umsetzung, höchstens jedoch die von `skipDetect()`.
+ * @param level Die gewünschte Umsetzung.
+ * @return Die tatsächlich gewählte Umsetzung.
+ */
+extern SkipLevel skipSelect(SkipLevel level);
+
+/**
+ * @brief Sucht das erste Zeichen, das kein Leerraum im Sinne von `isspace()`
+ * ist.
+ *
+ * @param p     Der Beginn der Suche.
+ * @param limit Das Ende der Suche.
+ * @param line  Die Zeilennummer, die um die übersprungenen Zeilenumbrüche
+ *              erhöht wird.
+ * @return Das gefundene Zeichen oder \p limit.
+ */
+extern const char* skipSpace(const char *p, const char *limit, int *line);
+
+/**
+ * @brief Sucht das nächste `*`, etwa als mögliches Ende eines
+ * Blockkommentars.
+ *
+ * @param p     Der Beginn der Suche.
+ * @param limit Das Ende der Suche.
+ * @param line  Die Zeilennummer, die um die übersprungenen Zeilenumbrüche
+ *              erhöht wird.
+ * @return Das gefundene Zeichen oder \p limit.
+ */
+extern const char* skipToStar(const char *p, const char *limit, int *line);
+
+/**
+ * @brief Sucht das nächste `"` oder den nächsten Zeilenumbruch, also das Ende
+ * eines Zeichenkettenliterals.
+ *
+ * @param p     Der Beginn der Suche hinter dem öffnenden `"`.
+ * @param limit Das Ende der Suche.
+ * @return Das gefundene Zeichen oder \p limit.
+ */
+extern const char* skipString(const char *p, const char *limit);
+
+#endif
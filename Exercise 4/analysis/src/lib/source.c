@@ -0,0 +1,133 @@
+/***************************************************************************//**
+ * @file source.c
+ * @brief Implementation des Ladens von Quelltexten.
+ ******************************************************************************/
+
+/* mmap und MAP_ANONYMOUS gehören nicht zu C11 */
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "source.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define HAVE_MMAP 1
+#endif
+
+/* *** internal structures ************************************************** */
+
+/** @internal @brief Anfangsgröße des Puffers beim Lesen. */
+#define READ_SIZE ((size_t) 1 << 16)
+
+/* *** internal helpers ***************************************************** */
+
+#ifdef HAVE_MMAP
+
+/**
+ * @internal
+ * @brief Blendet die ersten \p len Bytes einer Datei gefolgt von
+ * `SOURCE_PADDING` Nullbytes ein.
+ *
+ * @return `1` bei Erfolg, sonst `0`.
+ */
+static int mapFile(Source *self, int fd, size_t len) {
+	size_t size = len + SOURCE_PADDING;
+	
+	/* reserve zero pages for the whole range, then map the file over its start */
+	char *data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (data == MAP_FAILED) { return 0; }
+	
+	if (mmap(data, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+		munmap(data, size);
+		return 0;
+	}
+	
+	madvise(data, len, MADV_SEQUENTIAL);
+	self->data = data;
+	self->len = len;
+	self->size = size;
+	return 1;
+}
+
+#endif
+
+/**
+ * @internal
+ * @brief Liest eine Datei vollständig in einen Puffer mit abschließenden
+ * Nullbytes.
+ */
+static void readFile(Source *self, FILE *file) {
+	size_t cap = READ_SIZE, len = 0, n;
+	char *data = malloc(cap);
+	
+	while (data != NULL && (n = fread(data + len, 1, cap - len - SOURCE_PADDING, file)) > 0) {
+		len += n;
+		
+		if (cap - len == SOURCE_PADDING) {
+			cap *= 2;
+			char *grown = realloc(data, cap);
+			if (grown == NULL) { free(data); }
+			data = grown;
+		}
+	}
+	
+	if (data == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	if (ferror(file)) {
+		free(data);
+		return;
+	}
+	
+	memset(data + len, 0, SOURCE_PADDING);
+	self->data = data;
+	self->len = len;
+}
+
+/* *** implementation ******************************************************* */
+
+Source sourceNew(const char *path) {
+	Source self = { 0 };
+	
+#ifdef HAVE_MMAP
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) { return self; }
+	
+	struct stat st;
+	int mapped = fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0
+		&& mapFile(&self, fd, st.st_size);
+	
+	close(fd);
+	if (mapped) { return self; }
+#endif
+	
+	FILE *file = fopen(path, "rb");
+	if (file == NULL) { return self; }
+	
+	readFile(&self, file);
+	fclose(file);
+	return self;
+}
+
+void sourceRelease(Source *self) {
+#ifdef HAVE_MMAP
+	if (self->size > 0) {
+		munmap(self->data, self->size);
+	} else {
+		free(self->data);
+	}
+#else
+	free(self->data);
+#endif
+	
+	self->data = NULL;
+	self->len = 0;
+	self->size = 0;
+}
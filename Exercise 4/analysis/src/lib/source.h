@@ -0,0 +1,63 @@
+/***************************************************************************//**
+ * @file source.h
+ * @brief Laden von Quelltexten für das Scannen an Ort und Stelle.
+ *
+ * # Überblick
+ *
+ * Der von flex erzeugte Scanner kann mit `yy_scan_buffer()` direkt auf einem
+ * Puffer arbeiten, statt die Eingabe blockweise aus einem `FILE` in seinen
+ * eigenen Puffer zu kopieren. Dazu muss der Puffer mit `SOURCE_PADDING`
+ * Nullbytes enden und beschreibbar sein, da der Scanner das Ende des
+ * aktuellen Tokens vorübergehend mit einem Nullbyte markiert.
+ *
+ * `sourceNew()` blendet reguläre Dateien mit `mmap()` privat in den
+ * Adressraum ein. Die Seiten hinter dem Dateiende werden vorher anonym
+ * reserviert, so dass die abschließenden Nullbytes unabhängig von der
+ * Dateigröße vorhanden sind, ohne dass ein Byte der Datei kopiert wird.
+ * Schreibzugriffe des Scanners verbleiben als Kopie der betroffenen Seite im
+ * Prozess. Ist das Einblenden nicht möglich, etwa bei leeren Dateien, Pipes
+ * oder auf Systemen ohne `mmap()`, wird die Datei stattdessen in einen
+ * Puffer gelesen.
+ ******************************************************************************/
+
+#ifndef SOURCE_H_INCLUDED
+#define SOURCE_H_INCLUDED
+
+/* *** Includes ************************************************************* */
+
+#include <stddef.h>
+
+/* *** Konstanten *********************************************************** */
+
+/** @brief Anzahl der Nullbytes, die flex am Ende des Puffers erwartet. */
+#define SOURCE_PADDING 2
+
+/* *** Strukturen *********************************************************** */
+
+/**
+ * @brief Ein geladener Quelltext.
+ */
+typedef struct Source {
+	char *data;  /**<@brief Der Inhalt, gefolgt von `SOURCE_PADDING` Nullbytes, oder `NULL`. */
+	size_t len;  /**<@brief Die Länge des Inhalts ohne die Nullbytes. */
+	size_t size; /**<@brief Die Größe der Einblendung oder `0`, falls gelesen wurde. */
+} Source;
+
+/* *** Öffentliche Schnittstelle ******************************************** */
+
+/**
+ * @brief Lädt eine Quelltextdatei.
+ *
+ * @param path Der Pfad der Datei.
+ * @return Der Quelltext; `data` ist `NULL`, falls die Datei nicht gelesen
+ *         werden konnte.
+ */
+extern Source sourceNew(const char *path);
+
+/**
+ * @brief Gibt einen Quelltext frei.
+ * @param self Der freizugebende Quelltext.
+ */
+extern void sourceRelease(Source *self);
+
+#endif
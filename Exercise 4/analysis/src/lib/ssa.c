@@ -0,0 +1,1493 @@
+/***************************************************************************//**
+ * @file ssa.c
+ * @brief Implementation der SSA-Zwischendarstellung.
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "ssa.h"
+#include "vec.h"
+
+/* *** internal structures ************************************************** */
+
+/**
+ * @internal
+ * @brief Eine φ-Funktion, deren Operanden erst nach dem Versiegeln ihres
+ * Blocks ergänzt werden können.
+ */
+typedef struct {
+	unsigned int block; /**<@brief Der noch unversiegelte Block. */
+	unsigned int slot;  /**<@brief Slot der Variablen. */
+	unsigned int phi;   /**<@brief Die unvollständige φ-Funktion. */
+} PendingPhi;
+
+/**
+ * @internal
+ * @brief Zustand der Konstruktion einer Funktion.
+ *
+ * Ein Block gilt als *versiegelt*, sobald all seine Vorgänger bekannt sind.
+ * Erst dann können die Operanden seiner φ-Funktionen bestimmt werden.
+ */
+typedef struct {
+	const DefInfo *defs;   /**<@brief Die Definitionstabelle. */
+	SsaFunc *func;         /**<@brief Die erzeugte Funktion. */
+	const DefId *vars;     /**<@brief Die lokalen Variablen, indiziert durch ihren Slot. */
+	unsigned int frame;    /**<@brief Anzahl der lokalen Variablen. */
+	unsigned int block;    /**<@brief Der Block, an den angehängt wird. */
+	unsigned int *current; /**<@brief Aktueller Wert je Block und Slot (`block*frame + slot`). */
+	unsigned char *sealed; /**<@brief Vektor, der angibt, ob ein Block versiegelt ist. */
+	PendingPhi *pending;   /**<@brief Vektor der unvollständigen φ-Funktionen. */
+} SsaBuilder;
+
+/**
+ * @internal
+ * @brief Zustand des Referenzauswerters.
+ */
+typedef struct {
+	const SsaProgram *prog; /**<@brief Das ausgeführte Programm. */
+	Value *globals;         /**<@brief Speicher der globalen Variablen. */
+	Out *out;               /**<@brief Ausgabepuffer für `print`. */
+} SsaEval;
+
+/* *** internal constants *************************************************** */
+
+const char *SSA_OP_NAMES[SSA_OP_COUNT] = {
+	[SSA_NOP]          = "nop",
+	[SSA_CONST]        = "const",
+	[SSA_UNDEF]        = "undef",
+	[SSA_PARAM]        = "param",
+	[SSA_PHI]          = "phi",
+	[SSA_LOAD_GLOBAL]  = "load",
+	[SSA_STORE_GLOBAL] = "store",
+	[SSA_CALL]         = "call",
+	[SSA_PRINT]        = "print",
+	[SSA_NEWLINE]      = "newline",
+	[SSA_I2F]          = "i2f",
+	[SSA_NEG_I]        = "neg.i",
+	[SSA_NEG_F]        = "neg.f",
+	[SSA_ADD_I]        = "add.i",
+	[SSA_SUB_I]        = "sub.i",
+	[SSA_MUL_I]        = "mul.i",
+	[SSA_DIV_I]        = "div.i",
+	[SSA_ADD_F]        = "add.f",
+	[SSA_SUB_F]        = "sub.f",
+	[SSA_MUL_F]        = "mul.f",
+	[SSA_DIV_F]        = "div.f",
+	[SSA_EQ_I]         = "eq.i",
+	[SSA_NEQ_I]        = "neq.i",
+	[SSA_LT_I]         = "lt.i",
+	[SSA_GT_I]         = "gt.i",
+	[SSA_LEQ_I]        = "leq.i",
+	[SSA_GEQ_I]        = "geq.i",
+	[SSA_EQ_F]         = "eq.f",
+	[SSA_NEQ_F]        = "neq.f",
+	[SSA_LT_F]         = "lt.f",
+	[SSA_GT_F]         = "gt.f",
+	[SSA_LEQ_F]        = "leq.f",
+	[SSA_GEQ_F]        = "geq.f",
+	[SSA_EQ_B]         = "eq.b",
+	[SSA_NEQ_B]        = "neq.b",
+	[SSA_LT_B]         = "lt.b",
+	[SSA_GT_B]         = "gt.b",
+	[SSA_LEQ_B]        = "leq.b",
+	[SSA_GEQ_B]        = "geq.b",
+};
+
+/**
+ * @internal
+ * @brief Operanden- und Ergebnistyp der Operationen ab `SSA_I2F`, die nur
+ * Werte eines Typs verknüpfen.
+ */
+static const struct {
+	DataType arg;      /**<@brief Typ aller Operanden. */
+	DataType result;   /**<@brief Typ des Ergebnisses. */
+	unsigned int argc; /**<@brief Anzahl der Operanden. */
+} SIGNATURES[SSA_OP_COUNT] = {
+	[SSA_I2F]   = { TYPE_INT,   TYPE_FLOAT, 1 },
+	[SSA_NEG_I] = { TYPE_INT,   TYPE_INT,   1 },
+	[SSA_NEG_F] = { TYPE_FLOAT, TYPE_FLOAT, 1 },
+	[SSA_ADD_I] = { TYPE_INT,   TYPE_INT,   2 },
+	[SSA_SUB_I] = { TYPE_INT,   TYPE_INT,   2 },
+	[SSA_MUL_I] = { TYPE_INT,   TYPE_INT,   2 },
+	[SSA_DIV_I] = { TYPE_INT,   TYPE_INT,   2 },
+	[SSA_ADD_F] = { TYPE_FLOAT, TYPE_FLOAT, 2 },
+	[SSA_SUB_F] = { TYPE_FLOAT, TYPE_FLOAT, 2 },
+	[SSA_MUL_F] = { TYPE_FLOAT, TYPE_FLOAT, 2 },
+	[SSA_DIV_F] = { TYPE_FLOAT, TYPE_FLOAT, 2 },
+	[SSA_EQ_I]  = { TYPE_INT,   TYPE_BOOL,  2 },
+	[SSA_NEQ_I] = { TYPE_INT,   TYPE_BOOL,  2 },
+	[SSA_LT_I]  = { TYPE_INT,   TYPE_BOOL,  2 },
+	[SSA_GT_I]  = { TYPE_INT,   TYPE_BOOL,  2 },
+	[SSA_LEQ_I] = { TYPE_INT,   TYPE_BOOL,  2 },
+	[SSA_GEQ_I] = { TYPE_INT,   TYPE_BOOL,  2 },
+	[SSA_EQ_F]  = { TYPE_FLOAT, TYPE_BOOL,  2 },
+	[SSA_NEQ_F] = { TYPE_FLOAT, TYPE_BOOL,  2 },
+	[SSA_LT_F]  = { TYPE_FLOAT, TYPE_BOOL,  2 },
+	[SSA_GT_F]  = { TYPE_FLOAT, TYPE_BOOL,  2 },
+	[SSA_LEQ_F] = { TYPE_FLOAT, TYPE_BOOL,  2 },
+	[SSA_GEQ_F] = { TYPE_FLOAT, TYPE_BOOL,  2 },
+	[SSA_EQ_B]  = { TYPE_BOOL,  TYPE_BOOL,  2 },
+	[SSA_NEQ_B] = { TYPE_BOOL,  TYPE_BOOL,  2 },
+	[SSA_LT_B]  = { TYPE_BOOL,  TYPE_BOOL,  2 },
+	[SSA_GT_B]  = { TYPE_BOOL,  TYPE_BOOL,  2 },
+	[SSA_LEQ_B] = { TYPE_BOOL,  TYPE_BOOL,  2 },
+	[SSA_GEQ_B] = { TYPE_BOOL,  TYPE_BOOL,  2 },
+};
+
+/* *** internal helpers ***************************************************** */
+
+/* forward declarations */
+static unsigned int buildExpr(SsaBuilder*, const Expr*);
+static void buildStmt(SsaBuilder*, const Stmt*);
+static unsigned int readVar(SsaBuilder*, unsigned int, unsigned int);
+
+/**
+ * @internal
+ * @brief Reserviert Speicher und beendet das Programm, falls keiner frei ist.
+ */
+static void* allocate(size_t size) {
+	void *result = malloc(size);
+	
+	if (result == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	return result;
+}
+
+/**
+ * @internal
+ * @brief Fügt die Instruktion \p id an der Stelle \p at in den Block ein.
+ */
+static void blockInsert(SsaBlock *block, unsigned int at, unsigned int id) {
+	vecPush(block->instrs) = id;
+	memmove(&block->instrs[at + 1], &block->instrs[at], (vecLen(block->instrs) - 1 - at)*sizeof(unsigned int));
+	block->instrs[at] = id;
+}
+
+/**
+ * @internal
+ * @brief Entfernt die Instruktion an der Stelle \p at aus dem Block.
+ */
+static void blockRemove(SsaBlock *block, unsigned int at) {
+	memmove(&block->instrs[at], &block->instrs[at + 1], (vecLen(block->instrs) - 1 - at)*sizeof(unsigned int));
+	(void) vecPop(block->instrs);
+}
+
+/**
+ * @internal
+ * @brief Gibt die Anzahl der φ-Funktionen am Anfang des Blocks zurück.
+ */
+static unsigned int phiCount(const SsaFunc *func, const SsaBlock *block) {
+	unsigned int count = 0;
+	
+	while (count < vecLen(block->instrs) && func->instrs[block->instrs[count]].op == SSA_PHI) {
+		++count;
+	}
+	
+	return count;
+}
+
+/**
+ * @internal
+ * @brief Legt eine neue Instruktion an, ohne sie in einen Block einzufügen.
+ */
+static unsigned int newInstr(SsaFunc *func, unsigned int block, SsaOp op, DataType type) {
+	vecPush(func->instrs) = (SsaInstr) { .op = op, .type = type, .block = block };
+	return vecLen(func->instrs) - 1;
+}
+
+/**
+ * @internal
+ * @brief Hängt eine Instruktion mit bis zu zwei Operanden an den aktuellen
+ * Block an; fehlende Operanden sind `SSA_NONE`.
+ */
+static unsigned int emit(SsaBuilder *self, SsaOp op, DataType type, unsigned int lhs, unsigned int rhs) {
+	unsigned int id = newInstr(self->func, self->block, op, type);
+	
+	if (lhs != SSA_NONE) { vecPush(self->func->instrs[id].args) = lhs; }
+	if (rhs != SSA_NONE) { vecPush(self->func->instrs[id].args) = rhs; }
+	
+	vecPush(self->func->blocks[self->block].instrs) = id;
+	return id;
+}
+
+/**
+ * @internal
+ * @brief Hängt eine Konstante an den aktuellen Block an.
+ */
+static unsigned int emitConst(SsaBuilder *self, DataType type, Value value) {
+	unsigned int id = emit(self, SSA_CONST, type, SSA_NONE, SSA_NONE);
+	self->func->instrs[id].value = value;
+	return id;
+}
+
+/**
+ * @internal
+ * @brief Fügt eine φ-Funktion ohne Operanden für die Variable \p var am
+ * Anfang von \p block ein.
+ */
+static unsigned int addPhi(SsaFunc *func, unsigned int block, DataType type, unsigned int var) {
+	unsigned int id = newInstr(func, block, SSA_PHI, type);
+	func->instrs[id].index = var;
+	blockInsert(&func->blocks[block], phiCount(func, &func->blocks[block]), id);
+	return id;
+}
+
+/**
+ * @internal
+ * @brief Legt einen neuen, unversiegelten Block an.
+ */
+static unsigned int newBlock(SsaBuilder *self) {
+	vecPush(self->func->blocks) = (SsaBlock) {
+		.term = SSA_RETURN,
+		.value = SSA_NONE,
+		.succ = { SSA_NONE, SSA_NONE }
+	};
+	
+	vecPush(self->sealed) = 0;
+	for (unsigned int i = 0; i < self->frame; ++i) {
+		vecPush(self->current) = SSA_NONE;
+	}
+	
+	return vecLen(self->func->blocks) - 1;
+}
+
+/**
+ * @internal
+ * @brief Beendet den aktuellen Block mit einem Sprung nach \p target.
+ */
+static void jump(SsaBuilder *self, unsigned int target) {
+	SsaBlock *block = &self->func->blocks[self->block];
+	block->term = SSA_JUMP;
+	block->succ[0] = target;
+	vecPush(self->func->blocks[target].preds) = self->block;
+}
+
+/**
+ * @internal
+ * @brief Beendet den aktuellen Block mit einer Verzweigung.
+ */
+static void branch(SsaBuilder *self, unsigned int cond, unsigned int if_true, unsigned int if_false) {
+	SsaBlock *block = &self->func->blocks[self->block];
+	block->term = SSA_BRANCH;
+	block->value = cond;
+	block->succ[0] = if_true;
+	block->succ[1] = if_false;
+	vecPush(self->func->blocks[if_true].preds) = self->block;
+	vecPush(self->func->blocks[if_false].preds) = self->block;
+}
+
+/**
+ * @internal
+ * @brief Beendet den aktuellen Block mit einer Rückkehr und setzt die
+ * Konstruktion in einem neuen, unerreichbaren Block fort.
+ */
+static void ret(SsaBuilder *self, unsigned int value) {
+	self->func->blocks[self->block].term = SSA_RETURN;
+	self->func->blocks[self->block].value = value;
+	self->block = newBlock(self);
+	self->sealed[self->block] = 1;
+}
+
+/**
+ * @internal
+ * @brief Setzt den aktuellen Wert der Variablen in \p slot im Block \p block.
+ */
+static inline void writeVar(SsaBuilder *self, unsigned int slot, unsigned int block, unsigned int value) {
+	self->current[block*self->frame + slot] = value;
+}
+
+/**
+ * @internal
+ * @brief Ergänzt die Operanden einer φ-Funktion um die Werte der Variablen in
+ * allen Vorgängern ihres Blocks.
+ */
+static void addPhiOperands(SsaBuilder *self, unsigned int slot, unsigned int phi) {
+	unsigned int block = self->func->instrs[phi].block;
+	
+	for (unsigned int i = 0; i < vecLen(self->func->blocks[block].preds); ++i) {
+		unsigned int value = readVar(self, slot, self->func->blocks[block].preds[i]);
+		vecPush(self->func->instrs[phi].args) = value;
+	}
+}
+
+/**
+ * @internal
+ * @brief Sucht den Wert einer Variablen, die im Block selbst nicht
+ * zugewiesen wurde, in dessen Vorgängern.
+ */
+static unsigned int readVarRecursive(SsaBuilder *self, unsigned int slot, unsigned int block) {
+	DefId var = self->vars[slot];
+	DataType type = self->defs[var.index].var.data_type;
+	const unsigned int *preds = self->func->blocks[block].preds;
+	unsigned int value;
+	
+	if (!self->sealed[block]) {
+		value = addPhi(self->func, block, type, var.index);
+		vecPush(self->pending) = (PendingPhi) { block, slot, value };
+	} else if (vecLen(preds) == 0) {
+		/* reading an uninitialized variable */
+		value = newInstr(self->func, block, SSA_UNDEF, type);
+		self->func->instrs[value].index = var.index;
+		vecPush(self->func->blocks[block].instrs) = value;
+	} else if (vecLen(preds) == 1) {
+		value = readVar(self, slot, preds[0]);
+	} else {
+		/* the phi function breaks cycles through loops */
+		value = addPhi(self->func, block, type, var.index);
+		writeVar(self, slot, block, value);
+		addPhiOperands(self, slot, value);
+	}
+	
+	writeVar(self, slot, block, value);
+	return value;
+}
+
+/**
+ * @internal
+ * @brief Gibt den aktuellen Wert der Variablen in \p slot im Block \p block
+ * zurück.
+ */
+static unsigned int readVar(SsaBuilder *self, unsigned int slot, unsigned int block) {
+	unsigned int value = self->current[block*self->frame + slot];
+	return value != SSA_NONE ? value : readVarRecursive(self, slot, block);
+}
+
+/**
+ * @internal
+ * @brief Versiegelt einen Block, dessen Vorgänger nun vollständig sind.
+ */
+static void sealBlock(SsaBuilder *self, unsigned int block) {
+	for (unsigned int i = 0; i < vecLen(self->pending); ++i) {
+		if (self->pending[i].block == block) {
+			self->pending[i].block = SSA_NONE;
+			addPhiOperands(self, self->pending[i].slot, self->pending[i].phi);
+		}
+	}
+	
+	self->sealed[block] = 1;
+}
+
+/**
+ * @internal
+ * @brief Wandelt einen Wert implizit von \p from nach \p to um.
+ */
+static unsigned int convert(SsaBuilder *self, unsigned int value, DataType from, DataType to) {
+	if (from == TYPE_INT && to == TYPE_FLOAT) {
+		return emit(self, SSA_I2F, TYPE_FLOAT, value, SSA_NONE);
+	}
+	
+	return value;
+}
+
+/**
+ * @internal
+ * @brief Übersetzt die Zuweisung von \p rhs an die Variable \p id.
+ * @return Der zugewiesene Wert.
+ */
+static unsigned int buildStore(SsaBuilder *self, DefId id, const Expr *rhs) {
+	const DefInfo *def = &self->defs[id.index];
+	unsigned int value = convert(self, buildExpr(self, rhs), rhs->data_type, def->var.data_type);
+	
+	if (def->tag == SYM_DEF_LOCAL_VAR) {
+		writeVar(self, def->var.offset, self->block, value);
+	} else {
+		unsigned int store = emit(self, SSA_STORE_GLOBAL, TYPE_VOID, value, SSA_NONE);
+		self->func->instrs[store].index = id.index;
+	}
+	
+	return value;
+}
+
+/**
+ * @internal
+ * @brief Übersetzt einen Funktionsaufruf.
+ */
+static unsigned int buildCall(SsaBuilder *self, const FuncCall *call) {
+	const FuncInfo *func = &self->defs[call->res_ident.res.index].func;
+	unsigned int *args = NULL;
+	
+	for (unsigned int i = 0; i < func->param_count; ++i) {
+		DataType type = self->defs[func->local_vars[i].index].var.data_type;
+		unsigned int value = buildExpr(self, &call->args[i]);
+		vecPush(args) = convert(self, value, call->args[i].data_type, type);
+	}
+	
+	unsigned int id = emit(self, SSA_CALL, func->return_type, SSA_NONE, SSA_NONE);
+	self->func->instrs[id].index = call->res_ident.res.index;
+	self->func->instrs[id].args = args;
+	return id;
+}
+
+/**
+ * @internal
+ * @brief Übersetzt `&&` und `||` in eine Verzweigung.
+ *
+ * Wird der rechte Operand übersprungen, ist das Ergebnis der linke Operand.
+ */
+static unsigned int buildLogical(SsaBuilder *self, const BinOpExpr *bin) {
+	unsigned int lhs = buildExpr(self, bin->lhs);
+	unsigned int rhs_block = newBlock(self);
+	unsigned int join = newBlock(self);
+	
+	if (bin->op == BIN_OP_LOG_AND) {
+		branch(self, lhs, rhs_block, join);
+	} else {
+		branch(self, lhs, join, rhs_block);
+	}
+	
+	sealBlock(self, rhs_block);
+	self->block = rhs_block;
+	unsigned int rhs = buildExpr(self, bin->rhs);
+	jump(self, join);
+	sealBlock(self, join);
+	self->block = join;
+	
+	unsigned int phi = addPhi(self->func, join, TYPE_BOOL, SSA_NONE);
+	vecPush(self->func->instrs[phi].args) = lhs;
+	vecPush(self->func->instrs[phi].args) = rhs;
+	return phi;
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine binäre Operation.
+ */
+static unsigned int buildBinOp(SsaBuilder *self, const BinOpExpr *bin) {
+	if (bin->op == BIN_OP_LOG_OR || bin->op == BIN_OP_LOG_AND) {
+		return buildLogical(self, bin);
+	}
+	
+	DataType lhs_type = bin->lhs->data_type;
+	int is_float = lhs_type == TYPE_FLOAT || bin->rhs->data_type == TYPE_FLOAT;
+	
+	unsigned int lhs = buildExpr(self, bin->lhs);
+	if (is_float) { lhs = convert(self, lhs, lhs_type, TYPE_FLOAT); }
+	unsigned int rhs = buildExpr(self, bin->rhs);
+	if (is_float) { rhs = convert(self, rhs, bin->rhs->data_type, TYPE_FLOAT); }
+	
+	if (bin->op <= BIN_OP_DIV) {
+		SsaOp op = (is_float ? SSA_ADD_F : SSA_ADD_I) + bin->op;
+		return emit(self, op, is_float ? TYPE_FLOAT : TYPE_INT, lhs, rhs);
+	}
+	
+	SsaOp base = is_float ? SSA_EQ_F : lhs_type == TYPE_BOOL ? SSA_EQ_B : SSA_EQ_I;
+	return emit(self, base + (bin->op - BIN_OP_EQ), TYPE_BOOL, lhs, rhs);
+}
+
+/**
+ * @internal
+ * @brief Übersetzt einen Ausdruck und gibt die Nummer seines Wertes zurück.
+ */
+static unsigned int buildExpr(SsaBuilder *self, const Expr *expr) {
+	switch (expr->tag) {
+	case EXPR_ASSIGN:
+		return buildStore(self, expr->assign.lhs.res, expr->assign.rhs);
+		
+	case EXPR_BIN_OP:
+		return buildBinOp(self, &expr->bin_op);
+		
+	case EXPR_UNARY_MINUS: {
+		unsigned int value = buildExpr(self, expr->unary_minus);
+		SsaOp op = expr->data_type == TYPE_FLOAT ? SSA_NEG_F : SSA_NEG_I;
+		return emit(self, op, expr->data_type, value, SSA_NONE);
+	}
+	
+	case EXPR_CALL:
+		return buildCall(self, &expr->call);
+		
+	case EXPR_LITERAL:
+		switch (expr->literal.tag) {
+		case LITERAL_INT:    return emitConst(self, TYPE_INT, (Value) { .i = expr->literal.iVal });
+		case LITERAL_FLOAT:  return emitConst(self, TYPE_FLOAT, (Value) { .f = expr->literal.fVal });
+		case LITERAL_BOOL:   return emitConst(self, TYPE_BOOL, (Value) { .i = expr->literal.bVal != 0 });
+		case LITERAL_STRING: return emitConst(self, TYPE_STRING, (Value) { .s = expr->literal.sVal });
+		}
+		break;
+		
+	case EXPR_VAR: {
+		const DefInfo *def = &self->defs[expr->var.res.index];
+		
+		if (def->tag == SYM_DEF_LOCAL_VAR) {
+			return readVar(self, def->var.offset, self->block);
+		}
+		
+		unsigned int load = emit(self, SSA_LOAD_GLOBAL, def->var.data_type, SSA_NONE, SSA_NONE);
+		self->func->instrs[load].index = expr->var.res.index;
+		return load;
+	}
+	
+	case EXPR_INVALID:
+		break;
+	}
+	
+	assert(0);
+	return SSA_NONE;
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine kopfgesteuerte Schleife; \p update kann `NULL` sein.
+ */
+static void buildLoop(SsaBuilder *self, const Expr *cond, const Stmt *body, const Assign *update) {
+	unsigned int header = newBlock(self);
+	unsigned int inner = newBlock(self);
+	unsigned int exit = newBlock(self);
+	
+	jump(self, header);
+	self->block = header;
+	branch(self, buildExpr(self, cond), inner, exit);
+	
+	sealBlock(self, inner);
+	self->block = inner;
+	buildStmt(self, body);
+	if (update != NULL) { buildStore(self, update->lhs.res, update->rhs); }
+	jump(self, header);
+	
+	sealBlock(self, header);
+	sealBlock(self, exit);
+	self->block = exit;
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine Anweisung.
+ */
+static void buildStmt(SsaBuilder *self, const Stmt *stmt) {
+	switch (stmt->tag) {
+	case STMT_EMPTY:
+		break;
+		
+	case STMT_IF: {
+		int has_else = stmt->if_stmt.if_false->tag != STMT_EMPTY;
+		unsigned int cond = buildExpr(self, &stmt->if_stmt.cond);
+		unsigned int if_true = newBlock(self);
+		unsigned int if_false = has_else ? newBlock(self) : SSA_NONE;
+		unsigned int join = newBlock(self);
+		
+		branch(self, cond, if_true, has_else ? if_false : join);
+		sealBlock(self, if_true);
+		self->block = if_true;
+		buildStmt(self, stmt->if_stmt.if_true);
+		jump(self, join);
+		
+		if (has_else) {
+			sealBlock(self, if_false);
+			self->block = if_false;
+			buildStmt(self, stmt->if_stmt.if_false);
+			jump(self, join);
+		}
+		
+		sealBlock(self, join);
+		self->block = join;
+		break;
+	}
+	
+	case STMT_FOR: {
+		const ForStmt *for_stmt = &stmt->for_stmt;
+		
+		if (for_stmt->init.tag == FOR_INIT_VAR_DEF) {
+			if (for_stmt->init.var_def.init.tag != EXPR_INVALID) {
+				buildStore(self, for_stmt->init.var_def.res_ident.res, &for_stmt->init.var_def.init);
+			}
+		} else {
+			buildStore(self, for_stmt->init.assign.lhs.res, for_stmt->init.assign.rhs);
+		}
+		
+		buildLoop(self, &for_stmt->cond, for_stmt->body, &for_stmt->update);
+		break;
+	}
+	
+	case STMT_WHILE:
+		buildLoop(self, &stmt->while_stmt.cond, stmt->while_stmt.body, NULL);
+		break;
+		
+	case STMT_DO_WHILE: {
+		unsigned int body = newBlock(self);
+		unsigned int exit = newBlock(self);
+		
+		jump(self, body);
+		self->block = body;
+		buildStmt(self, stmt->do_while_stmt.body);
+		branch(self, buildExpr(self, &stmt->do_while_stmt.cond), body, exit);
+		
+		sealBlock(self, body);
+		sealBlock(self, exit);
+		self->block = exit;
+		break;
+	}
+	
+	case STMT_RETURN: {
+		unsigned int value = SSA_NONE;
+		
+		if (stmt->return_stmt.tag != EXPR_INVALID) {
+			value = buildExpr(self, &stmt->return_stmt);
+			value = convert(self, value, stmt->return_stmt.data_type, self->func->return_type);
+		}
+		
+		ret(self, value);
+		break;
+	}
+	
+	case STMT_PRINT:
+		vecForEach(const Expr *expr, stmt->print_stmt.expressions) {
+			emit(self, SSA_PRINT, TYPE_VOID, buildExpr(self, expr), SSA_NONE);
+		}
+		
+		emit(self, SSA_NEWLINE, TYPE_VOID, SSA_NONE, SSA_NONE);
+		break;
+		
+	case STMT_VAR_DEF:
+		if (stmt->var_def.init.tag != EXPR_INVALID) {
+			buildStore(self, stmt->var_def.res_ident.res, &stmt->var_def.init);
+		}
+		break;
+		
+	case STMT_ASSIGN:
+		buildStore(self, stmt->assign.lhs.res, stmt->assign.rhs);
+		break;
+		
+	case STMT_CALL:
+		buildCall(self, &stmt->call);
+		break;
+		
+	case STMT_BLOCK:
+		vecForEach(const Stmt *inner, stmt->block.statements) {
+			buildStmt(self, inner);
+		}
+		break;
+	}
+}
+
+/**
+ * @internal
+ * @brief Übersetzt eine Funktion oder die Initialisierung globaler Variablen.
+ *
+ * @param info  Die Funktion oder `NULL` für die Initialisierung.
+ * @param stmts Die Anweisungen bzw. `NULL` für die Initialisierung.
+ * @param ast   Der Syntaxbaum, dessen globale Variablen initialisiert werden.
+ */
+static void buildFunc(SsaFunc *func, const DefInfo *defs, const FuncInfo *info, const Stmt *stmts, const Program *ast) {
+	SsaBuilder self = {
+		.defs = defs,
+		.func = func,
+		.vars = info != NULL ? info->local_vars : NULL,
+		.frame = info != NULL ? vecLen(info->local_vars) : 0
+	};
+	
+	self.block = newBlock(&self);
+	sealBlock(&self, self.block);
+	
+	for (unsigned int i = 0; i < func->param_count; ++i) {
+		DataType type = defs[info->local_vars[i].index].var.data_type;
+		unsigned int param = emit(&self, SSA_PARAM, type, SSA_NONE, SSA_NONE);
+		func->instrs[param].index = i;
+		writeVar(&self, i, self.block, param);
+	}
+	
+	if (info != NULL) {
+		vecForEach(const Stmt *stmt, stmts) {
+			buildStmt(&self, stmt);
+		}
+	} else {
+		vecForEach(const Item *item, ast->items) {
+			if (item->tag == ITEM_GLOBAL_VAR && item->var_def.init.tag != EXPR_INVALID) {
+				buildStore(&self, item->var_def.res_ident.res, &item->var_def.init);
+			}
+		}
+	}
+	
+	/* a missing return statement yields 0 */
+	if (func->return_type == TYPE_VOID) {
+		ret(&self, SSA_NONE);
+	} else {
+		ret(&self, emitConst(&self, func->return_type, (Value) { .f = 0 }));
+	}
+	
+	/* the block opened by the final return is never reached */
+	(void) vecPop(func->blocks);
+	
+	vecRelease(self.current);
+	vecRelease(self.sealed);
+	vecRelease(self.pending);
+	ssaRemoveTrivialPhis(func);
+}
+
+/**
+ * @internal
+ * @brief Gibt die Speicher einer Funktion frei.
+ */
+static void funcRelease(SsaFunc *func) {
+	vecForEach(SsaInstr *instr, func->instrs) {
+		vecRelease(instr->args);
+	}
+	
+	vecForEach(SsaBlock *block, func->blocks) {
+		vecRelease(block->instrs);
+		vecRelease(block->preds);
+	}
+	
+	vecRelease(func->instrs);
+	vecRelease(func->blocks);
+}
+
+/**
+ * @internal
+ * @brief Folgt den Ersetzungen in \p forward bis zu einem Wert, der nicht
+ * ersetzt wurde.
+ */
+static inline unsigned int resolve(const unsigned int *forward, unsigned int value) {
+	while (forward[value] != value) {
+		value = forward[value];
+	}
+	
+	return value;
+}
+
+/**
+ * @internal
+ * @brief Ordnet die von \p block aus erreichbaren Blöcke in Postordnung an.
+ */
+static void postorder(const SsaFunc *func, unsigned int block, unsigned char *visited, unsigned int **order) {
+	visited[block] = 1;
+	const SsaBlock *b = &func->blocks[block];
+	
+	if (b->term != SSA_RETURN) {
+		for (int i = b->term == SSA_BRANCH; i >= 0; --i) {
+			if (!visited[b->succ[i]]) {
+				postorder(func, b->succ[i], visited, order);
+			}
+		}
+	}
+	
+	vecPush(*order) = block;
+}
+
+/**
+ * @internal
+ * @brief Gibt einen Wert als Operanden der Textausgabe aus.
+ */
+static void printConst(const SsaInstr *instr, FILE *out) {
+	if (instr->type == TYPE_STRING) {
+		fprintf(out, "\"%s\"", instr->value.s);
+	} else {
+		/* an unbuffered output keeps the order with the surrounding text */
+		Out text = outNew(out, 0);
+		interpValuePrint(instr->value, instr->type, &text);
+		outRelease(&text);
+	}
+}
+
+/**
+ * @internal
+ * @brief Gibt eine Funktion in Textform aus.
+ */
+static void funcPrint(const SsaProgram *prog, const SsaFunc *func, FILE *out) {
+	fprintf(out, "function %s(", func->name);
+	
+	for (unsigned int i = 0; i < func->param_count; ++i) {
+		fprintf(out, "%s%s", i > 0 ? ", " : "", TYPE_NAMES[func->instrs[func->blocks[0].instrs[i]].type]);
+	}
+	
+	fprintf(out, ") -> %s\n", TYPE_NAMES[func->return_type]);
+	
+	for (unsigned int b = 0; b < vecLen(func->blocks); ++b) {
+		const SsaBlock *block = &func->blocks[b];
+		fprintf(out, "b%u:", b);
+		
+		for (unsigned int i = 0; i < vecLen(block->preds); ++i) {
+			fprintf(out, "%s b%u", i > 0 ? "," : " ; preds:", block->preds[i]);
+		}
+		
+		fputc('\n', out);
+		
+		vecForEach(const unsigned int *id, block->instrs) {
+			const SsaInstr *instr = &func->instrs[*id];
+			fputc('\t', out);
+			
+			if (instr->type != TYPE_VOID) {
+				fprintf(out, "%%%u = %s ", *id, TYPE_NAMES[instr->type]);
+			}
+			
+			fputs(SSA_OP_NAMES[instr->op], out);
+			
+			switch (instr->op) {
+			case SSA_CONST:
+				fputc(' ', out);
+				printConst(instr, out);
+				break;
+				
+			case SSA_PARAM:
+				fprintf(out, " %u", instr->index);
+				break;
+				
+			case SSA_PHI:
+				for (unsigned int i = 0; i < vecLen(instr->args); ++i) {
+					fprintf(out, "%s [b%u: %%%u]", i > 0 ? "," : "", block->preds[i], instr->args[i]);
+				}
+				break;
+				
+			case SSA_LOAD_GLOBAL:
+			case SSA_STORE_GLOBAL:
+			case SSA_CALL:
+				fprintf(out, " @%s", internName(prog->defs[instr->index].ident));
+				/* fall through */
+				
+			default:
+				for (unsigned int i = 0; i < vecLen(instr->args); ++i) {
+					fprintf(out, "%s %%%u", i > 0 ? "," : "", instr->args[i]);
+				}
+				break;
+			}
+			
+			if ((instr->op == SSA_PHI || instr->op == SSA_UNDEF) && instr->index != SSA_NONE) {
+				fprintf(out, " ; %s", internName(prog->defs[instr->index].ident));
+			}
+			
+			fputc('\n', out);
+		}
+		
+		switch (block->term) {
+		case SSA_JUMP:
+			fprintf(out, "\tjump b%u\n", block->succ[0]);
+			break;
+			
+		case SSA_BRANCH:
+			fprintf(out, "\tbranch %%%u, b%u, b%u\n", block->value, block->succ[0], block->succ[1]);
+			break;
+			
+		case SSA_RETURN:
+			if (block->value != SSA_NONE) {
+				fprintf(out, "\treturn %%%u\n", block->value);
+			} else {
+				fputs("\treturn\n", out);
+			}
+			break;
+		}
+	}
+	
+	fputs("end\n", out);
+}
+
+/**
+ * @internal
+ * @brief Meldet einen Fehler der Prüfung.
+ */
+static void report(unsigned int *errors, FILE *err, const SsaFunc *func, unsigned int block, unsigned int id, const char *msg) {
+	if (id != SSA_NONE) {
+		fprintf(err, "ssa: %s: b%u: %%%u: %s\n", func->name, block, id, msg);
+	} else {
+		fprintf(err, "ssa: %s: b%u: %s\n", func->name, block, msg);
+	}
+	
+	++*errors;
+}
+
+/**
+ * @internal
+ * @brief Prüft, ob \p value ein gültiger Wert vom Typ \p type ist, dessen
+ * Definition die Verwendung am Ende bzw. vor Position \p pos des Blocks
+ * \p block dominiert.
+ *
+ * @param type Der erwartete Typ oder `TYPE_VOID` für einen beliebigen Typ.
+ * @param pos  Die Position der Verwendung oder `SSA_NONE` für das Blockende.
+ */
+static int checkOperand(const SsaFunc *func, const unsigned int *idom, unsigned int value, DataType type, unsigned int block, unsigned int pos) {
+	if (value >= vecLen(func->instrs)) { return 0; }
+	
+	const SsaInstr *def = &func->instrs[value];
+	if (def->op == SSA_NOP || def->type == TYPE_VOID) { return 0; }
+	if (type != TYPE_VOID && def->type != type) { return 0; }
+	
+	/* operands in unreachable code are only checked for their types */
+	if (idom[block] == SSA_NONE) { return 1; }
+	if (def->block != block) { return ssaDominates(idom, def->block, block); }
+	if (pos == SSA_NONE) { return 1; }
+	
+	for (unsigned int i = 0; i < pos; ++i) {
+		if (func->blocks[block].instrs[i] == value) { return 1; }
+	}
+	
+	return 0;
+}
+
+/**
+ * @internal
+ * @brief Prüft die Operanden und Typen einer Instruktion.
+ */
+static void verifyInstr(const SsaProgram *prog, const SsaFunc *func, const unsigned int *idom, unsigned int block, unsigned int pos, unsigned int *errors, FILE *err) {
+	unsigned int id = func->blocks[block].instrs[pos];
+	const SsaInstr *instr = &func->instrs[id];
+	unsigned int argc = vecLen(instr->args);
+	
+	switch (instr->op) {
+	case SSA_NOP:
+		report(errors, err, func, block, id, "removed instruction in block");
+		return;
+		
+	case SSA_CONST:
+	case SSA_UNDEF:
+		if (argc != 0 || instr->type == TYPE_VOID) { report(errors, err, func, block, id, "malformed constant"); }
+		return;
+		
+	case SSA_PARAM:
+		if (block != 0 || instr->index >= func->param_count) { report(errors, err, func, block, id, "malformed parameter"); }
+		return;
+		
+	case SSA_PHI: {
+		const unsigned int *preds = func->blocks[block].preds;
+		
+		if (argc != vecLen(preds)) {
+			report(errors, err, func, block, id, "phi operands do not match predecessors");
+			return;
+		}
+		
+		for (unsigned int i = 0; i < argc; ++i) {
+			/* the operand must be available at the end of the predecessor */
+			unsigned int pred = preds[i];
+			int ok = idom[pred] == SSA_NONE
+				? instr->args[i] < vecLen(func->instrs) && func->instrs[instr->args[i]].type == instr->type
+				: checkOperand(func, idom, instr->args[i], instr->type, pred, SSA_NONE);
+				
+			if (!ok) { report(errors, err, func, block, id, "invalid phi operand"); }
+		}
+		return;
+	}
+	
+	case SSA_LOAD_GLOBAL:
+	case SSA_STORE_GLOBAL: {
+		const DefInfo *def = &prog->defs[instr->index];
+		int store = instr->op == SSA_STORE_GLOBAL;
+		
+		if (def->tag != SYM_DEF_GLOBAL_VAR || argc != (unsigned int) store
+			|| (store ? instr->type != TYPE_VOID : instr->type != def->var.data_type)
+			|| (store && !checkOperand(func, idom, instr->args[0], def->var.data_type, block, pos))) {
+			report(errors, err, func, block, id, "malformed global access");
+		}
+		return;
+	}
+	
+	case SSA_CALL: {
+		const DefInfo *def = &prog->defs[instr->index];
+		
+		if (def->tag != SYM_DEF_FUNC || argc != def->func.param_count || instr->type != def->func.return_type) {
+			report(errors, err, func, block, id, "malformed call");
+			return;
+		}
+		
+		for (unsigned int i = 0; i < argc; ++i) {
+			DataType type = prog->defs[def->func.local_vars[i].index].var.data_type;
+			
+			if (!checkOperand(func, idom, instr->args[i], type, block, pos)) {
+				report(errors, err, func, block, id, "invalid argument");
+			}
+		}
+		return;
+	}
+	
+	case SSA_PRINT:
+		if (argc != 1 || instr->type != TYPE_VOID || !checkOperand(func, idom, instr->args[0], TYPE_VOID, block, pos)) {
+			report(errors, err, func, block, id, "malformed print");
+		}
+		return;
+		
+	case SSA_NEWLINE:
+		if (argc != 0 || instr->type != TYPE_VOID) { report(errors, err, func, block, id, "malformed newline"); }
+		return;
+		
+	default:
+		break;
+	}
+	
+	if (instr->op >= SSA_OP_COUNT || argc != SIGNATURES[instr->op].argc || instr->type != SIGNATURES[instr->op].result) {
+		report(errors, err, func, block, id, "malformed operation");
+		return;
+	}
+	
+	for (unsigned int i = 0; i < argc; ++i) {
+		if (!checkOperand(func, idom, instr->args[i], SIGNATURES[instr->op].arg, block, pos)) {
+			report(errors, err, func, block, id, "invalid operand");
+		}
+	}
+}
+
+/**
+ * @internal
+ * @brief Prüft eine Funktion.
+ */
+static void verifyFunc(const SsaProgram *prog, const SsaFunc *func, unsigned int *errors, FILE *err) {
+	unsigned int count = vecLen(func->blocks);
+	unsigned int *owner = allocate((vecLen(func->instrs) + 1)*sizeof(unsigned int));
+	
+	for (unsigned int i = 0; i < vecLen(func->instrs); ++i) {
+		owner[i] = SSA_NONE;
+	}
+	
+	if (count == 0) {
+		report(errors, err, func, 0, SSA_NONE, "function without blocks");
+		free(owner);
+		return;
+	}
+	
+	/* every edge must appear exactly once in the predecessors of its target */
+	for (unsigned int b = 0; b < count; ++b) {
+		const SsaBlock *block = &func->blocks[b];
+		unsigned int succs = block->term == SSA_RETURN ? 0 : block->term == SSA_BRANCH ? 2 : 1;
+		
+		for (unsigned int i = 0; i < succs; ++i) {
+			if (block->succ[i] >= count) {
+				report(errors, err, func, b, SSA_NONE, "invalid successor");
+				free(owner);
+				return;
+			}
+		}
+		
+		for (unsigned int s = 0; s < count; ++s) {
+			unsigned int edges = 0, preds = 0;
+			
+			for (unsigned int i = 0; i < succs; ++i) { edges += block->succ[i] == s; }
+			vecForEach(const unsigned int *pred, func->blocks[s].preds) { preds += *pred == b; }
+			
+			if (edges != preds) { report(errors, err, func, s, SSA_NONE, "predecessors do not match edges"); }
+		}
+	}
+	
+	if (!vecIsEmpty(func->blocks[0].preds)) {
+		report(errors, err, func, 0, SSA_NONE, "entry block has predecessors");
+	}
+	
+	unsigned int *idom = ssaDominators(func);
+	
+	for (unsigned int b = 0; b < count; ++b) {
+		const SsaBlock *block = &func->blocks[b];
+		int phis = 1;
+		
+		for (unsigned int pos = 0; pos < vecLen(block->instrs); ++pos) {
+			unsigned int id = block->instrs[pos];
+			
+			if (id >= vecLen(func->instrs) || owner[id] != SSA_NONE || func->instrs[id].block != b) {
+				report(errors, err, func, b, id, "instruction is not owned by its block");
+				continue;
+			}
+			
+			owner[id] = b;
+			
+			if (func->instrs[id].op != SSA_PHI) {
+				phis = 0;
+			} else if (!phis) {
+				report(errors, err, func, b, id, "phi after other instructions");
+			}
+			
+			verifyInstr(prog, func, idom, b, pos, errors, err);
+		}
+		
+		if (block->term == SSA_BRANCH && !checkOperand(func, idom, block->value, TYPE_BOOL, b, SSA_NONE)) {
+			report(errors, err, func, b, SSA_NONE, "invalid branch condition");
+		}
+		
+		if (block->term == SSA_RETURN) {
+			if (func->return_type == TYPE_VOID
+				? block->value != SSA_NONE
+				: !checkOperand(func, idom, block->value, func->return_type, b, SSA_NONE)) {
+				report(errors, err, func, b, SSA_NONE, "invalid return value");
+			}
+		}
+	}
+	
+	free(owner);
+	vecRelease(idom);
+}
+
+/**
+ * @internal
+ * @brief Führt eine Funktion mit dem Referenzauswerter aus.
+ *
+ * Alle φ-Funktionen eines Blocks werden gleichzeitig ausgewertet, so dass sie
+ * die Werte der vorherigen Iteration lesen.
+ */
+static Value evalFunc(SsaEval *self, const SsaFunc *func, const Value *params) {
+	unsigned int count = vecLen(func->instrs);
+	Value *values = allocate((2*count + 1)*sizeof(Value));
+	Value *phis = values + count;
+	unsigned int block = 0, prev = SSA_NONE;
+	Value result = { .f = 0 };
+	
+/* Hilfsmakros für Operationen */
+#define ARG(N) values[instr->args[N]]
+#define ARITH_I(OP) \
+	values[id].i = (int) ((unsigned int) ARG(0).i OP (unsigned int) ARG(1).i); \
+	break;
+#define BINARY(DST, SRC, OP) \
+	values[id].DST = ARG(0).SRC OP ARG(1).SRC; \
+	break;
+	
+	for (;;) {
+		const SsaBlock *b = &func->blocks[block];
+		unsigned int pred = 0, pos = 0;
+		
+		if (prev != SSA_NONE) {
+			while (b->preds[pred] != prev) { ++pred; }
+		}
+		
+		for (; pos < vecLen(b->instrs) && func->instrs[b->instrs[pos]].op == SSA_PHI; ++pos) {
+			phis[pos] = values[func->instrs[b->instrs[pos]].args[pred]];
+		}
+		
+		for (unsigned int i = 0; i < pos; ++i) {
+			values[b->instrs[i]] = phis[i];
+		}
+		
+		for (; pos < vecLen(b->instrs); ++pos) {
+			unsigned int id = b->instrs[pos];
+			const SsaInstr *instr = &func->instrs[id];
+			
+			switch (instr->op) {
+			case SSA_NOP:
+			case SSA_PHI:
+				break;
+				
+			case SSA_CONST:
+				values[id] = instr->value;
+				break;
+				
+			case SSA_UNDEF:
+				values[id] = (Value) { .f = 0 };
+				break;
+				
+			case SSA_PARAM:
+				values[id] = params[instr->index];
+				break;
+				
+			case SSA_LOAD_GLOBAL:
+				values[id] = self->globals[self->prog->defs[instr->index].var.offset];
+				break;
+				
+			case SSA_STORE_GLOBAL:
+				self->globals[self->prog->defs[instr->index].var.offset] = ARG(0);
+				break;
+				
+			case SSA_CALL: {
+				unsigned int argc = vecLen(instr->args);
+				Value *args = allocate((argc + 1)*sizeof(Value));
+				
+				for (unsigned int i = 0; i < argc; ++i) {
+					args[i] = ARG(i);
+				}
+				
+				values[id] = evalFunc(self, &self->prog->funcs[instr->index], args);
+				free(args);
+				break;
+			}
+			
+			case SSA_PRINT:
+				interpValuePrint(ARG(0), func->instrs[instr->args[0]].type, self->out);
+				break;
+				
+			case SSA_NEWLINE:
+				outChar(self->out, '\n');
+				break;
+				
+			case SSA_I2F:   values[id].f = ARG(0).i; break;
+			case SSA_NEG_I: values[id].i = (int) -(unsigned int) ARG(0).i; break;
+			case SSA_NEG_F: values[id].f = -ARG(0).f; break;
+			case SSA_ADD_I: ARITH_I(+)
+			case SSA_SUB_I: ARITH_I(-)
+			case SSA_MUL_I: ARITH_I(*)
+			case SSA_DIV_I: BINARY(i, i, /)
+			case SSA_ADD_F: BINARY(f, f, +)
+			case SSA_SUB_F: BINARY(f, f, -)
+			case SSA_MUL_F: BINARY(f, f, *)
+			case SSA_DIV_F: BINARY(f, f, /)
+			case SSA_EQ_I:  BINARY(i, i, ==)
+			case SSA_NEQ_I: BINARY(i, i, !=)
+			case SSA_LT_I:  BINARY(i, i, <)
+			case SSA_GT_I:  BINARY(i, i, >)
+			case SSA_LEQ_I: BINARY(i, i, <=)
+			case SSA_GEQ_I: BINARY(i, i, >=)
+			case SSA_EQ_F:  BINARY(i, f, ==)
+			case SSA_NEQ_F: BINARY(i, f, !=)
+			case SSA_LT_F:  BINARY(i, f, <)
+			case SSA_GT_F:  BINARY(i, f, >)
+			case SSA_LEQ_F: BINARY(i, f, <=)
+			case SSA_GEQ_F: BINARY(i, f, >=)
+			case SSA_EQ_B:  BINARY(i, i, ==)
+			case SSA_NEQ_B: BINARY(i, i, !=)
+			case SSA_LT_B:  BINARY(i, i, <)
+			case SSA_GT_B:  BINARY(i, i, >)
+			case SSA_LEQ_B: BINARY(i, i, <=)
+			case SSA_GEQ_B: BINARY(i, i, >=)
+			
+			case SSA_OP_COUNT:
+				assert(0);
+				break;
+			}
+		}
+		
+		prev = block;
+		
+		switch (b->term) {
+		case SSA_JUMP:
+			block = b->succ[0];
+			break;
+			
+		case SSA_BRANCH:
+			block = values[b->value].i ? b->succ[0] : b->succ[1];
+			break;
+			
+		case SSA_RETURN:
+			if (b->value != SSA_NONE) { result = values[b->value]; }
+			free(values);
+			return result;
+		}
+	}
+	
+#undef ARG
+#undef ARITH_I
+#undef BINARY
+}
+
+/* *** implementation ******************************************************* */
+
+SsaProgram ssaBuild(const Program *ast, const SymDefTable *tab) {
+	SsaProgram self = {
+		.defs = tab->definitions,
+		.global_count = tab->global_count,
+		.main_func = tab->main_func,
+		.init = { .name = "<init>", .return_type = TYPE_VOID }
+	};
+	
+	for (unsigned int i = 0; i < vecLen(tab->definitions); ++i) {
+		const DefInfo *def = &tab->definitions[i];
+		SsaFunc *func = &vecPush(self.funcs);
+		*func = (SsaFunc) { .name = internName(def->ident) };
+		
+		if (def->tag == SYM_DEF_FUNC) {
+			func->return_type = def->func.return_type;
+			func->param_count = def->func.param_count;
+		}
+	}
+	
+	for (unsigned int i = 0; i < vecLen(tab->definitions); ++i) {
+		const DefInfo *def = &tab->definitions[i];
+		
+		if (def->tag == SYM_DEF_FUNC) {
+			const FuncDef *func_def = &ast->items[def->func.item_id.index].func_def;
+			buildFunc(&self.funcs[i], self.defs, &def->func, func_def->statements, ast);
+		}
+	}
+	
+	buildFunc(&self.init, self.defs, NULL, NULL, ast);
+	return self;
+}
+
+void ssaProgramPrint(const SsaProgram *self, FILE *out) {
+	funcPrint(self, &self->init, out);
+	
+	vecForEach(const SsaFunc *func, self->funcs) {
+		if (func->blocks != NULL) {
+			fputc('\n', out);
+			funcPrint(self, func, out);
+		}
+	}
+}
+
+unsigned int ssaVerify(const SsaProgram *self, FILE *err) {
+	unsigned int errors = 0;
+	
+	verifyFunc(self, &self->init, &errors, err);
+	
+	for (unsigned int i = 0; i < vecLen(self->funcs); ++i) {
+		if (self->defs[i].tag == SYM_DEF_FUNC) {
+			verifyFunc(self, &self->funcs[i], &errors, err);
+		}
+	}
+	
+	return errors;
+}
+
+void ssaRun(const SsaProgram *self, Out *out) {
+	SsaEval eval = {
+		.prog = self,
+		.globals = calloc(self->global_count + 1, sizeof(Value)),
+		.out = out
+	};
+	
+	if (eval.globals == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	evalFunc(&eval, &self->init, NULL);
+	evalFunc(&eval, &self->funcs[self->main_func.index], NULL);
+	free(eval.globals);
+}
+
+void ssaRelease(SsaProgram *self) {
+	vecForEach(SsaFunc *func, self->funcs) {
+		funcRelease(func);
+	}
+	
+	funcRelease(&self->init);
+	vecRelease(self->funcs);
+	self->funcs = NULL;
+}
+
+unsigned int* ssaReversePostorder(const SsaFunc *func) {
+	unsigned int *order = NULL;
+	unsigned char *visited = calloc(vecLen(func->blocks) + 1, 1);
+	
+	if (visited == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	postorder(func, 0, visited, &order);
+	free(visited);
+	
+	for (unsigned int i = 0, j = vecLen(order) - 1; i < j; ++i, --j) {
+		unsigned int tmp = order[i];
+		order[i] = order[j];
+		order[j] = tmp;
+	}
+	
+	return order;
+}
+
+unsigned int* ssaDominators(const SsaFunc *func) {
+	unsigned int count = vecLen(func->blocks);
+	unsigned int *order = ssaReversePostorder(func);
+	unsigned int *rank = allocate((count + 1)*sizeof(unsigned int));
+	unsigned int *idom = NULL;
+	
+	for (unsigned int b = 0; b < count; ++b) {
+		vecPush(idom) = SSA_NONE;
+		rank[b] = SSA_NONE;
+	}
+	
+	for (unsigned int i = 0; i < vecLen(order); ++i) {
+		rank[order[i]] = i;
+	}
+	
+	/* Cooper, Harvey and Kennedy: "A Simple, Fast Dominance Algorithm" */
+	idom[0] = 0;
+	int changed = 1;
+	
+	while (changed) {
+		changed = 0;
+		
+		for (unsigned int i = 1; i < vecLen(order); ++i) {
+			unsigned int b = order[i];
+			unsigned int next = SSA_NONE;
+			
+			vecForEach(const unsigned int *pred, func->blocks[b].preds) {
+				unsigned int p = *pred;
+				if (idom[p] == SSA_NONE) { continue; }
+				
+				if (next == SSA_NONE) {
+					next = p;
+					continue;
+				}
+				
+				/* intersect both paths towards the entry block */
+				unsigned int a = p;
+				while (a != next) {
+					while (rank[a] > rank[next]) { a = idom[a]; }
+					while (rank[next] > rank[a]) { next = idom[next]; }
+				}
+			}
+			
+			if (idom[b] != next) {
+				idom[b] = next;
+				changed = 1;
+			}
+		}
+	}
+	
+	free(rank);
+	vecRelease(order);
+	return idom;
+}
+
+int ssaDominates(const unsigned int *idom, unsigned int a, unsigned int b) {
+	if (idom[b] == SSA_NONE) { return 0; }
+	
+	while (b != a && b != 0) {
+		b = idom[b];
+	}
+	
+	return b == a;
+}
+
+unsigned int ssaRemoveTrivialPhis(SsaFunc *func) {
+	unsigned int count = vecLen(func->instrs);
+	unsigned int *forward = allocate((count + 1)*sizeof(unsigned int));
+	unsigned int removed = 0;
+	int changed = 1;
+	
+	for (unsigned int i = 0; i < count; ++i) {
+		forward[i] = i;
+	}
+	
+	while (changed) {
+		changed = 0;
+		
+		vecForEach(SsaBlock *block, func->blocks) {
+			for (unsigned int pos = 0; pos < vecLen(block->instrs); ++pos) {
+				unsigned int id = block->instrs[pos];
+				SsaInstr *phi = &func->instrs[id];
+				unsigned int same = SSA_NONE;
+				int trivial = 1;
+				
+				if (phi->op != SSA_PHI) { break; }
+				
+				vecForEach(const unsigned int *arg, phi->args) {
+					unsigned int value = resolve(forward, *arg);
+					if (value == same || value == id) { continue; }
+					
+					if (same != SSA_NONE) {
+						trivial = 0;
+						break;
+					}
+					
+					same = value;
+				}
+				
+				if (!trivial) { continue; }
+				
+				vecRelease(phi->args);
+				phi->args = NULL;
+				blockRemove(block, pos--);
+				
+				if (same == SSA_NONE) {
+					/* only reachable through itself, i.e. never initialized */
+					phi->op = SSA_UNDEF;
+					blockInsert(block, phiCount(func, block), id);
+				} else {
+					phi->op = SSA_NOP;
+					forward[id] = same;
+				}
+				
+				++removed;
+				changed = 1;
+			}
+		}
+	}
+	
+	vecForEach(SsaInstr *instr, func->instrs) {
+		vecForEach(unsigned int *arg, instr->args) {
+			*arg = resolve(forward, *arg);
+		}
+	}
+	
+	vecForEach(SsaBlock *block, func->blocks) {
+		if (block->term != SSA_JUMP && block->value != SSA_NONE) {
+			block->value = resolve(forward, block->value);
+		}
+	}
+	
+	free(forward);
+	return removed;
+}
@@ -0,0 +1,253 @@
+/***************************************************************************//**
+ * @file ssa.h
+ * @brief Zwischendarstellung in SSA-Form für C1-Programme.
+ *
+ * # Überblick
+ *
+ * Jede Funktion wird in einen Kontrollflussgraphen aus Grundblöcken übersetzt,
+ * deren Instruktionen in *Static Single Assignment*-Form vorliegen: Jede
+ * Instruktion definiert höchstens einen Wert, der über ihre Nummer
+ * referenziert wird und nie wieder überschrieben wird.
+ *
+ * - Die Kontrollstrukturen `if`, `while`, `do while` und `for` sowie die
+ *   Kurzschlussauswertung von `&&` und `||` werden zu expliziten Sprüngen
+ *   zwischen Blöcken. Jeder Block endet mit genau einem Sprung, einer
+ *   Verzweigung oder einer Rückkehr (`SsaTerm`).
+ * - Lokale Variablen existieren nur während der Konstruktion: Jeder Zugriff
+ *   wird durch den zuletzt zugewiesenen Wert ersetzt, an Zusammenflüssen
+ *   entstehen φ-Funktionen (`SSA_PHI`), die die `DefId` ihrer Variablen
+ *   tragen. Die Konstruktion folgt Braun et al., *Simple and Efficient
+ *   Construction of Static Single Assignment Form* (2013).
+ * - Globale Variablen bleiben Speicherzellen und werden über `SSA_LOAD_GLOBAL`
+ *   und `SSA_STORE_GLOBAL` mit ihrer `DefId` angesprochen, da sie von jedem
+ *   Funktionsaufruf verändert werden können.
+ * - Jeder Wert trägt seinen `DataType`; die Operationen sind wie im Bytecode
+ *   nach dem Datentyp ihrer Operanden spezialisiert, implizite Umwandlungen
+ *   sind als `SSA_I2F` explizit.
+ *
+ * Zur Darstellung gehören eine Textausgabe (`ssaProgramPrint()`), eine
+ * Prüfung der Invarianten (`ssaVerify()`) und ein Referenzauswerter
+ * (`ssaRun()`), an dem Optimierungen gegen die erwarteten Ausgaben der
+ * Testprogramme geprüft werden können.
+ ******************************************************************************/
+
+#ifndef SSA_H_INCLUDED
+#define SSA_H_INCLUDED
+
+/* *** Includes ************************************************************* */
+
+#include <stdio.h>
+#include "ast.h"
+#include "symtab.h"
+#include "interp.h"
+
+/* *** Konstanten *********************************************************** */
+
+/** @brief Nummer für einen fehlenden Wert oder Block. */
+#define SSA_NONE ((unsigned int) -1)
+
+/* *** Strukturen *********************************************************** */
+
+/**
+ * @brief Die Operationen der SSA-Instruktionen.
+ *
+ * Die Suffixe `_I`, `_F` und `_B` geben den Datentyp der Operanden an. Die
+ * arithmetischen Operationen und Vergleiche stehen in derselben Reihenfolge
+ * wie in `BinOp`.
+ */
+typedef enum SsaOp {
+	SSA_NOP,          /**<@brief Entfernte Instruktion. */
+	SSA_CONST,        /**<@brief Die Konstante `value`. */
+	SSA_UNDEF,        /**<@brief Wert einer nicht initialisierten Variablen (`0`). */
+	SSA_PARAM,        /**<@brief Der Parameter mit der Nummer `index`. */
+	SSA_PHI,          /**<@brief `args[i]`, falls aus `preds[i]` gesprungen wurde. */
+	SSA_LOAD_GLOBAL,  /**<@brief Lädt die globale Variable mit der `DefId` `index`. */
+	SSA_STORE_GLOBAL, /**<@brief Speichert `args[0]` in die globale Variable `index`. */
+	SSA_CALL,         /**<@brief Ruft die Funktion mit der `DefId` `index` auf. */
+	SSA_PRINT,        /**<@brief Gibt `args[0]` aus. */
+	SSA_NEWLINE,      /**<@brief Beendet die Ausgabe einer `print`-Anweisung. */
+	SSA_I2F,
+	SSA_NEG_I,
+	SSA_NEG_F,
+	SSA_ADD_I,
+	SSA_SUB_I,
+	SSA_MUL_I,
+	SSA_DIV_I,
+	SSA_ADD_F,
+	SSA_SUB_F,
+	SSA_MUL_F,
+	SSA_DIV_F,
+	SSA_EQ_I,
+	SSA_NEQ_I,
+	SSA_LT_I,
+	SSA_GT_I,
+	SSA_LEQ_I,
+	SSA_GEQ_I,
+	SSA_EQ_F,
+	SSA_NEQ_F,
+	SSA_LT_F,
+	SSA_GT_F,
+	SSA_LEQ_F,
+	SSA_GEQ_F,
+	SSA_EQ_B,
+	SSA_NEQ_B,
+	SSA_LT_B,
+	SSA_GT_B,
+	SSA_LEQ_B,
+	SSA_GEQ_B,
+	SSA_OP_COUNT      /**<@brief Anzahl der Operationen. */
+} SsaOp;
+
+/**
+ * @brief Eine Instruktion, die zugleich den von ihr definierten Wert
+ * darstellt.
+ */
+typedef struct SsaInstr {
+	SsaOp op;           /**<@brief Die Operation. */
+	DataType type;      /**<@brief Typ des Ergebnisses, `TYPE_VOID` ohne Ergebnis. */
+	unsigned int block; /**<@brief Der Block, der die Instruktion enthält. */
+
+	union {
+		Value value;        /**<@brief Wert für `SSA_CONST`. */
+		unsigned int index; /**<@brief Parameternummer oder `DefId` einer Variablen bzw. Funktion. */
+	};
+
+	unsigned int *args; /**<@brief Vektor der Operanden. */
+} SsaInstr;
+
+/**
+ * @brief Die Arten, einen Block zu verlassen.
+ */
+typedef enum SsaTerm {
+	SSA_JUMP,   /**<@brief Sprung nach `succ[0]`. */
+	SSA_BRANCH, /**<@brief Sprung nach `succ[0]`, falls `value` wahr ist, sonst nach `succ[1]`. */
+	SSA_RETURN  /**<@brief Rückkehr mit `value` oder `SSA_NONE` ohne Rückgabewert. */
+} SsaTerm;
+
+/**
+ * @brief Ein Grundblock.
+ *
+ * Jede Kante zwischen zwei Blöcken erscheint genau einmal in `preds` ihres
+ * Ziels; die Reihenfolge von `preds` bestimmt die der Operanden aller
+ * φ-Funktionen des Blocks.
+ */
+typedef struct SsaBlock {
+	unsigned int *instrs; /**<@brief Vektor der Instruktionen, φ-Funktionen zuerst. */
+	unsigned int *preds;  /**<@brief Vektor der Vorgängerblöcke. */
+	SsaTerm term;         /**<@brief Wie der Block verlassen wird. */
+	unsigned int value;   /**<@brief Bedingung bzw. Rückgabewert. */
+	unsigned int succ[2]; /**<@brief Die Nachfolgerblöcke. */
+} SsaBlock;
+
+/**
+ * @brief Eine Funktion in SSA-Form.
+ */
+typedef struct SsaFunc {
+	const char *name;         /**<@brief Name der Funktion. */
+	DataType return_type;     /**<@brief Rückgabetyp der Funktion. */
+	unsigned int param_count; /**<@brief Anzahl der Parameter. */
+	SsaInstr *instrs;         /**<@brief Vektor aller Instruktionen, indiziert durch ihre Nummer. */
+	SsaBlock *blocks;         /**<@brief Vektor der Blöcke; Block 0 ist der Eintrittsblock. */
+} SsaFunc;
+
+/**
+ * @brief Ein Programm in SSA-Form.
+ */
+typedef struct SsaProgram {
+	SsaFunc *funcs;            /**<@brief Funktionen, indiziert durch `DefId`; leer für Variablen. */
+	SsaFunc init;              /**<@brief Initialisierung der globalen Variablen. */
+	const DefInfo *defs;       /**<@brief Die Definitionstabelle des Programms. */
+	unsigned int global_count; /**<@brief Anzahl globaler Variablen. */
+	DefId main_func;           /**<@brief `DefId` der Funktion `main()`. */
+} SsaProgram;
+
+/* *** Öffentliche Schnittstelle ******************************************** */
+
+/**
+ * @brief Die Namen der Operationen für die Textausgabe.
+ */
+extern const char *SSA_OP_NAMES[SSA_OP_COUNT];
+
+/**
+ * @brief Übersetzt ein semantisch analysiertes Programm in SSA-Form.
+ *
+ * Die Definitionstabelle und der Syntaxbaum (für Zeichenkettenkonstanten)
+ * müssen mindestens so lange leben wie das Ergebnis.
+ *
+ * @param ast Die Wurzel des abstrakten Syntaxbaumes.
+ * @param tab Die Definitionstabelle des Programms.
+ * @return Das übersetzte Programm.
+ */
+extern SsaProgram ssaBuild(const Program *ast, const SymDefTable *tab);
+
+/**
+ * @brief Gibt ein Programm in Textform aus.
+ * @param self Das auszugebende Programm.
+ * @param out  Der Ausgabestrom.
+ */
+extern void ssaProgramPrint(const SsaProgram *self, FILE *out);
+
+/**
+ * @brief Prüft die Invarianten eines Programms.
+ *
+ * Geprüft werden die Konsistenz von Kanten und Vorgängern, die Stellung und
+ * Stelligkeit der φ-Funktionen, die Datentypen aller Operanden sowie, dass
+ * jede Definition ihre Verwendungen dominiert.
+ *
+ * @param self Das zu prüfende Programm.
+ * @param err  Der Ausgabestrom für Fehlermeldungen.
+ * @return Die Anzahl der gefundenen Fehler.
+ */
+extern unsigned int ssaVerify(const SsaProgram *self, FILE *err);
+
+/**
+ * @brief Führt ein Programm mit dem Referenzauswerter aus.
+ * @param self Das auszuführende Programm.
+ * @param out  Der Ausgabepuffer für die `print`-Anweisung.
+ */
+extern void ssaRun(const SsaProgram *self, Out *out);
+
+/**
+ * @brief Gibt den Speicher eines Programms frei.
+ * @param self Das freizugebende Programm.
+ */
+extern void ssaRelease(SsaProgram *self);
+
+/**
+ * @brief Berechnet die Blöcke einer Funktion in umgekehrter Postordnung.
+ *
+ * Vom Eintrittsblock aus nicht erreichbare Blöcke sind nicht enthalten.
+ *
+ * @param func Die Funktion.
+ * @return Ein Vektor von Blocknummern, der vom Rufer freizugeben ist.
+ */
+extern unsigned int* ssaReversePostorder(const SsaFunc *func);
+
+/**
+ * @brief Berechnet die unmittelbaren Dominatoren aller Blöcke.
+ *
+ * @param func Die Funktion.
+ * @return Ein Vektor, der für jeden Block seinen unmittelbaren Dominator
+ *         enthält; `0` für den Eintrittsblock und `SSA_NONE` für nicht
+ *         erreichbare Blöcke. Der Vektor ist vom Rufer freizugeben.
+ */
+extern unsigned int* ssaDominators(const SsaFunc *func);
+
+/**
+ * @brief Gibt zurück, ob Block \p a den Block \p b dominiert.
+ * @param idom Die unmittelbaren Dominatoren aus `ssaDominators()`.
+ * @param a    Der dominierende Block.
+ * @param b    Der dominierte Block.
+ */
+extern int ssaDominates(const unsigned int *idom, unsigned int a, unsigned int b);
+
+/**
+ * @brief Entfernt φ-Funktionen, deren Operanden bis auf sie selbst
+ * übereinstimmen, und ersetzt ihre Verwendungen.
+ *
+ * @param func Die zu vereinfachende Funktion.
+ * @return Die Anzahl der entfernten φ-Funktionen.
+ */
+extern unsigned int ssaRemoveTrivialPhis(SsaFunc *func);
+
+#endif
@@ -5,7 +5,6 @@
  ******************************************************************************/
 
 #include <stdlib.h>
-#include <string.h>
 #include <limits.h>
 #include <assert.h>
 #include "symtab.h"
@@ -64,11 +63,11 @@
 } while (0)
 
 /**
- * Makro zur Ausgabe von Strukturfeldern mit Zeigertyp.
+ * Makro zur Ausgabe von Strukturfeldern mit Bezeichnertyp.
  */
-#define STR_FIELD(NAME) do {                                                   \
-	fprintf(out, "%s\n%*s." #NAME " = \"%s\"", sep, indent*4, "", self->NAME); \
-	sep = ",";                                                                 \
+#define IDENT_FIELD(NAME) do {                                                             \
+	fprintf(out, "%s\n%*s." #NAME " = \"%s\"", sep, indent*4, "", internName(self->NAME)); \
+	sep = ",";                                                                             \
 } while (0)
 
 /**
@@ -96,21 +95,21 @@ void defInfoPrint(
 	switch (self->tag) {
 	case SYM_DEF_FUNC:
 		CHOICE(Func, {
-			fprintf(out, "\"%s\", ", self->ident);
+			fprintf(out, "\"%s\", ", internName(self->ident));
 			funcInfoPrint(&self->func, definitions, indent, out);
 		});
 		break;
 		
 	case SYM_DEF_GLOBAL_VAR:
 		CHOICE(GlobalVar, {
-			fprintf(out, "\"%s\", ", self->ident);
+			fprintf(out, "\"%s\", ", internName(self->ident));
 			symVarPrint(&self->var, definitions, indent, out);
 		});
 		break;
 		
 	case SYM_DEF_LOCAL_VAR:
 		CHOICE(LocalVar, {
-			fprintf(out, "\"%s\", ", self->ident);
+			fprintf(out, "\"%s\", ", internName(self->ident));
 			symVarPrint(&self->var, definitions, indent, out);
 		});
 		break;
@@ -153,7 +152,7 @@ void symVarPrint(
 
 void symbolPrint(const SymtabSymbol* self, const DefInfo* definitions, unsigned int indent, FILE* out) {
 	STRUCT(SymtabSymbol, {
-		STR_FIELD(ident);
+		IDENT_FIELD(ident);
 		
 		if (self->prev_record != -1u) {
 			INT_FIELD(prev_record);
@@ -170,8 +169,6 @@ static void symDefVecRelease(DefInfo *self) {
 		if (def->tag == SYM_DEF_FUNC) {
 			vecRelease(def->func.local_vars);
 		}
-		
-		free(def->ident);
 	}
 	
 	vecRelease(self);
@@ -206,24 +203,6 @@ static DefId define(Symtab *self, DefInfo def) {
 	return def_id;
 }
 
-/**
- * @internal
- * @brief Dupliziert eine Zeichenkette und gibt einen Zeiger auf die Kopie
- * zurück.
- */
-static char* stringDup(const char *str) {
-	size_t len = strlen(str);
-	char *mem = malloc(len + 1);
-	
-	if (mem == NULL) {
-		fputs("out-of-memory error", stderr);
-		exit(-1);
-	}
-	
-	memcpy(mem, str, len + 1);
-	return mem;
-}
-
 /* *** implementation ******************************************************* */
 
 /* ****** Symbol Table ****************************************************** */
@@ -250,12 +229,12 @@ void symtabRelease(Symtab *self) {
 	vecRelease(self->vars_in_scope);
 }
 
-bool symtabDefineFunc(Symtab *self, const char *ident, DataType return_type) {
+bool symtabDefineFunc(Symtab *self, Ident ident, DataType return_type) {
 	assert(isGlobalScope(self));
 	
 	DefInfo def = {
 		.tag = SYM_DEF_FUNC,
-		.ident = stringDup(ident),
+		.ident = ident,
 		.func = {
 			.item_id = INVALID_ITEM_ID,
 			.return_type = return_type
@@ -265,14 +244,13 @@ bool symtabDefineFunc(Symtab *self, const char *ident, DataType return_type) {
 	self->current_func = define(self, def);
 	if (defIdIsInvalid(self->current_func)) {
 		vecRelease(def.func.local_vars);
-		free(def.ident);
 		return false;
 	}
 	
 	return true;
 }
 
-bool symtabDefineParam(Symtab *self, const char *ident, DataType data_type) {
+bool symtabDefineParam(Symtab *self, Ident ident, DataType data_type) {
 	assert(!isGlobalScope(self));
 	if (defIdIsInvalid(symtabDefineVar(self, ident, data_type)))
 		return false;
@@ -281,7 +259,7 @@ bool symtabDefineParam(Symtab *self, const char *ident, DataType data_type) {
 	return true;
 }
 
-DefId symtabDefineVar(Symtab *self, const char *ident, DataType data_type) {
+DefId symtabDefineVar(Symtab *self, Ident ident, DataType data_type) {
 	/* set the kind of variable and calculate the offset into the stack */
 	unsigned int offset;
 	int tag;
@@ -297,7 +275,7 @@ DefId symtabDefineVar(Symtab *self, const char *ident, DataType data_type) {
 	/* prepare the variable definition */
 	DefInfo def = {
 		.tag = tag,
-		.ident = stringDup(ident),
+		.ident = ident,
 		.var = { .data_type = data_type, .offset = offset }
 	};
 	
@@ -306,7 +284,6 @@ DefId symtabDefineVar(Symtab *self, const char *ident, DataType data_type) {
 	
 	/* short-circuit in case of double declaration */
 	if (defIdIsInvalid(def_id)) {
-		free(def.ident);
 		return def_id;
 	}
 	
@@ -341,7 +318,7 @@ void symtabScopeLeave(Symtab *self) {
 	}
 }
 
-DefId symtabResolve(const Symtab *self, const char *ident) {
+DefId symtabResolve(const Symtab *self, Ident ident) {
 	unsigned int sym = dictGet(&self->map, ident);
 	if (sym == -1u) { return INVALID_DEF_ID; }
 	return self->decl[sym].def;
@@ -408,7 +385,7 @@ SymDefTable symDefTableNew(Symtab *tab, const Program *ast) {
 	SymDefTable result = {
 		.definitions = tab->definitions,
 		.global_count = tab->global_count,
-		.main_func = symtabResolve(tab, "main")
+		.main_func = symtabResolve(tab, internLiteral("main"))
 	};
 	
 	/* release the symbol definitions */
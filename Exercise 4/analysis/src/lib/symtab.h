@@ -74,7 +74,7 @@ typedef struct DefInfo {
 		SYM_DEF_GLOBAL_VAR /**<@brief Globale Variablendefinition. */
 	} tag;
 	
-	char *ident; /**<@brief Bezeichner des Elementes. */
+	Ident ident; /**<@brief Bezeichner des Elementes. */
 	
 	union {
 		FuncInfo func; /**<@brief Funktionsspezifische Informationen. */
@@ -100,7 +100,7 @@ typedef struct SymDefTable {
  * @brief Struktur eines Symbols in der Symboltabelle.
  */
 typedef struct SymtabSymbol {
-	const char *ident;        /**<@brief Bezeichner im Quellcode. */
+	Ident ident;              /**<@brief Bezeichner im Quellcode. */
 	unsigned int prev_record; /**<@brief Eintrag der Vorgängerdefinition. */
 	DefId def;                /**<@brief Index in die Definitionstabelle. */
 } SymtabSymbol;
@@ -154,7 +154,7 @@ extern void symtabRelease(Symtab *self);
  * @param return_type Der Rückgabetyp der Funktion.
  * @return `true`, wenn die Funktionsdefinition erfolgreich war, sonst `false`.
  */
-extern bool symtabDefineFunc(Symtab *self, const char *ident, DataType return_type);
+extern bool symtabDefineFunc(Symtab *self, Ident ident, DataType return_type);
 
 /**
  * @brief Definiert einen neuen Parameter einer Funktion in der Symboltabelle.
@@ -166,7 +166,7 @@ extern bool symtabDefineFunc(Symtab *self, const char *ident, DataType return_ty
  * @param data_type Der Datentyp des Parameters.
  * @return `true`, wenn die Parameterdefinition erfolgreich war, sonst `false`.
  */
-extern bool symtabDefineParam(Symtab *self, const char *ident, DataType data_type);
+extern bool symtabDefineParam(Symtab *self, Ident ident, DataType data_type);
 
 /**
  * @brief Definiert eine neue Variable in der Symboltabelle.
@@ -180,7 +180,7 @@ extern bool symtabDefineParam(Symtab *self, const char *ident, DataType data_typ
  * @return Die `DefId` der Variablen, wenn die Definition erfolgreich war,
  * sonst `INVALID_DEF_ID`.
  */
-extern DefId symtabDefineVar(Symtab *self, const char *ident, DataType data_type);
+extern DefId symtabDefineVar(Symtab *self, Ident ident, DataType data_type);
 
 /**
  * @brief Betritt einen neuen Sichtbarkeitsbereich.
@@ -202,7 +202,7 @@ extern void symtabScopeLeave(Symtab *self);
  * @return Die Definition des Bezeichners oder `INVALID_DEF_ID`, wenn der Bezeichner
  * nicht gefunden wurde.
  */
-extern DefId symtabResolve(const Symtab *self, const char *ident);
+extern DefId symtabResolve(const Symtab *self, Ident ident);
 
 /**
  * @brief Löst eine Definition anhand ihrer ID auf.
@@ -0,0 +1,125 @@
+/***************************************************************************//**
+ * @file vm.c
+ * @brief Implementation der Stackmaschine für C1-Bytecode.
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <assert.h>
+#include "vm.h"
+#include "vec.h"
+
+/* *** internal structures ************************************************** */
+
+/**
+ * @internal
+ * @brief Gibt an, ob die Ausführung mit berechneten Sprüngen übersetzt wird.
+ *
+ * Label-Adressen sind eine Erweiterung von GCC und Clang. Mit dem Makro
+ * `VM_NO_THREADING` lässt sich die Verteilung über `switch` erzwingen, etwa
+ * für Compiler, die nur striktes C11 unterstützen.
+ */
+#if defined(__GNUC__) && !defined(VM_NO_THREADING)
+	#define VM_THREADING 1
+#else
+	#define VM_THREADING 0
+#endif
+
+/**
+ * @internal
+ * @brief Eintrag des Aufrufstacks.
+ *
+ * Beide Felder sind Indizes, da der Wertestack beim Wachsen verschoben werden
+ * kann.
+ */
+typedef struct {
+	unsigned int pc; /**<@brief Index der Rücksprungadresse. */
+	unsigned int fp; /**<@brief Beginn des Frames des Rufers. */
+} Frame;
+
+#if VM_THREADING
+/**
+ * @internal
+ * @brief Eine in Handler-Adresse und Operand übersetzte Instruktion.
+ */
+typedef struct {
+	const void *handler; /**<@brief Adresse des Handlers für den Opcode. */
+	int arg;             /**<@brief Der Operand der Instruktion. */
+} ThreadedInstr;
+#endif
+
+/* *** internal helpers ***************************************************** */
+
+/**
+ * @internal
+ * @brief Reserviert Speicher, ohne im Fehlerfall zurückzukehren.
+ */
+static void* vmRealloc(void *ptr, size_t size) {
+	ptr = realloc(ptr, size);
+	
+	if (ptr == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	return ptr;
+}
+
+/* Verteilung über eine switch-Anweisung */
+#define VM_LOOP_NAME vmRunSwitch
+#define VM_LOOP_THREADED 0
+#define VM_LOOP_PROFILE 0
+#include "vmloop.h"
+#undef VM_LOOP_NAME
+#undef VM_LOOP_THREADED
+#undef VM_LOOP_PROFILE
+
+/* Verteilung über eine switch-Anweisung mit Zählung der Opcode-Paare */
+#define VM_LOOP_NAME vmRunProfile
+#define VM_LOOP_THREADED 0
+#define VM_LOOP_PROFILE 1
+#include "vmloop.h"
+#undef VM_LOOP_NAME
+#undef VM_LOOP_THREADED
+#undef VM_LOOP_PROFILE
+
+#if VM_THREADING
+/* Verteilung über berechnete Sprünge; die Warnungen von -pedantic über
+ * Label-Adressen sind hier beabsichtigt */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#define VM_LOOP_NAME vmRunThreaded
+#define VM_LOOP_THREADED 1
+#define VM_LOOP_PROFILE 0
+#include "vmloop.h"
+#undef VM_LOOP_NAME
+#undef VM_LOOP_THREADED
+#undef VM_LOOP_PROFILE
+#pragma GCC diagnostic pop
+#endif
+
+/* *** implementation ******************************************************* */
+
+int vmHasThreading(void) {
+	return VM_THREADING;
+}
+
+void vmRunWith(const Bytecode *bc, Out *out, VmStats *stats, VmDispatch dispatch) {
+	if (stats != NULL && stats->pairs != NULL) {
+		vmRunProfile(bc, out, stats);
+		return;
+	}
+	
+#if VM_THREADING
+	if (dispatch == VM_DISPATCH_THREADED) {
+		vmRunThreaded(bc, out, stats);
+		return;
+	}
+#else
+	(void) dispatch;
+#endif
+	vmRunSwitch(bc, out, stats);
+}
+
+void vmRun(const Bytecode *bc, Out *out, VmStats *stats) {
+	vmRunWith(bc, out, stats, VM_DISPATCH_THREADED);
+}
@@ -0,0 +1,91 @@
+/***************************************************************************//**
+ * @file vm.h
+ * @brief Schnittstelle der Stackmaschine für C1-Bytecode.
+ *
+ * # Überblick
+ *
+ * Die Stackmaschine führt den von `bcCompile()` erzeugten Bytecode aus. Alle
+ * Frames liegen in einem gemeinsamen, zusammenhängenden Wertestack: Ein Frame
+ * beginnt mit den Parametern der Funktion, gefolgt von den übrigen lokalen
+ * Variablen und dem Operandenstack. Rücksprungadressen werden getrennt davon
+ * in einem eigenen Aufrufstack verwaltet.
+ *
+ * Da der Übersetzer die maximale Tiefe des Operandenstacks jeder Funktion
+ * bestimmt, muss die Größe des Wertestacks nur beim Funktionsaufruf geprüft
+ * werden.
+ *
+ * Die Instruktionen werden entweder über eine `switch`-Anweisung oder, sofern
+ * der Compiler Label-Adressen unterstützt, über berechnete Sprünge verteilt
+ * (siehe `vmloop.h`).
+ ******************************************************************************/
+
+#ifndef VM_H_INCLUDED
+#define VM_H_INCLUDED
+
+/* *** Includes ************************************************************* */
+
+#include <stdio.h>
+#include "bytecode.h"
+#include "out.h"
+
+/* *** Strukturen *********************************************************** */
+
+/**
+ * @brief Laufzeitstatistik einer Ausführung.
+ */
+typedef struct VmStats {
+	unsigned long long dispatches; /**<@brief Anzahl ausgeführter Instruktionen. */
+	
+	/**
+	 * @brief Häufigkeiten aufeinanderfolgender Opcodes oder `NULL`.
+	 *
+	 * Ist das Feld gesetzt, muss es auf `OP_COUNT * OP_COUNT` Zähler zeigen.
+	 * Die Ausführung zählt dann für jede Instruktion `b` mit Vorgänger `a` den
+	 * Eintrag `pairs[a * OP_COUNT + b]` hoch und verwendet dafür unabhängig von
+	 * der gewählten Strategie die Verteilung über `switch`.
+	 */
+	unsigned long long *pairs;
+} VmStats;
+
+/**
+ * @brief Strategie zur Verteilung der Instruktionen.
+ */
+typedef enum VmDispatch {
+	VM_DISPATCH_SWITCH,  /**<@brief Portable Verteilung über `switch`. */
+	VM_DISPATCH_THREADED /**<@brief Berechnete Sprünge (direct threading). */
+} VmDispatch;
+
+/* *** Öffentliche Schnittstelle ******************************************** */
+
+/**
+ * @brief Führt ein übersetztes Programm aus.
+ *
+ * Es wird die schnellste verfügbare Verteilungsstrategie verwendet.
+ *
+ * @param bc    Der auszuführende Bytecode.
+ * @param out   Der Ausgabepuffer für die `print`-Anweisung.
+ * @param stats Nimmt die Laufzeitstatistik auf, falls nicht `NULL`.
+ */
+extern void vmRun(const Bytecode *bc, Out *out, VmStats *stats);
+
+/**
+ * @brief Führt ein übersetztes Programm mit der gewählten Verteilungsstrategie
+ * aus.
+ *
+ * Steht `VM_DISPATCH_THREADED` nicht zur Verfügung, wird stattdessen über
+ * `switch` verteilt.
+ *
+ * @param bc       Der auszuführende Bytecode.
+ * @param out      Der Ausgabepuffer für die `print`-Anweisung.
+ * @param stats    Nimmt die Laufzeitstatistik auf, falls nicht `NULL`.
+ * @param dispatch Die gewünschte Verteilungsstrategie.
+ */
+extern void vmRunWith(const Bytecode *bc, Out *out, VmStats *stats, VmDispatch dispatch);
+
+/**
+ * @brief Gibt zurück, ob berechnete Sprünge zur Verfügung stehen.
+ * @return 1, falls `VM_DISPATCH_THREADED` unterstützt wird, sonst 0.
+ */
+extern int vmHasThreading(void);
+
+#endif
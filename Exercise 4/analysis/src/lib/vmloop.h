@@ -0,0 +1,353 @@
+/***************************************************************************//**
+ * @file vmloop.h
+ * @brief Ausführungsschleife der Stackmaschine als Vorlage.
+ *
+ * # Überblick
+ *
+ * Diese Datei wird von `vm.c` für jede Verteilungsstrategie einmal
+ * eingebunden und erzeugt dabei eine Funktion namens `VM_LOOP_NAME`. Die
+ * Semantik der Instruktionen ist somit nur an einer Stelle beschrieben.
+ *
+ * - Ist `VM_LOOP_THREADED` gleich 0, wird jede Instruktion über eine
+ *   `switch`-Anweisung verteilt. Dies ist portables C11.
+ * - Andernfalls wird der Bytecode vor der Ausführung in ein Feld aus
+ *   Handler-Adressen und Operanden übersetzt. Jeder Handler springt über
+ *   `goto *` direkt zum Handler der nächsten Instruktion (*direct
+ *   threading*), so dass jede Instruktion einen eigenen indirekten Sprung
+ *   besitzt, den der Prozessor getrennt vorhersagen kann. Hierfür werden die
+ *   Erweiterungen von GCC bzw. Clang für Label-Adressen benötigt.
+ *
+ * Ist zusätzlich `VM_LOOP_PROFILE` gesetzt, zählt die `switch`-Variante jedes
+ * Paar aufeinanderfolgender Opcodes in `VmStats.pairs`.
+ ******************************************************************************/
+
+/* diese Datei besitzt absichtlich keinen Include-Guard */
+
+#if VM_LOOP_THREADED
+	#define CODE ThreadedInstr
+	#define OP(NAME) L_##NAME:
+	#define NEXT do { ins = pc++; ++dispatches; goto *ins->handler; } while (0)
+#else
+	#define CODE Instr
+	#define OP(NAME) case NAME:
+	#define NEXT break
+#endif
+
+/* Hilfsmakros für binäre Operationen auf den obersten beiden Einträgen */
+#define ARITH_I(OP) \
+	sp[-2].i = (int) ((unsigned int) sp[-2].i OP (unsigned int) sp[-1].i); --sp; NEXT
+#define BINARY(DST, SRC, OP) \
+	sp[-2].DST = sp[-2].SRC OP sp[-1].SRC; --sp; NEXT
+
+/* Hilfsmakro für den Vergleich einer lokalen Ganzzahl mit einem Literal */
+#define CMP_JUMP(OP) \
+	if (fp[ins->arg].i OP pc[0].arg) { pc = code + pc[1].arg; } else { pc += 2; } NEXT
+
+static void VM_LOOP_NAME(const Bytecode *bc, Out *out, VmStats *stats) {
+#if VM_LOOP_THREADED
+	static const void *const HANDLERS[OP_COUNT] = {
+		[OP_HALT]         = &&L_OP_HALT,
+		[OP_POP]          = &&L_OP_POP,
+		[OP_DUP]          = &&L_OP_DUP,
+		[OP_PUSH]         = &&L_OP_PUSH,
+		[OP_CONST]        = &&L_OP_CONST,
+		[OP_LOAD_LOCAL]   = &&L_OP_LOAD_LOCAL,
+		[OP_STORE_LOCAL]  = &&L_OP_STORE_LOCAL,
+		[OP_LOAD_GLOBAL]  = &&L_OP_LOAD_GLOBAL,
+		[OP_STORE_GLOBAL] = &&L_OP_STORE_GLOBAL,
+		[OP_I2F]          = &&L_OP_I2F,
+		[OP_NEG_I]        = &&L_OP_NEG_I,
+		[OP_NEG_F]        = &&L_OP_NEG_F,
+		[OP_ADD_I]        = &&L_OP_ADD_I,
+		[OP_SUB_I]        = &&L_OP_SUB_I,
+		[OP_MUL_I]        = &&L_OP_MUL_I,
+		[OP_DIV_I]        = &&L_OP_DIV_I,
+		[OP_ADD_F]        = &&L_OP_ADD_F,
+		[OP_SUB_F]        = &&L_OP_SUB_F,
+		[OP_MUL_F]        = &&L_OP_MUL_F,
+		[OP_DIV_F]        = &&L_OP_DIV_F,
+		[OP_EQ_I]         = &&L_OP_EQ_I,
+		[OP_NEQ_I]        = &&L_OP_NEQ_I,
+		[OP_LT_I]         = &&L_OP_LT_I,
+		[OP_GT_I]         = &&L_OP_GT_I,
+		[OP_LEQ_I]        = &&L_OP_LEQ_I,
+		[OP_GEQ_I]        = &&L_OP_GEQ_I,
+		[OP_EQ_F]         = &&L_OP_EQ_F,
+		[OP_NEQ_F]        = &&L_OP_NEQ_F,
+		[OP_LT_F]         = &&L_OP_LT_F,
+		[OP_GT_F]         = &&L_OP_GT_F,
+		[OP_LEQ_F]        = &&L_OP_LEQ_F,
+		[OP_GEQ_F]        = &&L_OP_GEQ_F,
+		[OP_JUMP]         = &&L_OP_JUMP,
+		[OP_JUMP_FALSE]   = &&L_OP_JUMP_FALSE,
+		[OP_JUMP_TRUE]    = &&L_OP_JUMP_TRUE,
+		[OP_OR]           = &&L_OP_OR,
+		[OP_AND]          = &&L_OP_AND,
+		[OP_CALL]         = &&L_OP_CALL,
+		[OP_RET]          = &&L_OP_RET,
+		[OP_RET_VAL]      = &&L_OP_RET_VAL,
+		[OP_PRINT_B]      = &&L_OP_PRINT_B,
+		[OP_PRINT_I]      = &&L_OP_PRINT_I,
+		[OP_PRINT_F]      = &&L_OP_PRINT_F,
+		[OP_PRINT_S]      = &&L_OP_PRINT_S,
+		[OP_PRINT_NL]     = &&L_OP_PRINT_NL,
+		[OP_JEQ_LK]       = &&L_OP_JEQ_LK,
+		[OP_JNEQ_LK]      = &&L_OP_JNEQ_LK,
+		[OP_JLT_LK]       = &&L_OP_JLT_LK,
+		[OP_JGT_LK]       = &&L_OP_JGT_LK,
+		[OP_JLEQ_LK]      = &&L_OP_JLEQ_LK,
+		[OP_JGEQ_LK]      = &&L_OP_JGEQ_LK,
+		[OP_ADD_LK]       = &&L_OP_ADD_LK,
+		[OP_LOAD_ADD_LK]  = &&L_OP_LOAD_ADD_LK,
+		[OP_LOAD_CALL]    = &&L_OP_LOAD_CALL,
+		[OP_EXT]          = &&L_OP_EXT,
+	};
+	
+	/* translate the opcodes into handler addresses */
+	ThreadedInstr *threaded = vmRealloc(NULL, (vecLen(bc->code) + 1)*sizeof(*threaded));
+	
+	for (unsigned int i = 0; i < vecLen(bc->code); ++i) {
+		assert(HANDLERS[bc->code[i].op] != NULL);
+		threaded[i] = (ThreadedInstr) { HANDLERS[bc->code[i].op], bc->code[i].arg };
+	}
+	
+	const CODE *code = threaded;
+#else
+	const CODE *code = bc->code;
+#endif
+	const CODE *pc = code + bc->entry;
+	const CODE *ins;
+	Value *globals = calloc(bc->global_count + 1, sizeof(Value));
+	size_t cap = bc->max_stack + 256;
+	Value *stack = vmRealloc(NULL, cap*sizeof(Value));
+	Value *fp = stack;
+	Value *sp = stack;
+	Frame *frames = NULL;
+	unsigned long long dispatches = 0;
+#if VM_LOOP_PROFILE
+	unsigned long long *pairs = stats->pairs;
+	Opcode prev = OP_COUNT;
+#endif
+	
+	if (globals == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+#if VM_LOOP_THREADED
+	NEXT;
+	{
+		{
+#else
+	for (;;) {
+		ins = pc++;
+		++dispatches;
+#if VM_LOOP_PROFILE
+		if (prev != OP_COUNT) { ++pairs[prev*OP_COUNT + ins->op]; }
+		prev = ins->op;
+#endif
+		
+		switch (ins->op) {
+#endif
+		OP(OP_HALT)
+			goto halt;
+			
+		OP(OP_POP)
+			--sp;
+			NEXT;
+			
+		OP(OP_DUP)
+			sp[0] = sp[-1];
+			++sp;
+			NEXT;
+			
+		OP(OP_PUSH)
+			(sp++)->i = ins->arg;
+			NEXT;
+			
+		OP(OP_CONST)
+			*sp++ = bc->consts[ins->arg];
+			NEXT;
+			
+		OP(OP_LOAD_LOCAL)
+			*sp++ = fp[ins->arg];
+			NEXT;
+			
+		OP(OP_STORE_LOCAL)
+			fp[ins->arg] = *--sp;
+			NEXT;
+			
+		OP(OP_LOAD_GLOBAL)
+			*sp++ = globals[ins->arg];
+			NEXT;
+			
+		OP(OP_STORE_GLOBAL)
+			globals[ins->arg] = *--sp;
+			NEXT;
+			
+		OP(OP_I2F)
+			sp[-1].f = sp[-1].i;
+			NEXT;
+			
+		OP(OP_NEG_I)
+			sp[-1].i = (int) (0u - (unsigned int) sp[-1].i);
+			NEXT;
+			
+		OP(OP_NEG_F)
+			sp[-1].f = -sp[-1].f;
+			NEXT;
+			
+		OP(OP_ADD_I) ARITH_I(+);
+		OP(OP_SUB_I) ARITH_I(-);
+		OP(OP_MUL_I) ARITH_I(*);
+		OP(OP_DIV_I) BINARY(i, i, /);
+		OP(OP_ADD_F) BINARY(f, f, +);
+		OP(OP_SUB_F) BINARY(f, f, -);
+		OP(OP_MUL_F) BINARY(f, f, *);
+		OP(OP_DIV_F) BINARY(f, f, /);
+		OP(OP_EQ_I)  BINARY(i, i, ==);
+		OP(OP_NEQ_I) BINARY(i, i, !=);
+		OP(OP_LT_I)  BINARY(i, i, <);
+		OP(OP_GT_I)  BINARY(i, i, >);
+		OP(OP_LEQ_I) BINARY(i, i, <=);
+		OP(OP_GEQ_I) BINARY(i, i, >=);
+		OP(OP_EQ_F)  BINARY(i, f, ==);
+		OP(OP_NEQ_F) BINARY(i, f, !=);
+		OP(OP_LT_F)  BINARY(i, f, <);
+		OP(OP_GT_F)  BINARY(i, f, >);
+		OP(OP_LEQ_F) BINARY(i, f, <=);
+		OP(OP_GEQ_F) BINARY(i, f, >=);
+		
+		OP(OP_JUMP)
+			pc = code + ins->arg;
+			NEXT;
+			
+		OP(OP_JUMP_FALSE)
+			if (!(--sp)->i) { pc = code + ins->arg; }
+			NEXT;
+			
+		OP(OP_JUMP_TRUE)
+			if ((--sp)->i) { pc = code + ins->arg; }
+			NEXT;
+			
+		OP(OP_OR)
+			if (sp[-1].i) { pc = code + ins->arg; } else { --sp; }
+			NEXT;
+			
+		OP(OP_AND)
+			if (!sp[-1].i) { pc = code + ins->arg; } else { --sp; }
+			NEXT;
+			
+		OP(OP_LOAD_CALL)
+			*sp++ = fp[ins->arg];
+			ins = pc++;
+			/* fall through: der OP_EXT-Eintrag enthält die gerufene Funktion */
+			
+		OP(OP_CALL) {
+			const BcFunc *func = &bc->funcs[ins->arg];
+			size_t base = (size_t) (sp - stack) - func->param_count;
+			
+			/* grow the value stack such that the whole frame fits */
+			if (base + func->frame_size + func->max_stack > cap) {
+				size_t frame = (size_t) (fp - stack);
+				
+				while (base + func->frame_size + func->max_stack > cap) {
+					cap *= 2;
+				}
+				
+				stack = vmRealloc(stack, cap*sizeof(Value));
+				fp = stack + frame;
+			}
+			
+			vecPush(frames) = (Frame) { pc - code, fp - stack };
+			fp = stack + base;
+			sp = fp + func->frame_size;
+			pc = code + func->entry;
+			NEXT;
+		}
+		
+		OP(OP_RET) {
+			Frame frame = vecPop(frames);
+			sp = fp;
+			fp = stack + frame.fp;
+			pc = code + frame.pc;
+			NEXT;
+		}
+		
+		OP(OP_RET_VAL) {
+			Frame frame = vecPop(frames);
+			*fp = sp[-1];
+			sp = fp + 1;
+			fp = stack + frame.fp;
+			pc = code + frame.pc;
+			NEXT;
+		}
+		
+		OP(OP_PRINT_B)
+			interpValuePrint(*--sp, TYPE_BOOL, out);
+			NEXT;
+			
+		OP(OP_PRINT_I)
+			interpValuePrint(*--sp, TYPE_INT, out);
+			NEXT;
+			
+		OP(OP_PRINT_F)
+			interpValuePrint(*--sp, TYPE_FLOAT, out);
+			NEXT;
+			
+		OP(OP_PRINT_S)
+			interpValuePrint(*--sp, TYPE_STRING, out);
+			NEXT;
+			
+		OP(OP_PRINT_NL)
+			outChar(out, '\n');
+			NEXT;
+			
+		OP(OP_JEQ_LK)  CMP_JUMP(==);
+		OP(OP_JNEQ_LK) CMP_JUMP(!=);
+		OP(OP_JLT_LK)  CMP_JUMP(<);
+		OP(OP_JGT_LK)  CMP_JUMP(>);
+		OP(OP_JLEQ_LK) CMP_JUMP(<=);
+		OP(OP_JGEQ_LK) CMP_JUMP(>=);
+		
+		OP(OP_ADD_LK)
+			fp[ins->arg].i = (int) ((unsigned int) fp[ins->arg].i + (unsigned int) pc->arg);
+			++pc;
+			NEXT;
+			
+		OP(OP_LOAD_ADD_LK)
+			(sp++)->i = (int) ((unsigned int) fp[ins->arg].i + (unsigned int) pc->arg);
+			++pc;
+			NEXT;
+			
+		OP(OP_EXT)
+			/* Operanden werden von ihrer Superinstruktion übersprungen */
+			assert(0);
+			goto halt;
+			
+#if !VM_LOOP_THREADED
+		case OP_COUNT:
+			break;
+#endif
+		}
+	}
+	
+halt:
+	if (stats != NULL) {
+		stats->dispatches = dispatches;
+	}
+	
+	vecRelease(frames);
+	free(stack);
+	free(globals);
+#if VM_LOOP_THREADED
+	free(threaded);
+#endif
+}
+
+#undef CODE
+#undef OP
+#undef NEXT
+#undef ARITH_I
+#undef BINARY
+#undef CMP_JUMP
@@ -1,34 +1,352 @@
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include <time.h>
 
 #include <parser.tab.h>
 #include <symtab.h>
+#include <interp.h>
+#include <vm.h>
+#include <regvm.h>
+#include <lower.h>
+#include <cgen.h>
+#include <asmgen.h>
+#include <ssa.h>
+#include <opt.h>
+#include <flow.h>
+#include <out.h>
+#include <scan.h>
 #include <ast.h>
 
 const int SEMANTIC_CHECK = 1;
 
+/* number of interpreted calls before a function is compiled by the JIT */
+#define JIT_THRESHOLD 10
+
+/* the files that the threads of --jobs parse and analyse */
+typedef struct {
+	const char **paths;   /* the input files */
+	ParseResult *results; /* the results in the order of the files, only tag and err are kept */
+	size_t count;         /* the number of files */
+	atomic_size_t next;   /* the first file that no thread has taken yet */
+} Batch;
+
+/* returns the current wall-clock time in milliseconds */
+static double now(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return ts.tv_sec*1e3 + ts.tv_nsec*1e-6;
+}
+
+/* executes the program with the selected engine */
+static int run(const char *engine, const Program *ast, const SymDefTable *tab, int stats, int fuse, unsigned int threshold, int checked, size_t buffer) {
+	Out out = outNew(stdout, buffer);
+	VmStats vm_stats = { 0 };
+	InterpStats interp_stats = { 0 };
+	int trapped = 0;
+	double start, end;
+	
+	outGuard(&out);
+	
+	if (strcmp(engine, "ast") == 0) {
+		start = now();
+		
+		if (checked) {
+			trapped = !interpRunChecked(ast, tab, &out, &interp_stats);
+		} else {
+			interpRunCounted(ast, tab, &out, &interp_stats);
+		}
+		
+		end = now();
+	} else if (strcmp(engine, "jit") == 0) {
+		start = now();
+		interpRunJit(ast, tab, &out, threshold);
+		end = now();
+	} else if (strcmp(engine, "vm") == 0) {
+		Bytecode bc = bcCompileWith(ast, tab, fuse);
+		start = now();
+		vmRun(&bc, &out, &vm_stats);
+		end = now();
+		bcRelease(&bc);
+	} else if (strcmp(engine, "reg") == 0) {
+		RegCode rc = regCompile(ast, tab);
+		start = now();
+		regRun(&rc, &out, &vm_stats);
+		end = now();
+		regRelease(&rc);
+	} else if (strcmp(engine, "typed") == 0) {
+		LowProgram low = lowerProgram(ast, tab);
+		start = now();
+		lowRun(&low, &out);
+		end = now();
+		lowRelease(&low);
+	} else if (strcmp(engine, "ssa") == 0) {
+		SsaProgram ssa = ssaBuild(ast, tab);
+		
+		if (ssaVerify(&ssa, stderr) > 0) {
+			ssaRelease(&ssa);
+			exit(EXIT_FAILURE);
+		}
+		
+		start = now();
+		ssaRun(&ssa, &out);
+		end = now();
+		ssaRelease(&ssa);
+	} else {
+		outRelease(&out);
+		return 0;
+	}
+	
+	outRelease(&out);
+	
+	if (stats) {
+		fprintf(stderr, "engine=%s ", engine);
+		
+		/* the bytecode engines count dispatches, the AST interpreter nodes and calls */
+		if (strcmp(engine, "vm") == 0 || strcmp(engine, "reg") == 0) {
+			fprintf(stderr, "dispatches=%llu ", vm_stats.dispatches);
+		} else if (strcmp(engine, "ast") == 0) {
+			fprintf(stderr, "evals=%llu calls=%llu tail_calls=%llu ", interp_stats.evals, interp_stats.calls, interp_stats.tail_calls);
+		}
+		
+		fprintf(stderr, "time=%.3fms\n", end - start);
+	}
+	
+	if (trapped) { exit(EXIT_FAILURE); }
+	return 1;
+}
+
+/* runs the unfused bytecode and prints the frequencies of adjacent opcodes */
+static void profile(const Program *ast, const SymDefTable *tab, size_t buffer) {
+	unsigned long long *pairs = calloc(OP_COUNT*OP_COUNT, sizeof(*pairs));
+	
+	if (pairs == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	VmStats vm_stats = { .pairs = pairs };
+	Bytecode bc = bcCompileWith(ast, tab, 0);
+	Out out = outNew(stdout, buffer);
+	outGuard(&out);
+	vmRun(&bc, &out, &vm_stats);
+	outRelease(&out);
+	
+	for (int i = 0; i < OP_COUNT*OP_COUNT; ++i) {
+		if (pairs[i] != 0) {
+			fprintf(stderr, "%s %s %llu\n", OPCODE_NAMES[i / OP_COUNT], OPCODE_NAMES[i % OP_COUNT], pairs[i]);
+		}
+	}
+	
+	bcRelease(&bc);
+	free(pairs);
+}
+
+/* takes files from the batch until none are left and parses and analyses them */
+static int analyseBatch(void *arg) {
+	Batch *batch = arg;
+	size_t i;
+	
+	while ((i = atomic_fetch_add(&batch->next, 1)) < batch->count) {
+		ParseResult result = astParseMapped(batch->paths[i]);
+		
+		if (result.tag == PARSE_OK) {
+			SymDefTable tab = symDefTableNew(&result.tab, &result.ok);
+			flowAnalyze(&result.ok, &tab);
+			astProgramRelease(&result.ok);
+			symDefTableRelease(&tab);
+		}
+		
+		batch->results[i] = result;
+	}
+	
+	return 0;
+}
+
+/* parses and analyses the files on the given number of threads and reports the results in input order */
+static int analyseFiles(const char **paths, size_t count, unsigned int jobs, int stats) {
+	Batch batch = { paths, calloc(count, sizeof(ParseResult)), count };
+	thrd_t *threads = calloc(jobs, sizeof(thrd_t));
+	unsigned int started = 0;
+	
+	if (batch.results == NULL || threads == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	atomic_init(&batch.next, 0);
+	double start = now();
+	
+	/* the main thread is the first worker; if a thread cannot be started, the others take its files */
+	while (started + 1 < jobs && started + 1 < count && thrd_create(&threads[started], analyseBatch, &batch) == thrd_success) {
+		++started;
+	}
+	
+	analyseBatch(&batch);
+	
+	for (unsigned int i = 0; i < started; ++i) {
+		thrd_join(threads[i], NULL);
+	}
+	
+	double end = now();
+	int failed = 0;
+	
+	for (size_t i = 0; i < count; ++i) {
+		if (batch.results[i].tag == PARSE_OK) {
+			printf("[✓] %s\n", paths[i]);
+		} else {
+			printf("[x] %s\n", paths[i]);
+			puts(batch.results[i].err);
+			failed = 1;
+		}
+	}
+	
+	if (stats) {
+		fprintf(stderr, "files=%zu threads=%u time=%.3fms\n", count, started + 1, end - start);
+	}
+	
+	free(threads);
+	free(batch.results);
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
 int main(int argc, const char* argv[]) {
-	if (argc < 2) {
-		fprintf(stderr, "Usage: %s <c1-source>\n", argv[0]);
+	const char *path = NULL;
+	const char **paths = calloc(argc, sizeof(*paths));
+	size_t count = 0;
+	const char *engine = "ast";
+	int dump = 0;
+	int stats = 0;
+	int fuse = 1;
+	int prof = 0;
+	int emit_c = 0;
+	int emit_asm = 0;
+	int dump_ssa = 0;
+	int optimize = 0;
+	int checked = 0;
+	unsigned int threshold = JIT_THRESHOLD;
+	unsigned int inline_threshold = OPT_INLINE_THRESHOLD;
+	size_t buffer = OUT_BUFFER_SIZE;
+	unsigned int jobs = 0;
+	int parallel = 0;
+	int invalid = 0;
+	
+	if (paths == NULL) {
+		fputs("out-of-memory error\n", stderr);
+		exit(-1);
+	}
+	
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--dump") == 0) {
+			dump = 1;
+		} else if (strcmp(argv[i], "--stats") == 0) {
+			stats = 1;
+		} else if (strcmp(argv[i], "--no-fuse") == 0) {
+			fuse = 0;
+		} else if (strcmp(argv[i], "--profile") == 0) {
+			prof = 1;
+		} else if (strcmp(argv[i], "--emit-c") == 0) {
+			emit_c = 1;
+		} else if (strcmp(argv[i], "--emit-asm") == 0) {
+			emit_asm = 1;
+		} else if (strcmp(argv[i], "-O") == 0) {
+			optimize = 1;
+		} else if (strcmp(argv[i], "--dump-ssa") == 0) {
+			dump_ssa = 1;
+		} else if (strcmp(argv[i], "--checked") == 0) {
+			checked = 1;
+		} else if (strncmp(argv[i], "--jit-threshold=", 16) == 0) {
+			threshold = (unsigned int) strtoul(argv[i] + 16, NULL, 10);
+		} else if (strncmp(argv[i], "--inline-threshold=", 19) == 0) {
+			/* --checked overrides it with 0 */
+			inline_threshold = (unsigned int) strtoul(argv[i] + 19, NULL, 10);
+		} else if (strcmp(argv[i], "--unbuffered") == 0) {
+			buffer = 0;
+		} else if (strncmp(argv[i], "--buffer=", 9) == 0) {
+			buffer = (size_t) strtoul(argv[i] + 9, NULL, 10);
+		} else if (strncmp(argv[i], "--scanner=", 10) == 0) {
+			if (strcmp(argv[i] + 10, "flex") == 0) {
+				scanMode = SCAN_FLEX;
+			} else if (strcmp(argv[i] + 10, "dfa") == 0) {
+				scanMode = SCAN_DFA;
+			} else {
+				invalid = 1;
+			}
+		} else if (strncmp(argv[i], "--engine=", 9) == 0) {
+			engine = argv[i] + 9;
+		} else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+			jobs = (unsigned int) strtoul(argv[++i], NULL, 10);
+			parallel = 1;
+		} else {
+			path = paths[count++] = argv[i];
+		}
+	}
+	
+	if (invalid || path == NULL || (parallel && jobs == 0)) {
+		fprintf(stderr, "Usage: %s [-O] [--dump] [--dump-ssa] [--emit-c] [--emit-asm] [--stats] [--checked] [--profile] [--no-fuse] [--jit-threshold=N] [--inline-threshold=N] [--buffer=N] [--unbuffered] [--scanner=flex|dfa] [--engine=ast|jit|typed|ssa|vm|reg] <c1-source>\n", argv[0]);
+		fprintf(stderr, "       %s [--stats] [--scanner=flex|dfa] --jobs N <c1-source>...\n", argv[0]);
+		fprintf(stderr, "--checked implies --inline-threshold=0, so that diagnostics name the function of the source\n");
+		free(paths);
 		return EXIT_FAILURE;
 	}
 	
-	FILE *in = fopen(argv[1], "r");
-	if (in == NULL) {
-		fprintf(stderr, "Failed to read c1 source file\n");
+	/* only parses and analyses the files, on N threads */
+	if (parallel) {
+		int status = analyseFiles(paths, count, jobs, stats);
+		free(paths);
+		return status;
+	}
+	
+	free(paths);
+	
+	/* only the AST interpreter detects undefined behaviour */
+	if (checked && strcmp(engine, "ast") != 0) {
+		fprintf(stderr, "--checked requires --engine=ast\n");
 		return EXIT_FAILURE;
 	}
 	
-	ParseResult result = astParse(in);
+	/* diagnostics name the current function, which is the caller after inlining */
+	if (checked) { inline_threshold = 0; }
+	
+	ParseResult result = astParseMapped(path);
+	
 	SymDefTable tab;
 	switch (result.tag) {
 	case PARSE_OK:
-		printf("[✓] syntax\n");
-		printf("[✓] analysis\n");
-		
 		tab = symDefTableNew(&result.tab, &result.ok);
-		astProgramPrint(&result.ok, 0, stdout);
-		symDefTablePrint(&tab, 0, stdout);
+		
+		if (optimize) {
+			OptStats opt_stats = { 0 };
+			optProgram(&result.ok, &tab, inline_threshold, &opt_stats);
+			if (stats) { optStatsPrint(&opt_stats, stderr); }
+		}
+		
+		flowAnalyze(&result.ok, &tab);
+		
+		if (dump) {
+			printf("[✓] syntax\n");
+			printf("[✓] analysis\n");
+			astProgramPrint(&result.ok, 0, stdout);
+			symDefTablePrint(&tab, 0, stdout);
+		} else if (emit_c) {
+			cgenProgram(&result.ok, &tab, stdout);
+		} else if (emit_asm) {
+			asmgenProgram(&result.ok, &tab, stdout);
+		} else if (dump_ssa) {
+			SsaProgram ssa = ssaBuild(&result.ok, &tab);
+			ssaProgramPrint(&ssa, stdout);
+			ssaVerify(&ssa, stderr);
+			ssaRelease(&ssa);
+		} else if (prof) {
+			profile(&result.ok, &tab, buffer);
+		} else if (!run(engine, &result.ok, &tab, stats, fuse, threshold, checked, buffer)) {
+			fprintf(stderr, "Unknown execution engine '%s'\n", engine);
+			astProgramRelease(&result.ok);
+			symDefTableRelease(&tab);
+			return EXIT_FAILURE;
+		}
 		
 		astProgramRelease(&result.ok);
 		symDefTableRelease(&tab);
@@ -44,6 +362,10 @@ int main(int argc, const char* argv[]) {
 		printf("[x] analysis\n");
 		puts(result.err);
 		break;
+		
+	case PARSE_ERR_INPUT:
+		fprintf(stderr, "Failed to read c1 source file\n");
+		break;
 	}
 	
 	return EXIT_FAILURE;
@@ -0,0 +1,54 @@
+#!/bin/sh
+# Benchmark of the runtime checks of `minako --checked`.
+#
+# Every program is run RUNS times by the AST interpreter with and without
+# checks. The best execution time reported by `--stats`, which excludes
+# parsing and analysis, is printed in milliseconds next to the relative
+# overhead; the last line sums up all programs.
+#
+# usage: checked.sh <minako> <c1-source>...
+
+MINAKO=$1
+shift
+
+RUNS=${RUNS:-5}
+
+# prints the best execution time of the command in microseconds
+best() {
+	min=
+	i=0
+	while [ $i -lt "$RUNS" ]; do
+		t=$("$@" 2>&1 > /dev/null | sed -n 's/.*time=\([0-9]*\)\.\([0-9]*\)ms.*/\1\2/p')
+		if [ -z "$t" ]; then return; fi
+		t=$(expr "$t" + 0)
+		if [ -z "$min" ] || [ $t -lt $min ]; then min=$t; fi
+		i=$((i + 1))
+	done
+	echo $min
+}
+
+# prints microseconds as milliseconds
+ms() {
+	printf "%d.%03d" $(($1 / 1000)) $(($1 % 1000))
+}
+
+total_plain=0
+total_checked=0
+
+for f in "$@"; do
+	plain=$(best "$MINAKO" --stats "$f")
+	checked=$(best "$MINAKO" --stats --checked "$f")
+	
+	if [ -z "$plain" ] || [ -z "$checked" ]; then
+		printf "%-44s failed\n" "$f"
+		continue
+	fi
+	
+	total_plain=$((total_plain + plain))
+	total_checked=$((total_checked + checked))
+	printf "%-44s plain=%sms checked=%sms overhead=%s%%\n" "$f" "$(ms $plain)" "$(ms $checked)" \
+		$(( plain > 0 ? 100 * (checked - plain) / plain : 0 ))
+done
+
+printf "%-44s plain=%sms checked=%sms overhead=%s%%\n" "total" "$(ms $total_plain)" "$(ms $total_checked)" \
+	$(( total_plain > 0 ? 100 * (total_checked - total_plain) / total_plain : 0 ))
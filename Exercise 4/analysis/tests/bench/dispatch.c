@@ -0,0 +1,183 @@
+/***************************************************************************//**
+ * @file dispatch.c
+ * @brief Microbenchmark comparing the dispatch strategies of the stack VM.
+ * 
+ * Every kernel is assembled directly as bytecode, so that the measurement
+ * does not depend on the front end. Each kernel is executed several times per
+ * dispatch strategy and the best run is reported in nanoseconds per
+ * dispatched instruction.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <vm.h>
+#include <vec.h>
+
+const int SEMANTIC_CHECK;
+
+/** Number of loop iterations of every kernel. */
+#define ITERATIONS 5000000
+
+/** Number of runs per kernel and dispatch strategy. */
+#define RUNS 5
+
+/**
+ * [X-Macro](https://en.wikipedia.org/wiki/X_macro) containing the names
+ * of the benchmark kernels.
+ */
+#define KERNELS \
+	X(int_loop) \
+	X(float_loop) \
+	X(call_loop)
+	
+/** Appends an instruction to the bytecode of the kernel. */
+#define EMIT(OP, ARG) (vecPush(bc.code) = (Instr) { OP, ARG })
+
+/** Adds the function `funcs[0]` starting at the current instruction. */
+#define FUNC(PARAMS, FRAME, STACK) \
+	(vecPush(bc.funcs) = (BcFunc) { vecLen(bc.code), PARAMS, FRAME, STACK })
+	
+/** Emits the entry code, which calls the function `funcs[MAIN]`. */
+#define ENTRY(MAIN) do { \
+	bc.entry = vecLen(bc.code); \
+	EMIT(OP_CALL, MAIN); \
+	EMIT(OP_HALT, 0); \
+} while (0)
+
+/* int i = 0; int s = 0; while (i < N) { s = s + i * 3; i = i + 1; } */
+static Bytecode int_loop(void) {
+	Bytecode bc = { 0 };
+	
+	FUNC(0, 2, 3);
+	EMIT(OP_PUSH, 0);        /*  0 */
+	EMIT(OP_STORE_LOCAL, 0); /*  1 */
+	EMIT(OP_PUSH, 0);        /*  2 */
+	EMIT(OP_STORE_LOCAL, 1); /*  3 */
+	EMIT(OP_JUMP, 15);       /*  4 */
+	EMIT(OP_LOAD_LOCAL, 1);  /*  5 */
+	EMIT(OP_LOAD_LOCAL, 0);  /*  6 */
+	EMIT(OP_PUSH, 3);        /*  7 */
+	EMIT(OP_MUL_I, 0);       /*  8 */
+	EMIT(OP_ADD_I, 0);       /*  9 */
+	EMIT(OP_STORE_LOCAL, 1); /* 10 */
+	EMIT(OP_LOAD_LOCAL, 0);  /* 11 */
+	EMIT(OP_PUSH, 1);        /* 12 */
+	EMIT(OP_ADD_I, 0);       /* 13 */
+	EMIT(OP_STORE_LOCAL, 0); /* 14 */
+	EMIT(OP_LOAD_LOCAL, 0);  /* 15 */
+	EMIT(OP_PUSH, ITERATIONS);
+	EMIT(OP_LT_I, 0);
+	EMIT(OP_JUMP_TRUE, 5);
+	EMIT(OP_RET, 0);
+	ENTRY(0);
+	return bc;
+}
+
+/* int i = 0; float f = 0.0; while (i < N) { f = f * 0.5 + i; i = i + 1; } */
+static Bytecode float_loop(void) {
+	Bytecode bc = { 0 };
+	
+	vecPush(bc.consts) = (Value) { .f = 0.0 };
+	vecPush(bc.consts) = (Value) { .f = 0.5 };
+	
+	FUNC(0, 2, 3);
+	EMIT(OP_PUSH, 0);        /*  0 */
+	EMIT(OP_STORE_LOCAL, 0); /*  1 */
+	EMIT(OP_CONST, 0);       /*  2 */
+	EMIT(OP_STORE_LOCAL, 1); /*  3 */
+	EMIT(OP_JUMP, 16);       /*  4 */
+	EMIT(OP_LOAD_LOCAL, 1);  /*  5 */
+	EMIT(OP_CONST, 1);       /*  6 */
+	EMIT(OP_MUL_F, 0);       /*  7 */
+	EMIT(OP_LOAD_LOCAL, 0);  /*  8 */
+	EMIT(OP_I2F, 0);         /*  9 */
+	EMIT(OP_ADD_F, 0);       /* 10 */
+	EMIT(OP_STORE_LOCAL, 1); /* 11 */
+	EMIT(OP_LOAD_LOCAL, 0);  /* 12 */
+	EMIT(OP_PUSH, 1);        /* 13 */
+	EMIT(OP_ADD_I, 0);       /* 14 */
+	EMIT(OP_STORE_LOCAL, 0); /* 15 */
+	EMIT(OP_LOAD_LOCAL, 0);  /* 16 */
+	EMIT(OP_PUSH, ITERATIONS);
+	EMIT(OP_LT_I, 0);
+	EMIT(OP_JUMP_TRUE, 5);
+	EMIT(OP_RET, 0);
+	ENTRY(0);
+	return bc;
+}
+
+/* int inc(int x) { return x + 1; } int i = 0; while (i < N) i = inc(i); */
+static Bytecode call_loop(void) {
+	Bytecode bc = { 0 };
+	
+	FUNC(0, 1, 2);
+	EMIT(OP_PUSH, 0);        /*  0 */
+	EMIT(OP_STORE_LOCAL, 0); /*  1 */
+	EMIT(OP_JUMP, 6);        /*  2 */
+	EMIT(OP_LOAD_LOCAL, 0);  /*  3 */
+	EMIT(OP_CALL, 1);        /*  4 */
+	EMIT(OP_STORE_LOCAL, 0); /*  5 */
+	EMIT(OP_LOAD_LOCAL, 0);  /*  6 */
+	EMIT(OP_PUSH, ITERATIONS);
+	EMIT(OP_LT_I, 0);
+	EMIT(OP_JUMP_TRUE, 3);
+	EMIT(OP_RET, 0);
+	
+	FUNC(1, 1, 2);
+	EMIT(OP_LOAD_LOCAL, 0);
+	EMIT(OP_PUSH, 1);
+	EMIT(OP_ADD_I, 0);
+	EMIT(OP_RET_VAL, 0);
+	ENTRY(0);
+	return bc;
+}
+
+/* returns the current wall-clock time in nanoseconds */
+static double now(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return ts.tv_sec*1e9 + ts.tv_nsec;
+}
+
+/* runs the kernel several times and prints the best time per dispatch */
+static void measure(const char *name, const Bytecode *bc, VmDispatch dispatch) {
+	const char *strategy = dispatch == VM_DISPATCH_SWITCH ? "switch" : "threaded";
+	double best = 0.0;
+	VmStats stats = { 0 };
+	
+	if (dispatch == VM_DISPATCH_THREADED && !vmHasThreading()) {
+		printf("%-12s %-9s n/a\n", name, strategy);
+		return;
+	}
+	
+	Out out = outNew(stdout, OUT_BUFFER_SIZE);
+	
+	for (int i = 0; i < RUNS; ++i) {
+		double start = now();
+		vmRunWith(bc, &out, &stats, dispatch);
+		double time = now() - start;
+		
+		if (i == 0 || time < best) {
+			best = time;
+		}
+	}
+	
+	outRelease(&out);
+	printf("%-12s %-9s %6.2f ns/op (%llu dispatches)\n", name, strategy, best/stats.dispatches, stats.dispatches);
+}
+
+int main(void) {
+	#define X(KERNEL) do { \
+		Bytecode bc = KERNEL(); \
+		measure(#KERNEL, &bc, VM_DISPATCH_SWITCH); \
+		measure(#KERNEL, &bc, VM_DISPATCH_THREADED); \
+		bcRelease(&bc); \
+	} while (0);
+	
+	KERNELS
+	
+	#undef X
+	return 0;
+}
@@ -0,0 +1,104 @@
+/***************************************************************************//**
+ * @file flow.c
+ * @brief Timing harness for the definite-assignment and missing-return
+ * analysis.
+ *
+ * A C1 program with a growing number of functions is generated, parsed and
+ * analysed several times per size; the best run is reported in nanoseconds
+ * per function. As every function has the same body, a constant time per
+ * function shows that the analysis runs in linear time.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <parser.tab.h>
+#include <symtab.h>
+#include <flow.h>
+
+const int SEMANTIC_CHECK = 1;
+
+/** Number of functions of the smallest program. */
+#define MIN_FUNCS 1000
+
+/** Number of functions of the largest program. */
+#define MAX_FUNCS 64000
+
+/** Number of runs per program size. */
+#define RUNS 5
+
+/** Body of every generated function, `%u` is replaced by its number. */
+#define FUNC_TEMPLATE \
+	"int f%u(int n) {\n" \
+	"\tint a;\n" \
+	"\tint b = n;\n" \
+	"\tif (n > 0) { a = n; } else { a = -n; }\n" \
+	"\twhile (b > 0) { b = b - 1; if (b == 3) return a; }\n" \
+	"\tfor (int i = 0; i < n; i = i + 1) { int c; c = i; a = a + c; }\n" \
+	"\tdo { b = b + 1; } while ((b < a) && (b < 10));\n" \
+	"\treturn a + b;\n" \
+	"}\n"
+	
+/* returns the current wall-clock time in nanoseconds */
+static double now(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return ts.tv_sec*1e9 + ts.tv_nsec;
+}
+
+/* generates and parses a program with the given number of functions */
+static ParseResult generate(unsigned int funcs) {
+	FILE *file = tmpfile();
+	
+	if (file == NULL) {
+		perror("tmpfile");
+		exit(EXIT_FAILURE);
+	}
+	
+	for (unsigned int i = 0; i < funcs; ++i) {
+		fprintf(file, FUNC_TEMPLATE, i);
+	}
+	
+	fputs("void main() {}\n", file);
+	rewind(file);
+	
+	ParseResult result = astParse(file);
+	fclose(file);
+	
+	if (result.tag != PARSE_OK) {
+		fprintf(stderr, "%s\n", result.err);
+		exit(EXIT_FAILURE);
+	}
+	
+	return result;
+}
+
+/* analyses the program several times and prints the best time per function */
+static void measure(unsigned int funcs) {
+	ParseResult result = generate(funcs);
+	SymDefTable tab = symDefTableNew(&result.tab, &result.ok);
+	double best = 0.0;
+	
+	for (int i = 0; i < RUNS; ++i) {
+		double start = now();
+		flowAnalyze(&result.ok, &tab);
+		double time = now() - start;
+		
+		if (i == 0 || time < best) {
+			best = time;
+		}
+	}
+	
+	printf("%6u functions %9.3f ms %6.1f ns/function\n", funcs, best/1e6, best/funcs);
+	astProgramRelease(&result.ok);
+	symDefTableRelease(&tab);
+}
+
+int main(void) {
+	for (unsigned int funcs = MIN_FUNCS; funcs <= MAX_FUNCS; funcs *= 2) {
+		measure(funcs);
+	}
+	
+	return 0;
+}
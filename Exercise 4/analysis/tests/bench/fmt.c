@@ -0,0 +1,133 @@
+/***************************************************************************//**
+ * @file fmt.c
+ * @brief Microbenchmark comparing `fmtFloat()` with `snprintf("%g")`.
+ *
+ * Both formatters are applied to the same sets of values several times and
+ * the best run is reported in nanoseconds per value. The outputs are
+ * compared as well, so that a faster but different result does not go
+ * unnoticed.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include <fmt.h>
+
+const int SEMANTIC_CHECK;
+
+/** Number of values of every set. */
+#define VALUES 1000000
+
+/** Number of runs per set and formatter. */
+#define RUNS 5
+
+/**
+ * [X-Macro](https://en.wikipedia.org/wiki/X_macro) containing the names
+ * of the value sets.
+ */
+#define SETS \
+	X(decimal) \
+	X(scientific) \
+	X(bit_patterns)
+
+/* the state of the xorshift generator */
+static uint64_t state = 88172645463325252u;
+
+/* returns the next pseudo-random number */
+static uint64_t next(void) {
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+	return state;
+}
+
+/* values with few decimal places, as printed by typical C1 programs */
+static double decimal(void) {
+	return (double) (int) (next() % 2000000 - 1000000) / 1000.0;
+}
+
+/* values of large and small magnitude */
+static double scientific(void) {
+	return (double) (next() % 1000000) * 1e-12 + (double) (next() % 1000) * 1e12;
+}
+
+/* arbitrary finite values */
+static double bit_patterns(void) {
+	double value;
+	
+	do {
+		uint64_t bits = next();
+		memcpy(&value, &bits, sizeof(value));
+	} while (value != value || isinf(value));
+	
+	return value;
+}
+
+/* returns the current wall-clock time in nanoseconds */
+static double now(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return ts.tv_sec*1e9 + ts.tv_nsec;
+}
+
+/* formats all values several times and returns the best time per value */
+static double measure(const double *values, int use_printf) {
+	char buf[FMT_FLOAT_SIZE];
+	double best = 0.0;
+	size_t sink = 0;
+	
+	for (int i = 0; i < RUNS; ++i) {
+		double start = now();
+		
+		for (int j = 0; j < VALUES; ++j) {
+			sink += use_printf ? snprintf(buf, sizeof(buf), "%g", values[j]) : fmtFloat(buf, values[j]);
+		}
+		
+		double time = now() - start;
+		
+		if (i == 0 || time < best) {
+			best = time;
+		}
+	}
+	
+	/* keeps the compiler from discarding the formatted values */
+	if (sink == 0) { puts(buf); }
+	return best/VALUES;
+}
+
+/* returns the number of values that are formatted differently */
+static unsigned int mismatches(const double *values) {
+	unsigned int count = 0;
+	
+	for (int i = 0; i < VALUES; ++i) {
+		char expected[FMT_FLOAT_SIZE], actual[FMT_FLOAT_SIZE];
+		snprintf(expected, sizeof(expected), "%g", values[i]);
+		fmtFloat(actual, values[i]);
+		count += strcmp(expected, actual) != 0;
+	}
+	
+	return count;
+}
+
+int main(void) {
+	static double values[VALUES];
+	
+	#define X(SET) do { \
+		for (int i = 0; i < VALUES; ++i) { \
+			values[i] = SET(); \
+		} \
+		\
+		double fast = measure(values, 0); \
+		double slow = measure(values, 1); \
+		printf("%-12s fmtFloat %6.1f ns/value snprintf %6.1f ns/value speedup %5.2fx mismatches %u\n", \
+			#SET, fast, slow, slow/fast, mismatches(values)); \
+	} while (0);
+	
+	SETS
+	
+	#undef X
+	return 0;
+}
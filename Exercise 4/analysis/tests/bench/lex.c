@@ -0,0 +1,187 @@
+/***************************************************************************//**
+ * @file lex.c
+ * @brief Timing harness comparing the flex scanner with the hand-written one.
+ *
+ * The C1 programs passed on the command line are concatenated and repeated
+ * to several megabytes; a second input of the same size is generated with
+ * deep indentation, long comments and long string literals. Each buffer is scanned to the end several times with
+ * `yylex()` once for the flex scanner and once for each skip implementation
+ * of the hand-written one that the processor supports; the best run is
+ * reported in milliseconds and megabytes per second. The token streams of
+ * all runs are hashed and must be identical.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <parser.tab.h>
+#include <source.h>
+#include <lex.h>
+#include <skip.h>
+
+const int SEMANTIC_CHECK = 1;
+
+/** Minimum size of the scanned input in bytes. */
+#define MIN_SIZE (16 << 20)
+
+/** Number of runs per scanner. */
+#define RUNS 5
+
+/** Body of every generated function, `%u` is replaced by its number. */
+#define FUNC_TEMPLATE \
+	"/*\n" \
+	" * generated function number %u\n" \
+	" *\n" \
+	" * the body is machine-generated, do not edit it by hand\n" \
+	" */\n" \
+	"int f%u(int n) {\n" \
+	"        // accumulate the first n multiples of three\n" \
+	"        int a = 0;\n" \
+	"        for (int i = 0; i < n; i = i + 1) {\n" \
+	"                if (a >= 100) {\n" \
+	"                        print(\"the accumulated value has become larger than one hundred\");\n" \
+	"                }\n" \
+	"                a = a + i * 3;\n" \
+	"        }\n" \
+	"        return a;\n" \
+	"}\n\n"
+	
+/** Summary of a token stream. */
+typedef struct {
+	unsigned long count;
+	unsigned long hash;
+} Stream;
+
+/* returns the current wall-clock time in nanoseconds */
+static double now(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return ts.tv_sec*1e9 + ts.tv_nsec;
+}
+
+/* concatenates the files and repeats them up to the minimum size */
+static char* load(int count, const char *paths[], size_t *len) {
+	size_t used = 0, cap = MIN_SIZE + SOURCE_PADDING;
+	char *buf = malloc(cap);
+	
+	for (int i = 0; i < count; ++i) {
+		Source source = sourceNew(paths[i]);
+		
+		if (source.data == NULL) {
+			perror(paths[i]);
+			exit(EXIT_FAILURE);
+		}
+		
+		if (used + source.len + 1 + SOURCE_PADDING > cap) {
+			cap = 2*(used + source.len + 1 + SOURCE_PADDING);
+			buf = realloc(buf, cap);
+		}
+		
+		memcpy(buf + used, source.data, source.len);
+		used += source.len;
+		buf[used++] = '\n';
+		sourceRelease(&source);
+	}
+	
+	for (size_t part = used; used + part <= MIN_SIZE; used += part) {
+		memcpy(buf + used, buf, part);
+	}
+	
+	memset(buf + used, 0, SOURCE_PADDING);
+	*len = used;
+	return buf;
+}
+
+/* generates functions up to the minimum size */
+static char* generate(size_t *len) {
+	size_t used = 0, cap = MIN_SIZE + 2*sizeof(FUNC_TEMPLATE) + SOURCE_PADDING;
+	char *buf = malloc(cap);
+	
+	for (unsigned int i = 0; used < MIN_SIZE; ++i) {
+		used += sprintf(buf + used, FUNC_TEMPLATE, i, i);
+	}
+	
+	memset(buf + used, 0, SOURCE_PADDING);
+	*len = used;
+	return buf;
+}
+
+/* scans the buffer to its end and returns the time in nanoseconds */
+static double scan(ScanMode mode, char *buf, size_t len, Stream *stream) {
+	double start = now();
+	Lexer lexer = lexerFromBuffer(mode, buf, len);
+	YYSTYPE lval;
+	int token;
+	
+	*stream = (Stream) { 0, 0 };
+	
+	while ((token = yylex(&lval, &lexer)) != EOF && token != YYUNDEF) {
+		stream->hash = stream->hash*31 + token;
+		++stream->count;
+	}
+	
+	double time = now() - start;
+	lexerRelease(&lexer);
+	return time;
+}
+
+/* scans the buffer several times and returns the best time */
+static double measure(ScanMode mode, char *buf, size_t len, Stream *stream) {
+	double best = 0.0;
+	
+	for (int i = 0; i < RUNS; ++i) {
+		double time = scan(mode, buf, len, stream);
+		
+		if (i == 0 || time < best) {
+			best = time;
+		}
+	}
+	
+	return best;
+}
+
+/* compares the scanners on one input and returns whether their token streams are identical */
+static int compare(const char *name, char *buf, size_t len) {
+	const char *levels[] = { "scalar", "sse2", "avx2" };
+	Stream flex, dfa;
+	
+	double mb = len/1e6;
+	double slow = measure(SCAN_FLEX, buf, len, &flex);
+	printf("%-9s %6.1f MB %8lu token flex        %8.2f ms %7.1f MB/s\n",
+		name, mb, flex.count, slow/1e6, mb/(slow/1e9));
+		
+	for (SkipLevel level = SKIP_SCALAR; level <= skipDetect(); ++level) {
+		skipSelect(level);
+		double fast = measure(SCAN_DFA, buf, len, &dfa);
+		
+		printf("%-9s %6.1f MB %8lu token dfa/%-6s %8.2f ms %7.1f MB/s speedup %5.2fx\n",
+			name, mb, dfa.count, levels[level], fast/1e6, mb/(fast/1e9), slow/fast);
+			
+		if (flex.count != dfa.count || flex.hash != dfa.hash) {
+			fprintf(stderr, "token streams differ: %lu and %lu token\n", flex.count, dfa.count);
+			return 0;
+		}
+	}
+	
+	return 1;
+}
+
+int main(int argc, const char *argv[]) {
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s <c1-source>...\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	
+	size_t len;
+	char *buf = load(argc - 1, argv + 1, &len);
+	int same = compare("programs", buf, len);
+	free(buf);
+	
+	buf = generate(&len);
+	same = same && compare("generated", buf, len);
+	free(buf);
+	
+	return same ? 0 : EXIT_FAILURE;
+}
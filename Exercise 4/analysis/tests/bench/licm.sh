@@ -0,0 +1,33 @@
+#!/bin/sh
+# Benchmark of the optimisations of `minako -O` on loop-heavy programs.
+#
+# Every program is run by the AST interpreter with and without optimisations.
+# The numbers of evaluated expression nodes and of function calls are
+# independent of the machine and are reported next to the relative saving.
+#
+# usage: licm.sh <minako> <c1-source>...
+
+MINAKO=$1
+shift
+
+# prints the counter NAME (`evals` or `calls`) of the command
+count() {
+	name=$1
+	shift
+	"$@" 2>&1 > /dev/null | sed -n "s/.*$name=\\([0-9]*\\).*/\\1/p"
+}
+
+for f in "$@"; do
+	before=$(count evals "$MINAKO" --stats "$f")
+	after=$(count evals "$MINAKO" -O --stats "$f")
+	calls_before=$(count calls "$MINAKO" --stats "$f")
+	calls_after=$(count calls "$MINAKO" -O --stats "$f")
+	
+	if [ -z "$before" ] || [ -z "$after" ]; then
+		printf "%-44s failed\n" "$f"
+		continue
+	fi
+	
+	printf "%-44s before=%s after=%s saved=%s%% calls=%s->%s\n" "$f" "$before" "$after" \
+		$(( before > 0 ? 100 * (before - after) / before : 0 )) "$calls_before" "$calls_after"
+done
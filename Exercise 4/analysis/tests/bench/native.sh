@@ -0,0 +1,46 @@
+#!/bin/sh
+# Benchmark of the programs translated by `minako --emit-asm`.
+#
+# Every program is assembled with `as`, linked against the C library with
+# `ld` and run RUNS times next to the AST interpreter. The best wall-clock
+# time of each, including process start-up, is reported in milliseconds.
+#
+# usage: native.sh <minako> <c1-source>...
+
+MINAKO=$1
+shift
+
+RUNS=${RUNS:-3}
+AS=${AS:-as}
+LD=${LD:-ld}
+CRT_DIR=${CRT_DIR:-/usr/lib/x86_64-linux-gnu}
+DYNAMIC_LINKER=${DYNAMIC_LINKER:-/lib64/ld-linux-x86-64.so.2}
+
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+# prints the best wall-clock time of the command in milliseconds
+best() {
+	min=
+	i=0
+	while [ $i -lt "$RUNS" ]; do
+		start=$(date +%s%N)
+		"$@" > /dev/null 2>&1
+		end=$(date +%s%N)
+		t=$(( (end - start) / 1000 ))
+		if [ -z "$min" ] || [ $t -lt $min ]; then min=$t; fi
+		i=$((i + 1))
+	done
+	printf "%d.%03d" $((min / 1000)) $((min % 1000))
+}
+
+for f in "$@"; do
+	if ! { "$MINAKO" --emit-asm "$f" > "$TMP/prog.s" &&
+		$AS "$TMP/prog.s" -o "$TMP/prog.o" &&
+		$LD -dynamic-linker "$DYNAMIC_LINKER" "$CRT_DIR/crt1.o" "$CRT_DIR/crti.o" "$TMP/prog.o" -lc "$CRT_DIR/crtn.o" -o "$TMP/prog"; }; then
+		printf "%-44s build failed\n" "$f"
+		continue
+	fi
+
+	printf "%-44s native=%sms ast=%sms\n" "$f" "$(best "$TMP/prog")" "$(best "$MINAKO" "$f")"
+done
@@ -0,0 +1,46 @@
+#!/bin/sh
+# Benchmark of the output buffer of `minako`.
+#
+# Every program is run RUNS times per engine with an unbuffered output and
+# with several buffer sizes. The best execution time reported by `--stats`
+# is printed in milliseconds; the output itself is discarded.
+#
+# usage: output.sh <minako> <c1-source>...
+
+MINAKO=$1
+shift
+
+RUNS=${RUNS:-5}
+SIZES=${SIZES:-"0 512 4096 65536 1048576"}
+
+# prints the best execution time of the command in microseconds
+best() {
+	min=
+	i=0
+	while [ $i -lt "$RUNS" ]; do
+		t=$("$@" 2>&1 > /dev/null | sed -n 's/.*time=\([0-9]*\)\.\([0-9]*\)ms.*/\1\2/p')
+		if [ -z "$t" ]; then return; fi
+		t=$(expr "$t" + 0)
+		if [ -z "$min" ] || [ $t -lt $min ]; then min=$t; fi
+		i=$((i + 1))
+	done
+	echo $min
+}
+
+# prints microseconds as milliseconds
+ms() {
+	printf "%d.%03d" $(($1 / 1000)) $(($1 % 1000))
+}
+
+for f in "$@"; do
+	for e in ast vm reg; do
+		printf "%-28s %-4s" "$f" "$e"
+		
+		for size in $SIZES; do
+			t=$(best "$MINAKO" --stats --engine=$e --buffer=$size "$f")
+			printf " %s=%sms" "$size" "$(ms ${t:-0})"
+		done
+		
+		printf "\n"
+	done
+done
@@ -0,0 +1,121 @@
+/***************************************************************************//**
+ * @file scan.c
+ * @brief Timing harness comparing `astParse()` with `astParseMapped()`.
+ *
+ * C1 programs of several megabytes are generated into a file and parsed
+ * several times from a stream and from the mapped file; the best run is
+ * reported in milliseconds and megabytes per second. Both entry points build
+ * the same AST, so the difference is the cost of copying the input into the
+ * buffer of the scanner.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <parser.tab.h>
+
+const int SEMANTIC_CHECK = 1;
+
+/** Path of the generated program, relative to the working directory. */
+#define PATH "scan.gen.c1"
+
+/** Number of functions of the smallest program. */
+#define MIN_FUNCS 10000
+
+/** Number of functions of the largest program. */
+#define MAX_FUNCS 40000
+
+/** Number of runs per program size and entry point. */
+#define RUNS 5
+
+/** Body of every generated function, `%u` is replaced by its number. */
+#define FUNC_TEMPLATE \
+	"/* generated function number %u */\n" \
+	"int f%u(int n) {\n" \
+	"\tint a = 0;\n" \
+	"\tfloat x = 1.5e-3;\n" \
+	"\tfor (int i = 0; i < n; i = i + 1) { a = a + i * 3; x = x * 2.0; }\n" \
+	"\tif ((a >= 100) && (x != 0.25)) { print(\"large\"); }\n" \
+	"\treturn a;\n" \
+	"}\n"
+
+/* returns the current wall-clock time in nanoseconds */
+static double now(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return ts.tv_sec*1e9 + ts.tv_nsec;
+}
+
+/* writes a program with the given number of functions and returns its size */
+static long generate(unsigned int funcs) {
+	FILE *file = fopen(PATH, "w");
+	
+	if (file == NULL) {
+		perror(PATH);
+		exit(EXIT_FAILURE);
+	}
+	
+	for (unsigned int i = 0; i < funcs; ++i) {
+		fprintf(file, FUNC_TEMPLATE, i, i);
+	}
+	
+	fputs("void main() {}\n", file);
+	long size = ftell(file);
+	fclose(file);
+	return size;
+}
+
+/* parses the program once and returns the time in nanoseconds */
+static double parse(int mapped) {
+	double start = now();
+	ParseResult result;
+	
+	if (mapped) {
+		result = astParseMapped(PATH);
+	} else {
+		FILE *file = fopen(PATH, "r");
+		result = astParse(file);
+		fclose(file);
+	}
+	
+	double time = now() - start;
+	
+	if (result.tag != PARSE_OK) {
+		fprintf(stderr, "%s\n", result.err);
+		exit(EXIT_FAILURE);
+	}
+	
+	astProgramRelease(&result.ok);
+	symtabRelease(&result.tab);
+	return time;
+}
+
+/* parses the program several times and returns the best time */
+static double measure(int mapped) {
+	double best = 0.0;
+	
+	for (int i = 0; i < RUNS; ++i) {
+		double time = parse(mapped);
+		
+		if (i == 0 || time < best) {
+			best = time;
+		}
+	}
+	
+	return best;
+}
+
+int main(void) {
+	for (unsigned int funcs = MIN_FUNCS; funcs <= MAX_FUNCS; funcs *= 2) {
+		double mb = generate(funcs)/1e6;
+		double stream = measure(0);
+		double mapped = measure(1);
+		
+		printf("%6.1f MB stream %8.2f ms %7.1f MB/s mapped %8.2f ms %7.1f MB/s speedup %5.2fx\n",
+			mb, stream/1e6, mb/(stream/1e9), mapped/1e6, mb/(mapped/1e9), stream/mapped);
+	}
+	
+	remove(PATH);
+	return 0;
+}
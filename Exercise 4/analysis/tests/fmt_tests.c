@@ -0,0 +1,103 @@
+#include "fmt_tests.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <fmt.h>
+
+typedef struct {
+	double input;
+	const char *output;
+} Expectation[];
+
+/**
+ * @brief Helper macro to compare and diagnose differences between the
+ * formatted value and the expected output.
+ * @param VALUE  the value to format
+ * @param OUTPUT the expected output
+ */
+#define EXPECT_FMT(VALUE, OUTPUT) { \
+	char buf[FMT_FLOAT_SIZE]; \
+	int len = fmtFloat(buf, VALUE); \
+	if (strcmp(buf, OUTPUT) != 0 || len != (int) strlen(OUTPUT)) { \
+		fprintf(stderr, "assertion `fmtFloat(%.17g) == \"%s\"` failed", VALUE, OUTPUT); \
+		fprintf(stderr, "\n\tleft: \"%s\" (%i),\n\tright: \"%s\"", buf, len, OUTPUT); \
+		return false; \
+	} \
+}
+
+static bool expect(const Expectation io, int count) {
+	for (int i = 0; i < count; ++i) {
+		EXPECT_FMT(io[i].input, io[i].output);
+	}
+	
+	return true;
+}
+
+bool fmt_special_values(void) {
+	Expectation io = {
+		{ NAN, "nan" },
+		{ INFINITY, "inf" },
+		{ -INFINITY, "-inf" },
+		{ 0.0, "0" },
+		{ -0.0, "-0" },
+	};
+	
+	return expect(io, sizeof(io)/sizeof(*io));
+}
+
+bool fmt_notation(void) {
+	Expectation io = {
+		{ 1.0, "1" },
+		{ -2.5, "-2.5" },
+		{ 123456.0, "123456" },
+		{ 1234567.0, "1.23457e+06" },
+		{ 0.0001, "0.0001" },
+		{ 0.00001234, "1.234e-05" },
+		{ 1e100, "1e+100" },
+		{ 5e-324, "4.94066e-324" },
+		{ 1.7976931348623157e308, "1.79769e+308" },
+	};
+	
+	return expect(io, sizeof(io)/sizeof(*io));
+}
+
+bool fmt_rounding(void) {
+	Expectation io = {
+		{ 999999.5, "1e+06" },
+		{ 9.999995e-5, "0.0001" },
+		{ 0.1 + 0.2, "0.3" },
+		{ 1234565.0, "1.23456e+06" },
+		{ 1234575.0, "1.23458e+06" },
+		{ 12345.25, "12345.2" },
+	};
+	
+	return expect(io, sizeof(io)/sizeof(*io));
+}
+
+bool fmt_matches_printf(void) {
+	uint64_t state = 88172645463325252u;
+	
+	for (int i = 0; i < 100000; ++i) {
+		char expected[32];
+		double value;
+		
+		/* xorshift over all bit patterns and over short decimal fractions */
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		
+		if (i % 2) {
+			memcpy(&value, &state, sizeof(value));
+			if (value != value || isinf(value)) { continue; }
+		} else {
+			value = (double) (int) (state % 2000000) / 1000.0;
+		}
+		
+		snprintf(expected, sizeof(expected), "%g", value);
+		EXPECT_FMT(value, expected);
+	}
+	
+	return true;
+}
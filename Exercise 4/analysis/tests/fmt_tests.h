@@ -0,0 +1,21 @@
+#ifndef FMT_TESTS_H_INCLUDED
+#define FMT_TESTS_H_INCLUDED
+
+#include <stdbool.h>
+
+/**
+ * [X-Macro](https://en.wikipedia.org/wiki/X_macro) containing the names
+ * of the test cases.
+ */
+#define FMT_TESTS \
+	X(fmt_special_values) \
+	X(fmt_notation) \
+	X(fmt_rounding) \
+	X(fmt_matches_printf)
+
+/* declare the test functions based on the list */
+#define X(CASE) extern bool CASE(void);
+FMT_TESTS
+#undef X
+
+#endif
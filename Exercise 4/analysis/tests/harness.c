@@ -8,6 +8,8 @@
 
 #include <stdio.h>
 #include "lexer_tests.h"
+#include "fmt_tests.h"
+#include "scan_tests.h"
 
 const int SEMANTIC_CHECK;
 
@@ -19,6 +21,8 @@ int main(void) {
 	} while (0);
 	
 	LEXER_TESTS
+	FMT_TESTS
+	SCAN_TESTS
 	
 	#undef X
 	return 0;
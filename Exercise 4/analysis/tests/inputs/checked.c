@@ -0,0 +1,46 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <ast.h>
+#include <flow.h>
+#include <interp.h>
+#include <parser.tab.h>
+
+const int SEMANTIC_CHECK = 1;
+
+/* exit code after undefined behaviour was detected, following the parse results */
+#define RUNTIME_ERROR 3
+
+int main(int argc, const char *argv[]) {
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s <c1-source>\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	
+	FILE *in = fopen(argv[1], "r");
+	if (in == NULL) {
+		fprintf(stderr, "Failed to read c1 source file\n");
+		return EXIT_FAILURE;
+	}
+	
+	ParseResult result = astParse(in);
+	int status = result.tag;
+	
+	switch (result.tag) {
+	case PARSE_OK: {
+		SymDefTable tab = symDefTableNew(&result.tab, &result.ok);
+		flowAnalyze(&result.ok, &tab);
+		Out out = outNew(stdout, OUT_BUFFER_SIZE);
+		if (!interpRunChecked(&result.ok, &tab, &out, NULL)) { status = RUNTIME_ERROR; }
+		outRelease(&out);
+		astProgramRelease(&result.ok);
+		symDefTableRelease(&tab);
+		break;
+	}
+	default:
+		puts(result.err);
+		break;
+	}
+	
+	return status;
+}
@@ -1,30 +1,46 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <parser.tab.h>
-
-YYSTYPE yylval;
+#include <source.h>
+#include <lex.h>
 
 const int SEMANTIC_CHECK;
 
 int main(int argc, const char *argv[]) {
+	Lexer lexer;
+	YYSTYPE yylval;
 	int token;
 
-	if (argc < 2) {
-		fprintf(stderr, "Usage: %s <c1-source>\n", argv[0]);
+	if (argc < 2 || (argc > 2 && strcmp(argv[1], "--dfa") != 0)) {
+		fprintf(stderr, "Usage: %s [--dfa] <c1-source>\n", argv[0]);
 		return EXIT_FAILURE;
 	}
 
-	// Open the source file.
-	yyin = fopen(argv[1], "r");
-	if (yyin == NULL) {
-		fprintf(stderr, "Failed to read c1 source file\n");
-		return EXIT_FAILURE;
+	if (argc > 2) {
+		// Scan the loaded file with the hand-written scanner.
+		Source source = sourceNew(argv[2]);
+		if (source.data == NULL) {
+			fprintf(stderr, "Failed to read c1 source file\n");
+			return EXIT_FAILURE;
+		}
+
+		lexer = lexerFromBuffer(SCAN_DFA, source.data, source.len);
+	} else {
+		// Open the source file.
+		FILE *input = fopen(argv[1], "r");
+		if (input == NULL) {
+			fprintf(stderr, "Failed to read c1 source file\n");
+			return EXIT_FAILURE;
+		}
+
+		lexer = lexerFromStream(input);
 	}
 
 	// Run the lexer.
-	while ((token = yylex()) != EOF) {
+	while ((token = yylex(&yylval, &lexer)) != EOF) {
 		const char *name;
-		printf("Line: %3d, ", yylineno);
+		printf("Line: %3d, ", lexerLine(&lexer));
 		switch (token) {
 		case LOG_AND:
 			name = "&&";
@@ -100,7 +116,7 @@ int main(int argc, const char *argv[]) {
 			break;
 
 		case IDENT:
-			printf("IDENT:  <%s>\n", yylval.string);
+			printf("IDENT:  <%s>\n", internName(yylval.ident));
 			continue;
 
 		case BOOL_LITERAL:
@@ -4,14 +4,10 @@
 #include <string.h>
 #include <stdio.h>
 #include <parser.tab.h>
+#include <lex.h>
 
-// import some flex functions for parsing from memory
-typedef struct yy_buffer_state* YY_BUFFER_STATE;
-extern YY_BUFFER_STATE yy_scan_string(const char *base);
-extern void yy_delete_buffer(YY_BUFFER_STATE b);
-extern void lexer_reset_state(void);
-
-YYSTYPE yylval;
+// the semantic value of the last token
+static YYSTYPE yylval;
 
 typedef struct {
 	const char *input;
@@ -35,10 +31,9 @@ typedef struct {
 	}
 
 static int scan(const char *input) {
-	YY_BUFFER_STATE buf = yy_scan_string(input);
-	int result = yylex();
-	lexer_reset_state();
-	yy_delete_buffer(buf);
+	Lexer lexer = lexerFromString(SCAN_FLEX, input);
+	int result = yylex(&yylval, &lexer);
+	lexerRelease(&lexer);
 	return result;
 }
 
@@ -121,11 +116,14 @@ bool lexer_identifiers(void) {
 	for (int i = 0; i < sizeof(io)/sizeof(*io); ++i) {
 		EXPECT_EQ(scan(io[i].input), IDENT, "%i", io[i].input);
 		
-		if (strcmp(yylval.string, io[i].value.string) != 0) {
-			fprintf(stderr, "assertion `yylval.string == io[i].value.string` failed [%s]", io[i].input);
-			fprintf(stderr, "\n\tleft: \"%s\",\n\tright: \"%s\"", yylval.string, io[i].value.string);
+		if (strcmp(internName(yylval.ident), io[i].value.string) != 0) {
+			fprintf(stderr, "assertion `internName(yylval.ident) == io[i].value.string` failed [%s]", io[i].input);
+			fprintf(stderr, "\n\tleft: \"%s\",\n\tright: \"%s\"", internName(yylval.ident), io[i].value.string);
 			return false;
 		}
+		
+		/* equal names share one identifier */
+		EXPECT_EQ(yylval.ident.index, internString(io[i].value.string, strlen(io[i].value.string)).index, "%u", io[i].input);
 	}
 	
 	return true;
@@ -200,11 +198,23 @@ bool lexer_unclosed_c_comment(void) {
 }
 
 bool lexer_illegal_character(void) {
-	YY_BUFFER_STATE buf = yy_scan_string("100%");
-	EXPECT_EQ(yylex(), INT_LITERAL, "%i", "100");
-	EXPECT_EQ(yylex(), YYUNDEF, "%i", "%");
-	lexer_reset_state();
-	yy_delete_buffer(buf);
+	Lexer lexer = lexerFromString(SCAN_FLEX, "100%");
+	EXPECT_EQ(yylex(&yylval, &lexer), INT_LITERAL, "%i", "100");
+	EXPECT_EQ(yylex(&yylval, &lexer), YYUNDEF, "%i", "%");
+	lexerRelease(&lexer);
+	
+	return true;
+}
+
+bool lexer_unpadded_buffer(void) {
+	/* no null bytes after the source, so flex cannot scan it in place */
+	char data[] = { 'i', 'n', 't', ' ', 'x', ';' };
+	Lexer lexer = lexerFromBuffer(SCAN_FLEX, data, sizeof(data));
+	EXPECT_EQ(yylex(&yylval, &lexer), KW_INT, "%i", "int");
+	EXPECT_EQ(yylex(&yylval, &lexer), IDENT, "%i", "x");
+	EXPECT_EQ(yylex(&yylval, &lexer), ';', "%i", ";");
+	EXPECT_EQ(yylex(&yylval, &lexer), EOF, "%i", "");
+	lexerRelease(&lexer);
 	
 	return true;
 }
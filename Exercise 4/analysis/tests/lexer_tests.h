@@ -18,7 +18,8 @@
 	X(lexer_operators) \
 	X(lexer_separators) \
 	X(lexer_unclosed_c_comment) \
-	X(lexer_illegal_character)
+	X(lexer_illegal_character) \
+	X(lexer_unpadded_buffer)
 
 /* declare the test functions based on the list */
 #define X(CASE) extern bool CASE(void);
@@ -0,0 +1,205 @@
+#include "scan_tests.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <parser.tab.h>
+#include <intern.h>
+#include <scan.h>
+#include <skip.h>
+
+/** @brief The longest token sequence of a test case, including `EOF`. */
+#define MAX_TOKENS 8
+
+typedef struct {
+	const char *input;
+	int tokens[MAX_TOKENS];
+} Expectation[];
+
+/**
+ * @brief Helper macro to compare and diagnose differences between expected and
+ * actual output.
+ * @param LHS    the left-hand-side of the comparison
+ * @param RHS    the right-hand-side of the comparison
+ * @param FMT    a format-specifier to print \p LHS and \p RHS
+ * @param INPUT  the input string for diagnostic purposes
+ */
+#define EXPECT_EQ(LHS, RHS, FMT, INPUT) \
+	if (LHS != RHS) { \
+		fprintf(stderr, "assertion `" #LHS " == " #RHS "` failed [%s]", INPUT); \
+		fprintf(stderr, "\n\tleft: " FMT ",\n\tright: " FMT, LHS, RHS); \
+		return false; \
+	}
+	
+/** @brief The scanner under test and the semantic value of its last token. */
+static Scanner scanner;
+static YYSTYPE yylval;
+
+static void start(const char *input) {
+	scanner = scanNew(input, strlen(input));
+}
+
+static int next(void) {
+	return scanLex(&scanner, &yylval);
+}
+
+static bool expect(const Expectation io, int count) {
+	for (int i = 0; i < count; ++i) {
+		start(io[i].input);
+		
+		for (int j = 0; j < MAX_TOKENS; ++j) {
+			int token = next();
+			EXPECT_EQ(token, io[i].tokens[j], "%i", io[i].input);
+			if (token == EOF) { break; }
+		}
+	}
+	
+	return true;
+}
+
+bool scan_keywords(void) {
+	Expectation io = {
+		{ "bool do else float for if int print return void while", {
+			KW_BOOLEAN, KW_DO, KW_ELSE, KW_FLOAT, KW_FOR, KW_IF, KW_INT, KW_PRINT
+		} },
+		{ "return void while true false", {
+			KW_RETURN, KW_VOID, KW_WHILE, BOOL_LITERAL, BOOL_LITERAL, EOF
+		} },
+	};
+	
+	return expect(io, sizeof(io)/sizeof(*io));
+}
+
+bool scan_keyword_near_misses(void) {
+	const char *words[] = {
+		"d", "dO", "doo", "i", "iff", "in", "int_", "Int", "_if", "boo", "bool1",
+		"els", "elsa", "fo", "fort", "floats", "prin", "retur", "returns",
+		"voids", "whil", "tru", "truee", "fals", "falsy", "dp", "ig"
+	};
+	
+	for (int i = 0; i < sizeof(words)/sizeof(*words); ++i) {
+		start(words[i]);
+		EXPECT_EQ(next(), IDENT, "%i", words[i]);
+		EXPECT_EQ(strcmp(internName(yylval.ident), words[i]), 0, "%i", words[i]);
+		EXPECT_EQ(next(), EOF, "%i", words[i]);
+	}
+	
+	return true;
+}
+
+bool scan_literals(void) {
+	start("true 42 3.5e2 .25 \"hi there\"");
+	EXPECT_EQ(next(), BOOL_LITERAL, "%i", "true");
+	EXPECT_EQ(yylval.intValue, 1, "%i", "true");
+	EXPECT_EQ(next(), INT_LITERAL, "%i", "42");
+	EXPECT_EQ(yylval.intValue, 42, "%i", "42");
+	EXPECT_EQ(next(), FLOAT_LITERAL, "%i", "3.5e2");
+	EXPECT_EQ(yylval.floatValue, 350.0, "%f", "3.5e2");
+	EXPECT_EQ(next(), FLOAT_LITERAL, "%i", ".25");
+	EXPECT_EQ(yylval.floatValue, .25, "%f", ".25");
+	EXPECT_EQ(next(), STRING_LITERAL, "%i", "\"hi there\"");
+	EXPECT_EQ(strcmp(yylval.string, "hi there"), 0, "%i", "\"hi there\"");
+	EXPECT_EQ(next(), EOF, "%i", "");
+	
+	return true;
+}
+
+bool scan_number_prefixes(void) {
+	Expectation io = {
+		{ "1.", { INT_LITERAL, YYUNDEF, EOF } },
+		{ "1e", { INT_LITERAL, IDENT, EOF } },
+		{ "1e+", { INT_LITERAL, IDENT, ADD, EOF } },
+		{ "2e-3", { FLOAT_LITERAL, EOF } },
+		{ "1.5.5", { FLOAT_LITERAL, FLOAT_LITERAL, EOF } },
+		{ "0x1", { INT_LITERAL, IDENT, EOF } },
+		{ ".", { YYUNDEF, EOF } },
+	};
+	
+	return expect(io, sizeof(io)/sizeof(*io));
+}
+
+bool scan_operators(void) {
+	Expectation io = {
+		{ "&&||==!=<=>=", { LOG_AND, LOG_OR, EQ, NEQ, LEQ, GEQ, EOF } },
+		{ "< > = + - * /", { LT, GT, ASSIGN, ADD, SUB, MUL, DIV, EOF } },
+		{ ";,(){}", { ';', ',', '(', ')', '{', '}', EOF } },
+		{ "&", { YYUNDEF, EOF } },
+		{ "|x", { YYUNDEF, IDENT, EOF } },
+		{ "!", { YYUNDEF, EOF } },
+		{ "100%", { INT_LITERAL, YYUNDEF, EOF } },
+		{ "\"open", { YYUNDEF, IDENT, EOF } },
+		{ "\"a\nb\"", { YYUNDEF, IDENT, IDENT, YYUNDEF, EOF } },
+	};
+	
+	return expect(io, sizeof(io)/sizeof(*io));
+}
+
+bool scan_comments(void) {
+	Expectation io = {
+		{ "a // b\nc", { IDENT, IDENT, EOF } },
+		{ "// no newline", { DIV, DIV, IDENT, IDENT, EOF } },
+		{ "a /* b */ c", { IDENT, IDENT, EOF } },
+		{ "/* ***/x", { IDENT, EOF } },
+		{ "/* **/ */x", { IDENT, EOF } },
+	};
+	
+	return expect(io, sizeof(io)/sizeof(*io));
+}
+
+bool scan_unclosed_input(void) {
+	start("x /* open");
+	EXPECT_EQ(next(), IDENT, "%i", "x");
+	EXPECT_EQ(next(), YYUNDEF, "%i", "/* open");
+	EXPECT_EQ(next(), YYUNDEF, "%i", "/* open");
+	
+	/* the star before the slash is consumed by the one in front of it */
+	start("/***/x");
+	EXPECT_EQ(next(), YYUNDEF, "%i", "/***/x");
+	
+	return true;
+}
+
+bool scan_line_numbers(void) {
+	start("a\n/* \n*\n */ b // c\n\r\n\"d\"");
+	EXPECT_EQ(next(), IDENT, "%i", "a");
+	EXPECT_EQ(scanner.line, 1, "%i", "a");
+	EXPECT_EQ(next(), IDENT, "%i", "b");
+	EXPECT_EQ(scanner.line, 4, "%i", "b");
+	EXPECT_EQ(next(), STRING_LITERAL, "%i", "\"d\"");
+	EXPECT_EQ(scanner.line, 6, "%i", "\"d\"");
+	
+	return true;
+}
+
+bool scan_skip_levels(void) {
+	/* runs of every kind that cross the 16 and 32 byte boundaries */
+	const char *input =
+		" \t\n\v\f\r  \n\n\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\tx"
+		"\n /* a comment\nthat spans\nseveral lines and is longer than a vector ** */ y"
+		"\"a string that is longer than thirty-two bytes\" \"broken\n\" \x80\xff"
+		"                                                                 z";
+	size_t len = strlen(input);
+	
+	for (size_t i = 0; i <= len; ++i) {
+		const char *limit = input + len - i % 7;
+		if (input + i > limit) { continue; }
+		
+		int line[3] = { 0 }, star[3] = { 0 };
+		const char *space_at[3], *star_at[3], *string_at[3];
+		
+		for (SkipLevel level = SKIP_SCALAR; level <= SKIP_AVX2; ++level) {
+			skipSelect(level);
+			space_at[level] = skipSpace(input + i, limit, &line[level]);
+			star_at[level] = skipToStar(input + i, limit, &star[level]);
+			string_at[level] = skipString(input + i, limit);
+			
+			EXPECT_EQ(space_at[level], space_at[SKIP_SCALAR], "%p", "space");
+			EXPECT_EQ(line[level], line[SKIP_SCALAR], "%i", "space");
+			EXPECT_EQ(star_at[level], star_at[SKIP_SCALAR], "%p", "star");
+			EXPECT_EQ(star[level], star[SKIP_SCALAR], "%i", "star");
+			EXPECT_EQ(string_at[level], string_at[SKIP_SCALAR], "%p", "string");
+		}
+	}
+	
+	skipSelect(skipDetect());
+	return true;
+}
@@ -0,0 +1,26 @@
+#ifndef SCAN_TESTS_H_INCLUDED
+#define SCAN_TESTS_H_INCLUDED
+
+#include <stdbool.h>
+
+/**
+ * [X-Macro](https://en.wikipedia.org/wiki/X_macro) containing the names
+ * of the test cases.
+ */
+#define SCAN_TESTS \
+	X(scan_keywords) \
+	X(scan_keyword_near_misses) \
+	X(scan_literals) \
+	X(scan_number_prefixes) \
+	X(scan_operators) \
+	X(scan_comments) \
+	X(scan_unclosed_input) \
+	X(scan_line_numbers) \
+	X(scan_skip_levels)
+
+/* declare the test functions based on the list */
+#define X(CASE) extern bool CASE(void);
+SCAN_TESTS
+#undef X
+
+#endif